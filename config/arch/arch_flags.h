@@ -319,6 +319,14 @@
 #     uC.PERIPH["EFR32MG1V132F256GM32"]    = {GPIO = true, UART = true}
 #     uC.PERIPH["EFR32MG1V132F256GM48"]    = {GPIO = true, UART = true}
 # end
+#
+# if uC.ARCH == "posix" then
+#     uC.AddPriorityItems = function(this, no_default)
+#         this:AddItem("Priority 0", "0")
+#     end
+#
+#     uC.PERIPH["LINUX_X86"] = {UART = true, HOSTBLK = true}
+# end
 #++*/
 
 #/* include of CPU mandatory file in Makefile
@@ -332,6 +340,7 @@ include ./config/arch/$(__CPU_ARCH__)/cpu_flags.h
 #include "noarch/sdspi_flags.h"
 #include "noarch/dht11_flags.h"
 #include "noarch/i2cee_flags.h"
+#include "noarch/veth_flags.h"
 
 #if (__CPU_ARCH__ == stm32f1)
 #include "stm32f1/can_flags.h"
@@ -370,6 +379,10 @@ include ./config/arch/$(__CPU_ARCH__)/cpu_flags.h
 #include "efr32/cpu_flags.h"
 #include "efr32/gpio_flags.h"
 #include "efr32/uart_flags.h"
+#elif (__CPU_ARCH__ == posix)
+#include "posix/cpu_flags.h"
+#include "posix/uart_flags.h"
+#include "posix/hostblk_flags.h"
 #endif
 
 #/*--
@@ -700,6 +713,30 @@ __ENABLE_PWM__=_NO_
 __ENABLE_SPIEE__=_NO_
 #*/
 
+#/*--
+# if uC.PERIPH[uC.NAME].HOSTBLK ~= nil then
+#     this:PutWidgets("HOSTBLK", "arch/"..uC.ARCH.."/hostblk_flags.h")
+#     this:SetToolTip("Block device backed by a file of the host system.")
+# else
+#     this:AddWidget("Value")
+#     this:SetFlagValue("__ENABLE_HOSTBLK__", "_NO_")
+# end
+#--*/
+#define __ENABLE_HOSTBLK__ _NO_
+#/*
+__ENABLE_HOSTBLK__=_NO_
+#*/
+
+#/*--
+# this:PutWidgets("VETH", "arch/noarch/veth_flags.h")
+# this:SetToolTip("Virtual Ethernet MAC: loopback pairs and pcap\n"..
+#                 "capture/replay for network benchmarks.")
+#--*/
+#define __ENABLE_VETH__ _NO_
+#/*
+__ENABLE_VETH__=_NO_
+#*/
+
 #// MODULE LIST END
 #//-----------------------------------------------------------------------------
 #/*-- save current configuration if CPU was changed
@@ -0,0 +1,112 @@
+#/*=============================================================================
+# @file    cpu_flags.h
+#
+# @author  Daniel Zorychta
+#
+# @brief   This file contains CPU configuration flags.
+#          Hybrid file: included both by Make and CC.
+#
+# @note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+#
+#          This program is free software; you can redistribute it and/or modify
+#          it under the terms of the GNU General Public License as published by
+#          the Free Software Foundation and modified by the dnx RTOS exception.
+#
+#          NOTE: The modification  to the GPL is  included to allow you to
+#                distribute a combined work that includes dnx RTOS without
+#                being obliged to provide the source  code for proprietary
+#                components outside of the dnx RTOS.
+#
+#          The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+#          but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+#          MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+#          GNU General Public License for more details.
+#
+#          Full license text is available on the following file: doc/license.txt.
+#
+#
+#=============================================================================*/
+
+#/*
+#* NOTE: All flags defined as: __FLAG_NAME__ (with doubled underscore as suffix
+#*       and prefix) are exported to the single configuration file
+#*       (by using Configtool) when entire project configuration is exported.
+#*       All other flag definitions and statements are ignored.
+#*/
+
+#ifndef _CPU_FLAGS_H_
+#define _CPU_FLAGS_H_
+
+#/*--
+# this:SetLayout("TitledGridBack", 2, "Home > Microcontroller > Selection",
+#                function() this:LoadFile("arch/arch_flags.h") end)
+#++*/
+
+#/*-- Flag is set in __CPU_NAME__ event
+# this:AddWidget("Value")
+#--*/
+#define __CPU_CODE__ _LINUX_X86
+#/*
+__CPU_CODE__=_LINUX_X86
+#*/
+
+#/*-- Flag is set in __CPU_NAME__ event
+# this:AddWidget("Value")
+#--*/
+#define __CPU_FAMILY__ _HOST_
+#/*
+__CPU_FAMILY__=_HOST_
+#*/
+
+#/*--
+# this:AddWidget("Combobox", "Host")
+# this:AddItem("LINUX_X86", "LINUX_X86")
+#--*/
+#define __CPU_NAME__ LINUX_X86
+#/*
+__CPU_NAME__=LINUX_X86
+#*/
+
+#/*--
+# this:AddWidget("Spinbox", 65536, 268435456, "Heap size [B]")
+# this:SetToolTip("Size of the memory region used as system heap. The region\n"..
+#                 "is allocated statically in the host process.")
+#--*/
+#define __CPU_HEAP_SIZE__ 4194304
+
+#/*--
+# this:AddWidget("Value")
+#--*/
+#define __CPU_DEFAULT_IRQ_PRIORITY__ 0
+
+
+#//-----------------------------------------------------------------------------
+#// mandatory flags, not configurable
+#//-----------------------------------------------------------------------------
+#define _CPU_START_FREQUENCY_           (1000000UL)
+#define _CPU_HEAP_ALIGN_                (8)
+#define _CPU_IRQ_RTOS_KERNEL_PRIORITY_  (0)
+#define _CPU_IRQ_RTOS_SYSCALL_PRIORITY_ (0)
+#define _CPU_IRQ_RTOS_APICALL_PRIORITY_ (0)
+#define _CPU_IRQ_SAFE_PRIORITY_         (0)
+#define ARCH_posix
+#/*
+# host has no GPIO driver, module is disabled when architecture is selected
+# manually, without the Configtool (ordinary assignment is ignored)
+override __ENABLE_GPIO__=_NO_
+CPUCONFIG_AFLAGS=
+CPUCONFIG_CFLAGS=-pthread -funsigned-char -fno-pie
+CPUCONFIG_CXXFLAGS=-pthread -funsigned-char -fno-pie
+CPUCONFIG_LDFLAGS=-pthread -no-pie -lrt
+#*/
+
+#// CPU family
+#define _HOST_                   0x1d2b6b3c
+
+#// All CPU names definitions - general usage
+#define _LINUX_X86               0x5c44a2b5
+
+#endif /* _CPU_FLAGS_H_ */
+#/*=============================================================================
+#  End of file
+#=============================================================================*/
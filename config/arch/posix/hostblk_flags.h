@@ -0,0 +1,74 @@
+/*=========================================================================*//**
+@file    hostblk_flags.h
+
+@author  Daniel Zorychta
+
+@brief   HOSTBLK module configuration flags.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * NOTE: All flags defined as: __FLAG_NAME__ (with doubled underscore as suffix
+ *       and prefix) are exported to the single configuration file
+ *       (by using Configtool) when entire project configuration is exported.
+ *       All other flag definitions and statements are ignored.
+ */
+
+#ifndef _HOSTBLK_FLAGS_H_
+#define _HOSTBLK_FLAGS_H_
+
+/*--
+this:SetLayout("TitledGridBack", 2, "Home > Microcontroller > HOSTBLK",
+               function() this:LoadFile("arch/arch_flags.h") end)
+++*/
+
+/*--
+this:AddWidget("Spinbox", 1, 4, "Number of devices")
+--*/
+#define __HOSTBLK_DEVICES__ 1
+
+/*--
+this:AddWidget("Editline", true, "Image file of device 0")
+this:SetToolTip("Host file used as device 0 storage. Path is relative to the\n"..
+                "working directory of the process.")
+--*/
+#define __HOSTBLK_IMAGE_0__ "hostblk0.img"
+
+/*--
+this:AddWidget("Editline", true, "Image file of device 1")
+--*/
+#define __HOSTBLK_IMAGE_1__ "hostblk1.img"
+
+/*--
+this:AddWidget("Editline", true, "Image file of device 2")
+--*/
+#define __HOSTBLK_IMAGE_2__ "hostblk2.img"
+
+/*--
+this:AddWidget("Editline", true, "Image file of device 3")
+--*/
+#define __HOSTBLK_IMAGE_3__ "hostblk3.img"
+
+#endif /* _HOSTBLK_FLAGS_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
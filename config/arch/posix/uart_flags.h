@@ -0,0 +1,63 @@
+/*=========================================================================*//**
+@file    uart_flags.h
+
+@author  Daniel Zorychta
+
+@brief   UART module configuration flags.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * NOTE: All flags defined as: __FLAG_NAME__ (with doubled underscore as suffix
+ *       and prefix) are exported to the single configuration file
+ *       (by using Configtool) when entire project configuration is exported.
+ *       All other flag definitions and statements are ignored.
+ */
+
+#ifndef _UART_FLAGS_H_
+#define _UART_FLAGS_H_
+
+/*--
+this:SetLayout("TitledGridBack", 2, "Home > Microcontroller > UART",
+               function() this:LoadFile("arch/arch_flags.h") end)
+++*/
+
+/*--
+this:AddExtraWidget("Label", "LabelDefaults", "Console", -1, "bold")
+this:AddExtraWidget("Void", "VoidDefaults")
+++*/
+/*--
+this:AddWidget("Spinbox", 16, 1024, "Rx buffer length [B]")
+--*/
+#define __UART_RX_BUFFER_LEN__ 128
+
+/*--
+this:AddWidget("Spinbox", 1, 100, "Input poll interval [ms]")
+this:SetToolTip("UART0 is connected to the host process standard input and\n"..
+                "output. Input is polled by a kernel thread at this interval.")
+--*/
+#define __UART_POLL_INTERVAL__ 10
+
+#endif /* _UART_FLAGS_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -44,6 +44,18 @@ this:AddWidget("Checkbox", "Enable file system debug")
 --*/
 #define __EEFS_LOG_ENABLE__ _NO_
 
+/*--
+this:AddWidget("Checkbox", "Wear leveling")
+this:SetToolTip("When enabled, new blocks are allocated by using rotating cursor "..
+                "and the least written free block is selected. Write counters "..
+                "count physical block writes (cache flushes, not each file write) "..
+                "and are kept in RAM only (2 bytes per block). Counters start from "..
+                "zero at each mount, so leveling is balanced within single mount "..
+                "only; the cursor start is randomized at mount to spread writes "..
+                "between mounts.")
+--*/
+#define __EEFS_CFG_WEAR_LEVELING__ _YES_
+
 #endif /* _EEFS_FLAGS_H_ */
 /*==============================================================================
   End of file
@@ -69,6 +69,22 @@ this:SetToolTip("This value determines how many blocks is cached. The 4 blocks "
 --*/
 #define __EXT4FS_CFG_BLK_CACHE_SIZE__ 1
 
+/*--
+this:AddWidget("Spinbox", 0, 64, "Readahead window [sectors]")
+this:SetToolTip("Maximum number of sectors read ahead when sequential access "..
+                "is detected. Use 0 to disable readahead. Value can be changed "..
+                "at mount by using readahead=<sectors> option.")
+--*/
+#define __EXT4FS_CFG_READAHEAD__ 16
+
+/*--
+this:AddWidget("Spinbox", 1, 16, "Write coalescing [sectors]")
+this:SetToolTip("Maximum number of adjacent dirty sectors written to the device "..
+                "by single write at synchronization. Use 1 to disable coalescing. "..
+                "Value can be changed at mount by using coalesce=<sectors> option.")
+--*/
+#define __EXT4FS_CFG_WRITE_COALESCE__ 16
+
 #endif /* _EXT4FS_FLAGS_H_ */
 /*==============================================================================
   End of file
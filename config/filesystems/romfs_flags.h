@@ -45,6 +45,14 @@ this:AddWidget("Checkbox", "Executable flag in regular files")
 --*/
 #define __ROMFS_CFG_EXEC_FILES__ _YES_
 
+/*--
+this:AddWidget("Checkbox", "Compressed image")
+this:SetToolTip("Files are compressed in blocks (LZ4) when romfs image is generated. "..
+                "Each opened compressed file allocates single block buffer (1 KiB) "..
+                "for decoding. Files that do not compress are stored uncompressed.")
+--*/
+#define __ROMFS_CFG_COMPRESSION__ _NO_
+
 #endif /* _ROMFS_FLAGS_H_ */
 /*==============================================================================
   End of file
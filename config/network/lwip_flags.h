@@ -933,7 +933,7 @@ this:AddItem("Disable (0)", "0")
 this:AddItem("Enable (1)", "1")
 this:SetToolTip("LWIP_STATS==1: Enable statistics collection in lwip_stats.")
 --*/
-#define __NETWORK_LWIP_STATS__ 0
+#define __NETWORK_LWIP_STATS__ 1
 
 
 
@@ -55,6 +55,16 @@
 __ENABLE_NETWORK__=_NO_
 #*/
 
+#/*--
+# this:AddWidget("Checkbox", "Socket statistics (/proc/net)")
+# this:AddExtraWidget("Void", "VoidSocketStats")
+# this:SetToolTip("Collect per-socket counters and queue state that are shown in the /proc/net/sockets file.")
+#--*/
+#define __NETWORK_SOCKET_STATISTICS__ _YES_
+#/*
+__NETWORK_SOCKET_STATISTICS__=_YES_
+#*/
+
 #/*--
 # this:AddExtraWidget("Label", "LabelStacks", "\nStacks", -1, "bold")
 # this:AddExtraWidget("Void", "VoidStacks")
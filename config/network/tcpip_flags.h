@@ -91,6 +91,32 @@ __NETWORK_TCPIP_STACK__=__STACK_LWIP__
 #--*/
 #define __NETWORK_TCPIP_DEVICE_PATH__ "/dev/ethmac"
 
+#/*--
+# this:AddExtraWidget("Label", "LabelRx", "\nPacket reception", -1, "bold")
+# this:AddExtraWidget("Void", "VoidRx0")
+# this:AddExtraWidget("Void", "VoidRx1")
+#
+# this:AddWidget("Spinbox", 1, 64, "Rx buffer pool size")
+# this:SetToolTip("Number of preallocated packet buffers loaned to the stack by\n"..
+#                 "interface. Each buffer takes about 1.5 KiB of RAM (maximum\n"..
+#                 "Ethernet frame and pbuf header), e.g. 2 buffers: 3 KiB,\n"..
+#                 "8 buffers: 12 KiB. Pool is allocated when interface is\n"..
+#                 "started and is never released. When all buffers are used by\n"..
+#                 "the stack, packets are copied to buffers allocated from heap.")
+# this:AddExtraWidget("Void", "VoidRxPool0", "")
+# this:AddExtraWidget("Void", "VoidRxPool1", "")
+#--*/
+#define __NETWORK_TCPIP_RX_POOL_SIZE__ 2
+
+#/*--
+# this:AddWidget("Spinbox", 1, 16, "Rx batch size")
+# this:SetToolTip("Maximum number of packets received from interface\n"..
+#                 "by single driver request. Limited by Rx buffer pool size.")
+# this:AddExtraWidget("Void", "VoidRxBatch0", "")
+# this:AddExtraWidget("Void", "VoidRxBatch1", "")
+#--*/
+#define __NETWORK_TCPIP_RX_BATCH__ 4
+
 
 
 #// Include configuration of selected task.
@@ -94,14 +94,15 @@ this:SetToolTip("Number of threads that can be started by user process.")
 /*--
 this:AddWidget("Combobox", "Mode of kworker syscall threads")
 this:AddItem("Mode 0: Automatic syscall thread allocation", "0")
-this:AddItem("Mode 1: Fixed number of syscall threads", "1")
+this:AddItem("Mode 1: Pool of syscall threads", "1")
 this:AddItem("Mode 2: Flat syscalls handling", "2")
 this:SetToolTip("When 'Mode 0: Automatic syscall thread allocation' is enabled then system creates\n"..
                 "syscall threads on demand. This option is slow but if system usage is\n"..
                 "not too intense then this option can limit RAM usage (peek usage can be high).\n\n"..
-                "When 'Mode 1: Fixed number of syscall threads' is used then user define how many\n"..
-                "syscall threads are created at system startup. This option provides\n"..
-                "fast response for syscalls but may use a lot of RAM.\n\n"..
+                "When 'Mode 1: Pool of syscall threads' is used then user define how many\n"..
+                "syscall threads are created at system startup and how many threads can be\n"..
+                "started on demand. This option provides fast response for syscalls but may\n"..
+                "use a lot of RAM.\n\n"..
                 "When 'Mode 2: Flat syscalls handling' is used then syscalls are handled directly "..
                 "by client process/thread. This option provides the fastest response for syscalls\n"..
                 "but each process must increase stack size for IO operations e.g. file system.")
@@ -115,21 +116,81 @@ this:SetToolTip("Number of threads that can be started by system process.")
 #define __OS_TASK_MAX_SYSTEM_THREADS__ 6
 
 /*--
-this:AddWidget("Spinbox", 1, 32, "Number of fixed I/O kworker threads")
-this:SetToolTip("Number of kworker threads for I/O syscall handling.\n"..
-                "Option valid only for 'Mode 1: Fixed number of syscall threads'.")
+this:AddWidget("Spinbox", 1, 32, "Minimum number of I/O kworker threads")
+this:SetToolTip("Number of kworker threads for I/O syscall handling started at system startup.\n"..
+                "Option valid only for 'Mode 1: Pool of syscall threads'.")
 --*/
 #define __OS_TASK_KWORKER_IO_THREADS__ 4
 
+/*--
+this:AddWidget("Spinbox", 1, 32, "Maximum number of I/O kworker threads")
+this:SetToolTip("Maximum number of kworker threads for I/O syscall handling. Threads above\n"..
+                "minimum number are started when all threads are busy and are stopped\n"..
+                "after idle timeout. Number is limited by maximum number of kworker threads.\n"..
+                "Option valid only for 'Mode 1: Pool of syscall threads'.")
+--*/
+#define __OS_TASK_KWORKER_IO_THREADS_MAX__ 4
+
+/*--
+this:AddWidget("Spinbox", 1, 3600, "I/O kworker thread idle timeout [s]")
+this:SetToolTip("Time after which idle I/O kworker thread above minimum number is stopped.\n"..
+                "Option valid only for 'Mode 1: Pool of syscall threads'.")
+--*/
+#define __OS_TASK_KWORKER_IO_IDLE_TIMEOUT__ 10
+
 /*--
 this:AddWidget("Combobox", "Priority management of syscall threads")
 this:AddItem("Equal priority for all", "0")
 this:AddItem("The same as the application thread", "1")
 this:SetToolTip("Number of kworker threads for I/O syscall handling.\n"..
-                "Option valid only for 'Mode 1: Fixed number of syscall threads'.")
+                "Option valid only for 'Mode 1: Pool of syscall threads'.")
 --*/
 #define __OS_TASK_KWORKER_THREADS_PRIORITY__ 0
 
+/*--
+this:AddExtraWidget("Label", "LabelTaskPool", "\nTask pool", -1, "bold")
+this:AddExtraWidget("Void", "VoidTaskPool")
+++*/
+/*--
+this:AddWidget("Spinbox", 48, 8192, "Small pool stack depth [levels]")
+this:SetToolTip("Stack depth of tasks in the small class of task pool.\n"..
+                "Task pool contains preallocated stacks and task control blocks. "..
+                "Task is created by using the smallest free stack that is not smaller "..
+                "than requested stack depth. If there is no suitable stack then the task "..
+                "is allocated on the heap. Pool reduces task creation time and heap fragmentation.")
+--*/
+#define __OS_TASK_POOL_SMALL_STACK_DEPTH__ 256
+
+/*--
+this:AddWidget("Spinbox", 0, 32, "Small pool tasks")
+this:SetToolTip("Number of preallocated tasks in the small class. Use 0 to disable class.")
+--*/
+#define __OS_TASK_POOL_SMALL_COUNT__ 0
+
+/*--
+this:AddWidget("Spinbox", 48, 8192, "Medium pool stack depth [levels]")
+this:SetToolTip("Stack depth of tasks in the medium class of task pool.")
+--*/
+#define __OS_TASK_POOL_MEDIUM_STACK_DEPTH__ 512
+
+/*--
+this:AddWidget("Spinbox", 0, 32, "Medium pool tasks")
+this:SetToolTip("Number of preallocated tasks in the medium class. Use 0 to disable class.")
+--*/
+#define __OS_TASK_POOL_MEDIUM_COUNT__ 0
+
+/*--
+this:AddWidget("Spinbox", 48, 8192, "Large pool stack depth [levels]")
+this:SetToolTip("Stack depth of tasks in the large class of task pool.")
+--*/
+#define __OS_TASK_POOL_LARGE_STACK_DEPTH__ 1024
+
+/*--
+this:AddWidget("Spinbox", 0, 32, "Large pool tasks")
+this:SetToolTip("Number of preallocated tasks in the large class. Use 0 to disable class.")
+--*/
+#define __OS_TASK_POOL_LARGE_COUNT__ 0
+
 /*--
 this:AddExtraWidget("Label", "LabelFeatures", "\nSystem features (advanced)", -1, "bold")
 this:AddExtraWidget("Void", "VoidFeatures")
@@ -152,6 +213,14 @@ this:SetToolTip("This function enables CPU load measurement.")
 --*/
 #define __OS_MONITOR_CPU_LOAD__ _YES_
 
+/*--
+this:AddWidget("Checkbox", "Kernel event tracer")
+this:SetToolTip("This function enables tracer of kernel events (context switches, "..
+                "blocking on queues, interrupts, and system calls). Events are "..
+                "stored in the ring buffer and can be read from /proc/trace file.")
+--*/
+#define __OS_ENABLE_TRACE__ _NO_
+
 /*--
 this:AddWidget("Checkbox", "Time management functions")
 this:SetToolTip("This function enables time management (RTC).")
@@ -248,6 +317,15 @@ this:SetToolTip("This option enables IPC shared memory.")
 --*/
 #define __OS_ENABLE_SHARED_MEMORY__ _NO_
 
+/*--
+this:AddWidget("Checkbox", "User space heap arenas")
+this:SetToolTip("If this option is enabled then small allocations of malloc(), calloc(), and realloc() "..
+                "are served from memory chunks taken from the kernel by each process. "..
+                "Allocations do not use syscalls and realloc() can resize block in place. "..
+                "Large allocations are still served directly by the kernel.")
+--*/
+#define __OS_ENABLE_USER_HEAP__ _NO_
+
 /*--
 this:AddWidget("Checkbox", "System log function")
 this:SetToolTip("If this function is selected then system messages can be send to the terminal or file.")
@@ -304,6 +382,23 @@ this:SetToolTip("This option determine period of cache synchronization with stor
 --*/
 #define __OS_SYSTEM_CACHE_SYNC_PERIOD__ 30
 
+/*--
+this:AddWidget("Spinbox", 0, 1048576, "Block device cache size [bytes]")
+this:SetToolTip("This option determine maximum amount of memory used by block device cache. "..
+                "The cache is shared by all block-backed file systems. Use 0 to disable cache.\n"..
+                "Readahead is limited to the cache capacity: each block read ahead costs\n"..
+                "about twice the block size (read buffer and cached block), thus e.g. ext4fs\n"..
+                "readahead of 16 sectors needs at least 20 KiB. Clean blocks are released\n"..
+                "when the system is short of memory.")
+--*/
+#define __OS_SYSTEM_CACHE_SIZE__ 4096
+
+/*--
+this:AddWidget("Spinbox", 0, 64, "Cache readahead [blocks]")
+this:SetToolTip("This option determine maximum number of blocks read ahead when sequential access is detected.")
+--*/
+#define __OS_SYSTEM_CACHE_READAHEAD__ 4
+
 /*--
 this:AddWidget("Spinbox", 0, 16777216, "Network memory limit [bytes]")
 this:SetToolTip("This option enables memory limit for network subsystem. Use 0 for no limit.")
@@ -337,6 +432,206 @@ this:SetToolTip("Enable/Disable block overflow check of heap memory.")
 --*/
 #define __OS_HEAP_OVERFLOW_CHECK__ _NO_
 
+/*--
+this:AddWidget("Spinbox", 16, 65536, "Kernel trace buffer [events]")
+this:SetToolTip("This option determine how many events can be stored by kernel event tracer. "..
+                "Each event uses 12 bytes of RAM. Option is active when kernel event tracer is enabled.")
+--*/
+#define __OS_TRACE_BUFFER_LENGTH__ 512
+
+/*--
+this:AddWidget("Spinbox", 256, 65536, "User heap chunk size [bytes]")
+this:SetToolTip("Size of memory chunk taken from the kernel by user space heap arena. "..
+                "Allocations larger than half of chunk are served directly by the kernel. "..
+                "Option is active when user space heap arenas are enabled.")
+--*/
+#define __OS_USER_HEAP_CHUNK_SIZE__ 1024
+
+/*--
+this:AddWidget("Combobox", "Allocation profiler")
+this:AddItem("Disable", "_NO_")
+this:AddItem("Enable", "_YES_")
+this:SetToolTip("Enable/Disable kernel allocation profiler. Profiler records caller address, size, "..
+                "and lifetime of each allocation. Call site statistics are available in /proc/allocprof. "..
+                "Each allocated block is extended by small header. Use only for debug purposes!")
+--*/
+#define __OS_ENABLE_ALLOC_PROFILER__ _NO_
+
+/*--
+this:AddWidget("Spinbox", 8, 1024, "Allocation profiler call sites")
+this:SetToolTip("Number of call sites recorded by allocation profiler. Each call site uses 28 bytes of RAM. "..
+                "Option is active when allocation profiler is enabled.")
+--*/
+#define __OS_ALLOC_PROFILER_SITES__ 32
+
+/*--
+this:AddWidget("Combobox", "Stack profiler")
+this:AddItem("Disable", "_NO_")
+this:AddItem("Enable", "_YES_")
+this:SetToolTip("Enable/Disable stack profiler. Profiler records peak stack usage of each program "..
+                "and thread (identified by program name and thread function) across all runs. "..
+                "Statistics and recommended stack depths are available in /proc/stackprof.")
+--*/
+#define __OS_ENABLE_STACK_PROFILER__ _NO_
+
+/*--
+this:AddWidget("Spinbox", 4, 256, "Stack profiler entries")
+this:SetToolTip("Number of program threads recorded by stack profiler. Each entry uses 20 bytes of RAM. "..
+                "Option is active when stack profiler is enabled.")
+--*/
+#define __OS_STACK_PROFILER_ENTRIES__ 32
+
+/*--
+this:AddWidget("Spinbox", 0, 200, "Stack profiler safety margin [%]")
+this:SetToolTip("Margin added to peak stack usage to calculate recommended stack depth. "..
+                "Option is active when stack profiler is enabled.")
+--*/
+#define __OS_STACK_PROFILER_MARGIN__ 25
+
+/*--
+this:AddExtraWidget("Void", "VoidStackProfiler")
+++*/
+
+/*--
+this:AddWidget("Combobox", "Lock profiler")
+this:AddItem("Disable", "_NO_")
+this:AddItem("Enable", "_YES_")
+this:SetToolTip("Enable/Disable lock profiler. Profiler records number of acquires, contended acquires, "..
+                "wait time and hold time of mutexes, semaphores, queues (send), and scheduler lock. "..
+                "Statistics are available in /proc/lockprof (write 'reset' to clear). "..
+                "Locks are time stamped by CPU cycle counter. Use only for debug purposes!")
+--*/
+#define __OS_ENABLE_LOCK_PROFILER__ _NO_
+
+/*--
+this:AddWidget("Spinbox", 4, 255, "Lock profiler entries")
+this:SetToolTip("Number of named locks recorded by lock profiler (including entries of unnamed locks "..
+                "and scheduler lock). Each entry uses 32 bytes of RAM. "..
+                "Option is active when lock profiler is enabled.")
+--*/
+#define __OS_LOCK_PROFILER_ENTRIES__ 32
+
+/*--
+this:AddExtraWidget("Label", "LabelMemPolicy", "\nMemory region allocation policy", -1, "bold")
+this:AddExtraWidget("Void", "VoidMemPolicy")
+++*/
+/*--
+this:AddWidget("Combobox", "Kernel")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by kernel objects (tasks, queues, etc.). "..
+                "Internal RAM is accessible by DMA, fast RAM (e.g. CCM) is not accessible by DMA, "..
+                "and external RAM (e.g. SDRAM) is large but slow. Region types not listed are not used.")
+--*/
+#define __OS_MM_POLICY_KERNEL__ 0x31
+
+/*--
+this:AddWidget("Combobox", "File systems")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by file systems.")
+--*/
+#define __OS_MM_POLICY_FILESYSTEM__ 0x31
+
+/*--
+this:AddWidget("Combobox", "Network")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by network subsystem. Network buffers can be accessed by DMA.")
+--*/
+#define __OS_MM_POLICY_NETWORK__ 0x31
+
+/*--
+this:AddWidget("Combobox", "Programs")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by programs (applications).")
+--*/
+#define __OS_MM_POLICY_PROGRAM__ 0x31
+
+/*--
+this:AddWidget("Combobox", "Shared memory")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by shared memory buffers.")
+--*/
+#define __OS_MM_POLICY_SHARED__ 0x31
+
+/*--
+this:AddWidget("Combobox", "Disc cache")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by disc cache. Cache buffers are large and rarely used, "..
+                "thus external RAM is the best place for them.")
+--*/
+#define __OS_MM_POLICY_CACHE__ 0x13
+
+/*--
+this:AddWidget("Combobox", "Modules (drivers)")
+this:AddItem("Internal, external", "0x31")
+this:AddItem("Internal, external, fast", "0x231")
+this:AddItem("Internal, fast, external", "0x321")
+this:AddItem("Fast, internal, external", "0x312")
+this:AddItem("External, internal", "0x13")
+this:AddItem("External, internal, fast", "0x213")
+this:AddItem("Internal only", "0x1")
+this:AddItem("Fast, internal", "0x12")
+this:AddItem("External only", "0x3")
+this:SetToolTip("Order of memory regions used by modules (drivers). Drivers can use DMA, thus "..
+                "fast RAM should be selected only if all used drivers support it.")
+--*/
+#define __OS_MM_POLICY_MODULE__ 0x31
+
+/*--
+this:AddWidget("Spinbox", 0, 1048576, "Low memory watermark [bytes]")
+this:SetToolTip("When allocation would drop free memory below this level then registered shrinkers "..
+                "(e.g. block cache, inactive terminal scrollback) release memory before allocation. "..
+                "Shrinkers are always called when allocation fails. Value 0 disables watermark.")
+--*/
+#define __OS_MM_LOW_WATERMARK__ 0
+
 
 /*--
 this:AddExtraWidget("Label", "LabelMisc", "\nMiscellaneous", -1, "bold")
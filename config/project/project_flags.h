@@ -80,11 +80,13 @@ __PROJECT_TOOLCHAIN__=arm-none-eabi-
 #define stm32f3 0x483962d4
 #define stm32f4 0x8dd787b6
 #define efr32   0xcd975039
+#define posix   0xe0e30f6e
 #/*--
 # this:AddWidget("Combobox", "CPU architecture")
 # this:AddItem("STMicroelectronics STM32F1", "stm32f1")
 # this:AddItem("STMicroelectronics STM32F4", "stm32f4")
 # this:AddItem("Silicon Labs EFR32 Mighty Gecko (experimental)", "efr32")
+# this:AddItem("Linux process (POSIX, host build)", "posix")
 #--*/
 #define __CPU_ARCH__ stm32f1
 #/*
@@ -331,7 +331,10 @@ int ipc_client_call(ipc_client_t *client)
                         client->last_call = get_time_ms();
                         #endif
 
-                        semaphore_wait(client->ans_sem, 0); // reset semaphore
+                        // reset semaphore (wait with 0 timeout blocks for tick)
+                        if (semaphore_get_value(client->ans_sem) > 0) {
+                                semaphore_wait(client->ans_sem, 0);
+                        }
 
                         IPC_DEBUG("client calling...", 0, client->host, client);
 
@@ -0,0 +1,651 @@
+/*==============================================================================
+File    ipc_chan.c
+
+Author  Daniel Zorychta
+
+Brief   IPC channels in shared memory.
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "ipc_chan.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/shm.h>
+#include <dnx/thread.h>
+#include <lib/ring.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define CHAN_MAGIC              0x4348414E
+#define CHAN_NAME_LEN           12
+#define CHAN_ALIGN(_n)          (((_n) + 7) & ~7)
+#define BITMAP_WORDS(_count)    (((_count) + 31) / 32)
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+/**
+ * Message descriptor passed by ring.
+ */
+typedef struct {
+        uint32_t slot;          /*!< Slot number */
+        uint32_t len;           /*!< Message length */
+} chan_desc_t;
+
+/**
+ * Channel header in shared memory. Header is followed by ring storage, slot
+ * bitmap and slots.
+ */
+typedef struct {
+        uint32_t magic;         /*!< Valid channel magic (cleared by receiver) */
+        uint32_t msg_size;      /*!< Slot size */
+        uint32_t msg_count;     /*!< Number of slots */
+        uint32_t slot_wait;     /*!< Number of senders waiting for slot */
+        uint32_t users;         /*!< Number of attached processes (receiver + senders) */
+        sem_t   *doorbell;      /*!< Receiver doorbell (ring data semaphore) */
+        sem_t   *slot_sem;      /*!< Signaled when slot is released */
+        ring_t   ring;          /*!< Descriptor ring */
+} chan_shm_t;
+
+/**
+ * Channel object representation (process local).
+ */
+struct ipc_chan {
+        void       *this;                       /*!< This pointer */
+        chan_shm_t *shm;                        /*!< Shared channel header */
+        uint32_t   *bitmap;                     /*!< Slot bitmap (1: used) */
+        uint8_t    *slots;                      /*!< Slots */
+        bool        receiver;                   /*!< Channel created by this object */
+        char        name[CHAN_NAME_LEN + 1];    /*!< Shared memory name */
+};
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static size_t get_layout(size_t msg_size, size_t msg_count, size_t *ring_cap,
+                         size_t *bitmap_offset, size_t *slots_offset);
+static int  slot_alloc(ipc_chan_t *chan);
+static void slot_free(ipc_chan_t *chan, uint32_t slot);
+static int  slot_of(ipc_chan_t *chan, void *msg);
+static bool is_valid(chan_shm_t *shm);
+static bool user_get(chan_shm_t *shm);
+static void user_put(chan_shm_t *shm, const char *name);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+* @brief  Function create new channel. Created channel is owned by receiver.
+*
+* @param  chan          channel object destination pointer
+* @param  name          channel name (shared memory region name, max 12 chars)
+* @param  msg_size      max message size
+* @param  msg_count     number of messages (slots)
+*
+* @return One of errno value.
+*/
+//==============================================================================
+int ipc_chan_create(ipc_chan_t **chan, const char *name, size_t msg_size, size_t msg_count)
+{
+        int err = EINVAL;
+
+        if (  chan && name && (strlen(name) > 0) && (strlen(name) <= CHAN_NAME_LEN)
+           && msg_size && msg_count && (msg_count <= UINT16_MAX) ) {
+
+                size_t ring_cap, bitmap_offset, slots_offset;
+                size_t size = get_layout(msg_size, msg_count, &ring_cap,
+                                         &bitmap_offset, &slots_offset);
+
+                ipc_chan_t *this = calloc(1, sizeof(ipc_chan_t));
+                if (!this) {
+                        return errno;
+                }
+
+                strncpy(this->name, name, CHAN_NAME_LEN);
+                this->receiver = true;
+
+                void  *mem     = NULL;
+                size_t memsize = 0;
+
+                // errno is not set if shared memory is disabled
+                if (shmget(name, size) != 0) {
+                        err = errno ? errno : ENOTSUP;
+                        free(this);
+                        return err;
+                }
+
+                if (shmat(name, &mem, &memsize) != 0) {
+                        err = errno;
+                        shmrm(name);
+                        free(this);
+                        return err;
+                }
+
+                chan_shm_t *shm = mem;
+                shm->msg_size   = CHAN_ALIGN(msg_size);
+                shm->msg_count  = msg_count;
+                shm->doorbell   = semaphore_new(1, 0);
+                shm->slot_sem   = semaphore_new(1, 0);
+                shm->users      = 1;
+
+                this->shm    = shm;
+                this->bitmap = (uint32_t*)((uint8_t*)mem + bitmap_offset);
+                this->slots  = (uint8_t*)mem + slots_offset;
+
+                err = _builtinfunc(ring_init, &shm->ring, RING_MODE_MPSC, sizeof(chan_desc_t),
+                                   ring_cap, (uint8_t*)mem + sizeof(chan_shm_t));
+
+                if (!err && shm->doorbell && shm->slot_sem) {
+                        _builtinfunc(ring_set_waiters, &shm->ring, shm->doorbell, NULL);
+
+                        // slots behind the last one are never free
+                        if (msg_count % 32) {
+                                this->bitmap[msg_count / 32] = ~((1UL << (msg_count % 32)) - 1);
+                        }
+
+                        __atomic_store_n(&shm->magic, CHAN_MAGIC, __ATOMIC_RELEASE);
+
+                        this->this = this;
+                        *chan      = this;
+
+                } else {
+                        err = err ? err : ENOMEM;
+
+                        if (shm->doorbell) {
+                                semaphore_delete(shm->doorbell);
+                        }
+
+                        if (shm->slot_sem) {
+                                semaphore_delete(shm->slot_sem);
+                        }
+
+                        shmdt(name);
+                        shmrm(name);
+                        free(this);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function open existing channel (sender).
+*
+* @param  chan          channel object destination pointer
+* @param  name          channel name
+*
+* @return One of errno value (ENOENT if channel is closed by receiver).
+*/
+//==============================================================================
+int ipc_chan_open(ipc_chan_t **chan, const char *name)
+{
+        int err = EINVAL;
+
+        if (chan && name && (strlen(name) > 0) && (strlen(name) <= CHAN_NAME_LEN)) {
+
+                ipc_chan_t *this = calloc(1, sizeof(ipc_chan_t));
+                if (!this) {
+                        return errno;
+                }
+
+                void  *mem     = NULL;
+                size_t memsize = 0;
+
+                if (shmat(name, &mem, &memsize) != 0) {
+                        err = errno ? errno : ENOTSUP;
+                        free(this);
+                        return err;
+                }
+
+                chan_shm_t *shm = mem;
+                err = ENOENT;
+
+                if ((memsize >= sizeof(chan_shm_t)) && user_get(shm)) {
+
+                        // receiver may close channel in the meantime
+                        if (!is_valid(shm)) {
+                                user_put(shm, name);
+                                free(this);
+                                return err;
+                        }
+
+                        size_t ring_cap, bitmap_offset, slots_offset;
+                        get_layout(shm->msg_size, shm->msg_count, &ring_cap,
+                                   &bitmap_offset, &slots_offset);
+
+                        strncpy(this->name, name, CHAN_NAME_LEN);
+                        this->shm    = shm;
+                        this->bitmap = (uint32_t*)((uint8_t*)mem + bitmap_offset);
+                        this->slots  = (uint8_t*)mem + slots_offset;
+                        this->this   = this;
+                        *chan        = this;
+                        err          = 0;
+
+                } else {
+                        shmdt(name);
+                        free(this);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function close channel. When receiver closes channel then channel
+*         becomes invalid for senders and waiting senders are woken up.
+*         Semaphores and shared memory are removed by the last process that
+*         closes channel, so senders never wait on deleted semaphore.
+*
+* @param  chan          channel object
+*/
+//==============================================================================
+void ipc_chan_close(ipc_chan_t *chan)
+{
+        if (chan && (chan->this == chan)) {
+                chan_shm_t *shm = chan->shm;
+
+                if (chan->receiver) {
+                        __atomic_store_n(&shm->magic, 0, __ATOMIC_RELEASE);
+                        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+                        // woken sender passes signal to the next one
+                        if (__atomic_load_n(&shm->slot_wait, __ATOMIC_RELAXED)) {
+                                semaphore_signal(shm->slot_sem);
+                        }
+                }
+
+                user_put(shm, chan->name);
+
+                chan->this = NULL;
+                free(chan);
+        }
+}
+
+//==============================================================================
+/**
+* @brief  Function allocate message slot. Message shall be written directly to
+*         the slot and sent by ipc_chan_send().
+*
+* @param  chan          channel object
+* @param  msg           message slot destination pointer
+* @param  timeout       maximum wait time for free slot in milliseconds
+*                       (0: non-blocking)
+*
+* @return One of errno value (ETIME if there is no free slot, EPIPE if
+*         receiver closed channel).
+*/
+//==============================================================================
+int ipc_chan_alloc(ipc_chan_t *chan, void **msg, uint32_t timeout)
+{
+        int err = EINVAL;
+
+        if (chan && (chan->this == chan) && msg) {
+                chan_shm_t *shm = chan->shm;
+
+                if (!is_valid(shm)) {
+                        *msg = NULL;
+                        return EPIPE;
+                }
+
+                int slot = slot_alloc(chan);
+
+                // slot release is seen by sender or release sees waiting sender
+                while ((slot < 0) && timeout) {
+                        __atomic_add_fetch(&shm->slot_wait, 1, __ATOMIC_RELAXED);
+                        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+                        slot = slot_alloc(chan);
+
+                        bool signaled = (slot >= 0) || !is_valid(shm)
+                                     || semaphore_wait(shm->slot_sem, timeout);
+
+                        __atomic_sub_fetch(&shm->slot_wait, 1, __ATOMIC_RELAXED);
+
+                        if (!is_valid(shm)) {
+                                if (__atomic_load_n(&shm->slot_wait, __ATOMIC_RELAXED)) {
+                                        semaphore_signal(shm->slot_sem);
+                                }
+
+                                if (slot >= 0) {
+                                        slot_free(chan, slot);
+                                }
+
+                                *msg = NULL;
+                                return EPIPE;
+
+                        } else if (!signaled) {
+                                break;
+
+                        } else if (slot < 0) {
+                                slot = slot_alloc(chan);
+                        }
+                }
+
+                if (slot >= 0) {
+                        *msg = chan->slots + (slot * shm->msg_size);
+                        err  = 0;
+                } else {
+                        *msg = NULL;
+                        err  = ETIME;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function send message allocated by ipc_chan_alloc(). Function never
+*         blocks, ring has place for all slots.
+*
+* @param  chan          channel object
+* @param  msg           message slot
+* @param  len           message length
+*
+* @return One of errno value (EPIPE if receiver closed channel).
+*/
+//==============================================================================
+int ipc_chan_send(ipc_chan_t *chan, void *msg, size_t len)
+{
+        int err = EINVAL;
+
+        if (chan && (chan->this == chan) && (len <= chan->shm->msg_size)) {
+                int slot = slot_of(chan, msg);
+
+                if (slot >= 0 && !is_valid(chan->shm)) {
+                        err = EPIPE;
+
+                } else if (slot >= 0) {
+                        chan_desc_t desc = {.slot = slot, .len = len};
+
+                        if (_builtinfunc(ring_push, &chan->shm->ring, &desc, 1) == 1) {
+                                err = 0;
+                        } else {
+                                err = EIO;
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function receive message. Received message points to the slot
+*         written by sender and shall be released by ipc_chan_release().
+*
+* @param  chan          channel object
+* @param  msg           message destination pointer
+* @param  len           message length
+* @param  timeout       maximum wait time in milliseconds (0: non-blocking)
+*
+* @return One of errno value (ETIME if there is no message).
+*/
+//==============================================================================
+int ipc_chan_recv(ipc_chan_t *chan, void **msg, size_t *len, uint32_t timeout)
+{
+        int err = EINVAL;
+
+        if (chan && (chan->this == chan) && msg && len) {
+                chan_desc_t desc;
+                size_t      n = 0;
+
+                err = _builtinfunc(ring_pop_wait, &chan->shm->ring, &desc, 1, &n, timeout);
+
+                if (!err && (n == 1) && (desc.slot < chan->shm->msg_count)) {
+                        *msg = chan->slots + (desc.slot * chan->shm->msg_size);
+                        *len = desc.len;
+                } else {
+                        *msg = NULL;
+                        *len = 0;
+                        err  = err ? err : EIO;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function release received message (or allocated and not sent).
+*
+* @param  chan          channel object
+* @param  msg           message slot
+*
+* @return One of errno value.
+*/
+//==============================================================================
+int ipc_chan_release(ipc_chan_t *chan, void *msg)
+{
+        int err = EINVAL;
+
+        if (chan && (chan->this == chan)) {
+                int slot = slot_of(chan, msg);
+
+                if (slot >= 0) {
+                        slot_free(chan, slot);
+                        err = 0;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+* @brief  Function return max message size.
+*
+* @param  chan          channel object
+*
+* @return Max message size or 0 on error.
+*/
+//==============================================================================
+size_t ipc_chan_get_msg_size(ipc_chan_t *chan)
+{
+        if (chan && (chan->this == chan)) {
+                return chan->shm->msg_size;
+        } else {
+                return 0;
+        }
+}
+
+//==============================================================================
+/**
+* @brief  Function calculate layout of shared memory region.
+*
+* @param  msg_size              message size
+* @param  msg_count             number of messages
+* @param  ring_cap              ring capacity (power of 2)
+* @param  bitmap_offset         offset of slot bitmap
+* @param  slots_offset          offset of slots
+*
+* @return Region size.
+*/
+//==============================================================================
+static size_t get_layout(size_t msg_size, size_t msg_count, size_t *ring_cap,
+                         size_t *bitmap_offset, size_t *slots_offset)
+{
+        *ring_cap = 2;
+        while (*ring_cap < msg_count) {
+                *ring_cap *= 2;
+        }
+
+        *bitmap_offset = CHAN_ALIGN(sizeof(chan_shm_t)
+                                   + _RING_STORAGE_SIZE(RING_MODE_MPSC, sizeof(chan_desc_t), *ring_cap));
+
+        *slots_offset  = CHAN_ALIGN(*bitmap_offset + (BITMAP_WORDS(msg_count) * sizeof(uint32_t)));
+
+        return *slots_offset + (CHAN_ALIGN(msg_size) * msg_count);
+}
+
+//==============================================================================
+/**
+* @brief  Function allocate free slot.
+*
+* @param  chan          channel object
+*
+* @return Slot number or -1 if there is no free slot.
+*/
+//==============================================================================
+static int slot_alloc(ipc_chan_t *chan)
+{
+        for (uint32_t w = 0; w < BITMAP_WORDS(chan->shm->msg_count); w++) {
+                uint32_t bits = __atomic_load_n(&chan->bitmap[w], __ATOMIC_RELAXED);
+
+                while (bits != UINT32_MAX) {
+                        uint32_t bit = __builtin_ctz(~bits);
+
+                        if (__atomic_compare_exchange_n(&chan->bitmap[w], &bits, bits | (1UL << bit),
+                                                        true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                                return (w * 32) + bit;
+                        }
+                }
+        }
+
+        return -1;
+}
+
+//==============================================================================
+/**
+* @brief  Function free slot and wake up waiting sender.
+*
+* @param  chan          channel object
+* @param  slot          slot number
+*/
+//==============================================================================
+static void slot_free(ipc_chan_t *chan, uint32_t slot)
+{
+        __atomic_fetch_and(&chan->bitmap[slot / 32], ~(1UL << (slot % 32)), __ATOMIC_RELEASE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&chan->shm->slot_wait, __ATOMIC_RELAXED)) {
+                semaphore_signal(chan->shm->slot_sem);
+        }
+}
+
+//==============================================================================
+/**
+* @brief  Function return slot number of message.
+*
+* @param  chan          channel object
+* @param  msg           message slot
+*
+* @return Slot number or -1 if message is not a slot of channel.
+*/
+//==============================================================================
+static int slot_of(ipc_chan_t *chan, void *msg)
+{
+        uint8_t *ptr = msg;
+
+        if ((ptr >= chan->slots) && (ptr < chan->slots + (chan->shm->msg_size * chan->shm->msg_count))) {
+                size_t offset = ptr - chan->slots;
+
+                if ((offset % chan->shm->msg_size) == 0) {
+                        return offset / chan->shm->msg_size;
+                }
+        }
+
+        return -1;
+}
+
+//==============================================================================
+/**
+* @brief  Function check if channel is not closed by receiver.
+*
+* @param  shm           shared channel header
+*
+* @return If channel is valid then true is returned, otherwise false.
+*/
+//==============================================================================
+static bool is_valid(chan_shm_t *shm)
+{
+        return __atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) == CHAN_MAGIC;
+}
+
+//==============================================================================
+/**
+* @brief  Function attach user to channel. Channel without users is being
+*         removed and cannot be attached.
+*
+* @param  shm           shared channel header
+*
+* @return If user is attached then true is returned, otherwise false.
+*/
+//==============================================================================
+static bool user_get(chan_shm_t *shm)
+{
+        uint32_t users = __atomic_load_n(&shm->users, __ATOMIC_RELAXED);
+
+        while (users && is_valid(shm)) {
+                if (__atomic_compare_exchange_n(&shm->users, &users, users + 1,
+                                                true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+//==============================================================================
+/**
+* @brief  Function detach user from channel. The last user deletes semaphores
+*         and removes shared memory region.
+*
+* @param  shm           shared channel header
+* @param  name          channel name
+*/
+//==============================================================================
+static void user_put(chan_shm_t *shm, const char *name)
+{
+        if (__atomic_sub_fetch(&shm->users, 1, __ATOMIC_ACQ_REL) == 0) {
+                semaphore_delete(shm->doorbell);
+                semaphore_delete(shm->slot_sem);
+                shmdt(name);
+                shmrm(name);
+        } else {
+                shmdt(name);
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
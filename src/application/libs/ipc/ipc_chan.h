@@ -0,0 +1,99 @@
+/*==============================================================================
+File    ipc_chan.h
+
+Author  Daniel Zorychta
+
+Brief   IPC channels in shared memory.
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/**
+@defgroup IPC_CHAN_H_ IPC_CHAN_H_
+
+Channel passes messages from many senders to single receiver without copying.
+Channel is a named shared memory region that contains slab of message slots
+and lock-free descriptor ring. Sender allocates slot, writes message directly
+to the slot and sends it. Receiver gets pointer to the same slot and releases
+slot when message is processed. Receiver is woken up by doorbell semaphore
+only if it waits for messages, senders wait for free slot in the same way.
+
+Receiver creates channel, senders open it by name. Each process opens
+channel once, the handle can be shared by threads of the process.
+*/
+/**@{*/
+
+#ifndef _IPC_CHAN_H_
+#define _IPC_CHAN_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <dnx/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/**
+ * Channel object representation.
+ */
+typedef struct ipc_chan ipc_chan_t;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+extern int    ipc_chan_create(ipc_chan_t**, const char*, size_t, size_t);
+extern int    ipc_chan_open(ipc_chan_t**, const char*);
+extern void   ipc_chan_close(ipc_chan_t*);
+extern int    ipc_chan_alloc(ipc_chan_t*, void**, uint32_t);
+extern int    ipc_chan_send(ipc_chan_t*, void*, size_t);
+extern int    ipc_chan_recv(ipc_chan_t*, void**, size_t*, uint32_t);
+extern int    ipc_chan_release(ipc_chan_t*, void*);
+extern size_t ipc_chan_get_msg_size(ipc_chan_t*);
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IPC_CHAN_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
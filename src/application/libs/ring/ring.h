@@ -0,0 +1,247 @@
+/*==============================================================================
+File    ring.h
+
+Author  Daniel Zorychta
+
+Brief   Lock-free ring buffer library.
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/**
+@defgroup RING_H_ RING_H_
+
+Ring buffer of fixed size items for threads of the same program. Ring is
+created in single producer (RING_MODE_SPSC) or many producers
+(RING_MODE_MPSC) mode, always with single consumer.
+*/
+/**@{*/
+
+#ifndef _LIB_RING_H_
+#define _LIB_RING_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <lib/ring.h>
+#include <dnx/thread.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief  Ring constructor.
+ * @param  mode                 ring mode (RING_MODE_SPSC or RING_MODE_MPSC)
+ * @param  item_size            item size
+ * @param  capacity             number of items (power of 2)
+ * @param  wait                 create semaphores for ring_push_wait() and ring_pop_wait()
+ * @return On success ring object is returned, otherwise NULL.
+ */
+//==============================================================================
+static inline ring_t *ring_new(enum ring_mode mode, size_t item_size, size_t capacity, bool wait)
+{
+        ring_t *ring = NULL;
+        errno = _builtinfunc(ring_create_usr, malloc, free, mode, item_size, capacity, &ring);
+
+        if (ring && wait) {
+                sem_t *data_sem  = semaphore_new(1, 0);
+                sem_t *space_sem = semaphore_new(1, 0);
+
+                if (data_sem && space_sem) {
+                        _builtinfunc(ring_set_waiters, ring, data_sem, space_sem);
+                } else {
+                        if (data_sem) {
+                                semaphore_delete(data_sem);
+                        }
+
+                        if (space_sem) {
+                                semaphore_delete(space_sem);
+                        }
+
+                        _builtinfunc(ring_destroy, ring);
+                        ring = NULL;
+                }
+        }
+
+        return ring;
+}
+
+//==============================================================================
+/**
+ * @brief  Ring destructor.
+ * @param  ring         ring object
+ */
+//==============================================================================
+static inline void ring_delete(ring_t *ring)
+{
+        if (ring) {
+                if (ring->data_sem) {
+                        semaphore_delete(ring->data_sem);
+                }
+
+                if (ring->space_sem) {
+                        semaphore_delete(ring->space_sem);
+                }
+
+                _builtinfunc(ring_destroy, ring);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function push items to ring. Items that do not fit are not pushed.
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ *
+ * @return Number of pushed items.
+ */
+//==============================================================================
+static inline size_t ring_push(ring_t *ring, const void *src, size_t count)
+{
+        return _builtinfunc(ring_push, ring, src, count);
+}
+
+//==============================================================================
+/**
+ * @brief  Function push all items to ring, waits for free space if needed.
+ *         Ring must be created with wait option.
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ * @param  timeout      timeout [ms]
+ *
+ * @return Number of pushed items.
+ */
+//==============================================================================
+static inline size_t ring_push_wait(ring_t *ring, const void *src, size_t count, u32_t timeout)
+{
+        size_t pushed = 0;
+        errno = _builtinfunc(ring_push_wait, ring, src, count, &pushed, timeout);
+        return pushed;
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring.
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer
+ * @param  count        max number of items
+ *
+ * @return Number of popped items.
+ */
+//==============================================================================
+static inline size_t ring_pop(ring_t *ring, void *dst, size_t count)
+{
+        return _builtinfunc(ring_pop, ring, dst, count);
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring, waits for at least one item if ring
+ *         is empty. Ring must be created with wait option.
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer
+ * @param  count        max number of items
+ * @param  timeout      timeout [ms]
+ *
+ * @return Number of popped items.
+ */
+//==============================================================================
+static inline size_t ring_pop_wait(ring_t *ring, void *dst, size_t count, u32_t timeout)
+{
+        size_t popped = 0;
+        errno = _builtinfunc(ring_pop_wait, ring, dst, count, &popped, timeout);
+        return popped;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of items in ring.
+ *
+ * @param  ring         ring object
+ *
+ * @return Number of items.
+ */
+//==============================================================================
+static inline size_t ring_get_count(ring_t *ring)
+{
+        return _builtinfunc(ring_get_count, ring);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return free space in ring.
+ *
+ * @param  ring         ring object
+ *
+ * @return Number of items that can be pushed.
+ */
+//==============================================================================
+static inline size_t ring_get_space(ring_t *ring)
+{
+        return _builtinfunc(ring_get_space, ring);
+}
+
+//==============================================================================
+/**
+ * @brief  Function drop all items. Only consumer can flush ring.
+ *
+ * @param  ring         ring object
+ */
+//==============================================================================
+static inline void ring_flush(ring_t *ring)
+{
+        _builtinfunc(ring_flush, ring);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_RING_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -67,8 +67,6 @@ GLOBAL_VARIABLES_SECTION {
 //==============================================================================
 int_main(free, STACK_DEPTH_LOW, int argc, char *argv[])
 {
-        (void)argc;
-
         uint  drv_count = get_number_of_modules();
         int *modmem = malloc(drv_count * sizeof(int));
         if (!modmem) {
@@ -93,7 +91,7 @@ int_main(free, STACK_DEPTH_LOW, int argc, char *argv[])
         printf("Used : %u\n", m_used);
         printf("Memory usage: %u.%u%%\n", m_perc / 10, m_perc % 10);
 
-        if (strcmp(argv[1], "-d") == 0) {
+        if (argc > 1 && strcmp(argv[1], "-d") == 0) {
                 printf("\nDetailed memory usage:\n");
                 printf("  Kernel     : %d\n", sysmem.kernel_memory_usage);
                 printf("  Filesystems: %d\n", sysmem.filesystems_memory_usage);
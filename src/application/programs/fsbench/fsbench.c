@@ -0,0 +1,230 @@
+/*=========================================================================*//**
+@file    fsbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure sequential file read and write speed
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_SIZE_KIB                256
+#define DEFAULT_BLOCK_SIZE              1024
+#define DEFAULT_RANDOM_READS            256
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void print_result(const char *op, u32_t bytes, u32_t time_ms, u32_t ops);
+static u32_t next_random(u32_t *seed);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(fsbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        if (argc < 2) {
+                printf("Usage: %s <file> [size KiB] [block size] [random reads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        u32_t size    = (argc > 2) ? atoi(argv[2]) * 1024 : DEFAULT_SIZE_KIB * 1024;
+        u32_t blksize = (argc > 3) ? atoi(argv[3])        : DEFAULT_BLOCK_SIZE;
+        u32_t reads   = (argc > 4) ? atoi(argv[4])        : DEFAULT_RANDOM_READS;
+
+        if ((size == 0) || (blksize == 0) || (blksize > size)) {
+                puts("Invalid size");
+                return EXIT_FAILURE;
+        }
+
+        u8_t *buf = malloc(blksize);
+        if (!buf) {
+                perror(NULL);
+                return EXIT_FAILURE;
+        }
+
+        for (u32_t i = 0; i < blksize; i++) {
+                buf[i] = i;
+        }
+
+        int err = EXIT_FAILURE;
+
+        /* sequential write */
+        FILE *file = fopen(argv[1], "w");
+        if (!file) {
+                perror(argv[1]);
+                goto finish;
+        }
+
+        u32_t start = get_time_ms();
+        u32_t n     = 0;
+
+        while (n < size) {
+                size_t len = (size - n) < blksize ? (size - n) : blksize;
+                if (fwrite(buf, 1, len, file) != len) {
+                        perror(argv[1]);
+                        break;
+                }
+
+                n += len;
+        }
+
+        fclose(file);
+        sync();
+
+        print_result("write", n, get_time_ms() - start, 0);
+
+        /* sequential read */
+        file = fopen(argv[1], "r");
+        if (!file) {
+                perror(argv[1]);
+                goto finish;
+        }
+
+        start = get_time_ms();
+        n     = 0;
+
+        size_t len;
+        while ((len = fread(buf, 1, blksize, file)) > 0) {
+                n += len;
+        }
+
+        fclose(file);
+
+        print_result("read", n, get_time_ms() - start, 0);
+
+        /* random read of whole blocks, the same sequence in each run */
+        if (reads > 0) {
+                file = fopen(argv[1], "r");
+                if (!file) {
+                        perror(argv[1]);
+                        goto finish;
+                }
+
+                u32_t blocks = size / blksize;
+                u32_t seed   = 1;
+                u32_t i      = 0;
+
+                start = get_time_ms();
+                n     = 0;
+
+                for (; i < reads; i++) {
+                        long pos = cast(long, next_random(&seed) % blocks) * blksize;
+
+                        if (  (fseek(file, pos, SEEK_SET) != 0)
+                           || (fread(buf, 1, blksize, file) != blksize) ) {
+                                perror(argv[1]);
+                                break;
+                        }
+
+                        n += blksize;
+                }
+
+                fclose(file);
+
+                print_result("random read", n, get_time_ms() - start, i);
+        }
+
+        err = EXIT_SUCCESS;
+
+        finish:
+        free(buf);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function print operation speed.
+ *
+ * @param  op           operation name
+ * @param  bytes        number of transferred bytes
+ * @param  time_ms      operation time
+ * @param  ops          number of read operations (latency is not printed if 0)
+ */
+//==============================================================================
+static void print_result(const char *op, u32_t bytes, u32_t time_ms, u32_t ops)
+{
+        u32_t speed = (bytes * 1000ULL) / max(1, time_ms) / 1024;
+
+        printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(11)": %u bytes in %u ms (%u KiB/s",
+               op, bytes, time_ms, speed);
+
+        if (ops) {
+                printf(", %u us/read", (u32_t)((time_ms * 1000ULL) / ops));
+        }
+
+        puts(")");
+}
+
+//==============================================================================
+/**
+ * @brief  Function generate pseudo-random number (LCG).
+ *
+ * @param  seed         generator state
+ *
+ * @return Pseudo-random number.
+ */
+//==============================================================================
+static u32_t next_random(u32_t *seed)
+{
+        *seed = (*seed * 1103515245) + 12345;
+        return *seed >> 8;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -205,6 +205,7 @@ static void INET_status(void)
                        "  Gateway: %d.%d.%d.%d\n"
                        "  Netmask: %d.%d.%d.%d\n"
                        "  RX packets: %u (%u %s)\n"
+                       "  RX dropped: %u, no buffer: %u\n"
                        "  TX packets: %u (%u %s)\n",
 
                        INET_STATE[ifstat.state],
@@ -232,6 +233,7 @@ static void INET_status(void)
                        NET_INET_IPv4_d(ifstat.mask),
 
                        (uint)ifstat.rx_packets, cast(uint, ifstat.rx_bytes), rx_unit,
+                       (uint)ifstat.rx_dropped, (uint)ifstat.rx_alloc_errors,
                        (uint)ifstat.tx_packets, cast(uint, ifstat.tx_bytes), tx_unit
                );
         }
@@ -0,0 +1,337 @@
+/*=========================================================================*//**
+@file    ipcbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program compare IPC calls and shared memory channels
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+#include <ipc.h>
+#include <ipc_chan.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   2000
+#define SMALL_SIZE                      16
+#define LARGE_SIZE                      1024
+#define CHAN_SLOTS                      8
+#define CHAN_REQ_NAME                   "ipcb-req"
+#define CHAN_RSP_NAME                   "ipcb-rsp"
+#define TIMEOUT                         1000
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef enum {
+        TEST_IPC_CALL,
+        TEST_CHAN_STREAM,
+        TEST_CHAN_CALL,
+        TEST_COUNT
+} test_t;
+
+typedef struct {
+        test_t        test;
+        u32_t         count;
+        size_t        size;
+        u32_t         errors;
+        ipc_host_t   *host;
+        ipc_chan_t   *req;
+        ipc_chan_t   *rsp;
+} peer_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void peer_func(void *arg);
+static int run(test_t test, u32_t count, size_t size, u32_t *time, u32_t *errors);
+static void fill(void *buf, size_t size, u32_t seq);
+static bool check(const void *buf, size_t size, u32_t seq);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        peer_t peer;
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+static const char *const test_name[TEST_COUNT] = {
+        [TEST_IPC_CALL]    = "ipc call",
+        [TEST_CHAN_STREAM] = "channel stream",
+        [TEST_CHAN_CALL]   = "channel call",
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(ipcbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        static const size_t size[] = {SMALL_SIZE, LARGE_SIZE};
+
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+
+        if (count == 0) {
+                printf("Usage: %s [count]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        for (size_t s = 0; s < ARRAY_SIZE(size); s++) {
+                for (test_t test = 0; test < TEST_COUNT; test++) {
+                        u32_t errors = 0;
+                        u32_t time   = 0;
+
+                        /* failed test is reported by run(), row is skipped */
+                        if (run(test, count, size[s], &time, &errors) != 0) {
+                                continue;
+                        }
+
+                        /* latency: round trip of call or send time of stream */
+                        printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(16)"%4u B: %u msg/s, %u us/msg",
+                               test_name[test], (u32_t)size[s],
+                               (u32_t)((count * 1000ULL) / max(1, time)),
+                               (u32_t)((time * 1000ULL) / count));
+
+                        if (errors) {
+                                printf(", %u errors", errors);
+                        }
+
+                        puts("");
+                }
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run selected test. Current thread is a client (sender),
+ *         created thread is a host (receiver).
+ *
+ * @param  test         test type
+ * @param  count        number of messages
+ * @param  size         message size
+ * @param  time         test time [ms]
+ * @param  errors       number of data errors
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int run(test_t test, u32_t count, size_t size, u32_t *time, u32_t *errors)
+{
+        peer_t       *peer   = &global->peer;
+        ipc_client_t *client = NULL;
+        int           err    = 0;
+
+        memset(peer, 0, sizeof(peer_t));
+        peer->test  = test;
+        peer->count = count;
+        peer->size  = size;
+
+        if (test == TEST_IPC_CALL) {
+                err = ipc_host_create(&peer->host, 1);
+                if (!err) {
+                        err = ipc_client_connect(peer->host, &client, size, size);
+                }
+        } else {
+                err = ipc_chan_create(&peer->req, CHAN_REQ_NAME, size, CHAN_SLOTS);
+                if (!err && (test == TEST_CHAN_CALL)) {
+                        err = ipc_chan_create(&peer->rsp, CHAN_RSP_NAME, size, CHAN_SLOTS);
+                }
+        }
+
+        tid_t tid = 0;
+        if (!err) {
+                tid = thread_create(peer_func, &thread_attr, peer);
+                err = tid ? 0 : errno;
+        }
+
+        u32_t start = get_time_ms();
+
+        for (u32_t seq = 0; !err && (seq < count); seq++) {
+                if (test == TEST_IPC_CALL) {
+                        fill(ipc_get_cmd_data(client), size, seq);
+                        err = ipc_client_call(client);
+
+                        if (!err && !check(ipc_get_ans_data(client), size, seq)) {
+                                (*errors)++;
+                        }
+
+                } else {
+                        void *msg;
+                        err = ipc_chan_alloc(peer->req, &msg, TIMEOUT);
+                        if (!err) {
+                                fill(msg, size, seq);
+                                err = ipc_chan_send(peer->req, msg, size);
+                        }
+
+                        if (!err && (test == TEST_CHAN_CALL)) {
+                                size_t len;
+                                err = ipc_chan_recv(peer->rsp, &msg, &len, TIMEOUT);
+                                if (!err) {
+                                        if ((len != size) || !check(msg, len, seq)) {
+                                                (*errors)++;
+                                        }
+
+                                        ipc_chan_release(peer->rsp, msg);
+                                }
+                        }
+                }
+        }
+
+        if (tid) {
+                thread_join(tid);
+        }
+
+        *time = get_time_ms() - start;
+
+        if (err) {
+                errno = err;
+                perror(test_name[test]);
+        }
+
+        *errors += peer->errors;
+
+        if (client) {
+                ipc_client_disconnect(client);
+        }
+
+        ipc_host_destroy(peer->host);
+        ipc_chan_close(peer->rsp);
+        ipc_chan_close(peer->req);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Host (receiver) that checks requests and sends the same data back.
+ *
+ * @param  arg          peer descriptor
+ */
+//==============================================================================
+static void peer_func(void *arg)
+{
+        peer_t *peer = arg;
+
+        for (u32_t seq = 0; seq < peer->count; seq++) {
+                if (peer->test == TEST_IPC_CALL) {
+                        ipc_client_t *client;
+                        if (ipc_host_recv_request(peer->host, &client, TIMEOUT) != 0) {
+                                break;
+                        }
+
+                        void *cmd = ipc_get_cmd_data(client);
+                        if (!check(cmd, peer->size, seq)) {
+                                peer->errors++;
+                        }
+
+                        memcpy(ipc_get_ans_data(client), cmd, peer->size);
+                        ipc_host_send_response(client);
+
+                } else {
+                        void  *msg;
+                        size_t len;
+                        if (ipc_chan_recv(peer->req, &msg, &len, TIMEOUT) != 0) {
+                                break;
+                        }
+
+                        /* message is processed in place (zero-copy) */
+                        if ((len != peer->size) || !check(msg, len, seq)) {
+                                peer->errors++;
+                        }
+
+                        if (peer->test == TEST_CHAN_CALL) {
+                                void *ans;
+                                if (ipc_chan_alloc(peer->rsp, &ans, TIMEOUT) == 0) {
+                                        memcpy(ans, msg, len);
+                                        ipc_chan_send(peer->rsp, ans, len);
+                                }
+                        }
+
+                        ipc_chan_release(peer->req, msg);
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function fill message by sequence number.
+ *
+ * @param  buf          buffer
+ * @param  size         buffer size
+ * @param  seq          sequence number
+ */
+//==============================================================================
+static void fill(void *buf, size_t size, u32_t seq)
+{
+        memset(buf, seq, size);
+        memcpy(buf, &seq, min(size, sizeof(seq)));
+}
+
+//==============================================================================
+/**
+ * @brief  Function check sequence number and last byte of message.
+ *
+ * @param  buf          buffer
+ * @param  size         buffer size
+ * @param  seq          expected sequence number
+ *
+ * @return If message is correct then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool check(const void *buf, size_t size, u32_t seq)
+{
+        return (memcmp(buf, &seq, min(size, sizeof(seq))) == 0)
+            && (((const u8_t*)buf)[size - 1] == (u8_t)seq);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
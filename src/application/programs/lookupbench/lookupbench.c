@@ -0,0 +1,221 @@
+/*=========================================================================*//**
+@file    lookupbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure path lookup throughput of concurrent threads
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_PATH                    "/tmp/lookupbench"
+#define DEFAULT_COUNT                   200
+#define MAX_THREADS                     (__OS_TASK_MAX_USER_THREADS__ - 1)
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef struct {
+        const char *path;
+        u32_t       count;
+        int         err;
+} worker_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void worker_func(void *arg);
+static int run(const char *path, u32_t count, int threads, u32_t *time);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        worker_t worker[MAX_THREADS];
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(lookupbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        const char *path    = (argc > 1) ? argv[1] : DEFAULT_PATH;
+        u32_t       count   = (argc > 2) ? atoi(argv[2]) : DEFAULT_COUNT;
+        int         threads = (argc > 3) ? atoi(argv[3]) : MAX_THREADS;
+
+        if (count == 0 || threads < 1 || threads > MAX_THREADS) {
+                printf("Usage: %s [path] [count] [threads (1-%d)]\n",
+                       argv[0], MAX_THREADS);
+                return EXIT_FAILURE;
+        }
+
+        /* default file is created by program, so exists in each configuration */
+        if (argc < 2) {
+                FILE *f = fopen(path, "w");
+                if (f) {
+                        fclose(f);
+                }
+        }
+
+        struct stat st;
+        if (stat(path, &st) != 0) {
+                perror(path);
+                return EXIT_FAILURE;
+        }
+
+        int status = EXIT_SUCCESS;
+
+        /* the same work per thread, number of threads doubled in each step */
+        for (int n = 1;; n = min(n * 2, threads)) {
+                u32_t time = 0;
+                u32_t ops  = 2 * count * n;
+
+                int err = run(path, count, n, &time);
+                if (err) {
+                        errno = err;
+                        perror(path);
+                        status = EXIT_FAILURE;
+                        break;
+                }
+
+                printf("%d thread(s): %u open+stat in %u ms (%u ops/s)\n",
+                       n, ops, time, (u32_t)((ops * 1000ULL) / max(1, time)));
+
+                if (n == threads) {
+                        break;
+                }
+        }
+
+        if (argc < 2) {
+                remove(path);
+        }
+
+        return status;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run selected number of workers and wait for finish.
+ *
+ * @param  path         file path
+ * @param  count        number of iterations of each worker
+ * @param  threads      number of workers
+ * @param  time         time of all workers [ms]
+ *
+ * @return One of errno value (first error of workers).
+ */
+//==============================================================================
+static int run(const char *path, u32_t count, int threads, u32_t *time)
+{
+        tid_t tid[MAX_THREADS];
+        int   err = 0;
+
+        u32_t start = get_time_ms();
+
+        for (int i = 0; i < threads; i++) {
+                global->worker[i].path   = path;
+                global->worker[i].count  = count;
+                global->worker[i].err    = 0;
+
+                tid[i] = thread_create(worker_func, &thread_attr, &global->worker[i]);
+                if (tid[i] == 0) {
+                        perror("thread_create");
+                        threads = i;
+                        break;
+                }
+        }
+
+        for (int i = 0; i < threads; i++) {
+                thread_join(tid[i]);
+
+                if (!err) {
+                        err = global->worker[i].err;
+                }
+        }
+
+        *time = get_time_ms() - start;
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Worker that opens and stats selected file. Both operations resolve
+ *         the path in the VFS mount table. Worker stops on first error.
+ *
+ * @param  arg          worker descriptor
+ */
+//==============================================================================
+static void worker_func(void *arg)
+{
+        worker_t *worker = arg;
+
+        for (u32_t i = 0; i < worker->count; i++) {
+                FILE *f = fopen(worker->path, "r");
+                if (f) {
+                        fclose(f);
+                } else {
+                        worker->err = errno;
+                        break;
+                }
+
+                struct stat st;
+                if (stat(worker->path, &st) != 0) {
+                        worker->err = errno;
+                        break;
+                }
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
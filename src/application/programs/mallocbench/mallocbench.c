@@ -0,0 +1,275 @@
+/*=========================================================================*//**
+@file    mallocbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure memory allocation performance
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   1000
+#define SLOTS                           16
+#define MAX_BLOCK_SIZE                  128
+#define REALLOC_STEP                    8
+#define REALLOC_SIZE                    512
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef struct {
+        void *(*alloc)(size_t);
+        void  (*free)(void*);
+        void *(*realloc)(void*, size_t);
+        const char *name;
+} allocator_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void *kernel_malloc(size_t size);
+static void  kernel_free(void *mem);
+static void *kernel_realloc(void *mem, size_t size);
+static void *libc_malloc(size_t size);
+static void  libc_free(void *mem);
+static void *libc_realloc(void *mem, size_t size);
+static int   test_alloc(const allocator_t *allocator, u32_t count);
+static int   test_realloc(const allocator_t *allocator, u32_t count);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        void  *slot[SLOTS];
+        size_t slot_size[SLOTS];
+};
+
+static const allocator_t allocator[] = {
+        {.alloc = kernel_malloc, .free = kernel_free, .realloc = kernel_realloc, .name = "syscall"},
+        {.alloc = libc_malloc,   .free = libc_free,   .realloc = libc_realloc,   .name = "malloc"},
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(mallocbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+        if (count == 0) {
+                printf("Usage: %s [count]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        int err = 0;
+
+        for (size_t i = 0; !err && i < ARRAY_SIZE(allocator); i++) {
+                err = test_alloc(&allocator[i], count);
+        }
+
+        for (size_t i = 0; !err && i < ARRAY_SIZE(allocator); i++) {
+                err = test_realloc(&allocator[i], count / 10 + 1);
+        }
+
+        if (err) {
+                perror(NULL);
+        }
+
+        return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure allocation and free of random small blocks.
+ *
+ * @param  allocator    tested allocator
+ * @param  count        number of operations
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int test_alloc(const allocator_t *allocator, u32_t count)
+{
+        int   err   = 0;
+        u32_t start = get_time_ms();
+
+        for (u32_t n = 0; !err && n < count; n++) {
+                size_t i = (u32_t)rand() % SLOTS;
+
+                if (global->slot[i]) {
+                        allocator->free(global->slot[i]);
+                        global->slot[i] = NULL;
+                } else {
+                        global->slot[i] = allocator->alloc(1 + (u32_t)rand() % MAX_BLOCK_SIZE);
+                        err = global->slot[i] ? 0 : -1;
+                }
+        }
+
+        for (size_t i = 0; i < SLOTS; i++) {
+                allocator->free(global->slot[i]);
+                global->slot[i] = NULL;
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        printf("%s alloc/free: %u operations in %u ms (%u ns/op)\n",
+               allocator->name, count, time, (u32_t)((time * 1000000ULL) / count));
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure growing of blocks by realloc.
+ *
+ * @param  allocator    tested allocator
+ * @param  count        number of grown blocks
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int test_realloc(const allocator_t *allocator, u32_t count)
+{
+        int   err   = 0;
+        u32_t ops   = 0;
+        u32_t start = get_time_ms();
+
+        for (u32_t n = 0; !err && n < count; n++) {
+                void *mem = NULL;
+
+                for (size_t size = REALLOC_STEP; size <= REALLOC_SIZE; size += REALLOC_STEP) {
+                        void *new = allocator->realloc(mem, size);
+                        if (new) {
+                                mem = new;
+                                ops++;
+                        } else {
+                                err = -1;
+                                break;
+                        }
+                }
+
+                allocator->free(mem);
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        printf("%s realloc: %u operations in %u ms (%u ns/op)\n",
+               allocator->name, ops, time, (u32_t)((time * 1000000ULL) / max(1, ops)));
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Allocation by using syscall (path used without user space heap).
+ */
+//==============================================================================
+static void *kernel_malloc(size_t size)
+{
+        void *mem = NULL;
+        syscall(SYSCALL_MALLOC, &mem, &size);
+        return mem;
+}
+
+//==============================================================================
+/**
+ * @brief  Free by using syscall (path used without user space heap).
+ */
+//==============================================================================
+static void kernel_free(void *mem)
+{
+        if (mem) {
+                syscall(SYSCALL_FREE, NULL, mem);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Realloc by using syscalls: new block is always allocated and data
+ *         is copied (block size is known by caller).
+ */
+//==============================================================================
+static void *kernel_realloc(void *mem, size_t size)
+{
+        void *new = kernel_malloc(size);
+        if (new && mem) {
+                memcpy(new, mem, size - REALLOC_STEP);
+                kernel_free(mem);
+        }
+
+        return new;
+}
+
+//==============================================================================
+/**
+ * @brief  Allocation by using libc (user space heap if enabled).
+ */
+//==============================================================================
+static void *libc_malloc(size_t size)
+{
+        return malloc(size);
+}
+
+//==============================================================================
+/**
+ * @brief  Free by using libc (user space heap if enabled).
+ */
+//==============================================================================
+static void libc_free(void *mem)
+{
+        free(mem);
+}
+
+//==============================================================================
+/**
+ * @brief  Realloc by using libc (user space heap if enabled).
+ */
+//==============================================================================
+static void *libc_realloc(void *mem, size_t size)
+{
+        return realloc(mem, size);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
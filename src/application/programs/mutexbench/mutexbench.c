@@ -0,0 +1,247 @@
+/*=========================================================================*//**
+@file    mutexbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure time of mutex lock/unlock pairs
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   100000
+#define THREADS                         2
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef enum {
+        TEST_FAST,
+        TEST_KERNEL,
+        TEST_SEMAPHORE,
+        TEST_RECURSIVE,
+        TEST_CONTENDED,
+        TEST_COUNT
+} test_t;
+
+typedef struct {
+        test_t   test;
+        u32_t    count;
+        mutex_t *mutex;
+        sem_t   *sem;
+} worker_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void worker_func(void *arg);
+static u32_t run(test_t test, u32_t count);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        worker_t worker[THREADS];
+        u32_t    counter;
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+static const char *const test_name[TEST_COUNT] = {
+        [TEST_FAST]      = "mutex (fast path)",
+        [TEST_KERNEL]    = "mutex (kernel)",
+        [TEST_SEMAPHORE] = "semaphore (queue)",
+        [TEST_RECURSIVE] = "recursive mutex",
+        [TEST_CONTENDED] = "mutex (2 threads)",
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(mutexbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+
+        if (count == 0) {
+                printf("Usage: %s [count]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        for (test_t test = 0; test < TEST_COUNT; test++) {
+                global->counter = 0;
+
+                u32_t time  = run(test, count);
+                u32_t pairs = (test == TEST_CONTENDED) ? count * THREADS : count;
+
+                printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(19)"%u lock/unlock in %u ms (%u ns/pair)",
+                       test_name[test], pairs, time,
+                       (u32_t)((time * 1000000ULL) / pairs));
+
+                if (global->counter != pairs) {
+                        printf(", counter error %u", global->counter);
+                }
+
+                puts("");
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run selected test and wait for finish.
+ *
+ * @param  test         test type
+ * @param  count        number of lock/unlock pairs of each thread
+ *
+ * @return Time of test [ms].
+ */
+//==============================================================================
+static u32_t run(test_t test, u32_t count)
+{
+        tid_t    tid[THREADS];
+        int      threads = (test == TEST_CONTENDED) ? THREADS : 1;
+        mutex_t *mutex   = NULL;
+        sem_t   *sem     = NULL;
+
+        if (test == TEST_SEMAPHORE) {
+                sem = semaphore_new(1, 1);
+        } else {
+                mutex = mutex_new((test == TEST_RECURSIVE) ? MUTEX_TYPE_RECURSIVE
+                                                           : MUTEX_TYPE_NORMAL);
+        }
+
+        if (!mutex && !sem) {
+                perror(NULL);
+                return 0;
+        }
+
+        /* recursive mutex is measured in nested level */
+        if (test == TEST_RECURSIVE) {
+                mutex_lock(mutex, MAX_DELAY_MS);
+        }
+
+        u32_t start = get_time_ms();
+
+        for (int i = 0; i < threads; i++) {
+                global->worker[i].test  = test;
+                global->worker[i].count = count;
+                global->worker[i].mutex = mutex;
+                global->worker[i].sem   = sem;
+
+                if (threads == 1) {
+                        worker_func(&global->worker[i]);
+                        break;
+                }
+
+                tid[i] = thread_create(worker_func, &thread_attr, &global->worker[i]);
+                if (tid[i] == 0) {
+                        perror("thread_create");
+                        threads = i;
+                        break;
+                }
+        }
+
+        for (int i = 0; threads > 1 && i < threads; i++) {
+                thread_join(tid[i]);
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        if (mutex) {
+                if (test == TEST_RECURSIVE) {
+                        mutex_unlock(mutex);
+                }
+
+                mutex_delete(mutex);
+        } else {
+                semaphore_delete(sem);
+        }
+
+        return time;
+}
+
+//==============================================================================
+/**
+ * @brief  Worker that increments shared counter in locked section.
+ *
+ * @param  arg          worker descriptor
+ */
+//==============================================================================
+static void worker_func(void *arg)
+{
+        worker_t *worker = arg;
+
+        for (u32_t i = 0; i < worker->count; i++) {
+                switch (worker->test) {
+                case TEST_KERNEL:
+                        /* kernel call of each lock, without inline fast path */
+                        _builtinfunc(mutex_lock, worker->mutex, MAX_DELAY_MS);
+                        global->counter++;
+                        _builtinfunc(mutex_unlock, worker->mutex);
+                        break;
+
+                case TEST_SEMAPHORE:
+                        semaphore_wait(worker->sem, MAX_DELAY_MS);
+                        global->counter++;
+                        semaphore_signal(worker->sem);
+                        break;
+
+                default:
+                        mutex_lock(worker->mutex, MAX_DELAY_MS);
+                        global->counter++;
+                        mutex_unlock(worker->mutex);
+                        break;
+                }
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
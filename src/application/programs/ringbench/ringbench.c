@@ -0,0 +1,281 @@
+/*=========================================================================*//**
+@file    ringbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program compare throughput of ring buffer and queue
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+#include <ring.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   10000
+#define CAPACITY                        64
+#define BULK                            16
+#define PRODUCERS                       2
+#define TIMEOUT                         1000
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef enum {
+        TEST_QUEUE,
+        TEST_RING,
+        TEST_RING_BULK,
+        TEST_RING_MPSC,
+        TEST_COUNT
+} test_t;
+
+typedef struct {
+        test_t   test;
+        u32_t    first;
+        u32_t    count;
+        queue_t *queue;
+        ring_t  *ring;
+} producer_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void producer_func(void *arg);
+static u32_t run(test_t test, u32_t count, u32_t *errors);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        producer_t producer[PRODUCERS];
+        u32_t      buf[BULK];
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+static const char *const test_name[TEST_COUNT] = {
+        [TEST_QUEUE]     = "queue (1 item)",
+        [TEST_RING]      = "ring SPSC (1 item)",
+        [TEST_RING_BULK] = "ring SPSC (bulk)",
+        [TEST_RING_MPSC] = "ring MPSC (bulk)",
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(ringbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+
+        if (count == 0) {
+                printf("Usage: %s [count]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        for (test_t test = 0; test < TEST_COUNT; test++) {
+                u32_t errors = 0;
+                u32_t time   = run(test, count, &errors);
+
+                printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(21)"%u items in %u ms (%u items/s)",
+                       test_name[test], count, time,
+                       (u32_t)((count * 1000ULL) / max(1, time)));
+
+                if (errors) {
+                        printf(", %u errors", errors);
+                }
+
+                puts("");
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run producers and consume all items in current thread.
+ *         Items are numbered, so lost or reordered items are counted as
+ *         errors.
+ *
+ * @param  test         test type
+ * @param  count        number of items
+ * @param  errors       number of errors
+ *
+ * @return Time of transfer [ms].
+ */
+//==============================================================================
+static u32_t run(test_t test, u32_t count, u32_t *errors)
+{
+        tid_t    tid[PRODUCERS];
+        int      producers = (test == TEST_RING_MPSC) ? PRODUCERS : 1;
+        u32_t    next[PRODUCERS];
+        queue_t *queue = NULL;
+        ring_t  *ring  = NULL;
+
+        if (test == TEST_QUEUE) {
+                queue = queue_new(CAPACITY, sizeof(u32_t));
+        } else {
+                ring = ring_new((test == TEST_RING_MPSC) ? RING_MODE_MPSC : RING_MODE_SPSC,
+                                sizeof(u32_t), CAPACITY, true);
+        }
+
+        if (!queue && !ring) {
+                perror(NULL);
+                *errors = count;
+                return 0;
+        }
+
+        u32_t start = get_time_ms();
+
+        for (int i = 0; i < producers; i++) {
+                global->producer[i].test  = test;
+                global->producer[i].first = (count / producers) * i;
+                global->producer[i].count = (i == producers - 1)
+                                          ? count - global->producer[i].first
+                                          : count / producers;
+                global->producer[i].queue = queue;
+                global->producer[i].ring  = ring;
+                next[i] = global->producer[i].first;
+
+                tid[i] = thread_create(producer_func, &thread_attr, &global->producer[i]);
+                if (tid[i] == 0) {
+                        perror("thread_create");
+                        producers = i;
+                        break;
+                }
+        }
+
+        /* each producer sends increasing numbers from own range */
+        u32_t received = 0;
+        while (received < count && producers > 0) {
+                size_t n = 0;
+
+                if (queue) {
+                        n = queue_receive(queue, &global->buf[0], TIMEOUT) ? 1 : 0;
+                } else {
+                        n = ring_pop_wait(ring, global->buf,
+                                          (test == TEST_RING) ? 1 : BULK, TIMEOUT);
+                }
+
+                if (n == 0) {
+                        *errors += count - received;
+                        break;
+                }
+
+                for (size_t i = 0; i < n; i++) {
+                        u32_t item = global->buf[i];
+                        int   p    = producers - 1;
+
+                        while (p > 0 && item < global->producer[p].first) {
+                                p--;
+                        }
+
+                        if (item != next[p]) {
+                                (*errors)++;
+                        }
+
+                        next[p] = item + 1;
+                }
+
+                received += n;
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        for (int i = 0; i < producers; i++) {
+                thread_join(tid[i]);
+        }
+
+        if (queue) {
+                queue_delete(queue);
+        } else {
+                ring_delete(ring);
+        }
+
+        return time;
+}
+
+//==============================================================================
+/**
+ * @brief  Producer that sends numbered items.
+ *
+ * @param  arg          producer descriptor
+ */
+//==============================================================================
+static void producer_func(void *arg)
+{
+        producer_t *producer = arg;
+        u32_t       buf[BULK];
+        u32_t       item = producer->first;
+        u32_t       end  = producer->first + producer->count;
+
+        while (item < end) {
+                if (producer->test == TEST_QUEUE) {
+                        if (!queue_send(producer->queue, &item, TIMEOUT)) {
+                                break;
+                        }
+
+                        item++;
+
+                } else {
+                        size_t n = (producer->test == TEST_RING) ? 1 : min(BULK, end - item);
+
+                        for (size_t i = 0; i < n; i++) {
+                                buf[i] = item + i;
+                        }
+
+                        if (ring_push_wait(producer->ring, buf, n, TIMEOUT) != n) {
+                                break;
+                        }
+
+                        item += n;
+                }
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,173 @@
+/*=========================================================================*//**
+@file    spawnbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure process and thread spawn latency
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   100
+#define CHILD_ARG                       "--child"
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void thread_func(void *arg);
+static void print_result(const char *op, u32_t count, u32_t time_ms, u32_t max_ms);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(spawnbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        if (argc > 1 && strcmp(argv[1], CHILD_ARG) == 0) {
+                return EXIT_SUCCESS;
+        }
+
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+        if (count == 0) {
+                printf("Usage: %s [count]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        /* process: create, run, and wait for exit */
+        u32_t total = 0;
+        u32_t worst = 0;
+        u32_t n;
+
+        for (n = 0; n < count; n++) {
+                u32_t start = get_time_ms();
+
+                pid_t pid = process_create("spawnbench "CHILD_ARG, NULL);
+                if (pid == 0) {
+                        perror("process_create");
+                        break;
+                }
+
+                process_wait(pid, NULL, MAX_DELAY_MS);
+
+                u32_t time = get_time_ms() - start;
+                total += time;
+                worst  = max(worst, time);
+        }
+
+        print_result("process", n, total, worst);
+
+        /* thread: create, run, and join */
+        total = 0;
+        worst = 0;
+
+        for (n = 0; n < count; n++) {
+                u32_t start = get_time_ms();
+
+                tid_t tid = thread_create(thread_func, &thread_attr, NULL);
+                if (tid == 0) {
+                        perror("thread_create");
+                        break;
+                }
+
+                thread_join(tid);
+
+                u32_t time = get_time_ms() - start;
+                total += time;
+                worst  = max(worst, time);
+        }
+
+        print_result("thread", n, total, worst);
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Thread that exits immediately.
+ *
+ * @param  arg          not used
+ */
+//==============================================================================
+static void thread_func(void *arg)
+{
+        UNUSED_ARG1(arg);
+}
+
+//==============================================================================
+/**
+ * @brief  Function print average spawn latency.
+ *
+ * @param  op           operation name
+ * @param  count        number of spawns
+ * @param  time_ms      total time
+ * @param  max_ms       the longest spawn
+ */
+//==============================================================================
+static void print_result(const char *op, u32_t count, u32_t time_ms, u32_t max_ms)
+{
+        u32_t avg_us = (time_ms * 1000ULL) / max(1, count);
+
+        printf("%s: %u spawns in %u ms (avg %u us, max %u ms)\n",
+               op, count, time_ms, avg_us, max_ms);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
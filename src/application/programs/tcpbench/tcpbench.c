@@ -0,0 +1,353 @@
+/*=========================================================================*//**
+@file    tcpbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure TCP send throughput of the network stack
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <dnx/net.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_SIZE_KIB                1024
+#define BUF_SIZE                        1024
+#define PORT                            5001
+#define TIMEOUT                         5000
+#define POLL_TIME                       100
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef enum {
+        TEST_COPY,
+        TEST_NOCOPY,
+        TEST_COUNT
+} test_t;
+
+typedef struct {
+        SOCKET *listener;
+        u32_t   size;
+        u32_t   received;
+        int     err;
+} sink_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int reflect_start(const char *path);
+static bool wait_for_network(NET_INET_status_t *status);
+static u32_t run(test_t test, NET_INET_IPv4_t addr, u32_t size, u32_t *received);
+static void sink_func(void *arg);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        sink_t sink;
+        FILE  *veth;
+        u8_t   tx_buf[BUF_SIZE];
+        u8_t   rx_buf[BUF_SIZE];
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+static const char *const test_name[TEST_COUNT] = {
+        [TEST_COPY]   = "copy",
+        [TEST_NOCOPY] = "nocopy",
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(tcpbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        u32_t size = ((argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE_KIB) * 1024;
+
+        if (size == 0) {
+                printf("Usage: %s [KiB] [reflecting veth device]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        if (argc > 2) {
+                int err = reflect_start(argv[2]);
+                if (err) {
+                        errno = err;
+                        perror(argv[2]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        NET_INET_status_t status;
+        if (!wait_for_network(&status)) {
+                puts("Network not configured");
+                return EXIT_FAILURE;
+        }
+
+        for (size_t i = 0; i < sizeof(global->tx_buf); i++) {
+                global->tx_buf[i] = i;
+        }
+
+        /* data is sent to own address, so receiver is the same stack */
+        for (test_t test = 0; test < TEST_COUNT; test++) {
+                u32_t received = 0;
+                u32_t time     = run(test, status.address, size, &received);
+
+                printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(8)"%u KiB in %u ms: %u KiB/s",
+                       test_name[test], received / 1024, time,
+                       (u32_t)((received * 1000ULL) / (max(1, time) * 1024ULL)));
+
+                if (received != size) {
+                        printf(", %u bytes lost", size - received);
+                }
+
+                puts("");
+        }
+
+        if (global->veth) {
+                ioctl(fileno(global->veth), IOCTL_ETHMAC__ETHERNET_STOP);
+                fclose(global->veth);
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function configure selected virtual Ethernet interface to reflect
+ *         all frames back to the stack. Interface should be a peer of the
+ *         interface used by the TCP/IP stack.
+ *
+ * @param  path         veth device path
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int reflect_start(const char *path)
+{
+        global->veth = fopen(path, "r+");
+        if (!global->veth) {
+                return errno;
+        }
+
+        VETH_config_t cfg = {.reflect = true};
+
+        if (  (ioctl(fileno(global->veth), IOCTL_VETH__CONFIGURE, &cfg) != 0)
+           || (ioctl(fileno(global->veth), IOCTL_ETHMAC__ETHERNET_START) != 0) ) {
+
+                int err = errno;
+                fclose(global->veth);
+                global->veth = NULL;
+                return err;
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait until network is configured. Link of reflecting
+ *         interface is connected just after start, so stack needs a while to
+ *         restore its configuration.
+ *
+ * @param  status       network status
+ *
+ * @return If network is configured then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool wait_for_network(NET_INET_status_t *status)
+{
+        u32_t start = get_time_ms();
+
+        while (ifstatus(NET_FAMILY__INET, status) == 0) {
+                if (  (status->state == NET_INET_STATE__STATIC_IP)
+                   || (status->state == NET_INET_STATE__DHCP_CONFIGURED) ) {
+                        return true;
+                }
+
+                if ((get_time_ms() - start) >= TIMEOUT) {
+                        break;
+                }
+
+                msleep(POLL_TIME);
+        }
+
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run selected test. Current thread is a sender, created
+ *         thread is a receiver.
+ *
+ * @param  test         test type
+ * @param  addr         receiver address
+ * @param  size         number of bytes to send
+ * @param  received     number of received bytes
+ *
+ * @return Test time [ms].
+ */
+//==============================================================================
+static u32_t run(test_t test, NET_INET_IPv4_t addr, u32_t size, u32_t *received)
+{
+        sink_t *sink = &global->sink;
+        SOCKET *sock = NULL;
+        tid_t   tid  = 0;
+        int     err  = 0;
+
+        memset(sink, 0, sizeof(sink_t));
+        sink->size = size;
+
+        NET_INET_sockaddr_t sockaddr = {.addr = NET_INET_IPv4_ANY, .port = PORT};
+
+        sink->listener = socket_open(NET_FAMILY__INET, NET_PROTOCOL__TCP);
+        err = sink->listener ? 0 : errno;
+
+        if (!err && (socket_bind(sink->listener, &sockaddr) != 0 || socket_listen(sink->listener) != 0)) {
+                err = errno;
+        }
+
+        if (!err) {
+                tid = thread_create(sink_func, &thread_attr, sink);
+                err = tid ? 0 : errno;
+        }
+
+        if (!err) {
+                sock = socket_open(NET_FAMILY__INET, NET_PROTOCOL__TCP);
+                err  = sock ? 0 : errno;
+        }
+
+        if (!err) {
+                socket_set_send_timeout(sock, TIMEOUT);
+
+                sockaddr.addr = addr;
+                if (socket_connect(sock, &sockaddr) != 0) {
+                        err = errno;
+                }
+        }
+
+        u32_t start = get_time_ms();
+
+        /* buffer is not modified, so can be sent without copy */
+        NET_flags_t flags = (test == TEST_NOCOPY) ? NET_FLAGS__NOCOPY : NET_FLAGS__COPY;
+
+        for (u32_t sent = 0; !err && (sent < size);) {
+                int n = socket_send(sock, global->tx_buf, min(size - sent, BUF_SIZE), flags);
+                if (n > 0) {
+                        sent += n;
+                } else {
+                        err = errno;
+                }
+        }
+
+        if (sock) {
+                socket_shutdown(sock, NET_SHUT__WR);
+        }
+
+        if (tid) {
+                thread_join(tid);
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        if (err || sink->err) {
+                errno = err ? err : sink->err;
+                perror(test_name[test]);
+        }
+
+        if (sock) {
+                socket_close(sock);
+        }
+
+        if (sink->listener) {
+                socket_close(sink->listener);
+        }
+
+        *received = sink->received;
+
+        return time;
+}
+
+//==============================================================================
+/**
+ * @brief  Receiver that accepts single connection and counts received bytes.
+ *
+ * @param  arg          sink descriptor
+ */
+//==============================================================================
+static void sink_func(void *arg)
+{
+        sink_t *sink = arg;
+        SOCKET *sock = NULL;
+
+        if (socket_accept(sink->listener, &sock) != 0) {
+                sink->err = errno;
+                return;
+        }
+
+        socket_set_recv_timeout(sock, TIMEOUT);
+
+        while (sink->received < sink->size) {
+                int n = socket_read(sock, global->rx_buf, sizeof(global->rx_buf));
+                if (n > 0) {
+                        sink->received += n;
+                } else {
+                        sink->err = errno;
+                        break;
+                }
+        }
+
+        socket_close(sock);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
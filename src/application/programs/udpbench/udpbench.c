@@ -0,0 +1,365 @@
+/*=========================================================================*//**
+@file    udpbench.c
+
+@author  Daniel Zorychta
+
+@brief   Program measure UDP packets per second of the network stack
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <dnx/net.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+#include <dnx/vt100.h>
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define DEFAULT_COUNT                   10000
+#define HEADER_SIZE                     8
+#define PAYLOAD_SIZE                    64
+#define BATCH                           8
+#define PORT                            5002
+#define TIMEOUT                         5000
+#define RECV_TIMEOUT                    200
+#define POLL_TIME                       100
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef enum {
+        TEST_SENDTO,
+        TEST_SENDMSG,
+        TEST_SENDMMSG,
+        TEST_SENDMMSG_NOCOPY,
+        TEST_COUNT
+} test_t;
+
+typedef struct {
+        SOCKET *sock;
+        u32_t   received;
+        bool    stop;
+} sink_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int reflect_start(const char *path);
+static bool wait_for_network(NET_INET_status_t *status);
+static u32_t run(test_t test, NET_INET_IPv4_t addr, u32_t count, u32_t *received);
+static void sink_func(void *arg);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        sink_t sink;
+        FILE  *veth;
+        u8_t   header[HEADER_SIZE];
+        u8_t   payload[PAYLOAD_SIZE];
+        u8_t   tx_buf[HEADER_SIZE + PAYLOAD_SIZE];
+        u8_t   rx_buf[HEADER_SIZE + PAYLOAD_SIZE];
+};
+
+static const thread_attr_t thread_attr = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+static const char *const test_name[TEST_COUNT] = {
+        [TEST_SENDTO]          = "sendto",
+        [TEST_SENDMSG]         = "sendmsg",
+        [TEST_SENDMMSG]        = "sendmmsg",
+        [TEST_SENDMMSG_NOCOPY] = "sendmmsg nocopy",
+};
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Program main function
+ */
+//==============================================================================
+int_main(udpbench, STACK_DEPTH_LOW, int argc, char *argv[])
+{
+        u32_t count = (argc > 1) ? atoi(argv[1]) : DEFAULT_COUNT;
+
+        if (count == 0) {
+                printf("Usage: %s [datagrams] [reflecting veth device]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        if (argc > 2) {
+                int err = reflect_start(argv[2]);
+                if (err) {
+                        errno = err;
+                        perror(argv[2]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        NET_INET_status_t status;
+        if (!wait_for_network(&status)) {
+                puts("Network not configured");
+                return EXIT_FAILURE;
+        }
+
+        memset(global->header, 0xAA, sizeof(global->header));
+        memset(global->payload, 0x55, sizeof(global->payload));
+
+        /* datagrams are sent to own address, so receiver is the same stack */
+        for (test_t test = 0; test < TEST_COUNT; test++) {
+                u32_t received = 0;
+                u32_t time     = run(test, status.address, count, &received);
+
+                printf("%s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(17)"%u pkt/s, %u us/pkt, received %u/%u\n",
+                       test_name[test],
+                       (u32_t)((count * 1000ULL) / max(1, time)),
+                       (u32_t)((time * 1000ULL) / count),
+                       received, count);
+        }
+
+        if (global->veth) {
+                ioctl(fileno(global->veth), IOCTL_ETHMAC__ETHERNET_STOP);
+                fclose(global->veth);
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function configure selected virtual Ethernet interface to reflect
+ *         all frames back to the stack. Interface should be a peer of the
+ *         interface used by the TCP/IP stack.
+ *
+ * @param  path         veth device path
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int reflect_start(const char *path)
+{
+        global->veth = fopen(path, "r+");
+        if (!global->veth) {
+                return errno;
+        }
+
+        VETH_config_t cfg = {.reflect = true};
+
+        if (  (ioctl(fileno(global->veth), IOCTL_VETH__CONFIGURE, &cfg) != 0)
+           || (ioctl(fileno(global->veth), IOCTL_ETHMAC__ETHERNET_START) != 0) ) {
+
+                int err = errno;
+                fclose(global->veth);
+                global->veth = NULL;
+                return err;
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait until network is configured.
+ *
+ * @param  status       network status
+ *
+ * @return If network is configured then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool wait_for_network(NET_INET_status_t *status)
+{
+        u32_t start = get_time_ms();
+
+        while (ifstatus(NET_FAMILY__INET, status) == 0) {
+                if (  (status->state == NET_INET_STATE__STATIC_IP)
+                   || (status->state == NET_INET_STATE__DHCP_CONFIGURED) ) {
+                        return true;
+                }
+
+                if ((get_time_ms() - start) >= TIMEOUT) {
+                        break;
+                }
+
+                msleep(POLL_TIME);
+        }
+
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function run selected test. Each datagram consists of header and
+ *         payload. Current thread is a sender, created thread is a receiver.
+ *
+ * @param  test         test type
+ * @param  addr         receiver address
+ * @param  count        number of datagrams
+ * @param  received     number of received datagrams
+ *
+ * @return Send time [ms].
+ */
+//==============================================================================
+static u32_t run(test_t test, NET_INET_IPv4_t addr, u32_t count, u32_t *received)
+{
+        sink_t *sink = &global->sink;
+        SOCKET *sock = NULL;
+        tid_t   tid  = 0;
+        int     err  = 0;
+
+        memset(sink, 0, sizeof(sink_t));
+
+        NET_INET_sockaddr_t sockaddr = {.addr = NET_INET_IPv4_ANY, .port = PORT};
+
+        sink->sock = socket_open(NET_FAMILY__INET, NET_PROTOCOL__UDP);
+        err = sink->sock ? 0 : errno;
+
+        if (!err && (socket_bind(sink->sock, &sockaddr) != 0)) {
+                err = errno;
+        }
+
+        if (!err) {
+                tid = thread_create(sink_func, &thread_attr, sink);
+                err = tid ? 0 : errno;
+        }
+
+        if (!err) {
+                sock = socket_open(NET_FAMILY__INET, NET_PROTOCOL__UDP);
+                err  = sock ? 0 : errno;
+        }
+
+        sockaddr.addr = addr;
+
+        const NET_segment_t seg[] = {
+                {.data = global->header,  .len = HEADER_SIZE},
+                {.data = global->payload, .len = PAYLOAD_SIZE}
+        };
+
+        NET_msg_t msg[BATCH];
+        for (size_t i = 0; i < BATCH; i++) {
+                msg[i].seg   = seg;
+                msg[i].count = ARRAY_SIZE(seg);
+                msg[i].to    = &sockaddr;
+        }
+
+        u32_t start = get_time_ms();
+
+        for (u32_t sent = 0; !err && (sent < count);) {
+                int n;
+
+                switch (test) {
+                case TEST_SENDTO:
+                        /* header and payload are concatenated by application */
+                        memcpy(global->tx_buf, global->header, HEADER_SIZE);
+                        memcpy(global->tx_buf + HEADER_SIZE, global->payload, PAYLOAD_SIZE);
+                        n = socket_sendto(sock, global->tx_buf, sizeof(global->tx_buf),
+                                          NET_FLAGS__COPY, &sockaddr) < 0 ? -1 : 1;
+                        break;
+
+                case TEST_SENDMSG:
+                        n = socket_sendmsg(sock, msg, NET_FLAGS__COPY) < 0 ? -1 : 1;
+                        break;
+
+                default:
+                        n = socket_sendmmsg(sock, msg, min(count - sent, BATCH),
+                                            (test == TEST_SENDMMSG_NOCOPY)
+                                            ? NET_FLAGS__NOCOPY : NET_FLAGS__COPY);
+                        break;
+                }
+
+                if (n > 0) {
+                        sent += n;
+                } else {
+                        err = errno;
+                }
+        }
+
+        u32_t time = get_time_ms() - start;
+
+        if (tid) {
+                sink->stop = true;
+                thread_join(tid);
+        }
+
+        if (err) {
+                errno = err;
+                perror(test_name[test]);
+        }
+
+        if (sock) {
+                socket_close(sock);
+        }
+
+        if (sink->sock) {
+                socket_close(sink->sock);
+        }
+
+        *received = sink->received;
+
+        return time;
+}
+
+//==============================================================================
+/**
+ * @brief  Receiver that counts datagrams until sender finishes and no more
+ *         datagrams are received.
+ *
+ * @param  arg          sink descriptor
+ */
+//==============================================================================
+static void sink_func(void *arg)
+{
+        sink_t *sink = arg;
+
+        socket_set_recv_timeout(sink->sock, RECV_TIMEOUT);
+
+        while (true) {
+                int n = socket_read(sink->sock, global->rx_buf, sizeof(global->rx_buf));
+                if (n > 0) {
+                        sink->received++;
+                } else if (sink->stop) {
+                        break;
+                }
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
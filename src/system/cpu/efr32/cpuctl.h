@@ -71,6 +71,11 @@ extern void  _cpuctl_init_CPU_load_counter      (void);
 extern u32_t _cpuctl_get_CPU_load_counter_delta (void);
 #endif
 
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+extern u32_t _cpuctl_get_cycle_counter          (void);
+extern u32_t _cpuctl_get_cycle_counter_frequency(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,219 @@
+/*=========================================================================*//**
+@file    cpuctl.c
+
+@author  Daniel Zorychta
+
+@brief   This file support CPU control
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "config.h"
+#include "posix/cpuctl.h"
+#include "posix/host.h"
+#include "kernel/kwrapper.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+static u64_t CPU_load_timestamp;
+#endif
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+/** memory used as main heap */
+u8_t _cpuctl_heap[__CPU_HEAP_SIZE__] __attribute__((aligned(_CPU_HEAP_ALIGN_)));
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Basic (first) CPU/microcontroller configuration. This function is
+ *         called before system start.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_init(void)
+{
+        #if (__OS_MONITOR_CPU_LOAD__ > 0)
+        _cpuctl_init_CPU_load_counter();
+        #endif
+}
+
+//==============================================================================
+/**
+ * @brief  This function restart CPU. The process image is executed again.
+ */
+//==============================================================================
+void _cpuctl_restart_system(void)
+{
+        _host_restart();
+}
+
+//==============================================================================
+/**
+ * @brief  This function shutdown CPU. The process is terminated.
+ */
+//==============================================================================
+void _cpuctl_shutdown_system(void)
+{
+        _host_exit(0);
+}
+
+//==============================================================================
+/**
+ * @brief  Function initialize CPU load counter. The host monotonic clock is
+ *         used as counter (1 us resolution).
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+void _cpuctl_init_CPU_load_counter(void)
+{
+        CPU_load_timestamp = _host_get_time_us();
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return valut that was counted from last call of this function.
+ *         This function must reset timer after read. Function is called from
+ *         IRQs.
+ *
+ * @param  None
+ *
+ * @return Timer value for last read (time delta).
+ */
+//==============================================================================
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+u32_t _cpuctl_get_CPU_load_counter_delta(void)
+{
+        u64_t now   = _host_get_time_us();
+        u32_t delta = now - CPU_load_timestamp;
+
+        CPU_load_timestamp = now;
+
+        return delta;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return value of free running cycle counter used by kernel
+ *         event tracer as time stamp. Counter overflows are handled by reader.
+ *         Function is called from IRQs.
+ *
+ * @return Counter value.
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter(void)
+{
+        return _host_get_time_us();
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return frequency of cycle counter.
+ *
+ * @return Counter frequency [Hz].
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter_frequency(void)
+{
+        return 1000000;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function sleep CPU weakly. All IRQs must be able to wake up CPU.
+ *         Host thread is suspended until next tick.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_sleep(void)
+{
+        _host_idle();
+}
+
+//==============================================================================
+/**
+ * @brief  Function update all system clock after CPU frequency change.
+ *         Host clock is constant so there is nothing to update.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_update_system_clocks(void)
+{
+}
+
+//==============================================================================
+/**
+ * @brief  Function delay code processing in microseconds.
+ *
+ * @note   Function should block CPU for specified amount of time.
+ * @note   Function should work in critical section and interrupts.
+ *
+ * @param  microseconds         microsecond delay
+ */
+//==============================================================================
+void _cpuctl_delay_us(u16_t microseconds)
+{
+        _host_delay_us(microseconds);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
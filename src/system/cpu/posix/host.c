@@ -0,0 +1,715 @@
+/*=========================================================================*//**
+@file    host.c
+
+@author  Daniel Zorychta
+
+@brief   Host operating system interface (POSIX target).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * NOTE: This file is compiled against host C library headers (see CSRC_HOST
+ *       in the Makefile). Do not include dnx headers except posix/host.h.
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include "posix/host.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define THREAD_STACK_SIZE               (1024 * 1024)
+#define IRQ_SIGNAL                      SIGALRM
+#define MAX_ARGS                        32
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+struct host_thread {
+        pthread_t       thread;
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        bool            run;
+        bool            dying;
+        void          (*func)(void *);
+        void           *arg;
+};
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void  irq_init(void) __attribute__((constructor));
+static void  tick_signal(int sig);
+static void  exit_signal(int sig);
+static void *thread_start(void *arg);
+static void  thread_wait(host_thread_t *thread);
+static void  thread_signal(host_thread_t *thread);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static sigset_t         irq_signals;
+static void           (*tick_handler)(void);
+static pthread_mutex_t  sched_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   sched_cond = PTHREAD_COND_INITIALIZER;
+static bool             sched_end;
+static struct termios   console_attr;
+static bool             console_raw;
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Prepare set of signals used as interrupts.
+ */
+//==============================================================================
+static void irq_init(void)
+{
+        sigemptyset(&irq_signals);
+        sigaddset(&irq_signals, IRQ_SIGNAL);
+}
+
+//==============================================================================
+/**
+ * @brief  Return monotonic host time.
+ *
+ * @return Time in microseconds.
+ */
+//==============================================================================
+uint64_t _host_get_time_us(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t)ts.tv_sec * 1000000) + ((uint64_t)ts.tv_nsec / 1000);
+}
+
+//==============================================================================
+/**
+ * @brief  Block calling thread for selected time. Sleep is continued when
+ *         interrupted by signal.
+ *
+ * @param  microseconds         delay
+ */
+//==============================================================================
+void _host_delay_us(uint32_t microseconds)
+{
+        struct timespec ts;
+        ts.tv_sec  = microseconds / 1000000;
+        ts.tv_nsec = (microseconds % 1000000) * 1000;
+
+        while (nanosleep(&ts, &ts) != 0 && errno == EINTR);
+}
+
+//==============================================================================
+/**
+ * @brief  Suspend calling thread until interrupt (signal) occurs.
+ */
+//==============================================================================
+void _host_idle(void)
+{
+        sigset_t mask;
+        pthread_sigmask(SIG_SETMASK, NULL, &mask);
+        sigdelset(&mask, IRQ_SIGNAL);
+        sigsuspend(&mask);
+}
+
+//==============================================================================
+/**
+ * @brief  Restart process. The process image is executed again with the same
+ *         arguments.
+ */
+//==============================================================================
+void _host_restart(void)
+{
+        static char  cmdline[4096];
+        char        *argv[MAX_ARGS + 1];
+        int          argc = 0;
+
+        int fd = open("/proc/self/cmdline", O_RDONLY);
+        if (fd >= 0) {
+                ssize_t len = read(fd, cmdline, sizeof(cmdline) - 1);
+                close(fd);
+
+                for (ssize_t i = 0; len > 0 && i < len && argc < MAX_ARGS;) {
+                        argv[argc++] = &cmdline[i];
+                        i += strlen(&cmdline[i]) + 1;
+                }
+        }
+
+        if (argc == 0) {
+                argv[argc++] = "/proc/self/exe";
+        }
+
+        argv[argc] = NULL;
+
+        _host_tick_stop();
+        _host_console_close();
+
+        /* signal mask is inherited by new image */
+        sigset_t mask;
+        sigemptyset(&mask);
+        pthread_sigmask(SIG_SETMASK, &mask, NULL);
+
+        execv("/proc/self/exe", argv);
+
+        _exit(EXIT_FAILURE);
+}
+
+//==============================================================================
+/**
+ * @brief  Terminate process.
+ *
+ * @param  status       exit status
+ */
+//==============================================================================
+void _host_exit(int status)
+{
+        _host_tick_stop();
+        _host_console_close();
+        _exit(status);
+}
+
+//==============================================================================
+/**
+ * @brief  Disable interrupts (block interrupt signals) in calling thread.
+ */
+//==============================================================================
+void _host_irq_disable(void)
+{
+        pthread_sigmask(SIG_BLOCK, &irq_signals, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Enable interrupts (unblock interrupt signals) in calling thread.
+ */
+//==============================================================================
+void _host_irq_enable(void)
+{
+        pthread_sigmask(SIG_UNBLOCK, &irq_signals, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Start periodic tick interrupt. Handler is called in context of
+ *         thread that has interrupts enabled (current task).
+ *
+ * @param  period_us    tick period
+ * @param  handler      tick handler
+ */
+//==============================================================================
+void _host_tick_start(uint32_t period_us, void (*handler)(void))
+{
+        tick_handler = handler;
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = tick_signal;
+        sa.sa_flags   = SA_RESTART;
+        sigfillset(&sa.sa_mask);
+        sigaction(IRQ_SIGNAL, &sa, NULL);
+
+        struct itimerval timer;
+        timer.it_interval.tv_sec  = period_us / 1000000;
+        timer.it_interval.tv_usec = period_us % 1000000;
+        timer.it_value            = timer.it_interval;
+        setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Stop tick interrupt.
+ */
+//==============================================================================
+void _host_tick_stop(void)
+{
+        struct itimerval timer;
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Tick signal handler.
+ *
+ * @param  sig          signal number
+ */
+//==============================================================================
+static void tick_signal(int sig)
+{
+        (void)sig;
+
+        int err = errno;
+
+        if (tick_handler) {
+                tick_handler();
+        }
+
+        errno = err;
+}
+
+//==============================================================================
+/**
+ * @brief  Create thread. Thread is started by _host_thread_resume() or
+ *         _host_thread_switch(). All signals are blocked in new thread.
+ *
+ * @param  func         thread function
+ * @param  arg          thread argument
+ *
+ * @return Thread object or NULL on error.
+ */
+//==============================================================================
+host_thread_t *_host_thread_create(void (*func)(void *), void *arg)
+{
+        /*
+         * Signals are blocked during creation: the new thread inherits mask,
+         * and current thread cannot be switched out while host library
+         * holds its internal locks.
+         */
+        sigset_t all, old;
+        sigfillset(&all);
+        pthread_sigmask(SIG_SETMASK, &all, &old);
+
+        host_thread_t *thread = calloc(1, sizeof(host_thread_t));
+        if (thread) {
+                pthread_mutex_init(&thread->lock, NULL);
+                pthread_cond_init(&thread->cond, NULL);
+                thread->func = func;
+                thread->arg  = arg;
+
+                pthread_attr_t attr;
+                pthread_attr_init(&attr);
+                pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+                pthread_attr_setstacksize(&attr, THREAD_STACK_SIZE);
+
+                if (pthread_create(&thread->thread, &attr, thread_start, thread) != 0) {
+                        pthread_cond_destroy(&thread->cond);
+                        pthread_mutex_destroy(&thread->lock);
+                        free(thread);
+                        thread = NULL;
+                }
+
+                pthread_attr_destroy(&attr);
+        }
+
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+        return thread;
+}
+
+//==============================================================================
+/**
+ * @brief  Resume selected thread.
+ *
+ * @param  thread       thread to resume
+ */
+//==============================================================================
+void _host_thread_resume(host_thread_t *thread)
+{
+        thread_signal(thread);
+}
+
+//==============================================================================
+/**
+ * @brief  Resume next thread and suspend calling one. Function returns when
+ *         calling thread is resumed again.
+ *
+ * @param  next         thread to resume
+ * @param  self         calling thread
+ */
+//==============================================================================
+void _host_thread_switch(host_thread_t *next, host_thread_t *self)
+{
+        thread_signal(next);
+        thread_wait(self);
+}
+
+//==============================================================================
+/**
+ * @brief  Cancel selected (suspended) thread. Thread is terminated when woken
+ *         up and releases its object.
+ *
+ * @param  thread       thread to cancel
+ */
+//==============================================================================
+void _host_thread_cancel(host_thread_t *thread)
+{
+        pthread_mutex_lock(&thread->lock);
+        thread->dying = true;
+        pthread_cond_signal(&thread->cond);
+        pthread_mutex_unlock(&thread->lock);
+}
+
+//==============================================================================
+/**
+ * @brief  Block main thread until scheduler end.
+ */
+//==============================================================================
+void _host_scheduler_wait(void)
+{
+        sigset_t all;
+        sigfillset(&all);
+        sigdelset(&all, SIGINT);
+        sigdelset(&all, SIGTERM);
+        pthread_sigmask(SIG_SETMASK, &all, NULL);
+
+        pthread_mutex_lock(&sched_lock);
+        while (!sched_end) {
+                pthread_cond_wait(&sched_cond, &sched_lock);
+        }
+        pthread_mutex_unlock(&sched_lock);
+}
+
+//==============================================================================
+/**
+ * @brief  Release main thread blocked by _host_scheduler_wait().
+ */
+//==============================================================================
+void _host_scheduler_end(void)
+{
+        pthread_mutex_lock(&sched_lock);
+        sched_end = true;
+        pthread_cond_signal(&sched_cond);
+        pthread_mutex_unlock(&sched_lock);
+}
+
+//==============================================================================
+/**
+ * @brief  Thread entry. Waits for first resume.
+ *
+ * @param  arg          thread object
+ *
+ * @return NULL
+ */
+//==============================================================================
+static void *thread_start(void *arg)
+{
+        host_thread_t *thread = arg;
+
+        thread_wait(thread);
+        thread->func(thread->arg);
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Wait for thread resume. Canceled thread is terminated.
+ *
+ * @param  thread       calling thread
+ */
+//==============================================================================
+static void thread_wait(host_thread_t *thread)
+{
+        pthread_mutex_lock(&thread->lock);
+
+        while (!thread->run && !thread->dying) {
+                pthread_cond_wait(&thread->cond, &thread->lock);
+        }
+
+        thread->run = false;
+        bool dying  = thread->dying;
+
+        pthread_mutex_unlock(&thread->lock);
+
+        if (dying) {
+                pthread_cond_destroy(&thread->cond);
+                pthread_mutex_destroy(&thread->lock);
+                free(thread);
+                pthread_exit(NULL);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Resume thread.
+ *
+ * @param  thread       thread to resume
+ */
+//==============================================================================
+static void thread_signal(host_thread_t *thread)
+{
+        pthread_mutex_lock(&thread->lock);
+        thread->run = true;
+        pthread_cond_signal(&thread->cond);
+        pthread_mutex_unlock(&thread->lock);
+}
+
+//==============================================================================
+/**
+ * @brief  Switch terminal connected to standard input to raw mode. Terminal
+ *         settings are restored at exit.
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_console_open(void)
+{
+        if (!console_raw && isatty(STDIN_FILENO)) {
+                if (tcgetattr(STDIN_FILENO, &console_attr) != 0) {
+                        return -1;
+                }
+
+                struct termios attr = console_attr;
+                attr.c_iflag &= ~(ICRNL | IXON);
+                attr.c_lflag &= ~(ICANON | ECHO | ECHONL);
+                attr.c_cc[VMIN]  = 0;
+                attr.c_cc[VTIME] = 0;
+
+                if (tcsetattr(STDIN_FILENO, TCSANOW, &attr) != 0) {
+                        return -1;
+                }
+
+                console_raw = true;
+
+                struct sigaction sa;
+                memset(&sa, 0, sizeof(sa));
+                sa.sa_handler = exit_signal;
+                sigaction(SIGINT, &sa, NULL);
+                sigaction(SIGTERM, &sa, NULL);
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Restore terminal settings.
+ */
+//==============================================================================
+void _host_console_close(void)
+{
+        if (console_raw) {
+                tcsetattr(STDIN_FILENO, TCSANOW, &console_attr);
+                console_raw = false;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Read available bytes from standard input. Function does not block.
+ *
+ * @param  buf          destination buffer
+ * @param  len          buffer size
+ *
+ * @return Number of read bytes (0 if no data), -1 on error or end of input.
+ */
+//==============================================================================
+int _host_console_read(void *buf, size_t len)
+{
+        struct pollfd pfd = {.fd = STDIN_FILENO, .events = POLLIN};
+
+        int n = poll(&pfd, 1, 0);
+        if (n > 0) {
+                ssize_t rd = read(STDIN_FILENO, buf, len);
+                return rd > 0 ? (int)rd : -1;
+        }
+
+        return (n == 0 || errno == EINTR) ? 0 : -1;
+}
+
+//==============================================================================
+/**
+ * @brief  Write buffer to standard output.
+ *
+ * @param  buf          source buffer
+ * @param  len          number of bytes to write
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_console_write(const void *buf, size_t len)
+{
+        const uint8_t *src = buf;
+
+        while (len > 0) {
+                ssize_t wr = write(STDOUT_FILENO, src, len);
+                if (wr > 0) {
+                        src += wr;
+                        len -= wr;
+                } else if (wr < 0 && errno != EINTR && errno != EAGAIN) {
+                        return -1;
+                }
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Restore terminal and terminate process on interrupt signal.
+ *
+ * @param  sig          signal number
+ */
+//==============================================================================
+static void exit_signal(int sig)
+{
+        _host_console_close();
+        _exit(128 + sig);
+}
+
+//==============================================================================
+/**
+ * @brief  Open existing host file for reading and writing.
+ *
+ * @param  path         file path
+ * @param  fd           file descriptor
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_open(const char *path, int *fd)
+{
+        *fd = open(path, O_RDWR | O_CLOEXEC);
+        return *fd >= 0 ? 0 : -1;
+}
+
+//==============================================================================
+/**
+ * @brief  Close host file.
+ *
+ * @param  fd           file descriptor
+ */
+//==============================================================================
+void _host_file_close(int fd)
+{
+        close(fd);
+}
+
+//==============================================================================
+/**
+ * @brief  Read from host file at selected offset.
+ *
+ * @param  fd           file descriptor
+ * @param  buf          destination buffer
+ * @param  len          number of bytes to read
+ * @param  offset       file offset
+ *
+ * @return 0 on success, -1 on error or if file is too short.
+ */
+//==============================================================================
+int _host_file_read(int fd, void *buf, size_t len, uint64_t offset)
+{
+        uint8_t *dst = buf;
+
+        while (len > 0) {
+                ssize_t rd = pread(fd, dst, len, (off_t)offset);
+                if (rd > 0) {
+                        dst    += rd;
+                        len    -= rd;
+                        offset += rd;
+                } else if (rd == 0 || errno != EINTR) {
+                        return -1;
+                }
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Write to host file at selected offset.
+ *
+ * @param  fd           file descriptor
+ * @param  buf          source buffer
+ * @param  len          number of bytes to write
+ * @param  offset       file offset
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_write(int fd, const void *buf, size_t len, uint64_t offset)
+{
+        const uint8_t *src = buf;
+
+        while (len > 0) {
+                ssize_t wr = pwrite(fd, src, len, (off_t)offset);
+                if (wr > 0) {
+                        src    += wr;
+                        len    -= wr;
+                        offset += wr;
+                } else if (wr == 0 || errno != EINTR) {
+                        return -1;
+                }
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Synchronize host file with storage.
+ *
+ * @param  fd           file descriptor
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_sync(int fd)
+{
+        return fsync(fd) == 0 ? 0 : -1;
+}
+
+//==============================================================================
+/**
+ * @brief  Return size of host file.
+ *
+ * @param  fd           file descriptor
+ * @param  size         file size
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_size(int fd, uint64_t *size)
+{
+        struct stat st;
+
+        if (fstat(fd, &st) == 0) {
+                *size = (uint64_t)st.st_size;
+                return 0;
+        }
+
+        return -1;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,107 @@
+/*=========================================================================*//**
+@file    host.h
+
+@author  Daniel Zorychta
+
+@brief   Host operating system interface (POSIX target).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+ * The host interface is the only part of the POSIX target compiled against
+ * the host C library headers (the dnx libc headers shadow the host ones in
+ * all other translation units). The interface uses only compiler-provided
+ * headers, so it can be included from both sides.
+ */
+
+#ifndef _HOST_H_
+#define _HOST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*==============================================================================
+  Exported symbolic constants/macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported types, enums definitions
+==============================================================================*/
+/** Host thread (opaque). */
+typedef struct host_thread host_thread_t;
+
+/*==============================================================================
+  Exported function prototypes
+==============================================================================*/
+/* time */
+extern uint64_t       _host_get_time_us   (void);
+extern void           _host_delay_us      (uint32_t microseconds);
+extern void           _host_idle          (void);
+
+/* process */
+extern void           _host_restart       (void) __attribute__((noreturn));
+extern void           _host_exit          (int status) __attribute__((noreturn));
+
+/* interrupt emulation */
+extern void           _host_irq_disable   (void);
+extern void           _host_irq_enable    (void);
+extern void           _host_tick_start    (uint32_t period_us, void (*handler)(void));
+extern void           _host_tick_stop     (void);
+
+/* threads */
+extern host_thread_t *_host_thread_create (void (*func)(void *), void *arg);
+extern void           _host_thread_resume (host_thread_t *thread);
+extern void           _host_thread_switch (host_thread_t *next, host_thread_t *self);
+extern void           _host_thread_cancel (host_thread_t *thread);
+extern void           _host_scheduler_wait(void);
+extern void           _host_scheduler_end (void);
+
+/* console (standard input and output) */
+extern int            _host_console_open  (void);
+extern void           _host_console_close (void);
+extern int            _host_console_read  (void *buf, size_t len);
+extern int            _host_console_write (const void *buf, size_t len);
+
+/* files */
+extern int            _host_file_open     (const char *path, int *fd);
+extern void           _host_file_close    (int fd);
+extern int            _host_file_read     (int fd, void *buf, size_t len, uint64_t offset);
+extern int            _host_file_write    (int fd, const void *buf, size_t len, uint64_t offset);
+extern int            _host_file_sync     (int fd);
+extern int            _host_file_size     (int fd, uint64_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
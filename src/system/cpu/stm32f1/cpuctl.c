@@ -88,6 +88,13 @@ void _cpuctl_init(void)
         #if (__OS_MONITOR_CPU_LOAD__ > 0)
         _cpuctl_init_CPU_load_counter();
         #endif
+
+        #if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+        /* enable cycle counter used as time stamp by kernel event tracer and lock profiler */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT       = 0;
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+        #endif
 }
 
 //==============================================================================
@@ -169,6 +176,38 @@ u32_t _cpuctl_get_CPU_load_counter_delta(void)
 }
 #endif
 
+//==============================================================================
+/**
+ * @brief  Function return value of free running cycle counter used by kernel
+ *         event tracer as time stamp. Counter overflows are handled by reader.
+ *         Function is called from IRQs.
+ *
+ * @return Counter value.
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter(void)
+{
+        return DWT->CYCCNT;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return frequency of cycle counter.
+ *
+ * @return Counter frequency [Hz].
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter_frequency(void)
+{
+        RCC_ClocksTypeDef freq;
+        RCC_GetClocksFreq(&freq);
+        return freq.HCLK_Frequency;
+}
+#endif
+
 //==============================================================================
 /**
  * @brief  Function sleep CPU weakly. All IRQs must be able to wake up CPU.
@@ -50,6 +50,9 @@
 #define RAM3_START              ((void *)&__ram3_start)
 #define RAM3_SIZE               ((size_t)&__ram3_size)
 
+#define CCM_START               ((void *)&__ccm_start)
+#define CCM_SIZE                ((size_t)&__ccm_size)
+
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
@@ -65,9 +68,12 @@ extern void *__ram2_start;
 extern void *__ram2_size;
 extern void *__ram3_start;
 extern void *__ram3_size;
+extern void *__ccm_start;
+extern void *__ccm_size;
 
 static _mm_region_t ram2;
 static _mm_region_t ram3;
+static _mm_region_t ccm;
 
 /*==============================================================================
   Function definitions
@@ -103,8 +109,16 @@ void _cpuctl_init(void)
         _cpuctl_init_CPU_load_counter();
         #endif
 
-        _mm_register_region(&ram2, RAM2_START, RAM2_SIZE);
-        _mm_register_region(&ram3, RAM3_START, RAM3_SIZE);
+        #if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+        /* enable cycle counter used as time stamp by kernel event tracer and lock profiler */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT       = 0;
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+        #endif
+
+        _mm_register_region(&ram2, RAM2_START, RAM2_SIZE, _MM_REGION_INTERNAL);
+        _mm_register_region(&ram3, RAM3_START, RAM3_SIZE, _MM_REGION_INTERNAL);
+        _mm_register_region(&ccm,  CCM_START,  CCM_SIZE,  _MM_REGION_FAST);
 }
 
 //==============================================================================
@@ -189,6 +203,38 @@ u32_t _cpuctl_get_CPU_load_counter_delta(void)
 }
 #endif
 
+//==============================================================================
+/**
+ * @brief  Function return value of free running cycle counter used by kernel
+ *         event tracer as time stamp. Counter overflows are handled by reader.
+ *         Function is called from IRQs.
+ *
+ * @return Counter value.
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter(void)
+{
+        return DWT->CYCCNT;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return frequency of cycle counter.
+ *
+ * @return Counter frequency [Hz].
+ */
+//==============================================================================
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+u32_t _cpuctl_get_cycle_counter_frequency(void)
+{
+        RCC_ClocksTypeDef freq;
+        RCC_GetClocksFreq(&freq);
+        return freq.HCLK_Frequency;
+}
+#endif
+
 //==============================================================================
 /**
  * @brief  Function sleep CPU weakly. All IRQs must be able to wake up CPU.
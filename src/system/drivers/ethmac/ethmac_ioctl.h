@@ -245,6 +245,24 @@ extern "C" {
  */
 #define IOCTL_ETHMAC__GET_LINK_STATUS                   _IOR(ETHMAC, 0x07, ETHMAC_link_status_t*)
 
+/**
+ * @brief  Send packet gathered from chain buffer. Packet is composed of all
+ *         chain links (up to total_size bytes) without intermediate buffer.
+ * @param  [WR] @ref ETHMAC_packet_chain_t*       first link of chain buffer.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_ETHMAC__SEND_PACKET_FROM_CHAIN            _IOW(ETHMAC, 0x08, ETHMAC_packet_chain_t*)
+
+/**
+ * @brief  Receive all pending packets (up to batch count) without waiting.
+ *         Each packet buffer should have size of maximum frame; payload_size
+ *         is set to received frame size (without CRC). Damaged or too big
+ *         frames are discarded and counted as dropped.
+ * @param  [WR,RD] @ref ETHMAC_packet_batch_t*    packet buffers and counters.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_ETHMAC__RECEIVE_PACKETS                   _IOWR(ETHMAC, 0x09, ETHMAC_packet_batch_t*)
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
@@ -256,6 +274,26 @@ typedef struct ETHMAC_packet_chain {
         u16_t  payload_size;    /*!< Payload size.*/
 } ETHMAC_packet_t;
 
+/**
+ * Type represent link of packet chain buffer.
+ */
+typedef struct ETHMAC_packet_chain_link {
+        struct ETHMAC_packet_chain_link *next;  /*!< Next chain link (NULL if last).*/
+        const void *payload;                    /*!< Payload of this link.*/
+        u16_t       total_size;                 /*!< Packet size (used only in first link).*/
+        u16_t       payload_size;               /*!< Payload size of this link.*/
+} ETHMAC_packet_chain_t;
+
+/**
+ * Type represent batch of received packets.
+ */
+typedef struct {
+        ETHMAC_packet_t *packet;        /*!< Packet buffers. Value is set by user at request.*/
+        size_t           count;         /*!< Number of packet buffers. Value is set by user at request.*/
+        size_t           received;      /*!< Number of received packets. Value is set by driver at response.*/
+        size_t           dropped;       /*!< Number of dropped packets. Value is set by driver at response.*/
+} ETHMAC_packet_batch_t;
+
 /**
  * Type represent link status.
  */
@@ -46,6 +46,7 @@
 ==============================================================================*/
 struct ethmac {
         sem_t              *rx_data_ready;
+        sem_t              *tx_done;
         mutex_t            *rx_access;
         mutex_t            *tx_access;
         dev_lock_t          dev_lock;
@@ -59,6 +60,8 @@ struct ethmac {
   Local function prototypes
 ==============================================================================*/
 static bool   is_Ethernet_started       (void);
+static int    send_chain                (struct ethmac *hdl, const ETHMAC_packet_chain_t *chain, u32_t timeout);
+static int    wait_for_Tx_descriptor    (sem_t *tx_done, u32_t timeout);
 static void   send_packet               (size_t size);
 static size_t wait_for_packet           (struct ethmac *hdl, uint32_t timeout);
 static void   give_Rx_buffer_to_DMA     (void);
@@ -114,6 +117,10 @@ API_MOD_INIT(ETHMAC, void **device_handle, u8_t major, u8_t minor)
                 if (err != ESUCC)
                         goto finish;
 
+                err = sys_semaphore_create(1, 0, &hdl->tx_done);
+                if (err != ESUCC)
+                        goto finish;
+
                 err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->rx_access);
                 if (err != ESUCC)
                         goto finish;
@@ -178,7 +185,7 @@ API_MOD_INIT(ETHMAC, void **device_handle, u8_t major, u8_t minor)
 
                         ethmac = hdl;
 
-                        ETH_DMAITConfig(ETH_DMA_IT_NIS | ETH_DMA_IT_R, ENABLE);
+                        ETH_DMAITConfig(ETH_DMA_IT_NIS | ETH_DMA_IT_R | ETH_DMA_IT_T, ENABLE);
 
                         ETH_DMATxDescChainInit(ethmac->DMA_tx_descriptor,
                                                &ethmac->tx_buffer[0][0],
@@ -209,6 +216,9 @@ API_MOD_INIT(ETHMAC, void **device_handle, u8_t major, u8_t minor)
                         if (hdl->rx_data_ready)
                                 sys_semaphore_destroy(hdl->rx_data_ready);
 
+                        if (hdl->tx_done)
+                                sys_semaphore_destroy(hdl->tx_done);
+
                         if (hdl->rx_access)
                                 sys_mutex_destroy(hdl->rx_access);
 
@@ -244,6 +254,7 @@ API_MOD_RELEASE(ETHMAC, void *device_handle)
                                       | RCC_AHB1ENR_ETHMACTXEN
                                       | RCC_AHB1ENR_ETHMACEN);
                 sys_semaphore_destroy(hdl->rx_data_ready);
+                sys_semaphore_destroy(hdl->tx_done);
                 sys_mutex_destroy(hdl->rx_access);
                 sys_mutex_destroy(hdl->tx_access);
                 sys_free(&device_handle);
@@ -323,42 +334,28 @@ API_MOD_WRITE(ETHMAC,
 
         if (is_Ethernet_started()) {
 
-                if (sys_mutex_lock(hdl->tx_access, fattr.non_blocking_wr ? 0 : MAX_DELAY_MS) == ESUCC) {
-
-                        *wrcnt = 0;
-                        int err;
-
-                        while (count) {
-                                while (is_buffer_owned_by_DMA(DMATxDescToSet)) {
-
-                                        if (fattr.non_blocking_wr) {
-                                                err = EAGAIN;
-                                                goto exit;
-                                        }
-
-                                        sys_sleep_ms(1);
-                                }
+                u32_t timeout = fattr.non_blocking_wr ? 0 : MAX_DELAY_MS;
+                int   err     = ESUCC;
 
-                                size_t packet_size = min(count, ETH_MAX_PACKET_SIZE);
+                *wrcnt = 0;
 
-                                u8_t *buffer = get_buffer_address(DMATxDescToSet);
-                                memcpy(buffer, src, packet_size);
-                                send_packet(packet_size);
+                while (count && !err) {
+                        ETHMAC_packet_chain_t chain;
+                        chain.next         = NULL;
+                        chain.payload      = src;
+                        chain.total_size   = min(count, ETH_MAX_PACKET_SIZE);
+                        chain.payload_size = chain.total_size;
 
-                                *wrcnt += packet_size;
-                                count  -= packet_size;
+                        err = send_chain(hdl, &chain, timeout);
+                        if (!err) {
+                                src    += chain.total_size;
+                                *wrcnt += chain.total_size;
+                                count  -= chain.total_size;
                         }
-
-                        err = ESUCC;
-
-                        exit:
-                        sys_mutex_unlock(hdl->tx_access);
-
-                        return err;
-                } else {
-                        return EAGAIN;
                 }
 
+                return err;
+
         } else {
                 return EIO;
         }
@@ -482,34 +479,24 @@ API_MOD_IOCTL(ETHMAC, void *device_handle, int request, void *arg)
                 break;
 
         case IOCTL_ETHMAC__SEND_PACKET:
-                if (arg) {
-                        if (sys_mutex_lock(hdl->tx_access, MAX_DELAY_MS) == ESUCC) {
-                                ETHMAC_packet_t *pkt = arg;
+                if (arg && cast(ETHMAC_packet_t*, arg)->payload) {
+                        ETHMAC_packet_t *pkt = arg;
 
-                                while (is_buffer_owned_by_DMA(DMATxDescToSet)) {
-                                        sys_sleep_ms(1);
-                                }
-
-                                if (  !is_buffer_owned_by_DMA(DMATxDescToSet)
-                                   && pkt->payload
-                                   && pkt->payload_size <= ETH_MAX_PACKET_SIZE) {
+                        ETHMAC_packet_chain_t chain;
+                        chain.next         = NULL;
+                        chain.payload      = pkt->payload;
+                        chain.total_size   = pkt->payload_size;
+                        chain.payload_size = pkt->payload_size;
 
-                                        u8_t *buffer = get_buffer_address(DMATxDescToSet);
-
-                                        memcpy(buffer, pkt->payload, pkt->payload_size);
-
-                                        send_packet(pkt->payload_size);
-
-                                        err = ESUCC;
-                                } else {
-                                        printk("ETH: payload size too big or NULL");
-                                        err = EAGAIN;
-                                }
+                        err = send_chain(hdl, &chain, MAX_DELAY_MS);
+                } else {
+                        err = EINVAL;
+                }
+                break;
 
-                                sys_mutex_unlock(hdl->tx_access);
-                        } else {
-                                err = EAGAIN;
-                        }
+        case IOCTL_ETHMAC__SEND_PACKET_FROM_CHAIN:
+                if (arg) {
+                        err = send_chain(hdl, arg, MAX_DELAY_MS);
                 } else {
                         err = EINVAL;
                 }
@@ -559,6 +546,49 @@ API_MOD_IOCTL(ETHMAC, void *device_handle, int request, void *arg)
                 }
                 break;
 
+        case IOCTL_ETHMAC__RECEIVE_PACKETS:
+                if (arg) {
+                        if (sys_mutex_lock(hdl->rx_access, MAX_DELAY_MS) == ESUCC) {
+                                ETHMAC_packet_batch_t *batch = arg;
+
+                                batch->received = 0;
+                                batch->dropped  = 0;
+
+                                while (  batch->received < batch->count
+                                      && !is_buffer_owned_by_DMA(DMARxDescToGet)) {
+
+                                        ETHMAC_packet_t *pkt  = &batch->packet[batch->received];
+                                        size_t           size = ETH_GetRxPktSize(DMARxDescToGet);
+
+                                        // NOTE: subtract packet size by 4 to discard CRC32
+                                        if (  size > 4
+                                           && pkt->payload
+                                           && size - 4 <= pkt->payload_size) {
+
+                                                u8_t *buffer = get_buffer_address(DMARxDescToGet);
+                                                memcpy(pkt->payload, buffer, size - 4);
+                                                pkt->payload_size = size - 4;
+                                                batch->received++;
+                                        } else {
+                                                batch->dropped++;
+                                        }
+
+                                        give_Rx_buffer_to_DMA();
+                                }
+
+                                make_Rx_buffer_available();
+
+                                sys_mutex_unlock(hdl->rx_access);
+
+                                err = ESUCC;
+                        } else {
+                                err = EAGAIN;
+                        }
+                } else {
+                        err = EINVAL;
+                }
+                break;
+
         case IOCTL_ETHMAC__ETHERNET_START:
                 ETH_Start();
                 return ESUCC;
@@ -642,6 +672,82 @@ static bool is_Ethernet_started(void)
         return (ETH->MACCR & ETH_MACCR_TE) && (ETH->MACCR & ETH_MACCR_RE);
 }
 
+//==============================================================================
+/**
+ * @brief  Function sends packet chain. Links are gathered to the buffer of
+ *         current Tx descriptor, then descriptor is given to the DMA.
+ *
+ * @param  hdl          driver context
+ * @param  chain        packet chain
+ * @param  timeout      free Tx descriptor wait timeout
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int send_chain(struct ethmac *hdl, const ETHMAC_packet_chain_t *chain, u32_t timeout)
+{
+        if (chain->total_size > ETH_MAX_PACKET_SIZE) {
+                printk("ETH: payload size too big");
+                return EAGAIN;
+        }
+
+        int err = sys_mutex_lock(hdl->tx_access, timeout);
+        if (!err) {
+                err = wait_for_Tx_descriptor(hdl->tx_done, timeout);
+                if (!err) {
+                        u8_t  *buffer = cast(u8_t*, DMATxDescToSet->Buffer1Addr);
+                        size_t size   = 0;
+
+                        for (const ETHMAC_packet_chain_t *link = chain;
+                             link && size < chain->total_size;
+                             link = link->next) {
+
+                                size_t n = min(link->payload_size, chain->total_size - size);
+
+                                if (link->payload) {
+                                        memcpy(&buffer[size], link->payload, n);
+                                        size += n;
+                                }
+                        }
+
+                        if (size == chain->total_size) {
+                                send_packet(size);
+                        } else {
+                                err = EINVAL;
+                        }
+                }
+
+                sys_mutex_unlock(hdl->tx_access);
+        } else {
+                err = EAGAIN;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function waits for Tx descriptor released by the DMA. Release is
+ *         signaled by Tx complete interrupt, thus semaphore can be signaled
+ *         before wait and state of descriptor is checked again.
+ *
+ * @param  tx_done      semaphore signaled by Tx complete interrupt
+ * @param  timeout      wait timeout
+ *
+ * @return ESUCC if descriptor is free, EAGAIN on timeout.
+ */
+//==============================================================================
+static int wait_for_Tx_descriptor(sem_t *tx_done, u32_t timeout)
+{
+        while (DMATxDescToSet->Status & ETH_DMATxDesc_OWN) {
+                if (sys_semaphore_wait(tx_done, timeout) != ESUCC) {
+                        return EAGAIN;
+                }
+        }
+
+        return ESUCC;
+}
+
 //==============================================================================
 /**
  * @brief  Send packet from current Tx buffer
@@ -659,6 +765,9 @@ static void send_packet(size_t size)
         /* Setting the last segment and first segment bits (in this case a frame is transmitted in one descriptor) */
         DMATxDescToSet->Status |= ETH_DMATxDesc_LS | ETH_DMATxDesc_FS;
 
+        /* Tx complete interrupt wakes up thread waiting for descriptor */
+        DMATxDescToSet->Status |= ETH_DMATxDesc_IC;
+
         /* Set Own bit of the Tx descriptor Status: gives the buffer back to ETHERNET DMA */
         DMATxDescToSet->Status |= ETH_DMATxDesc_OWN;
 
@@ -781,15 +890,20 @@ void ETH_EXTERN_GetSpeedAndDuplex(uint32_t PHYAddress, ETH_InitTypeDef *ETH_Init
 //==============================================================================
 void ETH_IRQHandler(void)
 {
-        if (ETH_GetDMAFlagStatus(ETH_DMA_FLAG_R)) {
-
-                bool woken = false;
-                sys_semaphore_signal_from_ISR(ethmac->rx_data_ready, &woken);
+        bool rx_woken = false;
+        bool tx_woken = false;
 
+        if (ETH_GetDMAFlagStatus(ETH_DMA_FLAG_R)) {
+                sys_semaphore_signal_from_ISR(ethmac->rx_data_ready, &rx_woken);
                 ETH_DMAClearITPendingBit(ETH_DMA_IT_NIS | ETH_DMA_IT_R);
+        }
 
-                sys_thread_yield_from_ISR(woken);
+        if (ETH_GetDMAFlagStatus(ETH_DMA_FLAG_T)) {
+                sys_semaphore_signal_from_ISR(ethmac->tx_done, &tx_woken);
+                ETH_DMAClearITPendingBit(ETH_DMA_IT_NIS | ETH_DMA_IT_T);
         }
+
+        sys_thread_yield_from_ISR(rx_woken || tx_woken);
 }
 
 /*==============================================================================
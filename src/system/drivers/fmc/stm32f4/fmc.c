@@ -440,7 +440,8 @@ static int SDRAM_init(void)
                                    * (2 << (__FMC_SDRAM_1_NC__ +  7)) // Col bits (0 - 8 bits:  A7)
                                    * (2 << (__FMC_SDRAM_1_NB__     )) // Banks (2 or 4)
                                    * (8 << (__FMC_SDRAM_1_MWID__   )) // Bus width
-                                   / (8));                            // Bits per byte
+                                   / (8),                             // Bits per byte
+                                   MEM_REGION_EXTERNAL);
 #endif
 
 #if __FMC_SDRAM_2_ENABLE__ > 0
@@ -449,7 +450,8 @@ static int SDRAM_init(void)
                                    * (2 << (__FMC_SDRAM_2_NC__ +  7)) // Col bits (0 - 8 bits:  A7)
                                    * (2 << (__FMC_SDRAM_2_NB__     )) // Banks (2 or 4)
                                    * (8 << (__FMC_SDRAM_2_MWID__   )) // Bus width
-                                   / (8));                            // Bits per byte
+                                   / (8),                             // Bits per byte
+                                   MEM_REGION_EXTERNAL);
 #endif
 
         return err1 ? err1 : (err2 ? err2 : ESUCC);
@@ -0,0 +1,125 @@
+/*=========================================================================*//**
+@file    hostblk_ioctl.h
+
+@author  Daniel Zorychta
+
+@brief   This file support ioctl request codes.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+@defgroup drv-hostblk HOSTBLK Driver (host image file block device)
+
+\section drv-hostblk-desc Description
+Driver exposes image file of host file system as block device. Driver is
+available only on hosted (POSIX) target and can be used to mount any block
+based file system (e.g. fatfs, ext4fs, eefs) on image stored on host.
+
+\section drv-hostblk-sup-arch Supported architectures
+\li posix
+
+\section drv-hostblk-ddesc Details
+\subsection drv-hostblk-ddesc-num Meaning of major and minor numbers
+The major number selects image file configured in the project configuration
+(__HOSTBLK_IMAGE_n__). The minor number should be set always to 0.
+
+\subsubsection drv-hostblk-ddesc-numres Numeration restrictions
+The major number can be set from 0 to number of configured images - 1.
+
+\subsection drv-hostblk-ddesc-init Driver initialization
+Image file must exist on host at driver initialization (path is relative to
+working directory of host process). To initialize driver the following code
+can be used:
+
+@code
+driver_init("HOSTBLK", 0, 0, "/dev/sda");
+@endcode
+
+\subsection drv-hostblk-ddesc-release Driver release
+@code
+driver_release("HOSTBLK", 0, 0);
+@endcode
+
+\subsection drv-hostblk-ddesc-cfg Driver configuration
+Driver does not support any configuration. Driver is ready to use after
+initialization.
+
+\subsection drv-hostblk-ddesc-write Data write
+Data is written at file position directly to the image file.
+
+\subsection drv-hostblk-ddesc-read Data read
+Data is read from file position directly from the image file.
+
+\subsection drv-hostblk-ddesc-flush Flush
+Flush operation synchronize image file with host storage.
+
+@{
+*/
+
+#ifndef _HOSTBLK_IOCTL_H_
+#define _HOSTBLK_IOCTL_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/ioctl_macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/**
+ *  @brief  Initialize storage (OS storage request). Image is ready after
+ *          driver initialization so request does nothing.
+ *  @return On success 0 is returned.
+ *          On error -1 is returned and @ref errno is set.
+ */
+#define IOCTL_HOSTBLK__INITIALIZE       IOCTL_STORAGE__INITIALIZE
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOSTBLK_IOCTL_H_ */
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
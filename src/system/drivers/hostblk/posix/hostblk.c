@@ -0,0 +1,334 @@
+/*=========================================================================*//**
+@file    hostblk.c
+
+@author  Daniel Zorychta
+
+@brief   Block device driver backed by image file of host file system
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/driver.h"
+#include "drivers/class/storage/ioctl.h"
+#include "../hostblk_ioctl.h"
+#include "posix/host.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define MUTEX_TIMEOUT           MAX_DELAY_MS
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        mutex_t    *mtx;
+        dev_lock_t  lock;
+        int         fd;
+} hostblk_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+MODULE_NAME(HOSTBLK);
+
+static const char *const IMAGE[] = {
+        __HOSTBLK_IMAGE_0__,
+        __HOSTBLK_IMAGE_1__,
+        __HOSTBLK_IMAGE_2__,
+        __HOSTBLK_IMAGE_3__,
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Initialize device
+ *
+ * @param[out]          **device_handle        device allocated memory
+ * @param[in ]            major                major device number
+ * @param[in ]            minor                minor device number
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_INIT(HOSTBLK, void **device_handle, u8_t major, u8_t minor)
+{
+        if (major >= __HOSTBLK_DEVICES__ || major >= ARRAY_SIZE(IMAGE) || minor != 0) {
+                return ENODEV;
+        }
+
+        int err = sys_zalloc(sizeof(hostblk_t), device_handle);
+        if (!err) {
+                hostblk_t *hdl = *device_handle;
+
+                sys_device_unlock(&hdl->lock, true);
+
+                err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->mtx);
+
+                if (!err) {
+                        if (_host_file_open(IMAGE[major], &hdl->fd) != 0) {
+                                printk("HOSTBLK: cannot open image %s", IMAGE[major]);
+                                err = ENOENT;
+                        }
+                }
+
+                if (err) {
+                        if (hdl->mtx) {
+                                sys_mutex_destroy(hdl->mtx);
+                        }
+
+                        sys_free(device_handle);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Release device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_RELEASE(HOSTBLK, void *device_handle)
+{
+        hostblk_t *hdl = device_handle;
+
+        int err = sys_device_lock(&hdl->lock);
+        if (!err) {
+                _host_file_sync(hdl->fd);
+                _host_file_close(hdl->fd);
+                sys_mutex_destroy(hdl->mtx);
+                sys_free(&device_handle);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Open device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           flags                  file operation flags (O_RDONLY, O_WRONLY, O_RDWR)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_OPEN(HOSTBLK, void *device_handle, u32_t flags)
+{
+        UNUSED_ARG2(device_handle, flags);
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Close device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           force                  device force close (true)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_CLOSE(HOSTBLK, void *device_handle, bool force)
+{
+        UNUSED_ARG2(device_handle, force);
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Write data to device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]          *src                    data source
+ * @param[in ]           count                  number of bytes to write
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *wrcnt                  number of written bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_WRITE(HOSTBLK,
+              void             *device_handle,
+              const u8_t       *src,
+              size_t            count,
+              fpos_t           *fpos,
+              size_t           *wrcnt,
+              struct vfs_fattr  fattr)
+{
+        UNUSED_ARG1(fattr);
+
+        hostblk_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (_host_file_write(hdl->fd, src, count, *fpos) == 0) {
+                        *wrcnt = count;
+                } else {
+                        err = EIO;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Read data from device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *dst                    data destination
+ * @param[in ]           count                  number of bytes to read
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *rdcnt                  number of read bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_READ(HOSTBLK,
+             void            *device_handle,
+             u8_t            *dst,
+             size_t           count,
+             fpos_t          *fpos,
+             size_t          *rdcnt,
+             struct vfs_fattr fattr)
+{
+        UNUSED_ARG1(fattr);
+
+        hostblk_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (_host_file_read(hdl->fd, dst, count, *fpos) == 0) {
+                        *rdcnt = count;
+                } else {
+                        err = EIO;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief IO control
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           request                request
+ * @param[in ][out]     *arg                    request's argument
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_IOCTL(HOSTBLK, void *device_handle, int request, void *arg)
+{
+        UNUSED_ARG2(device_handle, arg);
+
+        switch (request) {
+        case IOCTL_HOSTBLK__INITIALIZE:
+                return ESUCC;
+
+        default:
+                return EBADRQC;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Flush device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_FLUSH(HOSTBLK, void *device_handle)
+{
+        hostblk_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (_host_file_sync(hdl->fd) != 0) {
+                        err = EIO;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Device information
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *device_stat            device status
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_STAT(HOSTBLK, void *device_handle, struct vfs_dev_stat *device_stat)
+{
+        hostblk_t *hdl = device_handle;
+
+        uint64_t size = 0;
+        if (_host_file_size(hdl->fd, &size) != 0) {
+                return EIO;
+        }
+
+        device_stat->st_size = size;
+
+        return ESUCC;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
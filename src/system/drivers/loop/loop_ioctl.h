@@ -412,6 +412,29 @@ request. Example code of handling flush request:
         // ...
 \endcode
 
+\subsubsection drv-loop-ddesc-host-storage Handling storage requests
+When loop device is used as storage by file system (e.g. FAT image file) then
+the file system can send storage requests. Flush and statistics requests are
+used to synchronize image and to read number of sectors. The
+@ref IOCTL_STORAGE__DISCARD request is send as ioctl request (see
+@ref drv-loop-ddesc-host-ioctl) when sectors are no longer used. The argument
+is a pointer to the @ref STORAGE_discard_t object. Host can release selected
+sectors (e.g. punch hole in the image file) or respond by EBADRQC if request is
+not supported. Example code:
+\code
+        // ...
+
+        case IOCTL_STORAGE__DISCARD: {
+                const STORAGE_discard_t *range = rq.ioctl.arg;
+                // release sectors range->sector ... range->sector + range->count - 1
+                // ...
+                ioctl_resp.err = ESUCC;
+                break;
+        }
+
+        // ...
+\endcode
+
 @{
 */
 
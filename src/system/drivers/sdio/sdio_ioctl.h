@@ -179,6 +179,14 @@ extern "C" {
  */
 #define IOCTL_SDIO__READ_MBR            IOCTL_STORAGE__READ_MBR
 
+/**
+ *  @brief  Erase sectors that are no longer used (OS storage request).
+ *  @param  [WR] @ref STORAGE_discard_t*  range of sectors (relative to partition)
+ *  @return On success 0 is returned.
+ *          On error -1 is returned and @ref errno is set.
+ */
+#define IOCTL_SDIO__DISCARD             IOCTL_STORAGE__DISCARD
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
@@ -143,6 +143,8 @@ static int card_get_response(SD_response_t *resp, resp_t type);
 static int card_read_sectors(SDIO_t *hdl, u8_t *dst, size_t count, u32_t address, size_t *rdsec);
 static int card_write_sectors(SDIO_t *hdl, const u8_t *src, size_t count, u32_t address, size_t *wrsec);
 static int card_transfer_block(SDIO_t *hdl, uint32_t cmd, uint32_t address, u8_t *buf, size_t count, dir_t dir);
+static int card_erase_sectors(SDIO_t *hdl, u32_t address, u32_t count);
+static int card_wait_ready(SDIO_t *hdl, u32_t timeout);
 static int MBR_detect_partitions(SDIO_t *hdl);
 
 #if USE_DMA != USE_DMA_NEVER
@@ -446,8 +448,6 @@ API_MOD_READ(SDIO,
 //==============================================================================
 API_MOD_IOCTL(SDIO, void *device_handle, int request, void *arg)
 {
-        UNUSED_ARG1(arg);
-
         SDIO_t *hdl = device_handle;
 
         int err = EBADRQC;
@@ -475,6 +475,32 @@ API_MOD_IOCTL(SDIO, void *device_handle, int request, void *arg)
                 break;
         }
 
+        case IOCTL_SDIO__DISCARD: {
+                const STORAGE_discard_t *range = arg;
+                part_t *part = &hdl->ctrl->part[hdl->minor];
+
+                if (!range || (range->count == 0)) {
+                        err = EINVAL;
+
+                } else if (  (range->sector >= part->size)
+                          || (range->count > (part->size - range->sector)) ) {
+                        err = ESPIPE;
+
+                } else {
+                        err = sys_mutex_lock(hdl->ctrl->protect, MAX_DELAY_MS);
+                        if (!err) {
+                                if (hdl->ctrl->initialized) {
+                                        err = card_erase_sectors(hdl, part->offset + range->sector,
+                                                                 range->count);
+                                } else {
+                                        err = ENOMEDIUM;
+                                }
+                                sys_mutex_unlock(hdl->ctrl->protect);
+                        }
+                }
+                break;
+        }
+
         default:
                 return EBADRQC;
         }
@@ -493,9 +519,18 @@ API_MOD_IOCTL(SDIO, void *device_handle, int request, void *arg)
 //==============================================================================
 API_MOD_FLUSH(SDIO, void *device_handle)
 {
-        UNUSED_ARG1(device_handle);
+        SDIO_t *hdl = device_handle;
 
-        return ESUCC;
+        int err = sys_mutex_lock(hdl->ctrl->protect, MAX_DELAY_MS);
+        if (!err) {
+                if (hdl->ctrl->initialized) {
+                        err = card_wait_ready(hdl, TRANSACTION_TIMEOUT);
+                }
+
+                sys_mutex_unlock(hdl->ctrl->protect);
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -947,6 +982,85 @@ static int card_write_sectors(SDIO_t *hdl, const u8_t *src, size_t count, u32_t
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function erase selected amount of sectors.
+ *
+ * @param  hdl          module handle
+ * @param  address      start sector address
+ * @param  count        number of sectors to erase
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int card_erase_sectors(SDIO_t *hdl, u32_t address, u32_t count)
+{
+        int err = EIO;
+        SD_response_t resp;
+
+        if (hdl->ctrl->card.type == SD_TYPE__MMC) {
+                return ENOTSUP;
+        }
+
+        u32_t last = address + count - 1;
+
+        if (hdl->ctrl->card.type == SD_TYPE__SD1) {
+                address *= SECTOR_SIZE;
+                last    *= SECTOR_SIZE;
+        }
+
+        catcherr(err = card_send_cmd(SD_CMD__CMD32, CMD_RESP_SHORT, address), exit);
+        catcherr(err = card_get_response(&resp, RESP_R1), exit);
+        catcherr(err = card_send_cmd(SD_CMD__CMD33, CMD_RESP_SHORT, last), exit);
+        catcherr(err = card_get_response(&resp, RESP_R1), exit);
+        catcherr(err = card_send_cmd(SD_CMD__CMD38, CMD_RESP_SHORT, 0), exit);
+        catcherr(err = card_get_response(&resp, RESP_R1b), exit);
+
+        /* erase can take much longer than single transaction */
+        err = card_wait_ready(hdl, 10 * TRANSACTION_TIMEOUT);
+
+        exit:
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait until card is ready for data (programming finished).
+ *
+ * @param  hdl          module handle
+ * @param  timeout      timeout in milliseconds
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int card_wait_ready(SDIO_t *hdl, u32_t timeout)
+{
+        int err = EIO;
+        SD_response_t resp;
+
+        u32_t timer = sys_time_get_reference();
+
+        do {
+                catcherr(err = card_send_cmd(SD_CMD__CMD13, CMD_RESP_SHORT, hdl->ctrl->RCA), exit);
+                catcherr(err = card_get_response(&resp, RESP_R1b), exit);
+
+                if (resp.RESPONSE[0] & 0x100) {
+                        break;
+                }
+
+                if (sys_time_is_expired(timer, timeout)) {
+                        err = ETIME;
+                        break;
+                }
+
+                sys_sleep_ms(1);
+
+        } while (true);
+
+        exit:
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief  Function transfer block to or from card.
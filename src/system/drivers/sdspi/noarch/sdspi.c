@@ -95,6 +95,7 @@ static ssize_t  card_write_partial_sectors (SDSPI_t *hdl, const u8_t *src, size_
 static int      card_initialize            (SDSPI_t *hdl);
 static int      card_read                  (SDSPI_t *hdl, u8_t *dst, size_t count, u64_t lseek, size_t *rdcnt);
 static int      card_write                 (SDSPI_t *hdl, const u8_t *src, size_t count, u64_t lseek, size_t *wrcnt);
+static int      card_erase                 (SDSPI_t *hdl, u32_t sector, u32_t count);
 static int      MBR_detect_partitions      (SDSPI_t *hdl);
 
 /*==============================================================================
@@ -408,6 +409,27 @@ API_MOD_IOCTL(SDSPI, void *device_handle, int request, void *arg)
                 break;
         }
 
+        case IOCTL_SDSPI__DISCARD: {
+                const STORAGE_discard_t *range = arg;
+                part_t *part = &hdl->stg->part[hdl->minor];
+
+                if (!range || (range->count == 0)) {
+                        err = EINVAL;
+
+                } else if (  (range->sector >= part->size)
+                          || (range->count > (part->size - range->sector)) ) {
+                        err = ESPIPE;
+
+                } else {
+                        err = sys_mutex_lock(hdl->stg->protect_mtx, MAX_DELAY_MS);
+                        if (!err) {
+                                err = card_erase(hdl, part->offset + range->sector, range->count);
+                                sys_mutex_unlock(hdl->stg->protect_mtx);
+                        }
+                }
+                break;
+        }
+
         default:
                 return EBADRQC;
         }
@@ -426,9 +448,21 @@ API_MOD_IOCTL(SDSPI, void *device_handle, int request, void *arg)
 //==============================================================================
 API_MOD_FLUSH(SDSPI, void *device_handle)
 {
-        UNUSED_ARG1(device_handle);
+        SDSPI_t *hdl = device_handle;
 
-        return ESUCC;
+        int err = sys_mutex_lock(hdl->stg->protect_mtx, MAX_DELAY_MS);
+        if (!err) {
+                if (hdl->stg->initialized) {
+                        /* card is busy (holds MISO low) until programming is finished */
+                        SPI_select_card(hdl);
+                        err = (card_wait_ready(hdl) == 0xFF) ? ESUCC : ETIME;
+                        SPI_deselect_card(hdl);
+                }
+
+                sys_mutex_unlock(hdl->stg->protect_mtx);
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -1131,6 +1165,58 @@ static int card_write(SDSPI_t *hdl, const u8_t *src, size_t count, u64_t lseek,
         }
 }
 
+//==============================================================================
+/**
+ * @brief Erase sectors of card
+ *
+ * @param[in]  hdl              driver's memory handle
+ * @param[in]  sector           first sector (absolute)
+ * @param[in]  count            number of sectors
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int card_erase(SDSPI_t *hdl, u32_t sector, u32_t count)
+{
+        if (hdl->stg->initialized == false) {
+                return EIO;
+        }
+
+        if (hdl->stg->type.type == SD_TYPE__MMC) {
+                return ENOTSUP;
+        }
+
+        u32_t first = sector;
+        u32_t last  = sector + count - 1;
+
+        if (!hdl->stg->type.block) {
+                first *= SECTOR_SIZE;
+                last  *= SECTOR_SIZE;
+        }
+
+        int err = EIO;
+
+        if (  (card_send_cmd(hdl, SD_CMD__CMD32, first) == 0)
+           && (card_send_cmd(hdl, SD_CMD__CMD33, last)  == 0)
+           && (card_send_cmd(hdl, SD_CMD__CMD38, 0)     == 0) ) {
+
+                err = ESUCC;
+
+                /* erase can take much longer than single timeout */
+                u32_t timer = sys_time_get_reference();
+                while (card_wait_ready(hdl) != 0xFF) {
+                        if (sys_time_is_expired(timer, 10 * hdl->stg->timeout_ms)) {
+                                err = ETIME;
+                                break;
+                        }
+                }
+        }
+
+        SPI_deselect_card(hdl);
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief Function detect partitions
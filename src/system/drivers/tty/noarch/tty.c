@@ -72,6 +72,7 @@ struct module {
         tid_t           service_out;
         tid_t           service_in;
         int             current_tty;
+        shrinker_t      shrinker;
 };
 
 /*==============================================================================
@@ -85,6 +86,7 @@ static void     vt100_analyze           (const char c);
 static void     copy_string_to_queue    (const char *str, queue_t *queue, bool lfend, uint timeout);
 static void     switch_terminal         (int term_no);
 static void     handle_new_line         (tty_t *tty);
+static size_t   shrink                  (size_t size, void *arg);
 
 /*==============================================================================
   Local object definitions
@@ -148,6 +150,10 @@ API_MOD_INIT(TTY, void **device_handle, u8_t major, u8_t minor)
                 if (err != ESUCC)
                         goto module_alloc_finish;
 
+                err = sys_queue_create(QUEUE_CMD_LEN, sizeof(tty_cmd_t), &tty_module->queue_cmd);
+                if (err != ESUCC)
+                        goto module_alloc_finish;
+
                 err = sys_thread_create(service_in, &SERVICE_IN_ATTR, NULL, &tty_module->service_in);
                 if (err != ESUCC)
                         goto module_alloc_finish;
@@ -156,7 +162,7 @@ API_MOD_INIT(TTY, void **device_handle, u8_t major, u8_t minor)
                 if (err != ESUCC)
                         goto module_alloc_finish;
 
-                err = sys_queue_create(QUEUE_CMD_LEN, sizeof(tty_cmd_t), &tty_module->queue_cmd);
+                err = sys_shrinker_register(&tty_module->shrinker, "tty", 10, shrink, NULL);
 
                 module_alloc_finish:
                 if (err != ESUCC) {
@@ -268,6 +274,7 @@ API_MOD_RELEASE(TTY, void *device_handle)
                 }
 
                 if (release_TTY) {
+                        sys_shrinker_unregister(&tty_module->shrinker);
                         sys_thread_destroy(tty_module->service_in);
                         sys_thread_destroy(tty_module->service_out);
                         sys_fclose(tty_module->infile);
@@ -896,6 +903,37 @@ static void handle_new_line(tty_t *tty)
         }
 }
 
+//==============================================================================
+/**
+ * @brief Shrinker callback: release scrollback lines of terminals that are not
+ *        currently displayed. Terminals in use are skipped.
+ *
+ * @param size          number of bytes to release
+ * @param arg           not used
+ *
+ * @return Number of released bytes.
+ */
+//==============================================================================
+static size_t shrink(size_t size, void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        size_t freed = 0;
+
+        for (int i = 0; (i < _TTY_NUMBER_OF_VT) && (freed < size); i++) {
+                tty_t *tty = tty_module->tty[i];
+
+                if (tty && (i != tty_module->current_tty)) {
+                        if (sys_mutex_trylock(tty->secure_mtx) == ESUCC) {
+                                freed += ttybfr_shrink(tty->screen, size - freed);
+                                sys_mutex_unlock(tty->secure_mtx);
+                        }
+                }
+        }
+
+        return freed;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -93,6 +93,7 @@ extern void             ttybfr_clear                    (ttybfr_t*);
 extern const char      *ttybfr_get_line                 (ttybfr_t*, int);
 extern const char      *ttybfr_get_fresh_line           (ttybfr_t*);
 extern void             ttybfr_clear_fresh_line_counter (ttybfr_t*);
+extern size_t           ttybfr_shrink                   (ttybfr_t*, size_t);
 
 /* editline support --------------------------------------------------------- */
 extern int              ttyedit_create                  (FILE*, ttyedit_t**);
@@ -414,6 +414,34 @@ void ttybfr_flush(ttybfr_t *this)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Release the oldest lines (scrollback) to free memory. Two the newest
+ *         lines are never released.
+ * @param  this          buffer object
+ * @param  size          number of bytes to release
+ * @return Number of released bytes (approximate)
+ */
+//==============================================================================
+size_t ttybfr_shrink(ttybfr_t *this, size_t size)
+{
+        size_t freed = 0;
+
+        if (is_valid(this)) {
+                for (int i = _TTY_TERMINAL_ROWS - 1; (i >= 2) && (freed < size); i--) {
+                        uint idx = get_line_index(this, i);
+                        if (this->line[idx]) {
+                                freed += strlen(this->line[idx]) + 1;
+                                sys_free(cast(void**, &this->line[idx]));
+                                this->line[idx]       = NULL;
+                                this->fresh_line[idx] = false;
+                        }
+                }
+        }
+
+        return freed;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
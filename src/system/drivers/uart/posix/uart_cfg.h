@@ -0,0 +1,79 @@
+/*=========================================================================*//**
+@file    uart_cfg.h
+
+@author  Daniel Zorychta
+
+@brief   This file support configuration of UART (host console)
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _UART_CFG_H_
+#define _UART_CFG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+
+/*==============================================================================
+  Exported symbolic constants/macros
+==============================================================================*/
+/* RX buffer size [B] */
+#define _UART_RX_BUFFER_SIZE                    __UART_RX_BUFFER_LEN__
+
+/* input poll interval [ms] */
+#define _UART_POLL_INTERVAL                     __UART_POLL_INTERVAL__
+
+/* UART default configuration (not used by host console) */
+#define _UART_DEFAULT_PARITY                    UART_PARITY__OFF
+#define _UART_DEFAULT_STOP_BITS                 UART_STOP_BIT__1
+#define _UART_DEFAULT_LIN_BREAK_LEN             UART_LIN_BREAK__10_BITS
+#define _UART_DEFAULT_TX_ENABLE                 _YES_
+#define _UART_DEFAULT_RX_ENABLE                 _YES_
+#define _UART_DEFAULT_LIN_MODE_ENABLE           _NO_
+#define _UART_DEFAULT_HW_FLOW_CTRL              _NO_
+#define _UART_DEFAULT_SINGLE_WIRE_MODE          _NO_
+#define _UART_DEFAULT_BAUD                      115200
+
+/*==============================================================================
+  Exported types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Exported object declarations
+==============================================================================*/
+
+/*==============================================================================
+  Exported function prototypes
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UART_CFG_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,222 @@
+/*=========================================================================*//**
+@file    uart_lld.c
+
+@author  Daniel Zorychta
+
+@brief   UART driver for host console (standard input and output)
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/driver.h"
+#if defined(ARCH_posix)
+#include "uart.h"
+#include "uart_ioctl.h"
+#include "posix/uart_cfg.h"
+#include "posix/host.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define RX_CHUNK_SIZE                   32
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void rx_thread(void *arg);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static const thread_attr_t RX_THREAD_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = true
+};
+
+static tid_t RX_thread[_UART_COUNT];
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief Function connect UART to host console and start input thread.
+ *
+ * @param major         UART number
+ *
+ * @return One of errno value
+ */
+//==============================================================================
+int _UART_LLD__turn_on(u8_t major)
+{
+        if (sys_thread_is_valid(RX_thread[major])) {
+                return EADDRINUSE;
+        }
+
+        if (_host_console_open() != 0) {
+                return EIO;
+        }
+
+        int err = sys_thread_create(rx_thread, &RX_THREAD_ATTR,
+                                    cast(void*, cast(uintptr_t, major)),
+                                    &RX_thread[major]);
+        if (err) {
+                _host_console_close();
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function stop input thread and restore host console.
+ *
+ * @param major         UART number
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _UART_LLD__turn_off(u8_t major)
+{
+        if (sys_thread_is_valid(RX_thread[major])) {
+                sys_thread_destroy(RX_thread[major]);
+                RX_thread[major] = 0;
+        }
+
+        _host_console_close();
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Function transmit currently setup buffer. Data is written to host
+ *        standard output at once.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__transmit(u8_t major)
+{
+        struct UART_mem *hdl = _UART_mem[major];
+
+        if (_host_console_write(hdl->Tx_buffer.src_ptr, hdl->Tx_buffer.data_size) == 0) {
+                hdl->Tx_buffer.data_size = 0;
+                hdl->Tx_buffer.src_ptr   = NULL;
+                sys_semaphore_signal(hdl->write_ready_sem);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function abort pending transmission.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__abort_trasmission(u8_t major)
+{
+        UNUSED_ARG1(major);
+}
+
+//==============================================================================
+/**
+ * @brief Function resume byte receiving.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__rx_resume(u8_t major)
+{
+        UNUSED_ARG1(major);
+        sys_critical_section_end();
+}
+
+//==============================================================================
+/**
+ * @brief Function hold byte receiving. Input thread writes to Rx FIFO in
+ *        critical section, so critical section holds receiving.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__rx_hold(u8_t major)
+{
+        UNUSED_ARG1(major);
+        sys_critical_section_begin();
+}
+
+//==============================================================================
+/**
+ * @brief Function configure selected UART. Host console has no line settings.
+ *
+ * @param major         major device number
+ * @param config        configuration structure
+ */
+//==============================================================================
+void _UART_LLD__configure(u8_t major, const struct UART_config *config)
+{
+        UNUSED_ARG2(major, config);
+}
+
+//==============================================================================
+/**
+ * @brief Thread polls host standard input and puts received bytes to Rx FIFO.
+ *
+ * @param arg           major device number
+ */
+//==============================================================================
+static void rx_thread(void *arg)
+{
+        u8_t major = cast(uintptr_t, arg);
+        u8_t buf[RX_CHUNK_SIZE];
+
+        for (;;) {
+                int n = _host_console_read(buf, sizeof(buf));
+
+                if (n > 0) {
+                        for (int i = 0; i < n; i++) {
+                                sys_critical_section_begin();
+                                bool written = _UART_FIFO__write(&_UART_mem[major]->Rx_FIFO, &buf[i]);
+                                sys_critical_section_end();
+
+                                if (written) {
+                                        sys_semaphore_signal(_UART_mem[major]->data_read_sem);
+                                }
+                        }
+                } else {
+                        sys_sleep_ms(_UART_POLL_INTERVAL);
+                }
+        }
+}
+
+#endif
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -46,6 +46,8 @@
 #include "efr32/uart_cfg.h"
 #include "efr32/efr32xx.h"
 #include "efr32/lib/em_cmu.h"
+#elif defined(ARCH_posix)
+#include "posix/uart_cfg.h"
 #endif
 
 #ifdef __cplusplus
@@ -115,6 +117,11 @@ enum {
 };
 #elif defined(ARCH_efr32)
 #define _UART_COUNT USART_COUNT
+#elif defined(ARCH_posix)
+enum {
+        _UART0,
+        _UART_COUNT
+};
 #endif
 
 
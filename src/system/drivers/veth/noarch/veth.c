@@ -0,0 +1,1159 @@
+/*=========================================================================*//**
+@file    veth.c
+
+@author  Daniel Zorychta
+
+@brief   Virtual Ethernet MAC driver.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/driver.h"
+#include "noarch/veth_cfg.h"
+#include "../veth_ioctl.h"
+#include "ethmac_ioctl.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define PCAP_MAGIC              0xA1B2C3D4
+#define PCAP_MAGIC_SWAPPED      0xD4C3B2A1
+#define PCAP_MAGIC_NS           0xA1B23C4D
+#define PCAP_MAGIC_NS_SWAPPED   0x4D3CB2A1
+#define PCAP_LINKTYPE_ETHERNET  1
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        u32_t magic;
+        u16_t version_major;
+        u16_t version_minor;
+        i32_t thiszone;
+        u32_t sigfigs;
+        u32_t snaplen;
+        u32_t network;
+} pcap_hdr_t;
+
+typedef struct {
+        u32_t ts_sec;
+        u32_t ts_usec;
+        u32_t incl_len;
+        u32_t orig_len;
+} pcap_rec_t;
+
+typedef struct {
+        u32_t tref;
+        u32_t delay;
+        u16_t size;
+        u8_t  data[_VETH_MAX_FRAME_SIZE];
+} frame_t;
+
+struct veth {
+        mutex_t       *rx_access;
+        mutex_t       *tx_access;
+        mutex_t       *pcap_access;
+        sem_t         *rx_ready;
+        sem_t         *replay_wake;
+        sem_t         *replay_done;
+        dev_lock_t     dev_lock;
+        u8_t           major;
+        u8_t           minor;
+        u8_t           MAC[6];
+        bool           started;
+        VETH_config_t  cfg;
+        u32_t          rand;
+        u32_t          tx_backlog_us;
+        VETH_stats_t   stats;
+        FILE          *capture;
+        FILE          *replay;
+        tid_t          replay_thread;
+        bool           replay_timing;
+        bool           replay_stop;
+        bool           replay_running;
+        size_t         rx_head;
+        size_t         rx_count;
+        frame_t        rx_queue[_VETH_RX_QUEUE_LEN];
+};
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int    transmit(struct veth *hdl, const ETHMAC_packet_chain_t *chain);
+static int    enqueue(u8_t major, u8_t minor, const ETHMAC_packet_chain_t *chain, u32_t delay);
+static int    dequeue(struct veth *hdl, void *dst, size_t *size);
+static size_t wait_for_packet(struct veth *hdl, u32_t timeout);
+static bool   is_lost(struct veth *hdl);
+static void   capture(struct veth *hdl, const ETHMAC_packet_chain_t *chain);
+static int    capture_start(struct veth *hdl, const char *path);
+static void   capture_stop(struct veth *hdl);
+static int    replay_start(struct veth *hdl, const VETH_replay_t *replay);
+static void   replay_stop(struct veth *hdl);
+static void   replay_thread(void *arg);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+MODULE_NAME(VETH);
+
+static struct veth *veth[_VETH_NUMBER_OF_PAIRS][2];
+
+static const thread_attr_t REPLAY_THREAD_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = true
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Initialize device
+ *
+ * @param[out]          **device_handle        device allocated memory
+ * @param[in ]            major                major device number
+ * @param[in ]            minor                minor device number
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_INIT(VETH, void **device_handle, u8_t major, u8_t minor)
+{
+        if (major >= _VETH_NUMBER_OF_PAIRS || minor > 1) {
+                return ENODEV;
+        }
+
+        if (veth[major][minor]) {
+                return EADDRINUSE;
+        }
+
+        int err = sys_zalloc(sizeof(struct veth), device_handle);
+        if (!err) {
+                struct veth *hdl = *device_handle;
+
+                err = sys_semaphore_create(1, 0, &hdl->rx_ready);
+                if (err != ESUCC)
+                        goto finish;
+
+                err = sys_semaphore_create(1, 0, &hdl->replay_wake);
+                if (err != ESUCC)
+                        goto finish;
+
+                err = sys_semaphore_create(1, 0, &hdl->replay_done);
+                if (err != ESUCC)
+                        goto finish;
+
+                err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->rx_access);
+                if (err != ESUCC)
+                        goto finish;
+
+                err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->tx_access);
+                if (err != ESUCC)
+                        goto finish;
+
+                err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->pcap_access);
+                if (err != ESUCC)
+                        goto finish;
+
+                hdl->major = major;
+                hdl->minor = minor;
+                hdl->rand  = 1;
+
+                // locally administered address
+                hdl->MAC[0] = 0x02;
+                hdl->MAC[4] = major;
+                hdl->MAC[5] = minor;
+
+                sys_critical_section_begin();
+                veth[major][minor] = hdl;
+                sys_critical_section_end();
+
+                finish:
+                if (err != ESUCC) {
+                        if (hdl->rx_ready)
+                                sys_semaphore_destroy(hdl->rx_ready);
+
+                        if (hdl->replay_wake)
+                                sys_semaphore_destroy(hdl->replay_wake);
+
+                        if (hdl->replay_done)
+                                sys_semaphore_destroy(hdl->replay_done);
+
+                        if (hdl->rx_access)
+                                sys_mutex_destroy(hdl->rx_access);
+
+                        if (hdl->tx_access)
+                                sys_mutex_destroy(hdl->tx_access);
+
+                        if (hdl->pcap_access)
+                                sys_mutex_destroy(hdl->pcap_access);
+
+                        sys_free(device_handle);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Release device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_RELEASE(VETH, void *device_handle)
+{
+        struct veth *hdl = device_handle;
+
+        int err = sys_device_lock(&hdl->dev_lock);
+        if (!err) {
+                replay_stop(hdl);
+                capture_stop(hdl);
+
+                // peer can not deliver frames after this point
+                sys_critical_section_begin();
+                veth[hdl->major][hdl->minor] = NULL;
+                sys_critical_section_end();
+
+                sys_semaphore_destroy(hdl->rx_ready);
+                sys_semaphore_destroy(hdl->replay_wake);
+                sys_semaphore_destroy(hdl->replay_done);
+                sys_mutex_destroy(hdl->rx_access);
+                sys_mutex_destroy(hdl->tx_access);
+                sys_mutex_destroy(hdl->pcap_access);
+                sys_free(&device_handle);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Open device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           flags                  file operation flags (O_RDONLY, O_WRONLY, O_RDWR)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_OPEN(VETH, void *device_handle, u32_t flags)
+{
+        UNUSED_ARG1(flags);
+
+        struct veth *hdl = device_handle;
+
+        return sys_device_lock(&hdl->dev_lock);
+}
+
+//==============================================================================
+/**
+ * @brief Close device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           force                  device force close (true)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_CLOSE(VETH, void *device_handle, bool force)
+{
+        struct veth *hdl = device_handle;
+
+        int err = sys_device_get_access(&hdl->dev_lock);
+
+        if (!err) {
+                err = sys_device_unlock(&hdl->dev_lock, force);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Write data to device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]          *src                    data source
+ * @param[in ]           count                  number of bytes to write
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *wrcnt                  number of written bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_WRITE(VETH,
+              void             *device_handle,
+              const u8_t       *src,
+              size_t            count,
+              fpos_t           *fpos,
+              size_t           *wrcnt,
+              struct vfs_fattr  fattr)
+{
+        UNUSED_ARG2(fpos, fattr);
+
+        struct veth *hdl = device_handle;
+
+        int err = ESUCC;
+
+        *wrcnt = 0;
+
+        while (!err && count) {
+                ETHMAC_packet_chain_t chain;
+                chain.next         = NULL;
+                chain.payload      = src;
+                chain.total_size   = min(count, _VETH_MAX_FRAME_SIZE);
+                chain.payload_size = chain.total_size;
+
+                err = transmit(hdl, &chain);
+                if (!err) {
+                        *wrcnt += chain.total_size;
+                        src    += chain.total_size;
+                        count  -= chain.total_size;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Read data from device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *dst                    data destination
+ * @param[in ]           count                  number of bytes to read
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *rdcnt                  number of read bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_READ(VETH,
+             void            *device_handle,
+             u8_t            *dst,
+             size_t           count,
+             fpos_t          *fpos,
+             size_t          *rdcnt,
+             struct vfs_fattr fattr)
+{
+        UNUSED_ARG1(fpos);
+
+        struct veth *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->rx_access, fattr.non_blocking_rd ? 0 : MAX_DELAY_MS);
+        if (!err) {
+                *rdcnt = 0;
+
+                if (wait_for_packet(hdl, fattr.non_blocking_rd ? 0 : MAX_DELAY_MS)) {
+                        *rdcnt = count;
+                        err    = dequeue(hdl, dst, rdcnt);
+                }
+
+                sys_mutex_unlock(hdl->rx_access);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief IO control
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           request                request
+ * @param[in ][out]     *arg                    request's argument
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_IOCTL(VETH, void *device_handle, int request, void *arg)
+{
+        struct veth *hdl = device_handle;
+
+        int err = EINVAL;
+
+        switch (request) {
+        case IOCTL_ETHMAC__WAIT_FOR_PACKET:
+                if (arg) {
+                        ETHMAC_packet_wait_t *pw = cast(ETHMAC_packet_wait_t*, arg);
+                        pw->pkt_size = wait_for_packet(hdl, pw->timeout);
+                        err = ESUCC;
+                }
+                break;
+
+        case IOCTL_ETHMAC__SET_MAC_ADDR:
+                if (arg) {
+                        memcpy(hdl->MAC, arg, sizeof(hdl->MAC));
+                        err = ESUCC;
+                }
+                break;
+
+        case IOCTL_ETHMAC__GET_MAC_ADDR:
+                if (arg) {
+                        memcpy(arg, hdl->MAC, sizeof(hdl->MAC));
+                        err = ESUCC;
+                }
+                break;
+
+        case IOCTL_ETHMAC__SEND_PACKET:
+                if (arg) {
+                        ETHMAC_packet_t *pkt = arg;
+
+                        ETHMAC_packet_chain_t chain;
+                        chain.next         = NULL;
+                        chain.payload      = pkt->payload;
+                        chain.total_size   = pkt->payload_size;
+                        chain.payload_size = pkt->payload_size;
+
+                        err = transmit(hdl, &chain);
+                }
+                break;
+
+        case IOCTL_ETHMAC__SEND_PACKET_FROM_CHAIN:
+                if (arg) {
+                        err = transmit(hdl, arg);
+                }
+                break;
+
+        case IOCTL_ETHMAC__RECEIVE_PACKET:
+                if (arg) {
+                        ETHMAC_packet_t *pkt = arg;
+
+                        err = sys_mutex_lock(hdl->rx_access, MAX_DELAY_MS);
+                        if (!err) {
+                                size_t size = pkt->payload_size;
+
+                                if (pkt->payload && wait_for_packet(hdl, MAX_DELAY_MS)) {
+                                        err = dequeue(hdl, pkt->payload, &size);
+                                } else {
+                                        err = EINVAL;
+                                }
+
+                                sys_mutex_unlock(hdl->rx_access);
+                        }
+                }
+                break;
+
+        case IOCTL_ETHMAC__RECEIVE_PACKETS:
+                if (arg) {
+                        ETHMAC_packet_batch_t *batch = arg;
+
+                        err = sys_mutex_lock(hdl->rx_access, MAX_DELAY_MS);
+                        if (!err) {
+                                batch->received = 0;
+                                batch->dropped  = 0;
+
+                                while (batch->received < batch->count) {
+                                        ETHMAC_packet_t *pkt  = &batch->packet[batch->received];
+                                        size_t           size = pkt->payload_size;
+
+                                        int r = dequeue(hdl, pkt->payload, &size);
+                                        if (r == ESUCC) {
+                                                pkt->payload_size = size;
+                                                batch->received++;
+
+                                        } else if (r == EFBIG) {
+                                                batch->dropped++;
+
+                                        } else {
+                                                break;
+                                        }
+                                }
+
+                                sys_mutex_unlock(hdl->rx_access);
+                        }
+                }
+                break;
+
+        case IOCTL_ETHMAC__ETHERNET_START:
+                hdl->started = true;
+                err = ESUCC;
+                break;
+
+        case IOCTL_ETHMAC__ETHERNET_STOP:
+                hdl->started = false;
+                err = ESUCC;
+                break;
+
+        case IOCTL_ETHMAC__GET_LINK_STATUS:
+                if (arg) {
+                        ETHMAC_link_status_t *linkstat = cast(ETHMAC_link_status_t*, arg);
+
+                        sys_critical_section_begin();
+                        struct veth *peer = veth[hdl->major][hdl->minor ^ 1];
+                        bool connected = (peer && peer->started) || hdl->replay;
+                        sys_critical_section_end();
+
+                        *linkstat = connected ? ETHMAC_LINK_STATUS__CONNECTED
+                                              : ETHMAC_LINK_STATUS__DISCONNECTED;
+                        err = ESUCC;
+                }
+                break;
+
+        case IOCTL_VETH__CONFIGURE:
+                if (arg) {
+                        const VETH_config_t *cfg = arg;
+
+                        if (cfg->loss_permille <= 1000) {
+                                err = sys_mutex_lock(hdl->tx_access, MAX_DELAY_MS);
+                                if (!err) {
+                                        hdl->cfg           = *cfg;
+                                        hdl->rand          = cfg->seed ? cfg->seed : 1;
+                                        hdl->tx_backlog_us = 0;
+                                        sys_mutex_unlock(hdl->tx_access);
+                                }
+                        }
+                }
+                break;
+
+        case IOCTL_VETH__CAPTURE_START:
+                if (arg) {
+                        err = capture_start(hdl, arg);
+                }
+                break;
+
+        case IOCTL_VETH__CAPTURE_STOP:
+                capture_stop(hdl);
+                err = ESUCC;
+                break;
+
+        case IOCTL_VETH__REPLAY_START:
+                if (arg) {
+                        err = replay_start(hdl, arg);
+                }
+                break;
+
+        case IOCTL_VETH__REPLAY_STOP:
+                replay_stop(hdl);
+                err = ESUCC;
+                break;
+
+        case IOCTL_VETH__GET_STATS:
+                if (arg) {
+                        sys_critical_section_begin();
+                        *cast(VETH_stats_t*, arg) = hdl->stats;
+                        sys_critical_section_end();
+                        err = ESUCC;
+                }
+                break;
+
+        default:
+                err = EBADRQC;
+                break;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Flush device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_FLUSH(VETH, void *device_handle)
+{
+        struct veth *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->pcap_access, MAX_DELAY_MS);
+        if (!err) {
+                if (hdl->capture) {
+                        err = sys_fflush(hdl->capture);
+                }
+
+                sys_mutex_unlock(hdl->pcap_access);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Device information
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *device_stat            device status
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_STAT(VETH, void *device_handle, struct vfs_dev_stat *device_stat)
+{
+        struct veth *hdl = device_handle;
+
+        device_stat->st_size  = 0;
+        device_stat->st_major = hdl->major;
+        device_stat->st_minor = hdl->minor;
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Function sends frame to the peer interface. Frame is delayed by
+ *         bandwidth limit and can be dropped by loss generator.
+ * @param  hdl          interface
+ * @param  chain        frame chain
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int transmit(struct veth *hdl, const ETHMAC_packet_chain_t *chain)
+{
+        if (chain->total_size == 0 || chain->total_size > _VETH_MAX_FRAME_SIZE) {
+                return EINVAL;
+        }
+
+        if (!hdl->started) {
+                return EIO;
+        }
+
+        int err = sys_mutex_lock(hdl->tx_access, MAX_DELAY_MS);
+        if (!err) {
+                if (hdl->cfg.bandwidth_kbps) {
+                        hdl->tx_backlog_us += (chain->total_size * 8 * 1000)
+                                            / hdl->cfg.bandwidth_kbps;
+
+                        if (hdl->tx_backlog_us >= 1000) {
+                                sys_sleep_ms(hdl->tx_backlog_us / 1000);
+                                hdl->tx_backlog_us %= 1000;
+                        }
+                }
+
+                capture(hdl, chain);
+
+                if (is_lost(hdl)) {
+                        hdl->stats.tx_lost++;
+                } else {
+                        err = enqueue(hdl->major, hdl->minor ^ 1, chain,
+                                      hdl->cfg.latency_ms);
+
+                        // frame sent to inactive or overloaded peer is lost
+                        // as on the wire (overflow is counted by the peer)
+                        if ((err == ENODEV) || (err == ENOSPC)) {
+                                err = ESUCC;
+                        }
+                }
+
+                if (!err) {
+                        hdl->stats.tx_packets++;
+                        hdl->stats.tx_bytes += chain->total_size;
+                }
+
+                sys_mutex_unlock(hdl->tx_access);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function puts frame to the receive queue of selected interface.
+ *         Interface is accessed in critical section because can be released
+ *         at any time. Frame sent to reflecting interface is put to the
+ *         receive queue of its peer.
+ * @param  major        interface pair
+ * @param  minor        interface in pair
+ * @param  chain        frame chain
+ * @param  delay        frame delay [ms]
+ * @return ESUCC if frame was queued, ENODEV if interface does not exist or is
+ *         stopped, ENOSPC if queue is full (frame dropped).
+ */
+//==============================================================================
+static int enqueue(u8_t major, u8_t minor, const ETHMAC_packet_chain_t *chain, u32_t delay)
+{
+        int err = ENODEV;
+
+        sys_critical_section_begin();
+
+        struct veth *hdl = veth[major][minor];
+
+        // reflecting interface sends frame back to the peer
+        if (hdl && hdl->cfg.reflect) {
+                hdl = veth[major][minor ^ 1];
+        }
+
+        if (hdl && hdl->started) {
+                if (hdl->rx_count < _VETH_RX_QUEUE_LEN) {
+                        size_t   idx   = (hdl->rx_head + hdl->rx_count) % _VETH_RX_QUEUE_LEN;
+                        frame_t *frame = &hdl->rx_queue[idx];
+                        size_t   size  = 0;
+
+                        for (const ETHMAC_packet_chain_t *link = chain;
+                             link && size < chain->total_size;
+                             link = link->next) {
+
+                                size_t n = min(link->payload_size,
+                                               chain->total_size - size);
+
+                                if (link->payload) {
+                                        memcpy(&frame->data[size], link->payload, n);
+                                        size += n;
+                                }
+                        }
+
+                        frame->tref  = sys_time_get_reference();
+                        frame->delay = delay;
+                        frame->size  = size;
+
+                        hdl->rx_count++;
+
+                        sys_semaphore_signal(hdl->rx_ready);
+
+                        err = ESUCC;
+                } else {
+                        hdl->stats.rx_overflow++;
+                        err = ENOSPC;
+                }
+        }
+
+        sys_critical_section_end();
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function gets first frame from the receive queue if frame delay
+ *         expired. Frame bigger than buffer is discarded. Function should be
+ *         called with rx_access locked.
+ * @param  hdl          interface
+ * @param  dst          destination buffer
+ * @param  size         [in] buffer size, [out] frame size
+ * @return ESUCC if frame was received, EAGAIN if queue is empty, EFBIG if
+ *         frame was discarded.
+ */
+//==============================================================================
+static int dequeue(struct veth *hdl, void *dst, size_t *size)
+{
+        frame_t *frame = NULL;
+
+        sys_critical_section_begin();
+        if (hdl->rx_count > 0) {
+                frame_t *head = &hdl->rx_queue[hdl->rx_head];
+                if (sys_time_is_expired(head->tref, head->delay)) {
+                        frame = head;
+                }
+        }
+        sys_critical_section_end();
+
+        if (frame == NULL) {
+                return EAGAIN;
+        }
+
+        // head frame is not modified by sender until queue index is moved
+        int err = EFBIG;
+
+        if (dst && frame->size <= *size) {
+                memcpy(dst, frame->data, frame->size);
+                *size = frame->size;
+
+                ETHMAC_packet_chain_t chain;
+                chain.next         = NULL;
+                chain.payload      = frame->data;
+                chain.total_size   = frame->size;
+                chain.payload_size = frame->size;
+                capture(hdl, &chain);
+
+                err = ESUCC;
+        }
+
+        sys_critical_section_begin();
+        hdl->rx_head = (hdl->rx_head + 1) % _VETH_RX_QUEUE_LEN;
+        hdl->rx_count--;
+
+        if (!err) {
+                hdl->stats.rx_packets++;
+                hdl->stats.rx_bytes += *size;
+        }
+        sys_critical_section_end();
+
+        // replay thread waits for free space in queue
+        if (hdl->replay) {
+                sys_semaphore_signal(hdl->replay_wake);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function waits for a frame and return a size of received frame.
+ * @param  hdl          interface
+ * @param  timeout      frame wait timeout
+ * @return Size of received frame, 0 if timeout.
+ */
+//==============================================================================
+static size_t wait_for_packet(struct veth *hdl, u32_t timeout)
+{
+        u32_t tref = sys_time_get_reference();
+
+        for (;;) {
+                size_t size    = 0;
+                u32_t  delayed = MAX_DELAY_MS;
+
+                sys_critical_section_begin();
+                if (hdl->rx_count > 0) {
+                        frame_t *head = &hdl->rx_queue[hdl->rx_head];
+                        u32_t    age  = sys_time_diff(sys_time_get_reference(), head->tref);
+                        if (age >= head->delay) {
+                                size = head->size;
+                        } else {
+                                delayed = head->delay - age;
+                        }
+                }
+                sys_critical_section_end();
+
+                if (size || sys_time_is_expired(tref, timeout)) {
+                        return size;
+                }
+
+                // wake up when new frame is queued or head frame delay expires
+                u32_t left = timeout - sys_time_diff(sys_time_get_reference(), tref);
+                sys_semaphore_wait(hdl->rx_ready, min(left, delayed));
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function decides if transmitted frame is lost. Generator is
+ *         xorshift32 seeded by configuration, thus loss pattern is repeatable.
+ * @param  hdl          interface
+ * @return If frame is lost then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool is_lost(struct veth *hdl)
+{
+        if (hdl->cfg.loss_permille == 0) {
+                return false;
+        }
+
+        u32_t x = hdl->rand;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        hdl->rand = x;
+
+        return (x % 1000) < hdl->cfg.loss_permille;
+}
+
+//==============================================================================
+/**
+ * @brief  Function writes frame to the capture file (if capture is active).
+ * @param  hdl          interface
+ * @param  chain        frame chain
+ */
+//==============================================================================
+static void capture(struct veth *hdl, const ETHMAC_packet_chain_t *chain)
+{
+        if (hdl->capture == NULL) {
+                return;
+        }
+
+        if (sys_mutex_lock(hdl->pcap_access, MAX_DELAY_MS) == ESUCC) {
+                if (hdl->capture) {
+                        u32_t uptime = sys_get_uptime_ms();
+
+                        pcap_rec_t rec;
+                        rec.ts_sec   = uptime / 1000;
+                        rec.ts_usec  = (uptime % 1000) * 1000;
+                        rec.incl_len = chain->total_size;
+                        rec.orig_len = chain->total_size;
+
+                        size_t wrcnt;
+                        sys_fwrite(&rec, sizeof(rec), &wrcnt, hdl->capture);
+
+                        size_t size = 0;
+                        for (const ETHMAC_packet_chain_t *link = chain;
+                             link && size < chain->total_size;
+                             link = link->next) {
+
+                                size_t n = min(link->payload_size,
+                                               chain->total_size - size);
+
+                                if (link->payload) {
+                                        sys_fwrite(link->payload, n, &wrcnt,
+                                                   hdl->capture);
+                                        size += n;
+                                }
+                        }
+                }
+
+                sys_mutex_unlock(hdl->pcap_access);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function opens capture file and writes pcap header.
+ * @param  hdl          interface
+ * @param  path         file path
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int capture_start(struct veth *hdl, const char *path)
+{
+        int err = sys_mutex_lock(hdl->pcap_access, MAX_DELAY_MS);
+        if (!err) {
+                if (hdl->capture == NULL) {
+                        FILE *file;
+                        err = sys_fopen(path, "w", &file);
+                        if (!err) {
+                                pcap_hdr_t hdr;
+                                hdr.magic         = PCAP_MAGIC;
+                                hdr.version_major = 2;
+                                hdr.version_minor = 4;
+                                hdr.thiszone      = 0;
+                                hdr.sigfigs       = 0;
+                                hdr.snaplen       = _VETH_MAX_FRAME_SIZE;
+                                hdr.network       = PCAP_LINKTYPE_ETHERNET;
+
+                                size_t wrcnt;
+                                err = sys_fwrite(&hdr, sizeof(hdr), &wrcnt, file);
+                                if (!err) {
+                                        hdl->capture = file;
+                                } else {
+                                        sys_fclose(file);
+                                }
+                        }
+                } else {
+                        err = EBUSY;
+                }
+
+                sys_mutex_unlock(hdl->pcap_access);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function closes capture file.
+ * @param  hdl          interface
+ */
+//==============================================================================
+static void capture_stop(struct veth *hdl)
+{
+        if (sys_mutex_lock(hdl->pcap_access, MAX_DELAY_MS) == ESUCC) {
+                if (hdl->capture) {
+                        sys_fclose(hdl->capture);
+                        hdl->capture = NULL;
+                }
+
+                sys_mutex_unlock(hdl->pcap_access);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function opens replay file and starts replay thread.
+ * @param  hdl          interface
+ * @param  replay       replay configuration
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int replay_start(struct veth *hdl, const VETH_replay_t *replay)
+{
+        if (replay->path == NULL) {
+                return EINVAL;
+        }
+
+        if (hdl->replay && hdl->replay_running) {
+                return EBUSY;
+        }
+
+        // close file of finished replay
+        replay_stop(hdl);
+
+        int err = sys_fopen(replay->path, "r", &hdl->replay);
+        if (!err) {
+                hdl->replay_timing  = replay->keep_timing;
+                hdl->replay_stop    = false;
+                hdl->replay_running = true;
+
+                err = sys_thread_create(replay_thread, &REPLAY_THREAD_ATTR, hdl,
+                                        &hdl->replay_thread);
+                if (err) {
+                        hdl->replay_running = false;
+                        sys_fclose(hdl->replay);
+                        hdl->replay = NULL;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function stops replay thread and waits for its exit. Thread signals
+ *         replay_done once on exit, thus finished replay is not waited.
+ * @param  hdl          interface
+ */
+//==============================================================================
+static void replay_stop(struct veth *hdl)
+{
+        if (hdl->replay) {
+                hdl->replay_stop = true;
+                sys_semaphore_signal(hdl->replay_wake);
+                sys_semaphore_wait(hdl->replay_done, MAX_DELAY_MS);
+
+                sys_fclose(hdl->replay);
+                hdl->replay = NULL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function swaps bytes of 32-bit value.
+ * @param  val          value
+ * @return Swapped value.
+ */
+//==============================================================================
+static u32_t swap32(u32_t val)
+{
+        return ((val & 0x000000FF) << 24) | ((val & 0x0000FF00) << 8)
+             | ((val & 0x00FF0000) >> 8)  | ((val & 0xFF000000) >> 24);
+}
+
+//==============================================================================
+/**
+ * @brief  Thread reads frames from pcap file and puts them to the receive
+ *         queue of interface. If timing is not kept then thread waits for
+ *         free space in queue, thus no frame is lost.
+ * @param  arg          interface
+ */
+//==============================================================================
+static void replay_thread(void *arg)
+{
+        struct veth *hdl = arg;
+
+        u8_t *buf = NULL;
+        if (sys_malloc(_VETH_MAX_FRAME_SIZE, cast(void**, &buf)) != ESUCC) {
+                goto finish;
+        }
+
+        pcap_hdr_t hdr;
+        size_t     rdcnt = 0;
+        sys_fread(&hdr, sizeof(hdr), &rdcnt, hdl->replay);
+
+        bool swapped = (hdr.magic == PCAP_MAGIC_SWAPPED) || (hdr.magic == PCAP_MAGIC_NS_SWAPPED);
+        bool nsec    = (hdr.magic == PCAP_MAGIC_NS) || (hdr.magic == PCAP_MAGIC_NS_SWAPPED);
+
+        if (  rdcnt != sizeof(hdr)
+           || !(swapped || nsec || hdr.magic == PCAP_MAGIC)
+           || (swapped ? swap32(hdr.network) : hdr.network) != PCAP_LINKTYPE_ETHERNET) {
+                printk("VETH: not a pcap Ethernet file");
+                goto finish;
+        }
+
+        u32_t tref   = sys_time_get_reference();
+        u32_t ts0    = 0;
+        bool  first  = true;
+
+        while (!hdl->replay_stop) {
+                pcap_rec_t rec;
+                if (sys_fread(&rec, sizeof(rec), &rdcnt, hdl->replay) || rdcnt != sizeof(rec)) {
+                        break;
+                }
+
+                if (swapped) {
+                        rec.ts_sec   = swap32(rec.ts_sec);
+                        rec.ts_usec  = swap32(rec.ts_usec);
+                        rec.incl_len = swap32(rec.incl_len);
+                }
+
+                if (rec.incl_len > _VETH_MAX_FRAME_SIZE) {
+                        sys_fseek(hdl->replay, rec.incl_len, VFS_SEEK_CUR);
+                        continue;
+                }
+
+                if (  sys_fread(buf, rec.incl_len, &rdcnt, hdl->replay)
+                   || rdcnt != rec.incl_len) {
+                        break;
+                }
+
+                if (hdl->replay_timing) {
+                        u32_t ts = rec.ts_sec * 1000 + rec.ts_usec / (nsec ? 1000000 : 1000);
+
+                        if (first) {
+                                ts0   = ts;
+                                first = false;
+                        }
+
+                        int wait;
+                        while (  !hdl->replay_stop
+                              && (wait = (ts - ts0) - sys_time_diff(sys_time_get_reference(), tref)) > 0) {
+
+                                sys_semaphore_wait(hdl->replay_wake, wait);
+                        }
+                }
+
+                ETHMAC_packet_chain_t chain;
+                chain.next         = NULL;
+                chain.payload      = buf;
+                chain.total_size   = rec.incl_len;
+                chain.payload_size = rec.incl_len;
+
+                // woken up by dequeue() or replay_stop()
+                while (  !hdl->replay_timing && !hdl->replay_stop
+                      && hdl->rx_count >= _VETH_RX_QUEUE_LEN) {
+
+                        sys_semaphore_wait(hdl->replay_wake, MAX_DELAY_MS);
+                }
+
+                if (!hdl->replay_stop) {
+                        enqueue(hdl->major, hdl->minor, &chain, 0);
+                }
+        }
+
+        finish:
+        if (buf) {
+                sys_free(cast(void**, &buf));
+        }
+
+        hdl->replay_running = false;
+        sys_semaphore_signal(hdl->replay_done);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
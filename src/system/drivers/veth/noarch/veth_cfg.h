@@ -0,0 +1,75 @@
+/*=========================================================================*//**
+@file    veth_cfg.h
+
+@author  Daniel Zorychta
+
+@brief   Virtual Ethernet MAC driver configuration.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _VETH_CFG_H_
+#define _VETH_CFG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/* number of interface pairs */
+#define _VETH_NUMBER_OF_PAIRS           __VETH_NUMBER_OF_PAIRS__
+
+/* receive queue length (frames) */
+#define _VETH_RX_QUEUE_LEN              __VETH_RX_QUEUE_LEN__
+
+/* maximum frame size (without CRC) */
+#define _VETH_MAX_FRAME_SIZE            1518
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VETH_CFG_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,232 @@
+/*=========================================================================*//**
+@file    veth_ioctl.h
+
+@author  Daniel Zorychta
+
+@brief   Virtual Ethernet MAC driver.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+@defgroup drv-veth VETH Driver
+
+\section drv-veth-desc Description
+Driver creates virtual Ethernet interfaces that do not require any hardware.
+Interfaces are created in pairs connected back-to-back: frame sent by one
+interface is received by the other one. Driver handles all @ref drv-ethmac
+requests, so it can be used by the TCP/IP stack instead of the ETHMAC driver.
+
+Each interface can shape transmitted traffic (latency, loss, and bandwidth),
+capture all transmitted and received frames to a pcap file, and replay frames
+from a pcap file as if they were received from the wire. Loss is generated by
+a pseudo-random generator with configured seed, thus results are repeatable.
+
+Interface can also reflect received frames back to the peer. In this mode the
+TCP/IP stack connected to the peer receives its own frames, so the stack can
+exchange data with its own address through the whole driver path (used by
+network benchmarks).
+
+Interface does not emulate checksum offload of Ethernet MAC, thus checksum
+generation (CHECKSUM_GEN_*) should be enabled in the TCP/IP stack
+configuration, otherwise all received IP packets are dropped by checksum check.
+
+\section drv-veth-sup-arch Supported architectures
+\li Any (noarch)
+
+\section drv-veth-ddesc Details
+\subsection drv-veth-ddesc-num Meaning of major and minor numbers
+The major number determines interface pair. The minor number selects end of
+the pair (0 or 1).
+
+\subsubsection drv-veth-ddesc-numres Numeration restrictions
+The major number can be set up to __VETH_NUMBER_OF_PAIRS__ - 1. The minor
+number can be 0 or 1.
+
+\subsection drv-veth-ddesc-init Driver initialization
+To initialize driver the following code can be used:
+
+@code
+driver_init("VETH", 0, 0, "/dev/eth0");         // used by TCP/IP stack
+driver_init("VETH", 0, 1, "/dev/veth0");        // used by benchmark application
+@endcode
+
+\subsection drv-veth-ddesc-release Driver release
+To release driver the following code can be used:
+@code
+driver_release("VETH", 0, 0);
+driver_release("VETH", 0, 1);
+@endcode
+
+\subsection drv-veth-ddesc-cfg Driver configuration
+Number of pairs and receive queue length are configured by using
+configuration files in the <tt>./config</tt> directory or by using Configtool.
+Traffic shaping is configured at runtime by @ref IOCTL_VETH__CONFIGURE.
+
+\subsection drv-veth-ddesc-write Data write
+Single write operation sends single frame (up to 1518 bytes).
+
+\subsection drv-veth-ddesc-read Data read
+Single read operation receives single frame. Buffer should have size of
+maximum frame.
+
+\subsection drv-veth-ddesc-pcap Capture and replay
+@code
+#include <stdio.h>
+#include <sys/ioctl.h>
+
+// ...
+
+FILE *dev = fopen("/dev/veth0", "r+");
+if (dev) {
+        VETH_config_t cfg = {
+                .latency_ms     = 2,
+                .loss_permille  = 10,
+                .bandwidth_kbps = 10000,
+                .seed           = 1
+        };
+
+        ioctl(fileno(dev), IOCTL_VETH__CONFIGURE, &cfg);
+        ioctl(fileno(dev), IOCTL_VETH__CAPTURE_START, "/mnt/capture.pcap");
+
+        VETH_replay_t replay = {.path = "/mnt/traffic.pcap", .keep_timing = true};
+        ioctl(fileno(dev), IOCTL_VETH__REPLAY_START, &replay);
+
+        // ...
+
+        ioctl(fileno(dev), IOCTL_VETH__CAPTURE_STOP);
+        fclose(dev);
+}
+@endcode
+
+@{
+*/
+
+#ifndef _VETH_IOCTL_H_
+#define _VETH_IOCTL_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/ioctl_macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/**
+ * @brief  Set traffic shaping of transmitted frames.
+ * @param  [WR] @ref VETH_config_t*     configuration.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__CONFIGURE           _IOW(VETH, 0x00, const VETH_config_t*)
+
+/**
+ * @brief  Start capture of transmitted and received frames to pcap file.
+ * @param  [WR] const char*     file path.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__CAPTURE_START       _IOW(VETH, 0x01, const char*)
+
+/**
+ * @brief  Stop capture and close pcap file.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__CAPTURE_STOP        _IO(VETH, 0x02)
+
+/**
+ * @brief  Start replay of pcap file. Frames are received by this interface.
+ * @param  [WR] @ref VETH_replay_t*     replay configuration.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__REPLAY_START        _IOW(VETH, 0x03, const VETH_replay_t*)
+
+/**
+ * @brief  Stop replay.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__REPLAY_STOP         _IO(VETH, 0x04)
+
+/**
+ * @brief  Get interface statistics.
+ * @param  [RD] @ref VETH_stats_t*      statistics.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VETH__GET_STATS           _IOR(VETH, 0x05, VETH_stats_t*)
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/**
+ * Traffic shaping of transmitted frames. Zero value disables selected feature.
+ */
+typedef struct {
+        u32_t latency_ms;       /*!< Delay of each frame.*/
+        u16_t loss_permille;    /*!< Frame loss probability (0-1000).*/
+        u32_t bandwidth_kbps;   /*!< Link bandwidth in kbit/s.*/
+        u32_t seed;             /*!< Seed of loss generator.*/
+        bool  reflect;          /*!< Frames received by this interface are sent back to the peer.*/
+} VETH_config_t;
+
+/**
+ * Replay configuration.
+ */
+typedef struct {
+        const char *path;       /*!< pcap file path.*/
+        bool        keep_timing;/*!< Keep inter-frame gaps from file (otherwise as fast as possible).*/
+} VETH_replay_t;
+
+/**
+ * Interface statistics.
+ */
+typedef struct {
+        u64_t tx_packets;       /*!< Transmitted frames.*/
+        u64_t tx_bytes;         /*!< Transmitted bytes.*/
+        u64_t rx_packets;       /*!< Received frames.*/
+        u64_t rx_bytes;         /*!< Received bytes.*/
+        u64_t tx_lost;          /*!< Frames dropped by loss generator.*/
+        u64_t rx_overflow;      /*!< Frames dropped because receive queue was full.*/
+} VETH_stats_t;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VETH_IOCTL_H_ */
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
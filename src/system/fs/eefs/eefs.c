@@ -64,11 +64,9 @@ Brief    EEPROM File System. File system for small memories 1-64KiB EEPROM.
 
 #define NAME_LEN                        21      // note: modify with care
 
-#define cache_get_block(sys_cache)      cast(block_cached_t*, &sys_cache[1])->block
-#define cache_get_block_num(sys_cache)  cast(block_cached_t*, &sys_cache[1])->block_num
-
 #define FLAG_SYNC                       (1<<0)
 #define FLAG_RDONLY                     (1<<1)
+#define FLAG_WEAR_DIRECT                (1<<2)
 
 #define block_is_dir(block_buf)         (block_buf.buf.dir.magic  == BLOCK_MAGIC_DIR)
 #define block_is_dir_entry(block_buf)   (block_buf.buf.dir_entry.magic  == BLOCK_MAGIC_DIR_ENTRY)
@@ -253,6 +251,10 @@ typedef struct {
         block_buf_t  block;
         block_buf_t  tmpblock;
         u8_t         flag;
+        u16_t        blocks;            //!< number of blocks on medium
+        u16_t        alloc_cursor;      //!< next block considered by allocator
+        u16_t        wear_floor;        //!< lowest write count seen in free blocks
+        u16_t       *wear;              //!< per-block write counters (RAM only)
 } EEFS_t;
 
 /*==============================================================================
@@ -265,6 +267,9 @@ static bool is_entry_item_used(dir_entry_t *entry);
 static int block_load(EEFS_t *hdl, const char *path);
 static int block_load_by_type(EEFS_t *hdl, const char *path, uint32_t type);
 static int block_get_file_stat(EEFS_t *hdl, struct stat *stat);
+static void wear_leveling_init(EEFS_t *hdl);
+static void wear_count(void *arg, u32_t blkpos, size_t blkcnt);
+static void bmp_block_locate(uint16_t blknum, uint16_t *bmpblk, uint8_t *blkidx);
 static int bmp_block_find_empty(EEFS_t *hdl, uint16_t *blknum);
 static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate);
 static int bmp_block_alloc(EEFS_t *hdl, uint16_t blknum);
@@ -320,6 +325,8 @@ API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts)
                         goto finish;
                 }
 
+                sys_mutex_set_name(hdl->lock_mtx, "eefs");
+
                 hdl->block.num = MAIN_BLOCK_ADDR;
                 err = block_read(hdl, &hdl->block);
                 if (!err) {
@@ -329,6 +336,9 @@ API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts)
                            && hdl->block.buf.main.bitmap_blocks <= 64 ) {
 
                                 hdl->root_dir_block = 1 + hdl->block.buf.main.bitmap_blocks;
+                                hdl->blocks         = hdl->block.buf.main.blocks;
+
+                                wear_leveling_init(hdl);
 
                                 if (!isstrempty(opts)) {
                                         if (sys_stropt_is_flag(opts, "sync")) {
@@ -358,6 +368,10 @@ API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts)
                                 sys_mutex_destroy(hdl->lock_mtx);
                         }
 
+                        if (hdl->wear) {
+                                sys_free(cast(void*, &hdl->wear));
+                        }
+
                         sys_free(fs_handle);
                 }
         }
@@ -382,8 +396,13 @@ API_FS_RELEASE(eefs, void *fs_handle)
         if (!err) {
                 if ((hdl->open_files == NULL) && (hdl->open_dirs == NULL)) {
 
+                        // last cache flush is counted, so free counters after close
                         sys_fclose(hdl->srcdev);
 
+                        if (hdl->wear) {
+                                sys_free(cast(void*, &hdl->wear));
+                        }
+
                         mutex_t *mtx = hdl->lock_mtx;
 
                         memset(hdl, 0, sizeof(EEFS_t));
@@ -1377,9 +1396,9 @@ API_FS_FLUSH(eefs, void *fs_handle, void *fhdl)
 //==============================================================================
 API_FS_SYNC(eefs, void *fs_handle)
 {
-        UNUSED_ARG1(fs_handle);
+        EEFS_t *hdl = fs_handle;
 
-        return ESUCC;
+        return sys_cache_flush(hdl->srcdev);
 }
 
 //==============================================================================
@@ -1430,9 +1449,7 @@ static int block_read(EEFS_t *hdl, block_buf_t *blk)
 {
         memset(&blk->buf, 0, 128);
 
-        size_t rdcnt = 0;
-        sys_fseek(hdl->srcdev, blk->num * BLOCK_SIZE, SEEK_SET);
-        int err = sys_fread(&blk->buf, BLOCK_SIZE, &rdcnt, hdl->srcdev);
+        int err = sys_cache_read(hdl->srcdev, blk->num, BLOCK_SIZE, 1, &blk->buf);
 
         if (!err) {
                 u16_t chsum  = fletcher16(blk->buf.chsum.buf, sizeof(blk->buf.chsum.buf));
@@ -1468,9 +1485,14 @@ static int block_write(EEFS_t *hdl, block_buf_t *blk)
                                                      sizeof(blk->buf.chsum.buf))
                                         ^ blk->num;
 
-                size_t wrcnt = 0;
-                sys_fseek(hdl->srcdev, blk->num * BLOCK_SIZE, SEEK_SET);
-                return sys_fwrite(&blk->buf, BLOCK_SIZE, &wrcnt, hdl->srcdev);
+                // without cache each block write is a device write
+                if (hdl->flag & FLAG_WEAR_DIRECT) {
+                        wear_count(hdl, blk->num, 1);
+                }
+
+                return sys_cache_write(hdl->srcdev, blk->num, BLOCK_SIZE, 1, &blk->buf,
+                                       (hdl->flag & FLAG_SYNC) ? CACHE_WRITE_THROUGH
+                                                               : CACHE_WRITE_BACK);
         }
 }
 
@@ -1676,10 +1698,97 @@ static int block_get_file_stat(EEFS_t *hdl, struct stat *stat)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function prepare wear leveling of mounted medium. The allocation
+ *         cursor is seeded from the clock so that consecutive mounts do not
+ *         start allocating from the same block. Write counters are kept in
+ *         RAM only (on-medium format has no room for them) and count device
+ *         writes reported by the cache, so cached rewrites of the same block
+ *         are counted once per flush. If there is not enough memory then only
+ *         rotation of allocation cursor is used.
+ *
+ * @param  hdl          EEFS handle
+ */
+//==============================================================================
+static void wear_leveling_init(EEFS_t *hdl)
+{
+#if __EEFS_CFG_WEAR_LEVELING__ > 0
+        time_t t = 0;
+        sys_gettime(&t);
+
+        hdl->alloc_cursor = (cast(u32_t, t) ^ sys_get_uptime_ms()) % hdl->blocks;
+        hdl->wear_floor   = 0;
+
+        if (sys_zalloc(hdl->blocks * sizeof(u16_t), cast(void**, &hdl->wear))) {
+                DBG("not enough memory for write counters");
+                hdl->wear = NULL;
+
+        } else if (sys_cache_set_write_callback(hdl->srcdev, BLOCK_SIZE,
+                                                wear_count, hdl) != ESUCC) {
+                hdl->flag |= FLAG_WEAR_DIRECT;
+        }
+#else
+        UNUSED_ARG1(hdl);
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function count blocks written to the medium. Function is called by
+ *         the cache when blocks are physically written.
+ *
+ * @param  arg          EEFS handle
+ * @param  blkpos       first written block
+ * @param  blkcnt       number of written blocks
+ */
+//==============================================================================
+static void wear_count(void *arg, u32_t blkpos, size_t blkcnt)
+{
+        EEFS_t *hdl = arg;
+
+        for (size_t i = 0; hdl->wear && (i < blkcnt) && (blkpos + i < hdl->blocks); i++) {
+                if (hdl->wear[blkpos + i] < UINT16_MAX) {
+                        hdl->wear[blkpos + i]++;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function calculate position of block bit in bitmap.
+ *
+ * @param  blknum       block number
+ * @param  bmpblk       bitmap block (0: main block, 1..n: bitmap blocks)
+ * @param  blkidx       byte index in selected bitmap
+ */
+//==============================================================================
+static void bmp_block_locate(uint16_t blknum, uint16_t *bmpblk, uint8_t *blkidx)
+{
+        const size_t main_sz = sizeof(((block_main_t*)0)->bitmap);
+        const size_t bmp_sz  = sizeof(((block_bitmap_t*)0)->map);
+
+        size_t idx = blknum / BLOCKS_IN_BYTE;
+
+        if (idx < main_sz) {
+                *bmpblk = 0;
+                *blkidx = idx;
+        } else {
+                idx    -= main_sz;
+                *bmpblk = (idx / bmp_sz) + 1;
+                *blkidx = (idx % bmp_sz);
+        }
+}
+
 //==============================================================================
 /**
  * @brief  Function find empty block by using bitmap.
  *
+ *         Search starts at allocation cursor and wraps around the medium, so
+ *         consecutive allocations are spread over the whole memory. If write
+ *         counters are available, the least written free block is selected.
+ *         Without wear leveling the first free block is selected.
+ *
  * @param  hdl          EEFS handle
  * @param  blknum       found empty block
  *
@@ -1690,59 +1799,84 @@ static int bmp_block_find_empty(EEFS_t *hdl, uint16_t *blknum)
 {
         hdl->tmpblock.num = MAIN_BLOCK_ADDR;
         int err = block_read(hdl, &hdl->tmpblock);
-        if (!err) {
+        if (err) {
+                return err;
+        }
 
-                if (hdl->tmpblock.buf.main.magic != BLOCK_MAGIC_MAIN) {
-                        err = EILSEQ;
-                        goto finish;
-                }
+        if (hdl->tmpblock.buf.main.magic != BLOCK_MAGIC_MAIN) {
+                return EILSEQ;
+        }
 
-                uint16_t blks    = hdl->tmpblock.buf.main.blocks;
-                uint16_t bmpblks = hdl->tmpblock.buf.main.bitmap_blocks;
-                uint8_t *bmp     = hdl->tmpblock.buf.main.bitmap;
-                uint8_t  bsz     = sizeof(hdl->tmpblock.buf.main.bitmap);
-                uint8_t  bmpnext = 1;
+        u16_t blks    = hdl->tmpblock.buf.main.blocks;
+        u16_t bmpblks = hdl->tmpblock.buf.main.bitmap_blocks;
+        u16_t loaded  = 0;
+        u16_t found   = 0;
+        u16_t least   = UINT16_MAX;
+        u32_t start   = (hdl->alloc_cursor < blks) ? hdl->alloc_cursor : 0;
+        bool  scanned = true;
 
-                *blknum = 0;
+        for (u32_t n = 0; !err && (n < blks); n++) {
+                u16_t blk = (start + n) % blks;
+                u16_t bmpblk;
+                u8_t  blkidx;
 
-                do {
-                        for (u8_t i = 0; i < bsz && blks > 0; i++, blks -= 8) {
-                                if (bmp[i] == 0) {
-                                        continue;
-                                }
+                bmp_block_locate(blk, &bmpblk, &blkidx);
 
-                                for (u8_t bit = 0; bit < 8; bit++) {
-                                        if ((bmp[i] >> bit) & 1) {
-                                                *blknum += (i * 8) + bit;
-                                                goto finish;
-                                        }
-                                }
+                if (bmpblk > bmpblks) {
+                        continue;
+                }
+
+                if (bmpblk != loaded) {
+                        hdl->tmpblock.num = bmpblk;
+                        err = block_read(hdl, &hdl->tmpblock);
+                        if (err) {
+                                break;
+
+                        } else if (bmpblk && hdl->tmpblock.buf.bitmap.magic != BLOCK_MAGIC_BITMAP) {
+                                DBG("Invalid bitmap block");
+                                err = EILSEQ;
+                                break;
                         }
 
-                        if (bmpblks && blks > 0) {
-                                *blknum += (bsz * 8);
+                        loaded = bmpblk;
+                }
 
-                                hdl->tmpblock.num = bmpnext;
-                                err = block_read(hdl, &hdl->tmpblock);
-                                if (!err) {
-                                        if (hdl->block.buf.bitmap.magic == BLOCK_MAGIC_BITMAP) {
-                                                bmp = hdl->block.buf.bitmap.map;
-                                                bsz = sizeof(hdl->block.buf.bitmap.map);
-                                                bmpnext++;
-                                        } else {
-                                                DBG("Invalid bitmap block");
-                                                err = EILSEQ;
-                                        }
-                                }
+                u8_t *bmp = (bmpblk == 0) ? hdl->tmpblock.buf.main.bitmap
+                                          : hdl->tmpblock.buf.bitmap.map;
+
+                if (bmp[blkidx] & (1 << (blk % BLOCKS_IN_BYTE))) {
+
+                        u16_t wear = hdl->wear ? hdl->wear[blk] : 0;
+
+                        if (wear < least) {
+                                least = wear;
+                                found = blk;
                         }
 
-                        if (*blknum == 0) {
-                                err = ENOSPC;
+                        if (wear <= hdl->wear_floor) {
+                                scanned = false;
+                                break;
                         }
-                } while (!err && bmpblks--);
+                }
+        }
+
+        if (!err) {
+                if (found == 0) {
+                        err = ENOSPC;
+                } else {
+                        /*
+                         * When the whole medium was scanned, no free block has
+                         * fewer writes than selected one: next search can stop
+                         * at first block at this level.
+                         */
+                        if (scanned) {
+                                hdl->wear_floor = least;
+                        }
+
+                        *blknum = found;
+                }
         }
 
-        finish:
         return err;
 }
 
@@ -1773,17 +1907,14 @@ static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate)
                         goto finish;
                 }
 
-                u16_t bmpblk = 0;
-                u8_t  blkidx = (blknum / 8);
-                u8_t  blkbit = (blknum % 8);
+                u16_t bmpblk;
+                u8_t  blkidx;
+                u8_t  blkbit = (blknum % BLOCKS_IN_BYTE);
                 u8_t *bmp    = hdl->tmpblock.buf.main.bitmap;
 
-                if (blkidx >= sizeof(hdl->tmpblock.buf.main.bitmap)) {
+                bmp_block_locate(blknum, &bmpblk, &blkidx);
 
-                        blkidx -= sizeof(hdl->tmpblock.buf.main.bitmap);
-                        bmpblk  = (blkidx / sizeof(hdl->tmpblock.buf.bitmap.map));
-                        blkidx -= bmpblk * sizeof(hdl->tmpblock.buf.bitmap.map);
-                        bmpblk += 1;
+                if (bmpblk > 0) {
 
                         if (bmpblk <= hdl->tmpblock.buf.main.bitmap_blocks) {
                                 hdl->tmpblock.num = bmpblk;
@@ -1828,7 +1959,15 @@ static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate)
 //==============================================================================
 static int bmp_block_alloc(EEFS_t *hdl, uint16_t blknum)
 {
-        return bmp_block_alloc_ctrl(hdl, blknum, true);
+        int err = bmp_block_alloc_ctrl(hdl, blknum, true);
+
+#if __EEFS_CFG_WEAR_LEVELING__ > 0
+        if (!err) {
+                hdl->alloc_cursor = (blknum + 1) % hdl->blocks;
+        }
+#endif
+
+        return err;
 }
 
 //==============================================================================
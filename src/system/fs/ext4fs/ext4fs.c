@@ -36,6 +36,8 @@ Brief   EXT4 file system
 ==============================================================================*/
 #define SECTOR_SIZE     512
 #define LOCK_TIMEOUT    MAX_DELAY_MS
+#define READAHEAD       __EXT4FS_CFG_READAHEAD__
+#define WRITE_COALESCE  __EXT4FS_CFG_WRITE_COALESCE__
 
 /*==============================================================================
   Local object types
@@ -114,6 +116,13 @@ API_FS_INIT(ext4fs, void **fs_handle, const char *src_path, const char *opts)
                 err = sys_mutex_create(MUTEX_TYPE_RECURSIVE, cast(mutex_t**, &hdl->fs_mutex));
                 if (err) goto finish;
 
+                sys_mutex_set_name(hdl->fs_mutex, "ext4fs");
+
+                err = sys_cache_configure(hdl->dev, SECTOR_SIZE,
+                                          sys_stropt_get_int(opts, "readahead", READAHEAD),
+                                          sys_stropt_get_int(opts, "coalesce", WRITE_COALESCE));
+                if (err) goto finish;
+
                 hdl->bdif.open     = bopen;
                 hdl->bdif.bread    = bread;
                 hdl->bdif.bwrite   = bwrite;
@@ -768,6 +777,10 @@ API_FS_SYNC(ext4fs, void *fs_handle)
                 ext4_cache_write_back(true, hdl->mp);
         }
 
+        if (!err) {
+                err = sys_cache_flush(hdl->dev);
+        }
+
         return err;
 }
 
@@ -847,9 +860,7 @@ static int bread(struct ext4_blockdev *bdev, void *buf, uint64_t blk_id, uint32_
 {
         ext4fs_t *hdl = bdev->bdif->p_user;
 
-        size_t rdcnt = 0;
-        sys_fseek(hdl->dev, blk_id * bdev->bdif->ph_bsize, SEEK_SET);
-        return sys_fread(buf, bdev->bdif->ph_bsize * blk_cnt, &rdcnt, hdl->dev);
+        return sys_cache_read(hdl->dev, blk_id, bdev->bdif->ph_bsize, blk_cnt, buf);
 }
 
 //==============================================================================
@@ -868,9 +879,8 @@ static int bwrite(struct ext4_blockdev *bdev, const void *buf, uint64_t blk_id,
 {
         ext4fs_t *hdl = bdev->bdif->p_user;
 
-        size_t wrcnt = 0;
-        sys_fseek(hdl->dev, blk_id * bdev->bdif->ph_bsize, SEEK_SET);
-        return sys_fwrite(buf, bdev->bdif->ph_bsize * blk_cnt, &wrcnt, hdl->dev);
+        return sys_cache_write(hdl->dev, blk_id, bdev->bdif->ph_bsize, blk_cnt, buf,
+                               CACHE_WRITE_BACK);
 }
 
 //==============================================================================
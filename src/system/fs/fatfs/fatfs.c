@@ -37,6 +37,12 @@
 ==============================================================================*/
 #define MUTEX_TIMEOUT   5000
 
+/* link map is built only for files that have at least this number of clusters */
+#define LINKMAP_MIN_CLUSTERS    4
+
+/* maximum link map size (number of DWORD items, 2 items per fragment) */
+#define LINKMAP_MAX_ITEMS       64
+
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
@@ -45,6 +51,11 @@ struct fatdir {
         char name[(FF_MAX_LFN + 1) * sizeof(TCHAR)];
 };
 
+struct fatfile {
+        FIL  fil;                       /* must be first */
+        bool linkmap_done;              /* link map creation attempted */
+};
+
 struct fatfs {
         FILE    *fsfile;
         FATFS    fatfs;
@@ -60,6 +71,7 @@ struct fatfs {
 static int    faterr_2_errno(FRESULT fresult);
 static time_t time_fat2unix(uint32_t fattime);
 static int    cmp_ptr(const void *a, const void *b);
+static void   linkmap_create(struct fatfile *file);
 
 /*==============================================================================
   Local object definitions
@@ -100,6 +112,10 @@ API_FS_INIT(fatfs, void **fs_handle, const char *src_path, const char *opts)
                         err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->mutex);
                 }
 
+                if (!err) {
+                        sys_mutex_set_name(hdl->mutex, "fatfs");
+                }
+
                 if (!err) {
                         err = sys_fopen(src_path, hdl->read_only ? "r" : "r+", &hdl->fsfile);
                 }
@@ -178,7 +194,7 @@ API_FS_OPEN(fatfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
 {
         struct fatfs *hdl = fs_handle;
 
-        int err = sys_zalloc(sizeof(FIL), fhdl);
+        int err = sys_zalloc(sizeof(struct fatfile), fhdl);
         if (err) {
                 return err;
         }
@@ -265,6 +281,11 @@ API_FS_CLOSE(fatfs, void *fs_handle, void *fhdl, bool force)
                 if (!err) {
                         int pos = sys_llist_find_begin(hdl->file_list, fatfile);
                         sys_llist_take(hdl->file_list, pos);
+
+                        if (fatfile->cltbl) {
+                                sys_free(cast(void**, &fatfile->cltbl));
+                        }
+
                         sys_free(&fhdl);
                 }
 
@@ -353,6 +374,7 @@ API_FS_READ(fatfs,
         int  err      = ESUCC;
 
         if (f_tell(fat_file) != (u32_t)*fpos) {
+                linkmap_create(fhdl);
                 err = faterr_2_errno(f_lseek(fat_file, (u32_t)*fpos));
         }
 
@@ -797,6 +819,8 @@ API_FS_SYNC(fatfs, void *fs_handle)
                                 f_sync(f);
                         }
 
+                        err = sys_cache_flush(hdl->fsfile);
+
                         sys_mutex_unlock(hdl->mutex);
                 }
 
@@ -806,6 +830,55 @@ API_FS_SYNC(fatfs, void *fs_handle)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function create cluster link map of file opened in read-only mode.
+ *         Link map is used by f_lseek() to find cluster without following
+ *         the FAT chain from the beginning of the file. Map is created at the
+ *         first seek and only once. Files opened for writing do not use link
+ *         map because file in fast seek mode cannot be expanded.
+ *
+ * @param  file         file
+ */
+//==============================================================================
+static void linkmap_create(struct fatfile *file)
+{
+        FIL *fil = &file->fil;
+
+        if (file->linkmap_done || (fil->flag & FA_WRITE)) {
+                return;
+        }
+
+        file->linkmap_done = true;
+
+        FSIZE_t clsize = cast(FSIZE_t, fil->obj.fs->csize) * FF_MIN_SS;
+        if (f_size(fil) < (LINKMAP_MIN_CLUSTERS * clsize)) {
+                return;
+        }
+
+        /* table of single fragment file: size, length, cluster, terminator */
+        DWORD items = 4;
+
+        while (items <= LINKMAP_MAX_ITEMS) {
+                DWORD *tbl = NULL;
+                if (sys_malloc(items * sizeof(DWORD), cast(void**, &tbl)) != ESUCC) {
+                        break;
+                }
+
+                tbl[0]     = items;
+                fil->cltbl = tbl;
+
+                FRESULT res = f_lseek(fil, CREATE_LINKMAP);
+                if (res == FR_OK) {
+                        return;
+                }
+
+                fil->cltbl = NULL;
+                items      = (res == FR_NOT_ENOUGH_CORE) ? tbl[0] : UINT32_MAX;
+                sys_free(cast(void**, &tbl));
+        }
+}
+
 //==============================================================================
 /**
  * @brief Function handle libfat errors and translate to errno
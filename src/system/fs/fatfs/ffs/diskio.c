@@ -55,10 +55,8 @@ DRESULT disk_read (
 	UINT count		/* Number of sectors to read */
 )
 {
-        size_t rdcnt = 0;
-        sys_fseek(pdrv, sector * FF_MIN_SS, SEEK_SET);
-        return sys_fread(buff, count * FF_MIN_SS, &rdcnt, pdrv) == ESUCC ?
-                         RES_OK : RES_ERROR;
+        return sys_cache_read(pdrv, sector, FF_MIN_SS, count, buff) == ESUCC ?
+                              RES_OK : RES_ERROR;
 }
 
 
@@ -76,10 +74,8 @@ DRESULT disk_write (
 	UINT count			/* Number of sectors to write */
 )
 {
-        size_t wrcnt = 0;
-        sys_fseek(pdrv, sector * FF_MIN_SS, SEEK_SET);
-        return sys_fwrite(buff, count * FF_MIN_SS, &wrcnt, pdrv) == ESUCC ?
-                          RES_OK : RES_ERROR;
+        return sys_cache_write(pdrv, sector, FF_MIN_SS, count, buff,
+                               CACHE_WRITE_BACK) == ESUCC ? RES_OK : RES_ERROR;
 }
 
 #endif
@@ -95,8 +91,56 @@ DRESULT disk_ioctl (
 	void *buff		/* Buffer to send/receive control data */
 )
 {
-        UNUSED_ARG3(pdrv, cmd, buff);
-
-        return RES_OK;
+        switch (cmd) {
+        case CTRL_SYNC:
+                if (  (sys_cache_flush(pdrv) == ESUCC)
+                   && (sys_fflush(pdrv) == ESUCC) ) {
+                        return RES_OK;
+                }
+                break;
+
+        case GET_SECTOR_COUNT: {
+                struct stat st;
+                if ((sys_fstat(pdrv, &st) == ESUCC) && (st.st_size > 0)) {
+                        *cast(LBA_t*, buff) = st.st_size / FF_MIN_SS;
+                        return RES_OK;
+                }
+                break;
+        }
+
+        case GET_SECTOR_SIZE:
+                *cast(WORD*, buff) = FF_MIN_SS;
+                return RES_OK;
+
+        case GET_BLOCK_SIZE:
+                *cast(DWORD*, buff) = 1;        /* erase block size unknown */
+                return RES_OK;
+
+        case CTRL_TRIM: {
+                LBA_t *range = buff;
+
+                STORAGE_discard_t discard;
+                discard.sector = range[0];
+                discard.count  = range[1] - range[0] + 1;
+
+                /* cached blocks of region cannot be read or written back */
+                int err = sys_cache_discard(pdrv, discard.sector, FF_MIN_SS, discard.count);
+                if (err) {
+                        break;
+                }
+
+                /* device that does not support discard is not an error */
+                err = sys_ioctl(pdrv, IOCTL_STORAGE__DISCARD, &discard);
+                if (!err || (err == EBADRQC) || (err == ENOTSUP) || (err == ESRCH)) {
+                        return RES_OK;
+                }
+                break;
+        }
+
+        default:
+                return RES_PARERR;
+        }
+
+        return RES_ERROR;
 }
 
@@ -40,9 +40,24 @@
 #define PATH_ROOT_BIN                   "/bin"
 #define PATH_ROOT_PID                   "/pid"
 #define PATH_ROOT_CPUINFO               "/cpuinfo"
+#define PATH_ROOT_NET                   "/net"
+#define PATH_ROOT_TRACE                 "/trace"
+#define PATH_ROOT_KWORKER               "/kworker"
+#define PATH_ROOT_MEMINFO               "/meminfo"
+#define PATH_ROOT_ALLOCPROF             "/allocprof"
+#define PATH_ROOT_STACKPROF             "/stackprof"
+#define PATH_ROOT_LOCKPROF              "/lockprof"
 
 #define FILE_BUFFER                     384
+#define NET_FILE_BUFFER                 1536
+#define MEMINFO_FILE_BUFFER             2048
+#define ALLOCPROF_FILE_BUFFER           (128 + (__OS_ALLOC_PROFILER_SITES__ * 72))
+#define STACKPROF_FILE_BUFFER           (256 + (__OS_STACK_PROFILER_ENTRIES__ * 80))
+#define LOCKPROF_FILE_BUFFER            (128 + (__OS_LOCK_PROFILER_ENTRIES__ * 80))
 #define PID_STR_LEN                     12
+#define TRACE_LINE_LEN                  32
+#define TRACE_NAME_LEN                  14
+#define TRACE_FORMAT_VERSION            1
 
 /*==============================================================================
   Local types, enums definitions
@@ -58,9 +73,49 @@ enum path_content {
         FILE_CONTENT_BIN,
         FILE_CONTENT_PID,
         FILE_CONTENT_CPUINFO,
+        FILE_CONTENT_NET,
+        FILE_CONTENT_TRACE,
+        FILE_CONTENT_KWORKER,
+        FILE_CONTENT_MEMINFO,
+        FILE_CONTENT_ALLOCPROF,
+        FILE_CONTENT_STACKPROF,
+        FILE_CONTENT_LOCKPROF,
         _FILE_CONTENT_COUNT
 };
 
+enum root_entry {
+        ROOT_ENTRY_BIN,
+        ROOT_ENTRY_PID,
+        ROOT_ENTRY_CPUINFO,
+        ROOT_ENTRY_MEMINFO,
+        #if __ENABLE_NETWORK__ == _YES_
+        ROOT_ENTRY_NET,
+        #endif
+        #if __OS_ENABLE_TRACE__ > 0
+        ROOT_ENTRY_TRACE,
+        #endif
+        #if __OS_TASK_KWORKER_MODE__ == 1
+        ROOT_ENTRY_KWORKER,
+        #endif
+        #if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        ROOT_ENTRY_ALLOCPROF,
+        #endif
+        #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        ROOT_ENTRY_STACKPROF,
+        #endif
+        #if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        ROOT_ENTRY_LOCKPROF,
+        #endif
+        _ROOT_ENTRY_COUNT
+};
+
+enum net_file {
+        NET_FILE_DEV,
+        NET_FILE_SOCKETS,
+        NET_FILE_MEMP,
+        _NET_FILE_COUNT
+};
+
 struct file_info {
         enum path_content content;
         int16_t           arg;
@@ -79,10 +134,43 @@ static int    procfs_readdir_pid (struct procfs *hdl, DIR *dir);
 static int    procfs_readdir_bin (struct procfs *hdl, DIR *dir);
 static int    add_file_to_list   (struct procfs *hdl, int16_t arg, enum path_content content, void **object);
 static size_t get_file_content   (struct file_info *file_info, char *buff, size_t size);
+static size_t get_file_buffer_size(struct file_info *file_info);
+#if __ENABLE_NETWORK__ == _YES_
+static int    procfs_readdir_net (struct procfs *hdl, DIR *dir);
+static size_t get_net_content    (enum net_file file, char *buff, size_t size);
+static const char *get_net_family_name(int family);
+#endif
+#if __OS_ENABLE_TRACE__ > 0
+static size_t get_trace_size     (void);
+static bool   get_trace_line     (size_t line, size_t events, char *buff);
+static size_t get_trace_content  (u8_t *dst, size_t count, fpos_t fpos);
+static int    set_trace_control  (const u8_t *src, size_t count);
+#endif
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+static int    set_lockprof_control(const u8_t *src, size_t count);
+#endif
 
 /*==============================================================================
   Local object definitions
 ==============================================================================*/
+#if __ENABLE_NETWORK__ == _YES_
+static const char *const net_file_name[_NET_FILE_COUNT] = {
+        [NET_FILE_DEV]     = "dev",
+        [NET_FILE_SOCKETS] = "sockets",
+        [NET_FILE_MEMP]    = "memp",
+};
+
+#if (__ENABLE_TCPIP_STACK__ > 0) || (__ENABLE_SIPC_STACK__ > 0)
+static const char *const net_family_name[_NET_FAMILY__COUNT] = {
+        #if __ENABLE_TCPIP_STACK__ > 0
+        [NET_FAMILY__INET] = "inet",
+        #endif
+        #if __ENABLE_SIPC_STACK__ > 0
+        [NET_FAMILY__SIPC] = "sipc",
+        #endif
+};
+#endif
+#endif
 
 /*==============================================================================
   Exported object definitions
@@ -119,11 +207,17 @@ API_FS_INIT(procfs, void **fs_handle, const char *src_path, const char *opts)
                 if (err != ESUCC)
                         goto finish;
 
+                sys_mutex_set_name(procfs->resource_mtx, "procfs");
+
                 if (!isstrempty(opts)) {
 
                         if (!(  isstreq(opts, PATH_ROOT)
                              || isstreq(opts, PATH_ROOT_BIN)
-                             || isstreq(opts, PATH_ROOT_PID)) ) {
+                             || isstreq(opts, PATH_ROOT_PID)
+#if __ENABLE_NETWORK__ == _YES_
+                             || isstreq(opts, PATH_ROOT_NET)
+#endif
+                             ) ) {
 
                                 err = ENOENT;
                                 goto finish;
@@ -208,10 +302,6 @@ API_FS_OPEN(procfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path
 {
         struct procfs *hdl = fs_handle;
 
-        if (flags != O_RDONLY) {
-                return EROFS;
-        }
-
         int err = ENOENT;
 
         *fpos = 0;
@@ -236,8 +326,14 @@ API_FS_OPEN(procfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path
 
         err = ENOENT;
 
+        // only trace and lock profiler files can be written
+        if (  (flags != O_RDONLY)
+           && !isstreq(mpath, PATH_ROOT_TRACE)
+           && !isstreq(mpath, PATH_ROOT_LOCKPROF) ) {
+                err = EROFS;
+
         // "/pid" path
-        if (isstreq(mpath, PATH_ROOT_PID)) {
+        } else if (isstreq(mpath, PATH_ROOT_PID)) {
                 err = add_file_to_list(hdl, -1, FILE_CONTENT_PID, fhdl);
 
         // "/pid/<pid>" path
@@ -274,6 +370,57 @@ API_FS_OPEN(procfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path
         } else if (isstreq(mpath, PATH_ROOT_CPUINFO)) {
                 err = add_file_to_list(hdl, 0, FILE_CONTENT_CPUINFO, fhdl);
 
+        // "/meminfo" path
+        } else if (isstreq(mpath, PATH_ROOT_MEMINFO)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_MEMINFO, fhdl);
+
+#if __ENABLE_NETWORK__ == _YES_
+        // "/net" path
+        } else if (isstreq(mpath, PATH_ROOT_NET)) {
+                err = add_file_to_list(hdl, -1, FILE_CONTENT_NET, fhdl);
+
+        // "/net/<file>" path
+        } else if (isstreqn(mpath, PATH_ROOT_NET"/", strlen(PATH_ROOT_NET) + 1)) {
+                mpath += strlen(PATH_ROOT_NET) + 1;
+
+                for (int i = 0; i < _NET_FILE_COUNT; i++) {
+                        if (isstreq(mpath, net_file_name[i])) {
+                                err = add_file_to_list(hdl, i, FILE_CONTENT_NET, fhdl);
+                                break;
+                        }
+                }
+#endif
+
+#if __OS_ENABLE_TRACE__ > 0
+        // "/trace" path
+        } else if (isstreq(mpath, PATH_ROOT_TRACE)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_TRACE, fhdl);
+#endif
+
+#if __OS_TASK_KWORKER_MODE__ == 1
+        // "/kworker" path
+        } else if (isstreq(mpath, PATH_ROOT_KWORKER)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_KWORKER, fhdl);
+#endif
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        // "/allocprof" path
+        } else if (isstreq(mpath, PATH_ROOT_ALLOCPROF)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_ALLOCPROF, fhdl);
+#endif
+
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        // "/stackprof" path
+        } else if (isstreq(mpath, PATH_ROOT_STACKPROF)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_STACKPROF, fhdl);
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        // "/lockprof" path
+        } else if (isstreq(mpath, PATH_ROOT_LOCKPROF)) {
+                err = add_file_to_list(hdl, 0, FILE_CONTENT_LOCKPROF, fhdl);
+#endif
+
         } else {
                 err = ENOENT;
         }
@@ -337,9 +484,33 @@ API_FS_WRITE(procfs,
              size_t          *wrcnt,
              struct vfs_fattr fattr)
 {
-        UNUSED_ARG7(fs_handle, fhdl, src, count, wrcnt, fpos, fattr);
+        UNUSED_ARG3(fs_handle, fpos, fattr);
 
-        return EROFS;
+        int err = EROFS;
+
+#if (__OS_ENABLE_TRACE__ > 0) || (__OS_ENABLE_LOCK_PROFILER__ == _YES_)
+        struct file_info *file = fhdl;
+
+#if __OS_ENABLE_TRACE__ > 0
+        if (file && file->content == FILE_CONTENT_TRACE) {
+                err = set_trace_control(src, count);
+        }
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        if (file && file->content == FILE_CONTENT_LOCKPROF) {
+                err = set_lockprof_control(src, count);
+        }
+#endif
+
+        if (!err) {
+                *wrcnt = count;
+        }
+#else
+        UNUSED_ARG4(fhdl, src, count, wrcnt);
+#endif
+
+        return err;
 }
 
 //==============================================================================
@@ -371,12 +542,21 @@ API_FS_READ(procfs,
         struct file_info *file = fhdl;
         int               err  = ENOENT;
 
+#if __OS_ENABLE_TRACE__ > 0
+        if (file && file->content == FILE_CONTENT_TRACE) {
+                *rdcnt = get_trace_content(dst, count, *fpos);
+                return ESUCC;
+        }
+#endif
+
         if (file && file->content < _FILE_CONTENT_COUNT) {
 
+                size_t size = get_file_buffer_size(file);
+
                 char *content;
-                err = sys_zalloc(FILE_BUFFER, cast(void**, &content));
+                err = sys_zalloc(size, cast(void**, &content));
                 if (!err) {
-                        size_t data_size = get_file_content(file, content, FILE_BUFFER);
+                        size_t data_size = get_file_content(file, content, size);
                         size_t seek      = min(*fpos, SIZE_MAX);
                         if (seek > data_size) {
                                 *rdcnt = 0;
@@ -454,18 +634,40 @@ API_FS_FSTAT(procfs, void *fs_handle, void *fhdl, struct stat *stat)
         stat->st_gid   = 0;
         stat->st_uid   = 0;
 
+        size_t size = get_file_buffer_size(file);
+
         char *content;
-        int err = sys_zalloc(FILE_BUFFER, cast(void**, &content));
+        int err = sys_zalloc(size, cast(void**, &content));
         if (!err) {
 
                 if (file->content < _FILE_CONTENT_COUNT) {
 
                         if (file->arg >= 0) {
-                                stat->st_size  = get_file_content(file, content, FILE_BUFFER);
+                                stat->st_size  = get_file_content(file, content, size);
                                 stat->st_mode |= S_IFREG;
 
+#if __OS_ENABLE_TRACE__ > 0
+                                if (file->content == FILE_CONTENT_TRACE) {
+                                        stat->st_size  = get_trace_size();
+                                        stat->st_mode |= S_IWUSR;
+                                }
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                                if (file->content == FILE_CONTENT_LOCKPROF) {
+                                        stat->st_mode |= S_IWUSR;
+                                }
+#endif
+
                                 if (  (file->content == FILE_CONTENT_PID)
-                                   || (file->content == FILE_CONTENT_CPUINFO) ) {
+                                   || (file->content == FILE_CONTENT_CPUINFO)
+                                   || (file->content == FILE_CONTENT_MEMINFO)
+                                   || (file->content == FILE_CONTENT_NET)
+                                   || (file->content == FILE_CONTENT_TRACE)
+                                   || (file->content == FILE_CONTENT_KWORKER)
+                                   || (file->content == FILE_CONTENT_ALLOCPROF)
+                                   || (file->content == FILE_CONTENT_STACKPROF)
+                                   || (file->content == FILE_CONTENT_LOCKPROF) ) {
 
                                         time_t t = 0;
                                         sys_gettime(&t);
@@ -607,7 +809,7 @@ API_FS_OPENDIR(procfs, void *fs_handle, const char *path, DIR *dir)
 
                 if (isstreq(opath, PATH_ROOT)) {
                         dirinfo->dir_name = PATH_ROOT;
-                        dir->d_items      = 3;
+                        dir->d_items      = _ROOT_ENTRY_COUNT;
 
                 } else if (isstreq(opath, PATH_ROOT_PID"/")) {
                         dirinfo->dir_name = PATH_ROOT_PID;
@@ -617,6 +819,12 @@ API_FS_OPENDIR(procfs, void *fs_handle, const char *path, DIR *dir)
                         dirinfo->dir_name = PATH_ROOT_BIN;
                         dir->d_items      = sys_get_programs_table_size();
 
+#if __ENABLE_NETWORK__ == _YES_
+                } else if (isstreq(opath, PATH_ROOT_NET"/")) {
+                        dirinfo->dir_name = PATH_ROOT_NET;
+                        dir->d_items      = _NET_FILE_COUNT;
+#endif
+
                 } else {
                         sys_free(&dir->d_hdl);
                         err = ENOENT;
@@ -675,6 +883,11 @@ API_FS_READDIR(procfs, void *fs_handle, DIR *dir)
 
                 } else if (isstreq(dirinfo->dir_name, PATH_ROOT_BIN)) {
                         err = procfs_readdir_bin(fs_handle, dir);
+
+#if __ENABLE_NETWORK__ == _YES_
+                } else if (isstreq(dirinfo->dir_name, PATH_ROOT_NET)) {
+                        err = procfs_readdir_net(fs_handle, dir);
+#endif
                 }
         }
 
@@ -813,17 +1026,17 @@ static int procfs_readdir_root(struct procfs *hdl, DIR *dir)
         dir->dirent.size = 0;
 
         switch (dir->d_seek++) {
-        case 0:
+        case ROOT_ENTRY_BIN:
                 dir->dirent.d_name = "bin";
                 dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFDIR;
                 break;
 
-        case 1:
+        case ROOT_ENTRY_PID:
                 dir->dirent.d_name = "pid";
                 dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFDIR;
                 break;
 
-        case 2: {
+        case ROOT_ENTRY_CPUINFO: {
                 char *content;
                 err = sys_zalloc(FILE_BUFFER, cast(void**, &content));
                 if (!err) {
@@ -837,6 +1050,99 @@ static int procfs_readdir_root(struct procfs *hdl, DIR *dir)
                 break;
         }
 
+        case ROOT_ENTRY_MEMINFO: {
+                char *content;
+                err = sys_zalloc(MEMINFO_FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+                        struct file_info file = {.content = FILE_CONTENT_MEMINFO, .arg = 0};
+                        dir->dirent.d_name = "meminfo";
+                        dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.size   = get_file_content(&file, content, MEMINFO_FILE_BUFFER);
+
+                        sys_free(cast(void**, &content));
+                }
+                break;
+        }
+
+#if __ENABLE_NETWORK__ == _YES_
+        case ROOT_ENTRY_NET:
+                dir->dirent.d_name = "net";
+                dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFDIR;
+                break;
+#endif
+
+#if __OS_ENABLE_TRACE__ > 0
+        case ROOT_ENTRY_TRACE:
+                dir->dirent.d_name = "trace";
+                dir->dirent.mode   = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH | S_IFREG;
+                dir->dirent.size   = get_trace_size();
+                break;
+#endif
+
+#if __OS_TASK_KWORKER_MODE__ == 1
+        case ROOT_ENTRY_KWORKER: {
+                char *content;
+                err = sys_zalloc(FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+                        struct file_info file = {.content = FILE_CONTENT_KWORKER, .arg = 0};
+                        dir->dirent.d_name = "kworker";
+                        dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.size   = get_file_content(&file, content, FILE_BUFFER);
+
+                        sys_free(cast(void**, &content));
+                }
+                break;
+        }
+#endif
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        case ROOT_ENTRY_ALLOCPROF: {
+                char *content;
+                err = sys_zalloc(ALLOCPROF_FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+                        struct file_info file = {.content = FILE_CONTENT_ALLOCPROF, .arg = 0};
+                        dir->dirent.d_name = "allocprof";
+                        dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.size   = get_file_content(&file, content, ALLOCPROF_FILE_BUFFER);
+
+                        sys_free(cast(void**, &content));
+                }
+                break;
+        }
+#endif
+
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        case ROOT_ENTRY_STACKPROF: {
+                char *content;
+                err = sys_zalloc(STACKPROF_FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+                        struct file_info file = {.content = FILE_CONTENT_STACKPROF, .arg = 0};
+                        dir->dirent.d_name = "stackprof";
+                        dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.size   = get_file_content(&file, content, STACKPROF_FILE_BUFFER);
+
+                        sys_free(cast(void**, &content));
+                }
+                break;
+        }
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        case ROOT_ENTRY_LOCKPROF: {
+                char *content;
+                err = sys_zalloc(LOCKPROF_FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+                        struct file_info file = {.content = FILE_CONTENT_LOCKPROF, .arg = 0};
+                        dir->dirent.d_name = "lockprof";
+                        dir->dirent.mode   = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.size   = get_file_content(&file, content, LOCKPROF_FILE_BUFFER);
+
+                        sys_free(cast(void**, &content));
+                }
+                break;
+        }
+#endif
+
         default:
                 err = ENOENT;
                 break;
@@ -923,6 +1229,46 @@ static int procfs_readdir_bin(struct procfs *hdl, DIR *dir)
         return err;
 }
 
+#if __ENABLE_NETWORK__ == _YES_
+//==============================================================================
+/**
+ * @brief Read directory
+ *
+ * @param[in ]          *hdl                    file system allocated memory
+ * @param[in,out]       *dir                    directory object
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int procfs_readdir_net(struct procfs *hdl, DIR *dir)
+{
+        UNUSED_ARG1(hdl);
+
+        int err = ENOENT;
+
+        if (dir->d_seek < _NET_FILE_COUNT) {
+
+                char *content;
+                err = sys_zalloc(NET_FILE_BUFFER, cast(void**, &content));
+                if (!err) {
+
+                        dir->dirent.d_name = net_file_name[dir->d_seek];
+                        dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH | S_IFREG;
+                        dir->dirent.dev    = 0;
+
+                        struct file_info file = {.arg = dir->d_seek, .content = FILE_CONTENT_NET};
+                        dir->dirent.size      = get_file_content(&file, content, NET_FILE_BUFFER);
+
+                        dir->d_seek++;
+
+                        err = sys_free(cast(void**, &content));
+                }
+        }
+
+        return err;
+}
+#endif
+
 //==============================================================================
 /**
  * @brief Add file info to list
@@ -1045,6 +1391,239 @@ static size_t get_file_content(struct file_info *file, char *buff, size_t size)
                 }
                 break;
 
+        case FILE_CONTENT_MEMINFO: {
+                static const char *const type_name[_MM_REGION_TYPE_COUNT] = {
+                        [_MM_REGION_INTERNAL] = "internal",
+                        [_MM_REGION_FAST]     = "fast",
+                        [_MM_REGION_EXTERNAL] = "external",
+                };
+
+                len = sys_snprintf(buff, size,
+                                   "Size: %u\n"
+                                   "Used: %u\n"
+                                   "Free: %u\n"
+                                   "region     type      start     size     free"
+                                   "   kernel       fs      net     prog      shm    cache  modules\n",
+                                   sys_get_mem_size(), sys_get_used_mem(),
+                                   sys_get_free_mem());
+
+                _mm_region_stat_t region;
+                for (uint i = 0; sys_get_mem_region_stat(i, &region) == ESUCC; i++) {
+
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%6u %8s 0x%08X %8u %8u",
+                                            i, type_name[region.type],
+                                            cast(uintptr_t, region.start),
+                                            region.size, region.free);
+
+                        for (int mpur = 0; mpur < _MM_COUNT; mpur++) {
+                                len += sys_snprintf(buff + len, size - len,
+                                                    " %8d", region.usage[mpur]);
+                        }
+
+                        len += sys_snprintf(buff + len, size - len, "\n");
+                }
+
+                len += sys_snprintf(buff + len, size - len,
+                                    "region  largest   blocks frag%%"
+                                    "   <64  <128  <256  <512   <1K   <2K   <4K  >=4K\n");
+
+                for (uint i = 0; sys_get_mem_region_stat(i, &region) == ESUCC; i++) {
+
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%6u %8u %8u %5u",
+                                            i, region.frag.largest_free,
+                                            region.frag.free_blocks,
+                                            region.frag.fragmentation);
+
+                        for (int class = 0; class < _HEAP_HISTOGRAM_SIZE; class++) {
+                                len += sys_snprintf(buff + len, size - len,
+                                                    " %5u", region.frag.histogram[class]);
+                        }
+
+                        len += sys_snprintf(buff + len, size - len, "\n");
+                }
+
+                len += sys_snprintf(buff + len, size - len,
+                                    "shrinker     prio    calls    freed\n");
+
+                _mm_shrinker_stat_t shrinker;
+                for (uint i = 0; sys_get_shrinker_stat(i, &shrinker) == ESUCC; i++) {
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%8s %8u %8u %8u\n",
+                                            shrinker.name, shrinker.priority,
+                                            shrinker.calls, shrinker.freed);
+                }
+                break;
+        }
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        case FILE_CONTENT_ALLOCPROF: {
+                _mm_alloc_site_t *site;
+                if (sys_malloc(__OS_ALLOC_PROFILER_SITES__ * sizeof(*site), cast(void**, &site)) == ESUCC) {
+
+                        // call sites sorted by number of allocations (hot sites first)
+                        uint sites = 0;
+                        while (sys_get_alloc_site(sites, &site[sites]) == ESUCC) {
+                                _mm_alloc_site_t cur = site[sites];
+
+                                uint n = sites++;
+                                for (; n > 0 && site[n - 1].allocs < cur.allocs; n--) {
+                                        site[n] = site[n - 1];
+                                }
+
+                                site[n] = cur;
+                        }
+
+                        len = sys_snprintf(buff, size,
+                                           "Call sites: %u/%u\n"
+                                           "Untracked allocations: %u\n"
+                                           "    caller   allocs    frees     live live_bytes life_avg life_max\n",
+                                           sites, __OS_ALLOC_PROFILER_SITES__,
+                                           sys_get_alloc_untracked());
+
+                        for (uint i = 0; i < sites; i++) {
+                                u32_t life_avg = site[i].frees ? site[i].lifetime_total / site[i].frees : 0;
+
+                                len += sys_snprintf(buff + len, size - len,
+                                                    "0x%08X %8u %8u %8u %10d %8u %8u\n",
+                                                    cast(uintptr_t, site[i].caller),
+                                                    site[i].allocs, site[i].frees,
+                                                    site[i].allocs - site[i].frees,
+                                                    site[i].live_bytes, life_avg,
+                                                    site[i].lifetime_max);
+                        }
+
+                        sys_free(cast(void**, &site));
+                }
+                break;
+        }
+#endif
+
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        case FILE_CONTENT_STACKPROF: {
+                static const struct {
+                        const char *name;
+                        size_t      depth;
+                } level[] = {
+                        {"MINIMAL",    STACK_DEPTH_MINIMAL   },
+                        {"VERY_LOW",   STACK_DEPTH_VERY_LOW  },
+                        {"LOW",        STACK_DEPTH_LOW       },
+                        {"MEDIUM",     STACK_DEPTH_MEDIUM    },
+                        {"LARGE",      STACK_DEPTH_LARGE     },
+                        {"VERY_LARGE", STACK_DEPTH_VERY_LARGE},
+                        {"HUGE",       STACK_DEPTH_HUGE      },
+                        {"VERY_HUGE",  STACK_DEPTH_VERY_HUGE },
+                };
+
+                len = sys_snprintf(buff, size,
+                                   "Safety margin: %u%%\n"
+                                   "     program      entry  depth   peak   runs    rec  STACK_DEPTH\n",
+                                   __OS_STACK_PROFILER_MARGIN__);
+
+                size_t reclaimable = 0;
+
+                _process_stack_prof_t prof;
+                for (uint i = 0; sys_process_get_stack_prof(i, &prof) == ESUCC; i++) {
+
+                        // recommended depth: peak usage with margin rounded up to 8 levels
+                        size_t rec = prof.max_usage + ((prof.max_usage * __OS_STACK_PROFILER_MARGIN__) / 100);
+                        rec = (rec + 7) & ~7;
+
+                        if (prof.stack_depth > rec) {
+                                reclaimable += prof.stack_depth - rec;
+                        }
+
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%12s 0x%08X %6u %6u %6u %6u  ",
+                                            prof.name, cast(uintptr_t, prof.entry),
+                                            prof.stack_depth, prof.max_usage,
+                                            prof.runs, rec);
+
+                        uint l = 0;
+                        while ((l < ARRAY_SIZE(level)) && (level[l].depth < rec)) {
+                                l++;
+                        }
+
+                        // the smallest standard depth that fits, otherwise custom one
+                        if (l < ARRAY_SIZE(level)) {
+                                len += sys_snprintf(buff + len, size - len,
+                                                    "%s\n", level[l].name);
+                        } else {
+                                len += sys_snprintf(buff + len, size - len,
+                                                    "CUSTOM(%u)\n", rec - __OS_IRQ_STACK_DEPTH__);
+                        }
+                }
+
+                len += sys_snprintf(buff + len, size - len,
+                                    "Reclaimable stack depth: %u\n", reclaimable);
+                break;
+        }
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        case FILE_CONTENT_LOCKPROF: {
+                len = sys_snprintf(buff, size,
+                                   "        lock   acquires  contended   timeouts"
+                                   "  wait[us]  avg[us]  max[us] hold[us]\n");
+
+                _lock_prof_t prof;
+                for (uint i = 0; sys_get_lock_prof(i, &prof) == ESUCC; i++) {
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%12s %10u %10u %10u %9u %8u %8u %8u\n",
+                                            prof.name, prof.acquires, prof.contended,
+                                            prof.timeouts, prof.wait_total,
+                                            prof.contended ? prof.wait_total / prof.contended : 0,
+                                            prof.wait_max, prof.hold_max);
+                }
+                break;
+        }
+#endif
+
+#if __ENABLE_NETWORK__ == _YES_
+        case FILE_CONTENT_NET:
+                if (file->arg >= 0 && file->arg < _NET_FILE_COUNT) {
+                        len = get_net_content(file->arg, buff, size);
+                }
+                break;
+#endif
+
+#if __OS_TASK_KWORKER_MODE__ == 1
+        case FILE_CONTENT_KWORKER: {
+                static const char *const class_name[_SYSCALL_CLASS_COUNT] = {
+                        [_SYSCALL_CLASS_FS]    = "fs",
+                        [_SYSCALL_CLASS_BLOCK] = "block",
+                        [_SYSCALL_CLASS_NET]   = "net",
+                };
+
+                _syscall_kworker_stat_t kw;
+                sys_get_kworker_stat(&kw);
+
+                len = sys_snprintf(buff, size,
+                                   "Threads: %u (idle %u, min %u, max %u, peak %u)\n"
+                                   "Spawned: %u\n"
+                                   "Reaped: %u\n"
+                                   "Spawn failures: %u\n"
+                                   "class depth   max  busy   requests wait_avg wait_max\n",
+                                   kw.threads, kw.threads_idle, kw.threads_min,
+                                   kw.threads_max, kw.threads_peak, kw.spawned,
+                                   kw.reaped, kw.spawn_failed);
+
+                for (int i = 0; i < _SYSCALL_CLASS_COUNT; i++) {
+                        _syscall_class_stat_t *cs = &kw.class[i];
+
+                        u32_t wait_avg = cs->requests ? cast(u32_t, cs->wait_total_ms / cs->requests) : 0;
+
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%5s %5u %5u %5u %10u %8u %8u\n",
+                                            class_name[i], cs->depth, cs->depth_max,
+                                            cs->busy, cs->requests, wait_avg,
+                                            cs->wait_max_ms);
+                }
+                break;
+        }
+#endif
+
 #if __OS_SYSTEM_SHEBANG_ENABLE__ > 0
         case FILE_CONTENT_BIN: {
                 const struct _prog_data *pdata = sys_get_programs_table();
@@ -1062,6 +1641,350 @@ static size_t get_file_content(struct file_info *file, char *buff, size_t size)
         return len;
 }
 
+//==============================================================================
+/**
+ * @brief Function return size of buffer needed to read file content
+ *
+ * @param file          file information
+ *
+ * @return buffer size
+ */
+//==============================================================================
+static size_t get_file_buffer_size(struct file_info *file)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        if (file->content == FILE_CONTENT_NET) {
+                return NET_FILE_BUFFER;
+        }
+#endif
+        if (file->content == FILE_CONTENT_MEMINFO) {
+                return MEMINFO_FILE_BUFFER;
+        }
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        if (file->content == FILE_CONTENT_ALLOCPROF) {
+                return ALLOCPROF_FILE_BUFFER;
+        }
+#endif
+
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        if (file->content == FILE_CONTENT_STACKPROF) {
+                return STACKPROF_FILE_BUFFER;
+        }
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        if (file->content == FILE_CONTENT_LOCKPROF) {
+                return LOCKPROF_FILE_BUFFER;
+        }
+#endif
+
+        return FILE_BUFFER;
+}
+
+#if __ENABLE_NETWORK__ == _YES_
+//==============================================================================
+/**
+ * @brief Function return content of network file (/net/...)
+ *
+ * @param file          network file
+ * @param buff          buffer
+ * @param size          buffer size
+ *
+ * @return number of bytes written to buffer
+ */
+//==============================================================================
+static size_t get_net_content(enum net_file file, char *buff, size_t size)
+{
+        size_t len = 0;
+
+        switch (file) {
+        case NET_FILE_DEV: {
+                len = sys_snprintf(buff, size,
+                                   "iface   rx_bytes rx_packets rx_dropped  rx_nobufs"
+                                   "   tx_bytes tx_packets state\n");
+
+                #if __ENABLE_TCPIP_STACK__ > 0
+                NET_INET_status_t inet;
+                if (sys_net_ifstatus(NET_FAMILY__INET, &inet) == ESUCC) {
+                        len += sys_snprintf(buff + len, size - len,
+                                            "inet  %10u %10u %10u %10u %10u %10u %s\n",
+                                            cast(u32_t, inet.rx_bytes),
+                                            cast(u32_t, inet.rx_packets),
+                                            cast(u32_t, inet.rx_dropped),
+                                            cast(u32_t, inet.rx_alloc_errors),
+                                            cast(u32_t, inet.tx_bytes),
+                                            cast(u32_t, inet.tx_packets),
+                                            inet.state == NET_INET_STATE__NOT_CONFIGURED ? "down"
+                                          : inet.state == NET_INET_STATE__LINK_DISCONNECTED ? "no-link"
+                                          : "up");
+                }
+                #endif
+
+                #if __ENABLE_SIPC_STACK__ > 0
+                NET_SIPC_status_t sipc;
+                if (sys_net_ifstatus(NET_FAMILY__SIPC, &sipc) == ESUCC) {
+                        len += sys_snprintf(buff + len, size - len,
+                                            "sipc  %10u %10u %10u %10u %10u %10u %s\n",
+                                            cast(u32_t, sipc.rx_bytes),
+                                            cast(u32_t, sipc.rx_packets),
+                                            0, 0,
+                                            cast(u32_t, sipc.tx_bytes),
+                                            cast(u32_t, sipc.tx_packets),
+                                            sipc.state == NET_SIPC_STATE__UP ? "up" : "down");
+                }
+                #endif
+                break;
+        }
+
+        case NET_FILE_SOCKETS: {
+                static const char *const protocol_name[] = {
+                        [NET_PROTOCOL__UDP]    = "udp",
+                        [NET_PROTOCOL__TCP]    = "tcp",
+                        [NET_PROTOCOL__STREAM] = "str",
+                };
+
+                len = sys_snprintf(buff, size,
+                                   "fam  prot  port   rx_queue   tx_queue rtx"
+                                   " rx_packets   rx_bytes tx_packets   tx_bytes errors\n");
+
+                NET_socket_stat_t stat;
+                for (size_t seek = 0; sys_net_socket_get_stat_seek(seek, &stat) == ESUCC; seek++) {
+                        len += sys_snprintf(buff + len, size - len,
+                                            "%s  %s %5u %10u %10u %3u %10u %10u %10u %10u %6u\n",
+                                            get_net_family_name(stat.family),
+                                            protocol_name[stat.protocol],
+                                            stat.port,
+                                            stat.rx_queue,
+                                            stat.tx_queue,
+                                            stat.retransmits,
+                                            stat.rx_packets,
+                                            cast(u32_t, stat.rx_bytes),
+                                            stat.tx_packets,
+                                            cast(u32_t, stat.tx_bytes),
+                                            stat.errors);
+                }
+                break;
+        }
+
+        case NET_FILE_MEMP: {
+                len = sys_snprintf(buff, size, "fam    size   used    max    err pool\n");
+
+                for (int family = 0; family < _NET_FAMILY__COUNT; family++) {
+                        NET_mempool_stat_t stat;
+                        for (size_t seek = 0;
+                             sys_net_mempool_get_stat_seek(family, seek, &stat) == ESUCC;
+                             seek++) {
+
+                                len += sys_snprintf(buff + len, size - len,
+                                                    "%s %6u %6u %6u %6u %s\n",
+                                                    get_net_family_name(family),
+                                                    stat.size,
+                                                    stat.used,
+                                                    stat.max,
+                                                    stat.err,
+                                                    stat.name);
+                        }
+                }
+                break;
+        }
+
+        default:
+                break;
+        }
+
+        return len;
+}
+
+//==============================================================================
+/**
+ * @brief Function return name of network family. Family list is empty when
+ *        network is enabled without any stack.
+ *
+ * @param family        network family
+ *
+ * @return Family name.
+ */
+//==============================================================================
+static const char *get_net_family_name(int family)
+{
+#if (__ENABLE_TCPIP_STACK__ > 0) || (__ENABLE_SIPC_STACK__ > 0)
+        if ((family >= 0) && (family < _NET_FAMILY__COUNT)) {
+                return net_family_name[family];
+        }
+#else
+        (void)family;
+#endif
+        return "?";
+}
+#endif
+
+#if __OS_ENABLE_TRACE__ > 0
+//==============================================================================
+/**
+ * @brief Function return size of trace file (/trace). File consists of
+ *        fixed length records: header, events (from the oldest), and names
+ *        of processes.
+ *
+ * @return file size
+ */
+//==============================================================================
+static size_t get_trace_size(void)
+{
+        return (1 + sys_trace_get_count() + sys_process_get_count()) * TRACE_LINE_LEN;
+}
+
+//==============================================================================
+/**
+ * @brief Function create selected record of trace file. Each record has format:
+ *        "<timestamp> <type> <arg16> <arg32>" (hex values) padded to fixed
+ *        length. Process name record contains name instead of arg32.
+ *
+ * @param line          record number
+ * @param events        number of events
+ * @param buff          buffer (TRACE_LINE_LEN + 1)
+ *
+ * @return On success true is returned, otherwise false.
+ */
+//==============================================================================
+static bool get_trace_line(size_t line, size_t events, char *buff)
+{
+        size_t len = 0;
+
+        if (line == 0) {
+                len = sys_snprintf(buff, TRACE_LINE_LEN, "%08x %02x %04x %08x",
+                                   0, _TRACE_EVENT_HEADER, TRACE_FORMAT_VERSION,
+                                   sys_trace_get_timestamp_frequency());
+
+        } else if (line <= events) {
+                _trace_event_t event;
+                if (sys_trace_get_event_seek(line - 1, &event) == ESUCC) {
+                        len = sys_snprintf(buff, TRACE_LINE_LEN, "%08x %02x %04x %08x",
+                                           event.timestamp, event.type,
+                                           event.arg16, event.arg32);
+                }
+
+        } else {
+                process_stat_t stat;
+                if (sys_process_get_stat_seek(line - events - 1, &stat) == ESUCC) {
+                        len = sys_snprintf(buff, TRACE_LINE_LEN, "%08x %02x %04x ",
+                                           0, _TRACE_EVENT_PROCESS_NAME, stat.pid);
+
+                        for (size_t i = 0; stat.name[i] && i < TRACE_NAME_LEN; i++) {
+                                buff[len++] = stat.name[i];
+                        }
+                }
+        }
+
+        if (len == 0) {
+                return false;
+        }
+
+        memset(buff + len, ' ', TRACE_LINE_LEN - 1 - len);
+        buff[TRACE_LINE_LEN - 1] = '\n';
+
+        return true;
+}
+
+//==============================================================================
+/**
+ * @brief Function read trace file content. Only requested records are created,
+ *        thus file can be read by small portions. Tracing should be stopped
+ *        before read, otherwise events are moved during read.
+ *
+ * @param dst           destination buffer
+ * @param count         number of bytes to read
+ * @param fpos          file position
+ *
+ * @return number of read bytes
+ */
+//==============================================================================
+static size_t get_trace_content(u8_t *dst, size_t count, fpos_t fpos)
+{
+        size_t events = sys_trace_get_count();
+        size_t n      = 0;
+
+        while (n < count) {
+                size_t line   = (fpos + n) / TRACE_LINE_LEN;
+                size_t offset = (fpos + n) % TRACE_LINE_LEN;
+
+                char buff[TRACE_LINE_LEN + 1];
+                if (!get_trace_line(line, events, buff)) {
+                        break;
+                }
+
+                size_t len = min(TRACE_LINE_LEN - offset, count - n);
+                memcpy(dst + n, buff + offset, len);
+                n += len;
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief Function control tracer by command written to trace file:
+ *        "start", "stop", or "clear".
+ *
+ * @param src           command
+ * @param count         command length
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int set_trace_control(const u8_t *src, size_t count)
+{
+        const char *cmd = (const char *)src;
+
+        while (count > 0 && (cmd[count - 1] == '\n' || cmd[count - 1] == ' ')) {
+                count--;
+        }
+
+        if (count == 5 && strncmp(cmd, "start", 5) == 0) {
+                sys_trace_start();
+
+        } else if (count == 4 && strncmp(cmd, "stop", 4) == 0) {
+                sys_trace_stop();
+
+        } else if (count == 5 && strncmp(cmd, "clear", 5) == 0) {
+                sys_trace_clear();
+
+        } else {
+                return EINVAL;
+        }
+
+        return ESUCC;
+}
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+//==============================================================================
+/**
+ * @brief Function control lock profiler by command written to lockprof file:
+ *        "reset".
+ *
+ * @param src           command
+ * @param count         command length
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int set_lockprof_control(const u8_t *src, size_t count)
+{
+        const char *cmd = (const char *)src;
+
+        while (count > 0 && (cmd[count - 1] == '\n' || cmd[count - 1] == ' ')) {
+                count--;
+        }
+
+        if (count == 5 && strncmp(cmd, "reset", 5) == 0) {
+                return sys_reset_lock_prof();
+        } else {
+                return EINVAL;
+        }
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -124,6 +124,8 @@ API_FS_INIT(ramfs, void **fs_handle, const char *src_path, const char *opts)
                 if (err)
                         goto finish;
 
+                sys_mutex_set_name(hdl->resource_mtx, "ramfs");
+
                 err = sys_llist_create(NULL, NULL, cast(llist_t**, &hdl->root_dir.data.llist_t));
                 if (err)
                         goto finish;
@@ -42,10 +42,25 @@ typedef struct {
         sem_t *openfiles;
 } romfs_t;
 
+/*
+ * Open compressed file. Plain files use ROM entry as file handle, compressed
+ * files use this object that starts with copy of the entry, so handle type
+ * is recognized by entry type.
+ */
+typedef struct {
+        romfs_entry_t entry;
+        u8_t         *cache;            /* decoded block of compressed file */
+        u32_t         cache_blk;
+        size_t        cache_len;
+} romfs_file_t;
+
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
 static int get_entry(const char *path, const romfs_entry_t **entry);
+static int entry_stat(const romfs_entry_t *entry, struct stat *stat);
+static int cfile_read(romfs_file_t *file, u8_t *dst, size_t count, fpos_t fpos, size_t *rdcnt);
+static int lz4_decode(const u8_t *src, size_t srclen, u8_t *dst, size_t dstlen, size_t *outlen);
 
 /*==============================================================================
   Local objects
@@ -151,8 +166,17 @@ API_FS_OPEN(romfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
         int err = get_entry(path, &entry);
         if (!err) {
                 if (entry->type == ROMFS_FILE_TYPE__FILE) {
-                        *fhdl = cast(void*, entry);
+                        *fhdl = const_cast(void*, entry);
                         sys_semaphore_signal(hdl->openfiles);
+
+                } else if (entry->type == ROMFS_FILE_TYPE__CFILE) {
+                        err = sys_zalloc(sizeof(romfs_file_t), fhdl);
+                        if (!err) {
+                                romfs_file_t *file = *fhdl;
+                                file->entry = *entry;
+
+                                sys_semaphore_signal(hdl->openfiles);
+                        }
                 } else {
                        err = EISDIR;
                 }
@@ -174,11 +198,23 @@ API_FS_OPEN(romfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
 //==============================================================================
 API_FS_CLOSE(romfs, void *fs_handle, void *fhdl, bool force)
 {
-        UNUSED_ARG2(fhdl, force);
+        UNUSED_ARG1(force);
 
-        romfs_t *hdl = fs_handle;
+        romfs_t             *hdl   = fs_handle;
+        const romfs_entry_t *entry = fhdl;
 
-        return sys_semaphore_wait(hdl->openfiles, 10);
+        int err = sys_semaphore_wait(hdl->openfiles, 10);
+        if (!err && (entry->type == ROMFS_FILE_TYPE__CFILE)) {
+                romfs_file_t *file = fhdl;
+
+                if (file->cache) {
+                        sys_free(cast(void*, &file->cache));
+                }
+
+                sys_free(cast(void*, &file));
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -237,19 +273,23 @@ API_FS_READ(romfs,
 
         int err = EFAULT;
 
-        romfs_entry_t *entry = fhdl;
+        const romfs_entry_t *entry = fhdl;
         if (entry) {
                 i32_t len = ((entry->size) ? *entry->size : 0) - *fpos;
                       len = min((i32_t)count, len);
 
-                if (len > 0) {
+                if (len <= 0) {
+                        *rdcnt = 0;
+                        err    = ESUCC;
+
+                } else if (entry->type == ROMFS_FILE_TYPE__CFILE) {
+                        err = cfile_read(fhdl, dst, len, *fpos, rdcnt);
+
+                } else {
                         memcpy(dst, entry->data + *fpos, len);
                         *rdcnt = len;
-                } else {
-                        *rdcnt = 0;
+                        err    = ESUCC;
                 }
-
-                err = ESUCC;
         }
 
         return err;
@@ -304,25 +344,7 @@ API_FS_FSTAT(romfs, void *fs_handle, void *fhdl, struct stat *stat)
 {
         UNUSED_ARG1(fs_handle);
 
-        int err = EIO;
-
-        romfs_entry_t *entry = fhdl;
-        if (entry) {
-                stat->st_ctime = COMPILE_EPOCH_TIME;
-                stat->st_mtime = COMPILE_EPOCH_TIME;
-                stat->st_dev   = 0;
-                stat->st_size  = entry->size ? *entry->size : 0;
-                stat->st_gid   = 0;
-                stat->st_uid   = 0;
-                stat->st_mode  = S_IRUSR | S_IRGRP | S_IROTH
-                               | ( entry->type == ROMFS_FILE_TYPE__FILE
-                                 ? (S_IXUSR * __ROMFS_CFG_EXEC_FILES__) : 0 )
-                               | (entry->type == ROMFS_FILE_TYPE__DIR
-                                 ? S_IFDIR : S_IFREG);
-                err = ESUCC;
-        }
-
-        return err;
+        return entry_stat(fhdl, stat);
 }
 
 //==============================================================================
@@ -340,9 +362,11 @@ API_FS_STAT(romfs, void *fs_handle, const char *path, struct stat *stat)
 {
         const romfs_entry_t *entry = NULL;
 
+        UNUSED_ARG1(fs_handle);
+
         int err = get_entry(path, &entry);
         if (!err) {
-                err = _romfs_fstat(fs_handle, const_cast(void*, entry), stat);
+                err = entry_stat(entry, stat);
         }
 
         return err;
@@ -638,13 +662,27 @@ static int get_entry(const char *path, const romfs_entry_t **entry)
 
                         found = false;
 
-                        for (size_t i = 0; i < dir->items; i++) {
+                        size_t lo = 0;
+                        size_t hi = dir->items;
+
+                        while (lo < hi) {
 
-                                ent = &dir->entry[i];
+                                size_t mid = lo + ((hi - lo) / 2);
 
-                                if (  (strlen(ent->name) == nlen)
-                                   && (strncmp(ent->name, path, nlen) == 0) ) {
+                                ent = &dir->entry[mid];
 
+                                int cmp = strncmp(ent->name, path, nlen);
+                                if ((cmp == 0) && (ent->name[nlen] != '\0')) {
+                                        cmp = 1;
+                                }
+
+                                if (cmp < 0) {
+                                        lo = mid + 1;
+
+                                } else if (cmp > 0) {
+                                        hi = mid;
+
+                                } else {
                                         found = true;
                                         path += nlen;
 
@@ -678,6 +716,209 @@ static int get_entry(const char *path, const romfs_entry_t **entry)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Return entry status.
+ *
+ * @param  entry        entry
+ * @param  stat         file status
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int entry_stat(const romfs_entry_t *entry, struct stat *stat)
+{
+        int err = EIO;
+
+        if (entry) {
+                stat->st_ctime = COMPILE_EPOCH_TIME;
+                stat->st_mtime = COMPILE_EPOCH_TIME;
+                stat->st_dev   = 0;
+                stat->st_size  = entry->size ? *entry->size : 0;
+                stat->st_gid   = 0;
+                stat->st_uid   = 0;
+                stat->st_mode  = S_IRUSR | S_IRGRP | S_IROTH
+                               | ( entry->type != ROMFS_FILE_TYPE__DIR
+                                 ? (S_IXUSR * __ROMFS_CFG_EXEC_FILES__) : 0 )
+                               | (entry->type == ROMFS_FILE_TYPE__DIR
+                                 ? S_IFDIR : S_IFREG);
+                err = ESUCC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Read data from compressed file. Last decoded block is cached in the
+ *        file object, so sequential reads decode each block once.
+ *
+ * @param  file         file object
+ * @param  dst          data destination
+ * @param  count        number of bytes to read (within file size)
+ * @param  fpos         position in file
+ * @param  rdcnt        number of read bytes
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int cfile_read(romfs_file_t *file, u8_t *dst, size_t count, fpos_t fpos, size_t *rdcnt)
+{
+        const romfs_cfile_t *cfile = file->entry.data;
+        const size_t         fsize = *file->entry.size;
+
+        int err = ESUCC;
+
+        if (!file->cache) {
+                err = sys_malloc(cfile->block_size, cast(void*, &file->cache));
+                if (err) {
+                        return err;
+                }
+
+                file->cache_len = 0;
+        }
+
+        *rdcnt = 0;
+
+        while (!err && count > 0) {
+                u32_t blk = fpos / cfile->block_size;
+                u32_t off = fpos % cfile->block_size;
+
+                if (blk >= cfile->blocks) {
+                        break;
+                }
+
+                if ((file->cache_len == 0) || (file->cache_blk != blk)) {
+
+                        const u8_t *src    = &cfile->data[cfile->index[blk]];
+                        size_t      srclen = cfile->index[blk + 1] - cfile->index[blk];
+                        size_t      blklen = min(cast(size_t, cfile->block_size),
+                                                 fsize - (cast(size_t, blk) * cfile->block_size));
+
+                        file->cache_len = 0;
+
+                        if (srclen == blklen) {
+                                memcpy(file->cache, src, blklen);
+                                file->cache_len = blklen;
+
+                        } else {
+                                err = lz4_decode(src, srclen, file->cache, blklen,
+                                                 &file->cache_len);
+
+                                if (!err && (file->cache_len != blklen)) {
+                                        file->cache_len = 0;
+                                        err = EILSEQ;
+                                }
+                        }
+
+                        file->cache_blk = blk;
+                }
+
+                if (!err) {
+                        size_t n = min(count, file->cache_len - off);
+
+                        memcpy(dst, &file->cache[off], n);
+
+                        dst    += n;
+                        fpos   += n;
+                        count  -= n;
+                        *rdcnt += n;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Decode single LZ4 block.
+ *
+ * @param  src          compressed data
+ * @param  srclen       compressed data length
+ * @param  dst          decoded data destination
+ * @param  dstlen       destination buffer size
+ * @param  outlen       number of decoded bytes
+ *
+ * @return On success ESUCC is returned, EILSEQ if block is malformed.
+ */
+//==============================================================================
+static int lz4_decode(const u8_t *src, size_t srclen, u8_t *dst, size_t dstlen, size_t *outlen)
+{
+        const u8_t *send = src + srclen;
+        u8_t       *dcur = dst;
+        u8_t       *dend = dst + dstlen;
+
+        while (src < send) {
+                u8_t   token = *src++;
+                size_t len   = token >> 4;
+
+                if (len == 15) {
+                        u8_t b;
+                        do {
+                                if (src >= send) {
+                                        return EILSEQ;
+                                }
+
+                                b    = *src++;
+                                len += b;
+                        } while (b == 255);
+                }
+
+                if ((len > cast(size_t, send - src)) || (len > cast(size_t, dend - dcur))) {
+                        return EILSEQ;
+                }
+
+                memcpy(dcur, src, len);
+                dcur += len;
+                src  += len;
+
+                if (src >= send) {
+                        break;  /* last sequence contains literals only */
+                }
+
+                if ((send - src) < 2) {
+                        return EILSEQ;
+                }
+
+                size_t offset = src[0] | (src[1] << 8);
+                src += 2;
+
+                if ((offset == 0) || (offset > cast(size_t, dcur - dst))) {
+                        return EILSEQ;
+                }
+
+                len = (token & 0x0F);
+
+                if (len == 15) {
+                        u8_t b;
+                        do {
+                                if (src >= send) {
+                                        return EILSEQ;
+                                }
+
+                                b    = *src++;
+                                len += b;
+                        } while (b == 255);
+                }
+
+                len += 4;
+
+                if (len > cast(size_t, dend - dcur)) {
+                        return EILSEQ;
+                }
+
+                /* byte copy: match can overlap with destination */
+                const u8_t *match = dcur - offset;
+                while (len--) {
+                        *dcur++ = *match++;
+                }
+        }
+
+        *outlen = dcur - dst;
+
+        return ESUCC;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
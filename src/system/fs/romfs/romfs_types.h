@@ -56,6 +56,7 @@ typedef enum {
         ROMFS_FILE_TYPE__NONE,
         ROMFS_FILE_TYPE__DIR,
         ROMFS_FILE_TYPE__FILE,
+        ROMFS_FILE_TYPE__CFILE,         /* compressed file, data is romfs_cfile_t */
 } romfs_file_type_t;
 
 typedef struct {
@@ -65,11 +66,29 @@ typedef struct {
         const char *name;
 } romfs_entry_t;
 
+/*
+ * Directory entries are sorted by name (byte order) by the generator,
+ * therefore entries can be found by using binary search.
+ */
 typedef struct {
         size_t items;
         romfs_entry_t entry[];
 } romfs_dir_t;
 
+/*
+ * Compressed file. File is split to blocks of block_size bytes (the last
+ * block can be shorter) and each block is compressed separately by using
+ * LZ4 block format. Block n is stored at data[index[n]] .. data[index[n+1]].
+ * If stored block size is equal to uncompressed block size then block is
+ * not compressed.
+ */
+typedef struct {
+        uint16_t block_size;
+        uint16_t blocks;
+        const uint32_t *index;
+        const uint8_t  *data;
+} romfs_cfile_t;
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -6,68 +6,178 @@ import re
 import hashlib
 
 try:
-    walk_dir = sys.argv[1]
-    dest_dir = sys.argv[2]
+    args       = [arg for arg in sys.argv[1:] if not arg.startswith("--")]
+    walk_dir   = args[0]
+    dest_dir   = args[1]
+    compress   = "--compress" in sys.argv
+    block_size = 1024
+
+    for arg in sys.argv[1:]:
+        if arg.startswith("--block-size="):
+            block_size = int(arg.split("=")[1])
+
+    if block_size < 64 or block_size > 32768:
+        raise ValueError
 except:
-    print("Usage: python romfsmap.py <source-dir> <output-dir>\n")
+    print("Usage: python romfsmap.py [--compress] [--block-size=<bytes>] <source-dir> <output-dir>\n")
     exit(1)
 
 file_dict  = {}
+cfile_dict = {}
 total_size = 0
+flash_size = 0
+
+
+def lz4_compress(src):
+    """Compress data to LZ4 block format (greedy, single hash table)."""
+
+    MINMATCH      = 4
+    LAST_LITERALS = 5
+    MFLIMIT       = 12
+
+    src    = bytearray(src)
+    n      = len(src)
+    out    = bytearray()
+    table  = {}
+    anchor = 0
+    i      = 0
+
+    def put_len(length):
+        while length >= 255:
+            out.append(255)
+            length -= 255
+        out.append(length)
+
+    def put_seq(literals, offset, mlen):
+        lit = len(literals)
+        token = (min(lit, 15) << 4) | (min(mlen - MINMATCH, 15) if mlen else 0)
+        out.append(token)
+        if lit >= 15:
+            put_len(lit - 15)
+        out.extend(literals)
+        if mlen:
+            out.append(offset & 0xFF)
+            out.append(offset >> 8)
+            if mlen - MINMATCH >= 15:
+                put_len(mlen - MINMATCH - 15)
+
+    while i + MFLIMIT <= n:
+        key  = bytes(src[i:i + MINMATCH])
+        cand = table.get(key)
+        table[key] = i
+
+        if cand is not None and i - cand <= 0xFFFF:
+            mlen  = MINMATCH
+            limit = n - LAST_LITERALS
+            while i + mlen < limit and src[cand + mlen] == src[i + mlen]:
+                mlen += 1
+
+            put_seq(src[anchor:i], i - cand, mlen)
+
+            i     += mlen
+            anchor = i
+        else:
+            i += 1
+
+    put_seq(src[anchor:], 0, 0)
+
+    return bytes(out)
+
+
+def carray(fout, name, ctype, values, fmt):
+    fout.write("const " + ctype + " " + name + "[" + str(len(values)) + "] = {\n    ")
+
+    ctr = 0
+    for val in values:
+        fout.write(fmt % val + ', ')
+        ctr = ctr + 1
+        if ctr >= 16:
+            fout.write('\n    ')
+            ctr = 0
+
+    fout.write("\n};\n\n")
 
 
 def file2carray(src_path, pointdir, filename):
 
     global file_dict
     global total_size
+    global flash_size
 
     filecontent = open(src_path, "rb").read()
-    total_size  = total_size + len(filecontent)
+    file_size   = len(filecontent)
+    total_size  = total_size + file_size
 
     hash_object = hashlib.sha1(filecontent)
     hash_name   = hash_object.hexdigest()
 
     outfile = os.path.join(dest_dir, hash_name) + '.c'
 
-    fout = open(outfile, "wb")
+    # compressed image: file is split to blocks compressed separately so
+    # each block can be decoded independently (random access)
+    blocks = []
+    if compress and len(filecontent) > 0:
+        for pos in range(0, len(filecontent), block_size):
+            raw = filecontent[pos:pos + block_size]
+            lz4 = lz4_compress(raw)
+            blocks.append(lz4 if len(lz4) < len(raw) else raw)
+
+    index = [0]
+    for block in blocks:
+        index.append(index[-1] + len(block))
+
+    compressed = bool(blocks) and (index[-1] + 4 * len(index) + 8 < len(filecontent))
+
+    if compressed:
+        filecontent = b"".join(blocks)
+
+    fout = open(outfile, "w")
     fout.write("// file generated\n")
     fout.write("// source file: " + src_path + '\n')
     fout.write("#include <stddef.h>\n")
-    fout.write("#include <stdint.h>\n\n")
+    fout.write("#include <stdint.h>\n")
+    if compressed:
+        fout.write('#include "romfs_types.h"\n')
+    fout.write("\n")
 
-    fout.write("const uint8_t romfsfile_" + hash_name + "["+ str(len(filecontent)) +"] = {\n    ")
+    carray(fout, "romfsfile_" + hash_name, "uint8_t", bytearray(filecontent), "0x%02x")
 
-    ctr = 0
-    for byte in filecontent:
-        fout.write('0x' + binascii.hexlify(byte) + ', ')
-        ctr = ctr + 1
-        if ctr >= 16:
-            fout.write('\n    ')
-            ctr = 0
+    if compressed:
+        carray(fout, "romfsfile_" + hash_name + "_index", "uint32_t", index, "%d")
 
-    fout.write("\n};\n\n")
+        fout.write("const romfs_cfile_t romfsfile_" + hash_name + "_cfile = {\n")
+        fout.write("    .block_size = " + str(block_size) + ",\n")
+        fout.write("    .blocks = " + str(len(blocks)) + ",\n")
+        fout.write("    .index = romfsfile_" + hash_name + "_index,\n")
+        fout.write("    .data = romfsfile_" + hash_name + ",\n")
+        fout.write("};\n\n")
+
+        flash_size = flash_size + len(filecontent) + 4 * len(index) + 8
+    else:
+        flash_size = flash_size + len(filecontent)
 
-    fout.write("const size_t romfsfile_" + hash_name + "_size = " + str(len(filecontent)) + ";\n")
+    fout.write("const size_t romfsfile_" + hash_name + "_size = " + str(file_size) + ";\n")
 
     fout.close()
 
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("               fs/romfs/" + outfile + '\\\n')
 
-    file_dict[src_path] = hash_name
+    file_dict[src_path]   = hash_name
+    cfile_dict[hash_name] = compressed
 
 
 def hashdir(dirname, subdirs, files):
 
     global file_dict
 
-    hash_object = hashlib.sha1(dirname)
+    hash_object = hashlib.sha1(dirname.encode("utf-8"))
 
     for subdir in subdirs:
-        hash_object.update(subdir)
+        hash_object.update(subdir.encode("utf-8"))
 
     for file in files:
-        hash_object.update(file)
+        hash_object.update(file.encode("utf-8"))
 
     hash_name = hash_object.hexdigest()
 
@@ -82,42 +192,51 @@ def dir2c(dirname, subdirs, files):
 
     outfile = os.path.join(dest_dir, "root" if dirname == "/" else file_dict[dirname]) + '.c'
 
-    fout = open(outfile, "wb")
+    fout = open(outfile, "w")
     fout.write("// file generated\n")
     fout.write("// source dir: " + walk_dir + dirname + '\n')
     fout.write("#include <stdint.h>\n")
     fout.write("#include <stddef.h>\n")
     fout.write('#include "romfs_types.h"\n\n')
 
+    # entries are sorted by name (byte order) for binary search lookup
+    entries = []
+
     for subdir in subdirs:
         name = file_dict[(dirname if dirname != "/" else "") + '/' + subdir]
+        entries.append((subdir, name, "DIR"))
         fout.write("extern const romfs_dir_t romfsdir_" + name + ";\n")
 
     for file in files:
         name = file_dict[walk_dir + (dirname if dirname != "/" else "") + '/' + file]
+        entries.append((file, name, "CFILE" if cfile_dict[name] else "FILE"))
         fout.write("extern const uint8_t romfsfile_" + name + "[];\n")
         fout.write("extern const size_t romfsfile_" + name + "_size;\n")
+        if cfile_dict[name]:
+            fout.write("extern const romfs_cfile_t romfsfile_" + name + "_cfile;\n")
+
+    entries.sort(key=lambda entry: entry[0].encode("utf-8"))
 
     fout.write("\n")
 
     name = "root" if dirname == "/" else file_dict[dirname]
 
     fout.write("const romfs_dir_t romfsdir_" + name + " = {\n")
-    fout.write("    .items = " + str(len(subdirs) + len(files)) + ",\n")
+    fout.write("    .items = " + str(len(entries)) + ",\n")
 
-    entry = 0
+    for entry, (fname, name, kind) in enumerate(entries):
+        fout.write("    .entry[" + str(entry) + "] = ")
 
-    for subdir in subdirs:
-        name = file_dict[(dirname if dirname != "/" else "") + '/' + subdir]
-        fout.write("    .entry[" + str(entry) + "] = {ROMFS_FILE_TYPE__DIR, NULL, &romfsdir_"
-                   + name + ', "' + subdir + '"},\n')
-        entry = entry + 1
+        if kind == "DIR":
+            fout.write("{ROMFS_FILE_TYPE__DIR, NULL, &romfsdir_" + name)
+        elif kind == "CFILE":
+            fout.write("{ROMFS_FILE_TYPE__CFILE, &romfsfile_" + name
+                       + "_size, &romfsfile_" + name + "_cfile")
+        else:
+            fout.write("{ROMFS_FILE_TYPE__FILE, &romfsfile_" + name
+                       + "_size, &romfsfile_" + name)
 
-    for file in files:
-        name = file_dict[walk_dir + (dirname if dirname != "/" else "") + '/' + file]
-        fout.write("    .entry[" + str(entry) + "] = {ROMFS_FILE_TYPE__FILE, &romfsfile_"
-                   + name + "_size, &romfsfile_" + name + ', "' + file + '"},\n')
-        entry = entry + 1
+        fout.write(', "' + fname + '"},\n')
 
     fout.write("};\n\n")
 
@@ -127,13 +246,13 @@ def dir2c(dirname, subdirs, files):
 
     fout.close()
 
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("               fs/romfs/" + outfile + '\\\n')
 
 
 def main():
     # prepare Makefile.in
-    with open(os.path.join(dest_dir, "Makefile.in"), "wb") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "w") as mk:
         mk.write("CSRC_CORE += $(sort\\\n")
 
 
@@ -169,10 +288,14 @@ def main():
 
 
     # prepare Makefile.in
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("              )\n")
 
 
+    print("romfs: %d files, %d bytes, %d bytes of file data in flash%s"
+          % (len(cfile_dict), total_size, flash_size,
+             " (compressed, %d B blocks)" % block_size if compress else ""))
+
     # DEBUG: print file hashes
     # for key, val in file_dict.iteritems(): print(key, val)
 
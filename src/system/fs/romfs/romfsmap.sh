@@ -4,9 +4,14 @@ root=$(pwd)
 
 mkdir -p res/romfs
 
+opts=""
+if grep -qE "^#define __ROMFS_CFG_COMPRESSION__ _YES_" "${root}/config/filesystems/romfs_flags.h"; then
+    opts="--compress"
+fi
+
 cd $(dirname $0)
 
 rm -rf data
 mkdir -p data
 
-/usr/bin/python romfsmap.py "${root}/res/romfs" data
+/usr/bin/env python3 romfsmap.py ${opts} "${root}/res/romfs" data
@@ -34,6 +34,7 @@
 #include <errno.h>
 #include <string.h>
 #include "fs/vfs.h"
+#include "mm/cache.h"
 #include "lib/llist.h"
 #include "kernel/kwrapper.h"
 #include "kernel/process.h"
@@ -67,14 +68,15 @@ static bool is_dir_valid     (DIR *dir);
 static int  parse_flags      (const char *str, u32_t *flags);
 static int  get_path_FS      (const char *path, size_t len, int *position, FS_entry_t **fs_entry);
 static int  get_path_base_FS (const char *path, const char **extPath, FS_entry_t **fs_entry);
+static int  find_path_base_FS(const char *path, const char **extPath, FS_entry_t **fs_entry);
 static int  new_absolute_path(const struct vfs_path *path, enum path_correction corr, char **new_path);
 
 /*==============================================================================
   Local object definitions
 ==============================================================================*/
 static struct {
-        llist_t *mnt_list;
-        mutex_t *resource_mtx;
+        llist_t  *mnt_list;
+        rwlock_t *mnt_lock;
 } VFS;
 
 /*==============================================================================
@@ -92,7 +94,11 @@ int _vfs_init(void)
 {
         int err = _llist_create_krn(_MM_KRN, NULL, NULL, &VFS.mnt_list);
         if (!err) {
-                err = _mutex_create(MUTEX_TYPE_RECURSIVE, &VFS.resource_mtx);
+                err = _rwlock_create(&VFS.mnt_lock);
+        }
+
+        if (!err) {
+                _rwlock_set_name(VFS.mnt_lock, "vfs");
         }
 
         return err;
@@ -176,7 +182,7 @@ int _vfs_mount(const struct vfs_path   *src_path,
         }
 
         // create new entry
-        err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+        err = _rwlock_write_lock(VFS.mnt_lock, MAX_DELAY_MS);
         if (not err) {
 
                 FS_entry_t *new_fs;
@@ -228,7 +234,7 @@ int _vfs_mount(const struct vfs_path   *src_path,
                         }
                 }
 
-                _mutex_unlock(VFS.resource_mtx);
+                _rwlock_write_unlock(VFS.mnt_lock);
         }
 
         finish:
@@ -261,7 +267,7 @@ int _vfs_umount(const struct vfs_path *path)
         char *cwd_path;
         int err = new_absolute_path(path, ADD_SLASH, &cwd_path);
         if (not err) {
-                err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+                err = _rwlock_write_lock(VFS.mnt_lock, MAX_DELAY_MS);
                 if (not err) {
 
                         int         position;
@@ -279,7 +285,7 @@ int _vfs_umount(const struct vfs_path *path)
                                 }
                         }
 
-                        _mutex_unlock(VFS.resource_mtx);
+                        _rwlock_write_unlock(VFS.mnt_lock);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -306,11 +312,11 @@ int _vfs_getmntentry(int seek, struct mntent *mntent)
         }
 
         FS_entry_t *fs = NULL;
-        int err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+        int err = _rwlock_read_lock(VFS.mnt_lock, MAX_DELAY_MS);
         if (!err) {
                 fs  = _llist_at(VFS.mnt_list, seek);
                 err = fs ? ESUCC : ENOENT;
-                _mutex_unlock(VFS.resource_mtx);
+                _rwlock_read_unlock(VFS.mnt_lock);
         }
 
         if (!err) {
@@ -599,21 +605,21 @@ int _vfs_remove(const struct vfs_path *path)
                 FS_entry_t *mount_fs;
                 FS_entry_t *base_fs;
 
-                err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+                // mount point check and parent FS lookup under single read lock
+                err = _rwlock_read_lock(VFS.mnt_lock, MAX_DELAY_MS);
                 if (!err) {
-
                         err = get_path_FS(cwd_path, PATH_MAX_LEN, NULL, &mount_fs);
+
                         if (err == ENOENT) {
                                 // remove slash at the end
                                 LAST_CHARACTER(cwd_path) = '\0';
 
-                                // get parent FS
-                                err = get_path_base_FS(cwd_path, &external_path, &base_fs);
+                                err = find_path_base_FS(cwd_path, &external_path, &base_fs);
                         } else {
                                 err = EBUSY;
                         }
 
-                        _mutex_unlock(VFS.resource_mtx);
+                        _rwlock_read_unlock(VFS.mnt_lock);
                 }
 
                 if (!err) {
@@ -660,13 +666,15 @@ int _vfs_rename(const struct vfs_path *old_name, const struct vfs_path *new_name
                 const char *old_extern_path;
                 const char *new_extern_path;
 
-                err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+                // both paths are resolved in the same mount table state
+                err = _rwlock_read_lock(VFS.mnt_lock, MAX_DELAY_MS);
                 if (!err) {
-                        err = get_path_base_FS(cwd_old_name, &old_extern_path, &old_fs);
+                        err = find_path_base_FS(cwd_old_name, &old_extern_path, &old_fs);
                         if (!err) {
-                                err = get_path_base_FS(cwd_new_name, &new_extern_path, &new_fs);
+                                err = find_path_base_FS(cwd_new_name, &new_extern_path, &new_fs);
                         }
-                        _mutex_unlock(VFS.resource_mtx);
+
+                        _rwlock_read_unlock(VFS.mnt_lock);
                 }
 
                 if (!err) {
@@ -945,6 +953,14 @@ int _vfs_fclose(FILE *file, bool force)
         int err = EINVAL;
 
         if (is_file_valid(file) && file->FS_if->fs_close) {
+                // device list of cache is not searched for regular files
+                if (file->f_flag.cached) {
+                        err = _cache_drop(file, force);
+                        if (err && !force) {
+                                return err;
+                        }
+                }
+
                 err = file->FS_if->fs_close(file->FS_hdl, file->f_hdl, force);
                 if (!err) {
                         file->header.type = RES_TYPE_UNKNOWN;
@@ -1287,14 +1303,16 @@ int _vfs_ferror(FILE *file, int *error)
 //==============================================================================
 void _vfs_sync(void)
 {
-        if (_mutex_lock(VFS.resource_mtx, MAX_DELAY_MS) == ESUCC) {
+        if (_rwlock_read_lock(VFS.mnt_lock, MAX_DELAY_MS) == ESUCC) {
 
                 _llist_foreach(FS_entry_t*, fs, VFS.mnt_list) {
                         fs->interface->fs_sync(fs->handle);
                 }
 
-                _mutex_unlock(VFS.resource_mtx);
+                _rwlock_read_unlock(VFS.mnt_lock);
         }
+
+        _cache_sync();
 }
 
 //==============================================================================
@@ -1511,6 +1529,32 @@ static int get_path_FS(const char *path, size_t len, int *position, FS_entry_t *
  */
 //==============================================================================
 static int get_path_base_FS(const char *path, const char **ext_path, FS_entry_t **fs_entry)
+{
+        // many lookups can be done at the same time, only mount and umount
+        // take lock exclusively
+        int err = _rwlock_read_lock(VFS.mnt_lock, MAX_DELAY_MS);
+        if (!err) {
+                err = find_path_base_FS(path, ext_path, fs_entry);
+                _rwlock_read_unlock(VFS.mnt_lock);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function returned the base file system of selected path. The external
+ *        path is passed by pointer ext_path.
+ *        Function shall be called when mount table read lock is taken.
+ *
+ * @param[in]  path           path to FS
+ * @param[out] ext_path       pointer to external part of path (can be NULL)
+ * @param[out] fs_entry       file system entry
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int find_path_base_FS(const char *path, const char **ext_path, FS_entry_t **fs_entry)
 {
         const char *path_tail = path + strlen(path);
 
@@ -1518,19 +1562,15 @@ static int get_path_base_FS(const char *path, const char **ext_path, FS_entry_t
                 path_tail--;
         }
 
-        int err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
-        if (!err) {
+        int err = ENOENT;
 
-                while (path_tail >= path) {
-                        err = get_path_FS(path, path_tail - path + 1, NULL, fs_entry);
-                        if (!err) {
-                                break;
-                        } else {
-                                while (*(--path_tail) != '/' && path_tail >= path);
-                        }
+        while (path_tail >= path) {
+                err = get_path_FS(path, path_tail - path + 1, NULL, fs_entry);
+                if (!err) {
+                        break;
+                } else {
+                        while (*(--path_tail) != '/' && path_tail >= path);
                 }
-
-                _mutex_unlock(VFS.resource_mtx);
         }
 
         if (!err && ext_path) {
@@ -45,6 +45,8 @@ extern "C" {
 #       include "stm32f4/cpuctl.h"
 #elif defined(ARCH_efr32)
 #       include "efr32/cpuctl.h"
+#elif defined(ARCH_posix)
+#       include "posix/cpuctl.h"
 #endif
 
 /*==============================================================================
@@ -62,9 +62,24 @@ extern "C" {
  */
 #define IOCTL_STORAGE__READ_MBR         _IO(STORAGE, 0x01)
 
+/**
+ *  @brief  Discard sectors that are no longer used by file system (TRIM)
+ *  @param  [WR] @ref STORAGE_discard_t*  range of sectors (relative to volume)
+ *  @return On success (sectors discarded) 0 is returned.
+ *          On error -1 is returned and errno is set.
+ */
+#define IOCTL_STORAGE__DISCARD          _IOW(STORAGE, 0x02, const STORAGE_discard_t*)
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
+/**
+ * Range of sectors to discard.
+ */
+typedef struct {
+        u32_t sector;                   /*!< First sector to discard.*/
+        u32_t count;                    /*!< Number of sectors to discard.*/
+} STORAGE_discard_t;
 
 /*==============================================================================
   Exported objects
@@ -223,6 +223,7 @@ typedef struct vfs_file_flags {
         bool                eof    :1;          //! end of file
         bool                error  :1;          //! error occurred
         bool                seekmod:1;          //! file position modified
+        bool                cached;             //! device blocks can be in cache (set by cache)
         struct vfs_fattr    fattr;
 } vfs_file_flags_t;
 
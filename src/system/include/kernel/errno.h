@@ -91,8 +91,9 @@ extern "C" {
 #define ECONNRESET      40      //!< Connection reset (POSIX.1)
 #define EISCONN         41      //!< Socket is connected (POSIX.1)
 #define EALREADY        42      //!< Connection already in progress
+#define EPIPE           43      //!< Broken pipe
 #ifndef DOXYGEN
-#define _ENUMBER        43      //!< total supported errors
+#define _ENUMBER        44      //!< total supported errors
 #endif
 
 /*==============================================================================
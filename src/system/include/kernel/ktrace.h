@@ -0,0 +1,142 @@
+/*=========================================================================*//**
+@file    ktrace.h
+
+@author  Daniel Zorychta
+
+@brief   Kernel event tracer.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _KTRACE_H_
+#define _KTRACE_H_
+
+#ifdef __cplusplus
+   extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdbool.h>
+#include <sys/types.h>
+#include "config.h"
+
+/*==============================================================================
+  Exported symbolic constants/macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported types, enums definitions
+==============================================================================*/
+/**
+ * Trace event types. Values are used in /proc/trace file, thus new types
+ * should be added at the end of list.
+ */
+typedef enum {
+        _TRACE_EVENT_HEADER,            //!< dump header: arg32 = time stamp frequency [Hz]
+        _TRACE_EVENT_TASK_SWITCHED_IN,  //!< arg16 = PID, arg32 = task
+        _TRACE_EVENT_TASK_SWITCHED_OUT, //!< arg16 = PID, arg32 = task
+        _TRACE_EVENT_BLOCK_ON_RECEIVE,  //!< arg32 = queue/semaphore/mutex
+        _TRACE_EVENT_BLOCK_ON_SEND,     //!< arg32 = queue/semaphore
+        _TRACE_EVENT_TASK_READY,        //!< arg32 = task moved to ready list
+        _TRACE_EVENT_SEND_FROM_ISR,     //!< arg32 = queue/semaphore
+        _TRACE_EVENT_RECEIVE_FROM_ISR,  //!< arg32 = queue/semaphore
+        _TRACE_EVENT_ISR_ENTER,         //!< arg16 = IRQ number
+        _TRACE_EVENT_ISR_EXIT,          //!< arg16 = IRQ number
+        _TRACE_EVENT_SYSCALL_ENTER,     //!< arg16 = syscall number, arg32 = client PID
+        _TRACE_EVENT_SYSCALL_EXIT,      //!< arg16 = syscall number, arg32 = error code
+        _TRACE_EVENT_PROCESS_NAME,      //!< dump only: arg16 = PID, process name instead of arg32
+} _trace_event_type_t;
+
+/**
+ * Single trace event (12 bytes).
+ */
+typedef struct {
+        u32_t timestamp;                //!< cycle counter value
+        u8_t  type;                     //!< event type (_trace_event_type_t)
+        u8_t  reserved;                 //!< not used
+        u16_t arg16;                    //!< event argument
+        u32_t arg32;                    //!< event argument
+} _trace_event_t;
+
+/*==============================================================================
+  Exported object declarations
+==============================================================================*/
+
+/*==============================================================================
+  Exported function prototypes
+==============================================================================*/
+#if __OS_ENABLE_TRACE__ > 0
+extern void   _trace_start(void);
+extern void   _trace_stop(void);
+extern void   _trace_clear(void);
+extern bool   _trace_is_enabled(void);
+extern void   _trace_event(u8_t type, u16_t arg16, u32_t arg32);
+extern size_t _trace_get_count(void);
+extern int    _trace_get_event_seek(size_t seek, _trace_event_t *event);
+#endif
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief  Function record beginning of interrupt handler. Function should be
+ *         called at the beginning of interrupt handler that should be traced.
+ *
+ * @param  irq          IRQ number
+ */
+//==============================================================================
+static inline void _trace_ISR_enter(u16_t irq)
+{
+#if __OS_ENABLE_TRACE__ > 0
+        _trace_event(_TRACE_EVENT_ISR_ENTER, irq, 0);
+#else
+        (void)irq;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function record end of interrupt handler. Function should be called
+ *         at the end of interrupt handler that should be traced.
+ *
+ * @param  irq          IRQ number
+ */
+//==============================================================================
+static inline void _trace_ISR_exit(u16_t irq)
+{
+#if __OS_ENABLE_TRACE__ > 0
+        _trace_event(_TRACE_EVENT_ISR_EXIT, irq, 0);
+#else
+        (void)irq;
+#endif
+}
+
+#ifdef __cplusplus
+   }
+#endif
+
+#endif /* _KTRACE_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
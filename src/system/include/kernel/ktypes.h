@@ -62,7 +62,8 @@ typedef enum {
         RES_TYPE_DIR           = 0x19586E97,
         RES_TYPE_MEMORY        = 0x9E834645,
         RES_TYPE_SOCKET        = 0x63ACC316,
-        RES_TYPE_FLAG          = 0x18FAEC0D
+        RES_TYPE_FLAG          = 0x18FAEC0D,
+        RES_TYPE_RWLOCK        = 0x6A3F52D1
 } res_type_t;
 
 /** KERNELSPACE: object header (must be the first in object) */
@@ -82,6 +83,9 @@ typedef struct {
         res_header_t      header;
         void             *object;
         StaticSemaphore_t buffer;
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        u8_t              prof;         //!< lock profiler entry
+#endif
 } sem_t;
 
 /** KERNELSPACE/USERSPACE: queue type */
@@ -89,17 +93,44 @@ typedef struct {
         res_header_t  header;
         void         *object;
         StaticQueue_t buffer;
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        u8_t          prof;             //!< lock profiler entry
+#endif
         uint8_t       storage[];
 } queue_t;
 
 /** KERNELSPACE/USERSPACE: mutex type */
 typedef struct {
         res_header_t      header;
-        void             *object;
+        void             *object;       //!< semaphore of waiting tasks
         StaticSemaphore_t buffer;
+        uintptr_t         owner;        //!< owner task and waiters flag
+        u16_t             nesting;      //!< recursive lock nesting of owner
+        u16_t             waiters;      //!< number of waiting tasks
         bool              recursive;
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        u8_t              prof;         //!< lock profiler entry
+        u32_t             locked_at;    //!< time stamp of the outermost lock
+#endif
 } mutex_t;
 
+/** KERNELSPACE: reader-writer lock type */
+typedef struct {
+        res_header_t      header;
+        void             *object;       //!< writer mutex (priority inheritance)
+        StaticSemaphore_t buffer;
+        void             *drain;        //!< signaled by the last leaving reader
+        StaticSemaphore_t drain_buffer;
+        void             *writer;       //!< task that holds write lock
+        u16_t             readers;      //!< number of readers
+        u16_t             nesting;      //!< lock nesting of writer
+        bool              drain_wait;   //!< writer waits for readers
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        u8_t              prof;         //!< lock profiler entry
+        u32_t             locked_at;    //!< time stamp of write lock
+#endif
+} rwlock_t;
+
 /** KERNELSPACE: flag type */
 typedef struct {
         res_header_t       header;
@@ -68,6 +68,9 @@ extern "C" {
 #define PRIORITY_NORMAL                 0
 #define PRIORITY_HIGHEST                ((int)(configMAX_PRIORITIES / 2))
 
+/** MUTEX OWNER FLAG: tasks wait for mutex, unlock must enter kernel */
+#define _MUTEX_WAITERS                  ((uintptr_t)1)
+
 /*==============================================================================
   Exported types, enums definitions
 ==============================================================================*/
@@ -77,6 +80,17 @@ enum mutex_type {
         MUTEX_TYPE_NORMAL
 };
 
+/** KERNELSPACE: lock statistics (lock profiler) */
+typedef struct {
+        const char *name;               //!< lock name
+        u32_t       acquires;           //!< number of successful acquires
+        u32_t       contended;          //!< number of acquires that found lock taken
+        u32_t       timeouts;           //!< number of failed acquires
+        u32_t       wait_total;         //!< total wait time [us]
+        u32_t       wait_max;           //!< max wait time [us]
+        u32_t       hold_max;           //!< max hold time [us] (mutexes and scheduler lock)
+} _lock_prof_t;
+
 /*==============================================================================
   Exported object declarations
 ==============================================================================*/
@@ -105,6 +119,7 @@ extern char    *_task_get_name                     (task_t*);
 extern int      _task_get_priority                 (task_t*);
 extern void     _task_set_priority                 (task_t*, const int);
 extern int      _task_get_free_stack               (task_t*);
+extern size_t   _task_get_stack_usage              (task_t*, size_t);
 extern void     _task_yield                        (void);
 extern void     _task_yield_from_ISR               (bool);
 extern task_t  *_task_get_handle                   (void);
@@ -118,11 +133,21 @@ extern int      _semaphore_signal                  (sem_t*);
 extern int      _semaphore_get_value               (sem_t *sem, size_t *value);
 extern int      _semaphore_wait_from_ISR           (sem_t*, bool*);
 extern int      _semaphore_signal_from_ISR         (sem_t*, bool*);
+extern int      _semaphore_set_name                (sem_t*, const char*);
 
 extern int      _mutex_create                      (enum mutex_type, mutex_t**);
 extern int      _mutex_destroy                     (mutex_t*);
 extern int      _mutex_lock                        (mutex_t*, const u32_t);
 extern int      _mutex_unlock                      (mutex_t*);
+extern int      _mutex_set_name                    (mutex_t*, const char*);
+
+extern int      _rwlock_create                     (rwlock_t**);
+extern int      _rwlock_destroy                    (rwlock_t*);
+extern int      _rwlock_read_lock                  (rwlock_t*, const u32_t);
+extern int      _rwlock_read_unlock                (rwlock_t*);
+extern int      _rwlock_write_lock                 (rwlock_t*, const u32_t);
+extern int      _rwlock_write_unlock               (rwlock_t*);
+extern int      _rwlock_set_name                   (rwlock_t*, const char*);
 
 extern int      _flag_create                       (flag_t**);
 extern int      _flag_destroy                      (flag_t*);
@@ -143,6 +168,10 @@ extern int      _queue_receive_peek                (queue_t*, void*, const u32_t
 extern int      _queue_get_number_of_items         (queue_t*, size_t*);
 extern int      _queue_get_number_of_items_from_ISR(queue_t*, size_t*);
 extern int      _queue_get_space_available         (queue_t*, size_t*);
+extern int      _queue_set_name                    (queue_t*, const char*);
+
+extern int      _lock_prof_get                     (uint, _lock_prof_t*);
+extern int      _lock_prof_reset                   (void);
 
 extern void     _critical_section_begin            (void);
 extern void     _critical_section_end              (void);
@@ -158,6 +187,85 @@ extern void     _sleep_until                       (const u32_t, u32_t*);
 /*==============================================================================
   Exported inline functions
 ==============================================================================*/
+//==============================================================================
+/**
+ * @brief  Function lock free or recursively owned mutex without entering the
+ *         kernel (atomic compare-and-swap of owner). When function fails the
+ *         _mutex_lock() shall be called.
+ *
+ * @param  mutex        mutex object
+ * @param  task         current task (NULL forces kernel path)
+ *
+ * @return On success true is returned, otherwise false.
+ */
+//==============================================================================
+static inline bool _mutex_fast_lock(mutex_t *mutex, task_t *task)
+{
+#if __OS_ENABLE_LOCK_PROFILER__ == _NO_
+        // full object validation is done by the kernel when fast path fails
+        if (!task || (mutex->header.type != RES_TYPE_MUTEX)) {
+                return false;
+        }
+
+        // plain load first, owned mutex is not written by atomic operation
+        uintptr_t owner = __atomic_load_n(&mutex->owner, __ATOMIC_RELAXED);
+
+        if (  (owner == 0)
+           && __atomic_compare_exchange_n(&mutex->owner, &owner, (uintptr_t)task, false,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                return true;
+        }
+
+        // only owner can see itself in the owner field
+        if (mutex->recursive && ((owner & ~_MUTEX_WAITERS) == (uintptr_t)task)) {
+                mutex->nesting++;
+                return true;
+        }
+#else
+        (void)mutex;
+        (void)task;
+#endif
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function unlock mutex without entering the kernel. Function fails
+ *         if tasks wait for mutex or task is not an owner. When function fails
+ *         the _mutex_unlock() shall be called.
+ *
+ * @param  mutex        mutex object
+ * @param  task         current task (NULL forces kernel path)
+ *
+ * @return On success true is returned, otherwise false.
+ */
+//==============================================================================
+static inline bool _mutex_fast_unlock(mutex_t *mutex, task_t *task)
+{
+#if __OS_ENABLE_LOCK_PROFILER__ == _NO_
+        if (!task || (mutex->header.type != RES_TYPE_MUTEX)) {
+                return false;
+        }
+
+        uintptr_t owner = (uintptr_t)task;
+
+        if ((__atomic_load_n(&mutex->owner, __ATOMIC_RELAXED) & ~_MUTEX_WAITERS) != owner) {
+                return false;
+        }
+
+        if (mutex->nesting) {
+                mutex->nesting--;
+                return true;
+        }
+
+        return __atomic_compare_exchange_n(&mutex->owner, &owner, 0, false,
+                                           __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+#else
+        (void)mutex;
+        (void)task;
+        return false;
+#endif
+}
 
 #ifdef __cplusplus
 }
@@ -160,6 +160,15 @@ typedef struct {
         bool   detached;                //!< independent thread (without join possibility)
 } thread_attr_t;
 
+/** KERNELSPACE: peak stack usage of program thread (stack profiler) */
+typedef struct {
+        const char   *name;             //!< program name
+        thread_func_t entry;            //!< thread function (NULL for main thread)
+        size_t        stack_depth;      //!< requested stack depth
+        size_t        max_usage;        //!< peak stack usage
+        u32_t         runs;             //!< number of finished runs
+} _process_stack_prof_t;
+
 /** USERSPACE: average CPU load */
 typedef struct {
         u16_t avg1sec;                  //!< average CPU laod within 1 second (1% = 10)
@@ -175,7 +184,9 @@ extern FILE                     *stdin;
 extern FILE                     *stdout;
 extern FILE                     *stderr;
 extern struct _GVAR_STRUCT_NAME *global;
+extern struct _uheap            *_uheap;
 extern int                      _errno;
+extern task_t                   *_active_task;
 extern const struct _prog_data  _prog_table[];
 extern const int                _prog_table_size;
 
@@ -203,6 +214,7 @@ extern int         _process_get_priority                (pid_t, int*);
 extern int         _process_get_container               (pid_t, _process_t**);
 extern int         _process_get_stat_seek               (size_t, process_stat_t*);
 extern int         _process_get_stat_pid                (pid_t, process_stat_t*);
+extern int         _process_get_stack_prof              (size_t, _process_stack_prof_t*);
 extern tid_t       _process_get_active_thread           (void);
 extern pid_t       _process_get_active_process_pid      (void);
 extern u8_t        _process_get_max_threads             (_process_t*);
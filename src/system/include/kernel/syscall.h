@@ -154,11 +154,47 @@ typedef enum {// NAME                      | RETURN TYPE    | ARG 1
         SYSCALL_NETSENDTO,              // | int            | SOCKET *socket            | const void *buf                     | size_t *len               | NET_flags_t *flags        | const NET_generic_sockaddr_t *to_sockaddr |
         SYSCALL_NETRECVFROM,            // | int            | SOCKET *socket            | void *buf                           | size_t *len               | NET_flags_t *flags        | NET_generic_sockaddr_t *from_sockaddr     |
         SYSCALL_NETGETADDRESS,          // | int            | SOCKET *socket            | NET_generic_sockaddr_t *addr        |                           |                           |                                           |
+        SYSCALL_NETRECVVIEW,            // | int            | SOCKET *socket            | NET_recv_view_t *view               |                           |                           |                                           |
+        SYSCALL_NETRECVRELEASE,         // | int            | SOCKET *socket            |                                     |                           |                           |                                           |
+        SYSCALL_NETSENDMSG,             // | int            | SOCKET *socket            | NET_msg_t *msg                      | size_t *count             | NET_flags_t *flags        |                                           |
     #endif
 #define _SYSCALL_GROUP_1_BLOCKING       _SYSCALL_COUNT // network group ----------------+-------------------------------------+---------------------------+---------------------------+-------------------------------------------+
         _SYSCALL_COUNT
 } syscall_t;
 
+#if __OS_TASK_KWORKER_MODE__ == 1
+/** Syscall classes handled by separate queues of kworker I/O threads. */
+enum _syscall_class {
+        _SYSCALL_CLASS_FS,              //!< file system and OS operations (fast)
+        _SYSCALL_CLASS_BLOCK,           //!< file data and device operations (slow)
+        _SYSCALL_CLASS_NET,             //!< network operations
+        _SYSCALL_CLASS_COUNT
+};
+
+/** Statistics of single syscall class queue. */
+typedef struct {
+        u32_t requests;                 //!< number of handled requests
+        u32_t depth;                    //!< number of waiting requests
+        u32_t depth_max;                //!< maximum number of waiting requests
+        u32_t busy;                     //!< number of threads handling requests
+        u32_t wait_max_ms;              //!< maximum time of waiting in queue
+        u64_t wait_total_ms;            //!< total time of waiting in queue
+} _syscall_class_stat_t;
+
+/** Statistics of kworker I/O thread pool. */
+typedef struct {
+        _syscall_class_stat_t class[_SYSCALL_CLASS_COUNT];
+        u32_t threads;                  //!< number of running threads
+        u32_t threads_idle;             //!< number of idle threads
+        u32_t threads_min;              //!< minimum number of threads
+        u32_t threads_max;              //!< maximum number of threads
+        u32_t threads_peak;             //!< maximum number of running threads
+        u32_t spawned;                  //!< number of threads started on demand
+        u32_t reaped;                   //!< number of threads stopped after idle timeout
+        u32_t spawn_failed;             //!< number of failed thread starts
+} _syscall_kworker_stat_t;
+#endif
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -173,6 +209,9 @@ extern pid_t _syscall_client_PID[__OS_TASK_MAX_SYSTEM_THREADS__];
 extern void syscall(syscall_t syscall, void *retptr, ...);
 extern int  _syscall_init();
 extern int  _syscall_kworker_process(int, char**);
+#if __OS_TASK_KWORKER_MODE__ == 1
+extern void _syscall_get_kworker_stat(_syscall_kworker_stat_t*);
+#endif
 
 /*==============================================================================
   Exported inline functions
@@ -58,8 +58,12 @@
 #include "kernel/kwrapper.h"
 #include "kernel/time.h"
 #include "kernel/process.h"
+#include "kernel/ktrace.h"
 #include "kernel/syscall.h"
 #include "fs/vfs.h"
+#include "mm/cache.h"
+#include "mm/shrinker.h"
+#include "net/netm.h"
 #include "drivers/drvctrl.h"
 #include "cpu/cpuctl.h"
 
@@ -107,6 +111,21 @@ extern "C" {
 #define O_APPEND                                02000
 #endif /* DOXYGEN */
 
+/**
+ * @brief Internal RAM region type (accessible by DMA).
+ */
+#define MEM_REGION_INTERNAL                     _MM_REGION_INTERNAL
+
+/**
+ * @brief Fast RAM region type, e.g. CCM (not accessible by DMA).
+ */
+#define MEM_REGION_FAST                         _MM_REGION_FAST
+
+/**
+ * @brief External RAM region type, e.g. SDRAM (large, slow).
+ */
+#define MEM_REGION_EXTERNAL                     _MM_REGION_EXTERNAL
+
 /**
  * @brief List's @b foreach loop.
  *
@@ -222,6 +241,17 @@ typedef struct {} llist_t;
  */
 typedef _mm_region_t mem_region_t;
 
+/**
+ * @brief Kind of memory region. Selects which memory purposes use region
+ *        (see memory region allocation policy in OS configuration).
+ */
+typedef enum _mm_region_type mem_region_type_t;
+
+/**
+ * @brief Memory shrinker object. Fields of object are private.
+ */
+typedef _mm_shrinker_t shrinker_t;
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -2991,6 +3021,235 @@ static inline int sys_fflush(FILE *file)
         return _vfs_fflush(file);
 }
 
+//==============================================================================
+/**
+ * @brief Function reads blocks from device file by using block cache.
+ *
+ * The function reads <i>blkcnt</i> blocks of size <i>blksz</i> starting from
+ * block <i>blkpos</i> of device <i>file</i>. Blocks that are not cached are
+ * read from device and stored in the cache. Sequential reads are detected
+ * and next blocks are read ahead.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ * @param blkpos        first block position
+ * @param blksz         block size
+ * @param blkcnt        number of blocks
+ * @param buf           destination buffer
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        u8_t sector[512];
+        int err = sys_cache_read(hdl->dev, 0, sizeof(sector), 1, sector);
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_write(), sys_cache_flush()
+ */
+//==============================================================================
+static inline int sys_cache_read(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, void *buf)
+{
+        return _cache_read(file, blkpos, blksz, blkcnt, buf);
+}
+
+//==============================================================================
+/**
+ * @brief Function writes blocks to device file by using block cache.
+ *
+ * The function writes <i>blkcnt</i> blocks of size <i>blksz</i> starting from
+ * block <i>blkpos</i> of device <i>file</i>. In CACHE_WRITE_THROUGH mode
+ * data is written to the device immediately. In CACHE_WRITE_BACK mode data
+ * is written at synchronization or when block is evicted from cache.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ * @param blkpos        first block position
+ * @param blksz         block size
+ * @param blkcnt        number of blocks
+ * @param buf           source buffer
+ * @param mode          write mode
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        u8_t sector[512];
+        memset(sector, 0, sizeof(sector));
+
+        int err = sys_cache_write(hdl->dev, 0, sizeof(sector), 1, sector,
+                                  CACHE_WRITE_BACK);
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_read(), sys_cache_flush()
+ */
+//==============================================================================
+static inline int sys_cache_write(FILE *file, u32_t blkpos, size_t blksz,
+                                  size_t blkcnt, const void *buf, enum cache_mode mode)
+{
+        return _cache_write(file, blkpos, blksz, blkcnt, buf, mode);
+}
+
+//==============================================================================
+/**
+ * @brief Function configures caching of device file.
+ *
+ * The function sets maximum readahead window and maximum number of adjacent
+ * dirty blocks merged into single device write. Function is used by file
+ * systems to apply mount options.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ * @param blksz         block size
+ * @param readahead     maximum readahead window in blocks (0: disabled)
+ * @param coalesce      maximum number of blocks in single write (1: disabled)
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        int ra = sys_stropt_get_int(opts, "readahead", 8);
+        int wc = sys_stropt_get_int(opts, "coalesce", 8);
+
+        int err = sys_cache_configure(hdl->dev, 512, ra, wc);
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_read(), sys_cache_write(), sys_cache_flush()
+ */
+//==============================================================================
+static inline int sys_cache_configure(FILE *file, size_t blksz, u32_t readahead, u32_t coalesce)
+{
+        return _cache_configure(file, blksz, readahead, coalesce);
+}
+
+//==============================================================================
+/**
+ * @brief Function sets notification of device block writes.
+ *
+ * The notification is called each time blocks of device file are physically
+ * written (write-through, flush or eviction), not when data is only stored in
+ * the cache. Notification is called with cache locks held, so it must be
+ * short and must not use the cache.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ * @param blksz         block size
+ * @param cb            notification function (NULL: disabled)
+ * @param arg           notification argument
+ *
+ * @return One of @ref errno value. ENOENT if cache is disabled (all writes go
+ *         directly to the device).
+ *
+ * @b Example
+ * @code
+        // ...
+
+        static void count_writes(void *arg, u32_t blkpos, size_t blkcnt)
+        {
+                foofs_t *hdl = arg;
+                hdl->writes += blkcnt;
+        }
+
+        // ...
+
+        int err = sys_cache_set_write_callback(hdl->dev, 512, count_writes, hdl);
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_write(), sys_cache_configure()
+ */
+//==============================================================================
+static inline int sys_cache_set_write_callback(FILE *file, size_t blksz, cache_write_cb_t cb, void *arg)
+{
+        return _cache_set_write_callback(file, blksz, cb, arg);
+}
+
+//==============================================================================
+/**
+ * @brief Function writes all cached dirty blocks of device file.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        API_FS_SYNC(foofs, void *fs_handle)
+        {
+                foofs_t *hdl = fs_handle;
+                return sys_cache_flush(hdl->dev);
+        }
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_read(), sys_cache_write()
+ */
+//==============================================================================
+static inline int sys_cache_flush(FILE *file)
+{
+        return _cache_flush(file);
+}
+
+//==============================================================================
+/**
+ * @brief Function releases cached blocks of discarded device region.
+ *
+ * Cached blocks (also not written ones) that are entirely in the region are
+ * released. Function should be called before the region is discarded by the
+ * device (e.g. @ref IOCTL_STORAGE__DISCARD request).
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          device file
+ * @param blkpos        first block position
+ * @param blksz         block size
+ * @param blkcnt        number of blocks
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        int err = sys_cache_discard(hdl->dev, sector, 512, count);
+        if (!err) {
+                STORAGE_discard_t discard = {.sector = sector, .count = count};
+                err = sys_ioctl(hdl->dev, IOCTL_STORAGE__DISCARD, &discard);
+        }
+
+        // ...
+   @endcode
+ *
+ * @see sys_cache_write(), sys_cache_flush()
+ */
+//==============================================================================
+static inline int sys_cache_discard(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt)
+{
+        return _cache_discard(file, blkpos, blksz, blkcnt);
+}
+
 //==============================================================================
 /**
  * @brief Function tests the end-of-file indicator.
@@ -4038,6 +4297,22 @@ static inline int sys_semaphore_signal(sem_t *sem)
         return _semaphore_signal(sem);
 }
 
+//==============================================================================
+/**
+ * @brief  Function set semaphore name used by lock profiler. Objects with the same
+ *         name are accounted together. Name is not copied.
+ *
+ * @param  sem      semaphore
+ * @param  name     semaphore name (static string)
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_semaphore_set_name(sem_t *sem, const char *name)
+{
+        return _semaphore_set_name(sem, name);
+}
+
 //==============================================================================
 /**
  * @brief Function wait for semaphore from ISR.
@@ -4781,6 +5056,22 @@ static inline int sys_mutex_unlock(mutex_t *mutex)
         return _mutex_unlock(mutex);
 }
 
+//==============================================================================
+/**
+ * @brief  Function set mutex name used by lock profiler. Objects with the same
+ *         name are accounted together. Name is not copied.
+ *
+ * @param  mutex    mutex
+ * @param  name     mutex name (static string)
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_mutex_set_name(mutex_t *mutex, const char *name)
+{
+        return _mutex_set_name(mutex, name);
+}
+
 //==============================================================================
 /**
  * @brief Function create new queue.
@@ -4825,6 +5116,22 @@ static inline int sys_queue_reset(queue_t *queue)
         return _queue_reset(queue);
 }
 
+//==============================================================================
+/**
+ * @brief  Function set queue name used by lock profiler. Objects with the same
+ *         name are accounted together. Name is not copied.
+ *
+ * @param  queue    queue
+ * @param  name     queue name (static string)
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_queue_set_name(queue_t *queue, const char *name)
+{
+        return _queue_set_name(queue, name);
+}
+
 //==============================================================================
 /**
  * @brief Function send queue.
@@ -5014,6 +5321,80 @@ static inline size_t sys_get_mem_size()
         return _mm_get_mem_size();
 }
 
+//==============================================================================
+/**
+ * @brief  Function return information about memory region: address, size,
+ *         type, and memory usage of each memory purpose. Regions are numbered
+ *         in order of registration.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  region       region number
+ * @param  stat         region information
+ *
+ * @return One of @ref errno value (EINVAL if region does not exist).
+ */
+//==============================================================================
+static inline int sys_get_mem_region_stat(uint region, _mm_region_stat_t *stat)
+{
+        return _mm_get_region_stat(region, stat);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return allocation statistics of selected call site
+ *         recorded by allocation profiler. Call sites are numbered in order
+ *         of first allocation.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  site         call site number
+ * @param  stat         call site statistics
+ *
+ * @return One of @ref errno value (EINVAL if call site does not exist,
+ *         ENOTSUP if profiler is disabled).
+ */
+//==============================================================================
+static inline int sys_get_alloc_site(uint site, _mm_alloc_site_t *stat)
+{
+        return _mm_get_alloc_site(site, stat);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of allocations that were not recorded by
+ *         allocation profiler because call site table was full.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @return Number of untracked allocations.
+ */
+//==============================================================================
+static inline u32_t sys_get_alloc_untracked(void)
+{
+        return _mm_get_alloc_untracked();
+}
+
+//==============================================================================
+/**
+ * @brief  Function return statistics of memory shrinker: name, priority,
+ *         number of calls, and number of released bytes. Shrinkers are
+ *         numbered in call order.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  shrinker     shrinker number
+ * @param  stat         shrinker statistics
+ *
+ * @return One of @ref errno value (EINVAL if shrinker does not exist, EBUSY
+ *         if shrinkers are just called).
+ */
+//==============================================================================
+static inline int sys_get_shrinker_stat(uint shrinker, _mm_shrinker_stat_t *stat)
+{
+        return _mm_get_shrinker_stat(shrinker, stat);
+}
+
 //==============================================================================
 /**
  * @brief Function return OS time in milliseconds.
@@ -5105,6 +5486,60 @@ static inline int sys_process_get_stat_seek(size_t seek, process_stat_t *stat)
         return _process_get_stat_seek(seek, stat);
 }
 
+//==============================================================================
+/**
+ * @brief  Function return peak stack usage of program thread recorded by
+ *         stack profiler. Threads are identified by program name and thread
+ *         function (NULL for main thread).
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  seek     entry seek (start from 0)
+ * @param  prof     stack profile
+ *
+ * @return One of @ref errno value (EINVAL if entry does not exist, ENOTSUP if
+ *         profiler is disabled).
+ */
+//==============================================================================
+static inline int sys_process_get_stack_prof(size_t seek, _process_stack_prof_t *prof)
+{
+        return _process_get_stack_prof(seek, prof);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return contention statistics of lock class recorded by
+ *         lock profiler. Entry 0 aggregates unnamed locks, entry 1 scheduler
+ *         lock sections.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  seek     entry seek (start from 0)
+ * @param  prof     lock statistics
+ *
+ * @return One of @ref errno value (EINVAL if entry does not exist, ENOTSUP if
+ *         profiler is disabled).
+ */
+//==============================================================================
+static inline int sys_get_lock_prof(uint seek, _lock_prof_t *prof)
+{
+        return _lock_prof_get(seek, prof);
+}
+
+//==============================================================================
+/**
+ * @brief  Function clear statistics collected by lock profiler.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @return One of @ref errno value (ENOTSUP if profiler is disabled).
+ */
+//==============================================================================
+static inline int sys_reset_lock_prof(void)
+{
+        return _lock_prof_reset();
+}
+
 //==============================================================================
 /**
  * @brief  Function return number of processes.
@@ -5119,6 +5554,234 @@ static inline size_t sys_process_get_count(void)
         return _process_get_count();
 }
 
+#if __ENABLE_NETWORK__ == _YES_
+//==============================================================================
+/**
+ * @brief  Function return status of selected network interface.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  family   network family
+ * @param  status   interface status (type depends on family)
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_net_ifstatus(NET_family_t family, NET_generic_status_t *status)
+{
+        return _net_ifstatus(family, status);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return statistics of selected socket.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  seek     socket seek (start from 0)
+ * @param  stat     socket statistics
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_net_socket_get_count()
+ */
+//==============================================================================
+static inline int sys_net_socket_get_stat_seek(size_t seek, NET_socket_stat_t *stat)
+{
+        return _net_socket_get_stat_seek(seek, stat);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of sockets.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @return Number of sockets.
+ */
+//==============================================================================
+static inline size_t sys_net_socket_get_count(void)
+{
+        return _net_socket_get_count();
+}
+
+//==============================================================================
+/**
+ * @brief  Function return statistics of selected memory pool of network stack.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  family   network family
+ * @param  seek     pool seek (start from 0)
+ * @param  stat     pool statistics
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_net_mempool_get_stat_seek(NET_family_t family, size_t seek,
+                                                NET_mempool_stat_t *stat)
+{
+        return _net_mempool_get_stat_seek(family, seek, stat);
+}
+#endif
+
+#if __OS_ENABLE_TRACE__ > 0
+//==============================================================================
+/**
+ * @brief  Function start recording of kernel events.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @see sys_trace_stop(), sys_trace_clear()
+ */
+//==============================================================================
+static inline void sys_trace_start(void)
+{
+        _trace_start();
+}
+
+//==============================================================================
+/**
+ * @brief  Function stop recording of kernel events. Recorded events are kept.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @see sys_trace_start(), sys_trace_clear()
+ */
+//==============================================================================
+static inline void sys_trace_stop(void)
+{
+        _trace_stop();
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove all recorded kernel events.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @see sys_trace_start(), sys_trace_stop()
+ */
+//==============================================================================
+static inline void sys_trace_clear(void)
+{
+        _trace_clear();
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of recorded kernel events.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @return Number of events.
+ *
+ * @see sys_trace_get_event_seek()
+ */
+//==============================================================================
+static inline size_t sys_trace_get_count(void)
+{
+        return _trace_get_count();
+}
+
+//==============================================================================
+/**
+ * @brief  Function return selected kernel event. Events are ordered from the
+ *         oldest one.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  seek     event seek (start from 0)
+ * @param  event    event destination
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_trace_get_count()
+ */
+//==============================================================================
+static inline int sys_trace_get_event_seek(size_t seek, _trace_event_t *event)
+{
+        return _trace_get_event_seek(seek, event);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return frequency of kernel event time stamps.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @return Frequency [Hz].
+ */
+//==============================================================================
+static inline u32_t sys_trace_get_timestamp_frequency(void)
+{
+        return _cpuctl_get_cycle_counter_frequency();
+}
+#endif
+
+#if __OS_TASK_KWORKER_MODE__ == 1
+//==============================================================================
+/**
+ * @brief  Function return statistics of kworker I/O thread pool: number of
+ *         threads, and depth and wait time of each syscall class queue.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param  stat     statistics destination
+ */
+//==============================================================================
+static inline void sys_get_kworker_stat(_syscall_kworker_stat_t *stat)
+{
+        _syscall_get_kworker_stat(stat);
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function record beginning of interrupt handler in kernel event
+ *         tracer. If tracer is disabled then function does nothing.
+ *
+ * @note Function can be used only by driver code.
+ *
+ * @param  irq      IRQ number
+ *
+ * @b Example
+ * @code
+        void IRQHandler(void)
+        {
+                sys_trace_ISR_enter(USART1_IRQn);
+
+                // ...
+
+                sys_trace_ISR_exit(USART1_IRQn);
+        }
+   @endcode
+ *
+ * @see sys_trace_ISR_exit()
+ */
+//==============================================================================
+static inline void sys_trace_ISR_enter(u16_t irq)
+{
+        _trace_ISR_enter(irq);
+}
+
+//==============================================================================
+/**
+ * @brief  Function record end of interrupt handler in kernel event tracer.
+ *         If tracer is disabled then function does nothing.
+ *
+ * @note Function can be used only by driver code.
+ *
+ * @param  irq      IRQ number
+ *
+ * @see sys_trace_ISR_enter()
+ */
+//==============================================================================
+static inline void sys_trace_ISR_exit(u16_t irq)
+{
+        _trace_ISR_exit(irq);
+}
+
 //==============================================================================
 /**
  * @brief Function create new thread (task), and if enabled, add to monitor list.
@@ -5731,6 +6394,8 @@ static inline struct tm *sys_localtime_r(const time_t *timer, struct tm *tm)
  * @param  region       region object (initialized by system)
  * @param  start        region start address
  * @param  size         region size
+ * @param  type         region type: MEM_REGION_INTERNAL, MEM_REGION_FAST, or
+ *                      MEM_REGION_EXTERNAL
  *
  * @return One of errno value.
  *
@@ -5740,7 +6405,7 @@ static inline struct tm *sys_localtime_r(const time_t *timer, struct tm *tm)
 
         mem_region_t ram2;
 
-        int err = sys_memory_register(&ram2, 0x20001000, 16384);
+        int err = sys_memory_register(&ram2, 0x20001000, 16384, MEM_REGION_INTERNAL);
         if (!err) {
                 // ...
         }
@@ -5750,9 +6415,81 @@ static inline struct tm *sys_localtime_r(const time_t *timer, struct tm *tm)
  *
  */
 //==============================================================================
-static inline int sys_memory_register(mem_region_t *region, void *start, size_t size)
+static inline int sys_memory_register(mem_region_t *region, void *start, size_t size,
+                                      mem_region_type_t type)
+{
+        return _mm_register_region(region, start, size, type);
+}
+
+//==============================================================================
+/**
+ * @brief  Function register memory shrinker. Shrinker is called when system
+ *         runs out of memory (or free memory drops below low watermark) and
+ *         should release memory that can be recreated (e.g. caches). Shrinkers
+ *         with lower priority value are called first.
+ *
+ * @note Function can be used only by driver code.
+ *
+ * @note Shrink function is called in context of allocating thread, thus it
+ *       must not block. Use zero timeout to lock mutexes.
+ *
+ * @param  shrinker     shrinker object (must be valid until unregistered)
+ * @param  name         subsystem name (visible in /proc/meminfo)
+ * @param  priority     call order (the lowest first)
+ * @param  shrink       function that release memory and return number of
+ *                      released bytes
+ * @param  arg          shrink function argument
+ *
+ * @return One of errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        static shrinker_t shrinker;
+
+        static size_t shrink(size_t size, void *arg)
+        {
+                size_t freed = 0;
+
+                // release up to size bytes of buffers...
+
+                return freed;
+        }
+
+        // ...
+
+        int err = sys_shrinker_register(&shrinker, "mydrv", 10, shrink, NULL);
+
+        // ...
+   @endcode
+ *
+ * @see sys_shrinker_unregister()
+ */
+//==============================================================================
+static inline int sys_shrinker_register(shrinker_t *shrinker, const char *name, u8_t priority,
+                                        size_t (*shrink)(size_t size, void *arg), void *arg)
+{
+        return _mm_shrinker_register(shrinker, name, priority, shrink, arg);
+}
+
+//==============================================================================
+/**
+ * @brief  Function unregister memory shrinker. If shrinkers are just called
+ *         then function waits until reclaim is finished.
+ *
+ * @note Function can be used only by driver code.
+ *
+ * @param  shrinker     shrinker object
+ *
+ * @return One of errno value.
+ *
+ * @see sys_shrinker_register()
+ */
+//==============================================================================
+static inline int sys_shrinker_unregister(shrinker_t *shrinker)
 {
-        return _mm_register_region(region, start, size);
+        return _mm_shrinker_unregister(shrinker);
 }
 
 //==============================================================================
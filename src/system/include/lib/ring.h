@@ -0,0 +1,151 @@
+/*==============================================================================
+File     ring.h
+
+Author   Daniel Zorychta
+
+Brief    Lock-free ring buffer library.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+==============================================================================*/
+
+/**
+@defgroup RING_H_ RING_H_
+
+Ring buffer of fixed size items without locks and critical sections. Ring
+can be used by single producer and single consumer (RING_MODE_SPSC) or by
+many producers and single consumer (RING_MODE_MPSC). All push and pop
+operations can be used in interrupts. Items are copied in bulk (at most two
+memcpy() calls per operation). Optional semaphores notify consumer waiting
+for data and producer waiting for free space.
+*/
+/**@{*/
+
+#ifndef _RING_H_
+#define _RING_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mm/mm.h"
+#include "kernel/ktypes.h"
+#include "kernel/builtinfunc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/** size of storage required by ring initialized by _ring_init() */
+#define _RING_STORAGE_SIZE(_mode, _item_size, _capacity)\
+        (((_mode) == RING_MODE_MPSC ? sizeof(u32_t) * (_capacity) : 0) + ((_item_size) * (_capacity)))
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/** ring mode */
+enum ring_mode {
+        RING_MODE_SPSC,         //!< single producer, single consumer
+        RING_MODE_MPSC          //!< many producers, single consumer
+};
+
+typedef void *(*ring_malloc_t)(size_t size);
+typedef void  (*ring_free_t)(void *mem);
+
+/** ring object (fields are private) */
+typedef struct {
+        u32_t   head;           //!< producer position (reserved in MPSC mode)
+        u32_t   tail;           //!< consumer position
+        u32_t   mask;           //!< capacity - 1
+        u32_t   item_size;      //!< item size
+        u32_t  *seq;            //!< item ready sequence (MPSC mode)
+        u8_t   *data;           //!< items
+        sem_t  *data_sem;       //!< signaled when data appears (optional)
+        sem_t  *space_sem;      //!< signaled when space appears (optional)
+        u32_t   data_wait;      //!< number of consumers waiting for data
+        u32_t   space_wait;     //!< number of producers waiting for space
+        u8_t    mode;           //!< ring mode
+        void  (*free)(void *mem, void *freectx);
+        void   *freectx;
+} ring_t;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+extern int _ring_init(ring_t        *ring,
+                      enum ring_mode mode,
+                      size_t         item_size,
+                      size_t         capacity,
+                      void          *storage);
+
+extern int _ring_create_usr(ring_malloc_t  malloc,
+                            ring_free_t    free,
+                            enum ring_mode mode,
+                            size_t         item_size,
+                            size_t         capacity,
+                            ring_t       **ring);
+
+extern int _ring_create_krn(enum _mm_mem   mem,
+                            enum ring_mode mode,
+                            size_t         item_size,
+                            size_t         capacity,
+                            ring_t       **ring);
+
+extern int _ring_create_mod(size_t         modid,
+                            enum ring_mode mode,
+                            size_t         item_size,
+                            size_t         capacity,
+                            ring_t       **ring);
+
+extern void   _ring_destroy(ring_t *ring);
+extern void   _ring_set_waiters(ring_t *ring, sem_t *data_sem, sem_t *space_sem);
+extern size_t _ring_push(ring_t *ring, const void *src, size_t count);
+extern size_t _ring_push_from_ISR(ring_t *ring, const void *src, size_t count, bool *task_woken);
+extern int    _ring_push_wait(ring_t *ring, const void *src, size_t count, size_t *pushed, u32_t timeout_ms);
+extern size_t _ring_pop(ring_t *ring, void *dst, size_t count);
+extern size_t _ring_pop_from_ISR(ring_t *ring, void *dst, size_t count, bool *task_woken);
+extern int    _ring_pop_wait(ring_t *ring, void *dst, size_t count, size_t *popped, u32_t timeout_ms);
+extern size_t _ring_get_count(ring_t *ring);
+extern size_t _ring_get_space(ring_t *ring);
+extern void   _ring_flush(ring_t *ring);
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RING_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
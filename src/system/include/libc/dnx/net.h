@@ -592,6 +592,78 @@ static inline int socket_recvfrom(SOCKET                 *socket,
 #endif
 }
 
+//==============================================================================
+/**
+ * @brief  The function is used to receive data from socket without copying.
+ *         The function returns read-only view of next received data: list of
+ *         segments that points directly to network stack buffers. Data is
+ *         valid until socket_recv_release() is called. Other receive
+ *         functions return EBUSY until view is released.
+ *
+ * @param  socket       The socket from which to receive the data.
+ * @param  view         The view of received data.
+ *
+ * @return Number of bytes in view, or -1 on error and @ref errno value is set
+ *         appropriately.
+ *
+ * @see socket_recv_release(), socket_recv()
+ *
+ * @b Example
+ * @code
+        // ...
+
+        NET_recv_view_t view;
+        while (socket_recv_view(socket, &view) > 0) {
+                for (size_t i = 0; i < view.count; i++) {
+                        fwrite(view.seg[i].data, 1, view.seg[i].len, file);
+                }
+
+                socket_recv_release(socket);
+        }
+
+        // ...
+   @endcode
+ */
+//==============================================================================
+static inline int socket_recv_view(SOCKET *socket, NET_recv_view_t *view)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        int result = -1;
+        syscall(SYSCALL_NETRECVVIEW, &result, socket, view);
+        return result;
+#else
+        UNUSED_ARG2(socket, view);
+        _errno = ENOTSUP;
+        return -1;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  The function releases view of received data obtained by
+ *         socket_recv_view(). All bytes of view are consumed.
+ *
+ * @param  socket       The socket.
+ *
+ * @return On success 0 is returned, otherwise -1 and @ref errno value is set
+ *         appropriately (EINVAL if there is no view to release).
+ *
+ * @see socket_recv_view()
+ */
+//==============================================================================
+static inline int socket_recv_release(SOCKET *socket)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        int result = -1;
+        syscall(SYSCALL_NETRECVRELEASE, &result, socket);
+        return result;
+#else
+        UNUSED_ARG1(socket);
+        _errno = ENOTSUP;
+        return -1;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  The function is used to transmit a message to another transport
@@ -685,6 +757,88 @@ static inline int socket_sendto(SOCKET                       *socket,
 #endif
 }
 
+//==============================================================================
+/**
+ * @brief  The function is used to transmit a message composed of several
+ *         segments (e.g. protocol header and payload) without concatenating
+ *         them in the user buffer. For UDP socket all segments are sent as
+ *         single datagram to address <i>msg->to</i> or to connected peer if
+ *         address is NULL. For TCP socket segments are written to the stream
+ *         and address is ignored.
+ *
+ * @param  socket       The socket to use to send the data.
+ * @param  msg          The message to send.
+ * @param  flags        Flags parameters that can be OR'ed together.
+ *
+ * @return Number of bytes actually sent on the socket, or -1 on error and
+ *         @ref errno value is set appropriately.
+ *
+ * @see socket_sendmmsg(), socket_send(), socket_sendto()
+ *
+ * @b Example
+ * @code
+        // ...
+
+        NET_segment_t seg[] = {
+                {.data = &header, .len = sizeof(header)},
+                {.data = payload, .len = payload_len}
+        };
+
+        NET_msg_t msg = {.seg = seg, .count = ARRAY_SIZE(seg), .to = NULL};
+
+        if (socket_sendmsg(socket, &msg, NET_FLAGS__NONE) < 0) {
+                perror("socket_sendmsg");
+        }
+
+        // ...
+   @endcode
+ */
+//==============================================================================
+static inline int socket_sendmsg(SOCKET *socket, NET_msg_t *msg, NET_flags_t flags)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        int    result = -1;
+        size_t count  = 1;
+        syscall(SYSCALL_NETSENDMSG, &result, socket, msg, &count, &flags);
+        return result < 0 ? -1 : (int)msg->sent;
+#else
+        UNUSED_ARG3(socket, msg, flags);
+        _errno = ENOTSUP;
+        return -1;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  The function is used to transmit several messages by single call.
+ *         Each message is sent as in socket_sendmsg(). Number of sent bytes
+ *         of each message is stored in <i>msg[n].sent</i>. Sending stops on
+ *         the first error.
+ *
+ * @param  socket       The socket to use to send the data.
+ * @param  msg          The messages to send.
+ * @param  count        Number of messages.
+ * @param  flags        Flags parameters that can be OR'ed together.
+ *
+ * @return Number of messages sent, or -1 on error (no message sent) and
+ *         @ref errno value is set appropriately.
+ *
+ * @see socket_sendmsg()
+ */
+//==============================================================================
+static inline int socket_sendmmsg(SOCKET *socket, NET_msg_t *msg, size_t count, NET_flags_t flags)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        int result = -1;
+        syscall(SYSCALL_NETSENDMSG, &result, socket, msg, &count, &flags);
+        return result;
+#else
+        UNUSED_ARG4(socket, msg, count, flags);
+        _errno = ENOTSUP;
+        return -1;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  The function shutdown selected communication direction.
@@ -85,6 +85,33 @@ typedef struct {
 typedef _mm_mem_usage_t memstat_t;
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief Memory region details
+ *
+ * The type contains information about memory region used by dynamic memory
+ * allocator and memory usage of each memory purpose in the region.
+ *
+ * @see get_memory_region_stat()
+ */
+typedef struct {
+        void  *start;                   /*!< Region start address.*/
+        size_t size;                    /*!< Region size.*/
+        size_t free;                    /*!< Free memory in region.*/
+        size_t used;                    /*!< Used memory in region.*/
+        int    type;                    /*!< Region type: 0 - internal, 1 - fast (e.g. CCM), 2 - external (e.g. SDRAM).*/
+        i32_t  usage[7];                /*!< Memory usage of kernel, file systems, network, programs, shared memory, cache, and modules.*/
+        struct {
+                size_t largest_free;    /*!< Size of the largest free block.*/
+                u32_t  free_blocks;     /*!< Number of free blocks.*/
+                u8_t   fragmentation;   /*!< Fragmentation index [%] (0 - all free memory in one block).*/
+                u32_t  histogram[8];    /*!< Number of free blocks of size: <64, <128, <256, <512, <1K, <2K, <4K, >=4K.*/
+        } frag;                         /*!< Fragmentation details.*/
+} memregion_t;
+#else
+typedef _mm_region_stat_t memregion_t;
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief Average CPU load
@@ -279,6 +306,46 @@ static inline i32_t get_module_memory_usage(uint module_number)
         return size;
 }
 
+//==============================================================================
+/**
+ * @brief Function returns details of selected memory region.
+ *
+ * The function get_memory_region_stat() return information about memory
+ * region <i>region</i> pointed by <i>stat</i>. Regions are numbered from 0 in
+ * order of registration. Each memory purpose (kernel, file systems, network,
+ * etc.) allocates blocks in regions according to preference list selected in
+ * the OS configuration.
+ *
+ * @param region    region number
+ * @param stat      region information
+ *
+ * @exception | @ref EINVAL
+ *
+ * @return Return @b 0 on success. On error (e.g. region does not exist),
+ * @b positive value is returned.
+ *
+ * @b Example
+ * @code
+        #include <dnx/os.h>
+
+        // ...
+
+        memregion_t region;
+        for (uint i = 0; get_memory_region_stat(i, &region) == 0; i++) {
+                printf("Region %u @ %p: %u/%u bytes used\n",
+                       i, region.start, region.used, region.size);
+        }
+
+        // ...
+
+   @endcode
+ */
+//==============================================================================
+static inline int get_memory_region_stat(uint region, memregion_t *stat)
+{
+        return _builtinfunc(mm_get_region_stat, region, stat);
+}
+
 //==============================================================================
 /**
  * @brief Function returns system uptime in seconds.
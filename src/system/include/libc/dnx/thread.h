@@ -1240,7 +1240,9 @@ static inline void mutex_delete(mutex_t *mutex)
  * mutex is locked by other thread then system try to lock mutex by <i>timeout</i>
  * milliseconds. If mutex is recursive then task can lock mutex recursively, and
  * the same times shall be unlocked. If normal mutex is used then task can lock
- * mutex only one time (not recursively).
+ * mutex only one time (not recursively). Free mutex is locked by atomic
+ * operation without entering the kernel. Kernel is used only when mutex is
+ * locked by other thread, then the owner inherits priority of waiting thread.
  *
  * @param mutex     mutex
  * @param timeout   timeout
@@ -1294,6 +1296,10 @@ static inline void mutex_delete(mutex_t *mutex)
 //==============================================================================
 static inline bool mutex_lock(mutex_t *mutex, const u32_t timeout)
 {
+        if (mutex && _builtinfunc(mutex_fast_lock, mutex, _active_task)) {
+                return true;
+        }
+
         _errno = _builtinfunc(mutex_lock, mutex, timeout);
         return !_errno;
 }
@@ -1422,6 +1428,10 @@ static inline bool mutex_trylock(mutex_t *mutex)
 //==============================================================================
 static inline bool mutex_unlock(mutex_t *mutex)
 {
+        if (mutex && _builtinfunc(mutex_fast_unlock, mutex, _active_task)) {
+                return true;
+        }
+
         _errno = _builtinfunc(mutex_unlock, mutex);
         return !_errno;
 }
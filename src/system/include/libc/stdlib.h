@@ -51,8 +51,10 @@ extern "C" {
 #include <kernel/syscall.h>
 #include <kernel/kwrapper.h>
 #include <kernel/builtinfunc.h>
+#if !defined(ARCH_posix)
 #include <machine/ieeefp.h>
 #include <_ansi.h>
+#endif
 
 #ifndef DOXYGEN
 #define __need_size_t
@@ -83,7 +85,11 @@ extern "C" {
 /**
  * @brief Is the maximum value that can be returned by rand() function.
  */
+#if defined(__RAND_MAX)
 #define RAND_MAX        __RAND_MAX
+#else
+#define RAND_MAX        0x7FFFFFFF
+#endif
 
 /*==============================================================================
   Exported object types
@@ -431,6 +437,15 @@ extern int rand(void);
 //==============================================================================
 extern void srand(unsigned int seed);
 
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+#ifndef DOXYGEN
+extern void *_uheap_malloc(size_t size);
+extern void *_uheap_calloc(size_t n, size_t size);
+extern void *_uheap_realloc(void *ptr, size_t size);
+extern void  _uheap_free(void *ptr);
+#endif
+#endif
+
 /*==============================================================================
   Exported inline functions
 ==============================================================================*/
@@ -463,9 +478,13 @@ extern void srand(unsigned int seed);
 //==============================================================================
 static inline void *malloc(size_t size)
 {
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+        return _uheap_malloc(size);
+#else
         void *mem = NULL;
         syscall(SYSCALL_MALLOC, &mem, &size);
         return mem;
+#endif
 }
 
 //==============================================================================
@@ -498,10 +517,14 @@ static inline void *malloc(size_t size)
 //==============================================================================
 static inline void *calloc(size_t n, size_t size)
 {
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+        return _uheap_calloc(n, size);
+#else
         void   *mem   = NULL;
         size_t  bsize = n * size;
         syscall(SYSCALL_ZALLOC, &mem, &bsize);
         return mem;
+#endif
 }
 
 //==============================================================================
@@ -536,9 +559,13 @@ static inline void *calloc(size_t n, size_t size)
 //==============================================================================
 static inline void free(void *ptr)
 {
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+        _uheap_free(ptr);
+#else
         if (ptr) {
                 syscall(SYSCALL_FREE, NULL, ptr);
         }
+#endif
 }
 
 //==============================================================================
@@ -554,7 +581,8 @@ static inline void free(void *ptr)
  * zero, and <i>ptr</i> is not @ref NULL, then the call is equivalent to free(ptr).
  * Unless <i>ptr</i> is @ref NULL, it must have been returned by an earlier call to
  * malloc(), calloc() or realloc().  If the area pointed to was moved, a
- * free(ptr) is done.
+ * free(ptr) is done. If user space heap arenas are enabled then block is
+ * resized in place when possible.
  *
  * @param ptr       pointer to memory space
  * @param size      size of new memory space
@@ -589,6 +617,9 @@ static inline void free(void *ptr)
 //==============================================================================
 static inline void *realloc(void *ptr, size_t size)
 {
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+        return _uheap_realloc(ptr, size);
+#else
         extern void* memcpy(void* dest, const void* src, size_t n);
 
         if (size) {
@@ -604,6 +635,7 @@ static inline void *realloc(void *ptr, size_t size)
         }
 
         return NULL;
+#endif
 }
 
 //==============================================================================
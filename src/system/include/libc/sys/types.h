@@ -42,6 +42,7 @@ The library contains system types.
 ==============================================================================*/
 #include <stdint.h>
 #include <stddef.h>
+#include <limits.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +51,9 @@ extern "C" {
 /*==============================================================================
   Exported macros
 ==============================================================================*/
+/** @brief Maximum value of ssize_t type (toolchain value can be long). */
+#undef  SSIZE_MAX
+#define SSIZE_MAX INT_MAX
 
 /*==============================================================================
   Exported object types
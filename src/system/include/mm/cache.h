@@ -0,0 +1,99 @@
+/*=========================================================================*//**
+File     cache.h
+
+Author   Daniel Zorychta
+
+Brief    Block device cache.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+@defgroup CACHE_H_ CACHE_H_
+
+Block device cache shared by all block-backed file systems.
+*/
+/**@{*/
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <config.h>
+#include "fs/vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/** Cache write mode. */
+enum cache_mode {
+        CACHE_WRITE_THROUGH,    //!< data is written to the device immediately
+        CACHE_WRITE_BACK        //!< data is written to the device at sync or eviction
+};
+
+/** Device write notification: called after blocks are written to the device. */
+typedef void (*cache_write_cb_t)(void *arg, u32_t blkpos, size_t blkcnt);
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+extern int    _cache_init(void);
+extern int    _cache_read(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, void *buf);
+extern int    _cache_write(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, const void *buf, enum cache_mode mode);
+extern int    _cache_configure(FILE *file, size_t blksz, u32_t readahead, u32_t coalesce);
+extern int    _cache_set_write_callback(FILE *file, size_t blksz, cache_write_cb_t cb, void *arg);
+extern int    _cache_flush(FILE *file);
+extern int    _cache_discard(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt);
+extern int    _cache_drop(FILE *file, bool force);
+extern void   _cache_sync(void);
+extern size_t _cache_reduce(size_t size);
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CACHE_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -73,6 +73,8 @@ extern "C" {
 /*==============================================================================
   Exported symbolic constants/macros
 ==============================================================================*/
+/** number of free block size classes (powers of 2 from 64 bytes) */
+#define _HEAP_HISTOGRAM_SIZE    8
 
 /*==============================================================================
   Exported types, enums definitions
@@ -97,6 +99,20 @@ typedef struct {
         size_t used_max;
 } _heap_t;
 
+typedef struct {
+        /** size of the largest free block (user data) */
+        size_t largest_free;
+
+        /** number of free blocks */
+        u32_t free_blocks;
+
+        /** fragmentation index [%]: 0 - all free memory in one block */
+        u8_t fragmentation;
+
+        /** number of free blocks in size classes: <64, <128, ... , >=4096 */
+        u32_t histogram[_HEAP_HISTOGRAM_SIZE];
+} _heap_frag_stat_t;
+
 /*==============================================================================
   Exported object declarations
 ==============================================================================*/
@@ -111,6 +127,7 @@ extern size_t _heap_get_free(_heap_t*);
 extern size_t _heap_get_used(_heap_t*);
 extern size_t _heap_get_size(_heap_t*);
 extern size_t _heap_get_block_size(_heap_t*, void*);
+extern void   _heap_get_frag_stat(_heap_t*, _heap_frag_stat_t*);
 
 #ifdef __cplusplus
 }
@@ -70,11 +70,40 @@ enum _mm_mem {
         _MM_COUNT
 };
 
+enum _mm_region_type {
+        _MM_REGION_INTERNAL,    //!< internal RAM (DMA capable)
+        _MM_REGION_FAST,        //!< core coupled RAM (fast, not accessible by DMA)
+        _MM_REGION_EXTERNAL,    //!< external RAM (slow, large)
+        _MM_REGION_TYPE_COUNT
+};
+
 typedef struct _mm_region {
-        _heap_t            heap;
-        struct _mm_region *next;
+        _heap_t               heap;
+        struct _mm_region    *next;
+        enum _mm_region_type  type;
+        i32_t                 usage[_MM_COUNT];
 } _mm_region_t;
 
+typedef struct {
+        void                 *start;
+        size_t                size;
+        size_t                free;
+        size_t                used;
+        enum _mm_region_type  type;
+        i32_t                 usage[_MM_COUNT];
+        _heap_frag_stat_t     frag;
+} _mm_region_stat_t;
+
+typedef struct {
+        void  *caller;          //!< call site address
+        u32_t  allocs;          //!< number of allocations
+        u32_t  frees;           //!< number of frees
+        u32_t  bytes;           //!< total allocated bytes
+        i32_t  live_bytes;      //!< currently allocated bytes
+        u32_t  lifetime_total;  //!< sum of lifetimes of freed blocks [ms]
+        u32_t  lifetime_max;    //!< the longest lifetime of freed block [ms]
+} _mm_alloc_site_t;
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -83,8 +112,11 @@ typedef struct _mm_region {
   Exported functions
 ==============================================================================*/
 extern int    _mm_init(void);
-extern int    _mm_register_region(_mm_region_t*, void*, size_t);
+extern int    _mm_register_region(_mm_region_t*, void*, size_t, enum _mm_region_type);
 extern int    _mm_get_mem_usage_details(_mm_mem_usage_t*);
+extern int    _mm_get_region_stat(uint region, _mm_region_stat_t *stat);
+extern int    _mm_get_alloc_site(uint site, _mm_alloc_site_t *stat);
+extern u32_t  _mm_get_alloc_untracked(void);
 extern int    _mm_get_module_mem_usage(uint module, i32_t *usage);
 extern size_t _mm_get_block_size(void*);
 extern size_t _mm_get_mem_free(void);
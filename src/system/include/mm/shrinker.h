@@ -0,0 +1,115 @@
+/*=========================================================================*//**
+File     shrinker.h
+
+Author   Daniel Zorychta
+
+Brief    Memory pressure shrinkers.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+@defgroup SHRINKER_H_ SHRINKER_H_
+
+Registry of reclaim callbacks called when system runs out of memory.
+*/
+/**@{*/
+
+#ifndef _SHRINKER_H_
+#define _SHRINKER_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/**
+ * Reclaim callback. Function should release at least size bytes if possible
+ * and return number of released bytes. Function is called in context of the
+ * allocating thread, thus it must not block (e.g. mutexes should be locked
+ * with 0 timeout).
+ */
+typedef size_t (*_mm_shrink_func_t)(size_t size, void *arg);
+
+/**
+ * Shrinker object. Object is created by subsystem and must be valid until
+ * unregistered. Fields are initialized by _mm_shrinker_register().
+ */
+typedef struct _mm_shrinker {
+        struct _mm_shrinker *next;      //!< next shrinker (ordered by priority)
+        const char          *name;      //!< subsystem name
+        _mm_shrink_func_t    shrink;    //!< reclaim callback
+        void                *arg;       //!< callback argument
+        u8_t                 priority;  //!< call order (the lowest first)
+        u32_t                calls;     //!< number of callback calls
+        u32_t                freed;     //!< total number of released bytes
+} _mm_shrinker_t;
+
+/**
+ * Shrinker statistics.
+ */
+typedef struct {
+        const char *name;               //!< subsystem name
+        u8_t        priority;           //!< call order (the lowest first)
+        u32_t       calls;              //!< number of callback calls
+        u32_t       freed;              //!< total number of released bytes
+} _mm_shrinker_stat_t;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+extern int    _mm_shrinker_register(_mm_shrinker_t *shrinker, const char *name,
+                                    u8_t priority, _mm_shrink_func_t shrink, void *arg);
+extern int    _mm_shrinker_unregister(_mm_shrinker_t *shrinker);
+extern size_t _mm_shrink(size_t size);
+extern int    _mm_get_shrinker_stat(uint shrinker, _mm_shrinker_stat_t *stat);
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SHRINKER_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
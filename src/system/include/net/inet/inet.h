@@ -56,7 +56,9 @@ extern "C" {
 typedef struct {
         struct netconn *netconn;
         struct netbuf  *netbuf;
+        struct netbuf  *txbuf;
         uint16_t        seek;
+        uint16_t        view_len;
 } INET_socket_t;
 
 /*==============================================================================
@@ -79,14 +81,19 @@ extern int   INET_socket_listen(INET_socket_t*);
 extern int   INET_socket_accept(INET_socket_t*, INET_socket_t*);
 extern int   INET_socket_recv(INET_socket_t*, void*, size_t, NET_flags_t, size_t*);
 extern int   INET_socket_recvfrom(INET_socket_t*, void*, size_t, NET_flags_t, NET_INET_sockaddr_t*, size_t*);
+extern int   INET_socket_recv_view(INET_socket_t*, NET_recv_view_t*);
+extern int   INET_socket_recv_release(INET_socket_t*);
 extern int   INET_socket_send(INET_socket_t*, const void*, size_t, NET_flags_t, size_t*);
 extern int   INET_socket_sendto(INET_socket_t*, const void*, size_t, NET_flags_t, const NET_INET_sockaddr_t*, size_t*);
+extern int   INET_socket_sendmsg(INET_socket_t*, NET_msg_t*, size_t, NET_flags_t, size_t*);
 extern int   INET_gethostbyname(const char*, NET_INET_sockaddr_t*);
 extern int   INET_socket_set_recv_timeout(INET_socket_t*, uint32_t);
 extern int   INET_socket_set_send_timeout(INET_socket_t*, uint32_t);
 extern int   INET_socket_get_recv_timeout(INET_socket_t*, uint32_t*);
 extern int   INET_socket_get_send_timeout(INET_socket_t*, uint32_t*);
 extern int   INET_socket_getaddress(INET_socket_t*, NET_INET_sockaddr_t*);
+extern int   INET_socket_stat(INET_socket_t*, NET_socket_stat_t*);
+extern int   INET_mempool_stat(size_t, NET_mempool_stat_t*);
 extern u16_t INET_hton_u16(u16_t);
 extern u32_t INET_hton_u32(u32_t);
 extern u64_t INET_hton_u64(u64_t);
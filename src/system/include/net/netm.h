@@ -79,6 +79,12 @@ extern "C" {
   SIPC NETWORK FAMILY
 ------------------------------------------------------------------------------*/
 
+/*------------------------------------------------------------------------------
+  GENERIC NETWORK
+------------------------------------------------------------------------------*/
+/** Maximum number of segments in view of received buffer. */
+#define NET_RECV_VIEW_SEGMENTS                  4
+
 
 /*==============================================================================
   Exported object types
@@ -139,6 +145,53 @@ typedef void NET_generic_status_t;
 /** Socket object definition. Protected object fields. */
 typedef struct socket SOCKET;
 
+/** Segment of received buffer (read only). */
+typedef struct {
+        const void *data;                       /*!< Segment data.*/
+        size_t      len;                        /*!< Segment length.*/
+} NET_segment_t;
+
+/** View of received buffer. Data is valid until view is released. */
+typedef struct {
+        NET_segment_t seg[NET_RECV_VIEW_SEGMENTS];      /*!< Segments of data.*/
+        size_t        count;                            /*!< Number of segments.*/
+        size_t        len;                              /*!< Total length of all segments.*/
+} NET_recv_view_t;
+
+/** Message of vectored send. Segments are sent as a single datagram (UDP)
+ *  or as continuous stream (TCP) without concatenation by the caller. */
+typedef struct {
+        const NET_segment_t          *seg;      /*!< Segments of data.*/
+        size_t                        count;    /*!< Number of segments.*/
+        const NET_generic_sockaddr_t *to;       /*!< Destination address, NULL for connected peer.*/
+        size_t                        sent;     /*!< Number of sent bytes (set by stack).*/
+} NET_msg_t;
+
+/** Socket statistics. Counters are collected by network manager, queue
+ *  state is read from network family stack. */
+typedef struct {
+        NET_family_t   family;                  /*!< Network family.*/
+        NET_protocol_t protocol;                /*!< Socket protocol.*/
+        u16_t          port;                    /*!< Local port (0 if not bound).*/
+        u32_t          rx_queue;                /*!< Number of received bytes not read yet.*/
+        u32_t          tx_queue;                /*!< Number of sent bytes not acknowledged yet.*/
+        u32_t          retransmits;             /*!< Retransmissions of oldest unacknowledged segment.*/
+        u64_t          rx_bytes;                /*!< Number of received bytes.*/
+        u64_t          tx_bytes;                /*!< Number of transmitted bytes.*/
+        u32_t          rx_packets;              /*!< Number of successful receive operations.*/
+        u32_t          tx_packets;              /*!< Number of successful transmit operations.*/
+        u32_t          errors;                  /*!< Number of failed operations (timeouts excluded).*/
+} NET_socket_stat_t;
+
+/** Memory pool statistics of network stack. */
+typedef struct {
+        const char    *name;                    /*!< Pool name.*/
+        u32_t          size;                    /*!< Element size.*/
+        u32_t          used;                    /*!< Number of used elements.*/
+        u32_t          max;                     /*!< Maximum number of used elements.*/
+        u32_t          err;                     /*!< Number of allocation failures.*/
+} NET_mempool_stat_t;
+
 /*------------------------------------------------------------------------------
   INET NETWORK FAMILY
 ------------------------------------------------------------------------------*/
@@ -187,6 +240,8 @@ typedef struct {
         u64_t            rx_bytes;              /*!< Number of received bytes.*/
         u64_t            tx_packets;            /*!< Number of transmitted packets.*/
         u64_t            rx_packets;            /*!< Number of received packets.*/
+        u64_t            rx_dropped;            /*!< Number of dropped received packets.*/
+        u64_t            rx_alloc_errors;       /*!< Number of Rx buffer allocation failures.*/
 } NET_INET_status_t;
 
 /*------------------------------------------------------------------------------
@@ -237,8 +292,11 @@ extern int   _net_socket_listen(SOCKET*);
 extern int   _net_socket_accept(SOCKET*, SOCKET**);
 extern int   _net_socket_recv(SOCKET*, void*, size_t, NET_flags_t, size_t*);
 extern int   _net_socket_recvfrom(SOCKET*, void*, size_t, NET_flags_t, NET_generic_sockaddr_t*, size_t*);
+extern int   _net_socket_recv_view(SOCKET*, NET_recv_view_t*);
+extern int   _net_socket_recv_release(SOCKET*);
 extern int   _net_socket_send(SOCKET*, const void*, size_t, NET_flags_t, size_t*);
 extern int   _net_socket_sendto(SOCKET*, const void*, size_t, NET_flags_t, const NET_generic_sockaddr_t*, size_t*);
+extern int   _net_socket_sendmsg(SOCKET*, NET_msg_t*, size_t, NET_flags_t, size_t*);
 extern int   _net_socket_set_recv_timeout(SOCKET*, uint32_t);
 extern int   _net_socket_set_send_timeout(SOCKET*, uint32_t);
 extern int   _net_socket_get_recv_timeout(SOCKET*, uint32_t*);
@@ -247,6 +305,9 @@ extern int   _net_socket_connect(SOCKET*, const NET_generic_sockaddr_t*);
 extern int   _net_socket_disconnect(SOCKET*);
 extern int   _net_socket_shutdown(SOCKET*, NET_shut_t);
 extern int   _net_socket_getaddress(SOCKET*, NET_generic_sockaddr_t*);
+extern int   _net_socket_get_stat_seek(size_t, NET_socket_stat_t*);
+extern size_t _net_socket_get_count(void);
+extern int   _net_mempool_get_stat_seek(NET_family_t, size_t, NET_mempool_stat_t*);
 extern u16_t _net_hton_u16(NET_family_t, u16_t);
 extern u32_t _net_hton_u32(NET_family_t, u32_t);
 extern u64_t _net_hton_u64(NET_family_t, u64_t);
@@ -33,6 +33,7 @@
 #include "mm/heap.h"
 #include "mm/mm.h"
 #include "mm/shm.h"
+#include "mm/cache.h"
 #include "fs/vfs.h"
 #include "lib/unarg.h"
 #include "kernel/syscall.h"
@@ -45,11 +46,13 @@
 /*==============================================================================
   Local symbolic constants/macros
 ==============================================================================*/
+#if !defined(_CPUCTL_HEAP_START)
 /* Stack size declared by linker script */
 #define STACK_SIZE                      (((size_t)&__stack_size) - 512)
 
 /* Stack start declared by linker script */
 #define STACK_START                     ((void *)&__stack_start)
+#endif
 
 /*==============================================================================
   Local types, enums definitions
@@ -66,11 +69,13 @@
 /*==============================================================================
   Exported object definitions
 ==============================================================================*/
+#if !defined(_CPUCTL_HEAP_START)
 /** pointer to stack size value */
 extern void *__stack_size;
 
 /** pointer to stack start */
 extern void *__stack_start;
+#endif
 
 /*==============================================================================
   Function definitions
@@ -93,6 +98,7 @@ void dnxinit(void *arg)
         _assert(ESUCC == _shm_init());
 #endif
 
+        _assert(ESUCC == _cache_init());
         _assert(ESUCC == _vfs_init());
         _assert(ESUCC == _syscall_init());
 
@@ -100,10 +106,13 @@ void dnxinit(void *arg)
          * This code reuse the main() stack that after kernel start is abandoned.
          * The stack region is reused for HEAP purposes.
          * If cause problems (strange system behaviour, kernel panics) disable
-         * this option.
+         * this option. Not possible when the heap is provided by CPU module
+         * (e.g. POSIX target), main() runs there on the host process stack.
          */
+#if !defined(_CPUCTL_HEAP_START)
         static _mm_region_t main_stack;
-        _mm_register_region(&main_stack, STACK_START, STACK_SIZE);
+        _mm_register_region(&main_stack, STACK_START, STACK_SIZE, _MM_REGION_INTERNAL);
+#endif
 
         _task_exit();
 }
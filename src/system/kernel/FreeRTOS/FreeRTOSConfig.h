@@ -71,6 +71,7 @@
 #include "config.h"             /* general configuration  */
 #include "cpu/cpuctl.h"         /* CPU vector definitions */
 #include "mm/mm.h"              /* memory management      */
+#include "kernel/ktrace.h"      /* kernel event tracer    */
 
 /*-------------------------------------------------------------
  * Used prototypes from external modules
@@ -153,9 +154,30 @@ extern void  vApplicationSwitchedOut(void);
 #define INCLUDE_xEventGroupSetBitFromISR        0
 #define INCLUDE_xTimerPendFunctionCall          0
 
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+#define INCLUDE_xSemaphoreGetMutexHolder        1
+#endif
+
 #define traceTASK_SWITCHED_OUT()                _task_switched_out(pxCurrentTCB, pxCurrentTCB->pxTaskTag)
 #define traceTASK_SWITCHED_IN()                 _task_switched_in(pxCurrentTCB, pxCurrentTCB->pxTaskTag)
 
+/* Pool of statically allocated tasks (see kwrapper.c) */
+#define _TASK_POOL_SIZE                         (__OS_TASK_POOL_SMALL_COUNT__ + __OS_TASK_POOL_MEDIUM_COUNT__ + __OS_TASK_POOL_LARGE_COUNT__)
+
+#if _TASK_POOL_SIZE > 0
+extern void _task_pool_release(void *tcb);
+#define configCLEAN_UP_TCB(pxTCB)               _task_pool_release(pxTCB)
+#define portCLEAN_UP_TCB(pxTCB)                 configCLEAN_UP_TCB(pxTCB)
+#endif
+
+#if __OS_ENABLE_TRACE__ > 0
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) _trace_event(_TRACE_EVENT_BLOCK_ON_RECEIVE, 0, (u32_t)(size_t)(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)    _trace_event(_TRACE_EVENT_BLOCK_ON_SEND, 0, (u32_t)(size_t)(pxQueue))
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)   _trace_event(_TRACE_EVENT_TASK_READY, 0, (u32_t)(size_t)(pxTCB))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       _trace_event(_TRACE_EVENT_SEND_FROM_ISR, 0, (u32_t)(size_t)(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    _trace_event(_TRACE_EVENT_RECEIVE_FROM_ISR, 0, (u32_t)(size_t)(pxQueue))
+#endif
+
 #if __OS_ENABLE_SYS_ASSERT__ > 0
 extern void _assert_hook(bool assert, const char *msg);
 #define configASSERT(x)                         _assert_hook(x, "kernel")
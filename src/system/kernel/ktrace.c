@@ -0,0 +1,205 @@
+/*=========================================================================*//**
+@file    ktrace.c
+
+@author  Daniel Zorychta
+
+@brief   Kernel event tracer.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "config.h"
+#include "kernel/ktrace.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+#include "cpu/cpuctl.h"
+
+#if __OS_ENABLE_TRACE__ > 0
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define TRACE_BUFFER_LENGTH             __OS_TRACE_BUFFER_LENGTH__
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+/*
+ * Events are stored in the ring buffer. When buffer is full the oldest
+ * event is overwritten, thus the last events before stop are always
+ * available (flight recorder). Target CPUs have single core, so single
+ * buffer is used.
+ */
+typedef struct {
+        _trace_event_t  event[TRACE_BUFFER_LENGTH];
+        size_t          head;           //!< index of next event
+        size_t          count;          //!< number of stored events
+        bool            enabled;        //!< recording enabled
+} trace_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static trace_t trace;
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function start event recording.
+ */
+//==============================================================================
+void _trace_start(void)
+{
+        trace.enabled = true;
+}
+
+//==============================================================================
+/**
+ * @brief  Function stop event recording. Recorded events are kept.
+ */
+//==============================================================================
+void _trace_stop(void)
+{
+        trace.enabled = false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove all recorded events.
+ */
+//==============================================================================
+void _trace_clear(void)
+{
+        UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        trace.head  = 0;
+        trace.count = 0;
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if event recording is enabled.
+ *
+ * @return If recording is enabled then true is returned, otherwise false.
+ */
+//==============================================================================
+bool _trace_is_enabled(void)
+{
+        return trace.enabled;
+}
+
+//==============================================================================
+/**
+ * @brief  Function record single event. Function is called from kernel trace
+ *         hooks, thus can be used in task, scheduler, and interrupt context.
+ *
+ * @param  type         event type (_trace_event_type_t)
+ * @param  arg16        event argument
+ * @param  arg32        event argument
+ */
+//==============================================================================
+void _trace_event(u8_t type, u16_t arg16, u32_t arg32)
+{
+        if (trace.enabled) {
+                UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+                _trace_event_t *event = &trace.event[trace.head];
+                event->timestamp = _cpuctl_get_cycle_counter();
+                event->type      = type;
+                event->reserved  = 0;
+                event->arg16     = arg16;
+                event->arg32     = arg32;
+
+                if (++trace.head >= TRACE_BUFFER_LENGTH) {
+                        trace.head = 0;
+                }
+
+                if (trace.count < TRACE_BUFFER_LENGTH) {
+                        trace.count++;
+                }
+
+                portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of events stored in the buffer.
+ *
+ * @return Number of events.
+ */
+//==============================================================================
+size_t _trace_get_count(void)
+{
+        return trace.count;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return selected event. Events are ordered from the oldest.
+ *         Recording should be stopped before events are read, otherwise
+ *         events can be overwritten during read.
+ *
+ * @param  seek         event seek (start from 0)
+ * @param  event        event destination
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _trace_get_event_seek(size_t seek, _trace_event_t *event)
+{
+        int err = EINVAL;
+
+        if (event) {
+                UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+                if (seek < trace.count) {
+                        size_t oldest = trace.head + TRACE_BUFFER_LENGTH - trace.count;
+                        *event = trace.event[(oldest + seek) % TRACE_BUFFER_LENGTH];
+                        err = ESUCC;
+                } else {
+                        err = ENOENT;
+                }
+
+                portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        }
+
+        return err;
+}
+
+#endif
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -29,11 +29,13 @@
 /*==============================================================================
   Include files
 ==============================================================================*/
+#include <string.h>
 #include "kernel/kwrapper.h"
 #include "kernel/ktypes.h"
 #include "kernel/errno.h"
 #include "kernel/sysfunc.h"
 #include "lib/cast.h"
+#include "cpu/cpuctl.h"
 #include "event_groups.h"
 
 /*==============================================================================
@@ -43,17 +45,76 @@
 #define _CEILING(x,y)   (((x) + (y) - 1) / (y))
 #define MS2TICK(ms)     ((ms <= (1000/(configTICK_RATE_HZ)) ? 1 : _CEILING(ms,(1000/(configTICK_RATE_HZ)))) + 1)
 
+/** TASK POOL */
+#define TASK_POOL_STACK_SIZE    (  (__OS_TASK_POOL_SMALL_COUNT__  * __OS_TASK_POOL_SMALL_STACK_DEPTH__ ) \
+                                 + (__OS_TASK_POOL_MEDIUM_COUNT__ * __OS_TASK_POOL_MEDIUM_STACK_DEPTH__) \
+                                 + (__OS_TASK_POOL_LARGE_COUNT__  * __OS_TASK_POOL_LARGE_STACK_DEPTH__ ))
+
+/** LOCK PROFILER */
+#define LOCK_PROF_OTHER         0
+#define LOCK_PROF_SCHEDULER     1
+#define LOCK_PROF_NAMED         2
+
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
+#if _TASK_POOL_SIZE > 0
+typedef struct {
+        size_t stack_depth;             //!< stack depth of each task in class
+        size_t count;                   //!< number of tasks in class
+} task_pool_class_t;
+#endif
 
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+#if _TASK_POOL_SIZE > 0
+static task_t *task_pool_create(task_func_t func, const char *name, size_t stack_depth,
+                                void *argv, UBaseType_t priority);
+#endif
+static bool mutex_take(mutex_t *mutex, task_t *task);
+static bool mutex_wait(mutex_t *mutex, task_t *task, u32_t blocktime_ms);
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+static u8_t lock_prof_entry(const char *name);
+static void lock_prof_acquire(u8_t entry, bool acquired, bool contended, u32_t wait);
+static void lock_prof_release(u8_t entry, u32_t hold);
+#endif
 
 /*==============================================================================
   Local object definitions
 ==============================================================================*/
+#if _TASK_POOL_SIZE > 0
+static const task_pool_class_t task_pool_class[] = {
+        {.stack_depth = __OS_TASK_POOL_SMALL_STACK_DEPTH__,  .count = __OS_TASK_POOL_SMALL_COUNT__ },
+        {.stack_depth = __OS_TASK_POOL_MEDIUM_STACK_DEPTH__, .count = __OS_TASK_POOL_MEDIUM_COUNT__},
+        {.stack_depth = __OS_TASK_POOL_LARGE_STACK_DEPTH__,  .count = __OS_TASK_POOL_LARGE_COUNT__ },
+};
+
+static struct {
+        StaticTask_t tcb[_TASK_POOL_SIZE];
+        StackType_t  stack[TASK_POOL_STACK_SIZE];
+        bool         used[_TASK_POOL_SIZE];
+} task_pool;
+#endif
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+/* lock statistics in cycles, entries are never released (names are static) */
+static struct {
+        const char *name;
+        u32_t       acquires;
+        u32_t       contended;
+        u32_t       timeouts;
+        u64_t       wait_total;
+        u32_t       wait_max;
+        u32_t       hold_max;
+} lock_prof[__OS_LOCK_PROFILER_ENTRIES__] = {
+        [LOCK_PROF_OTHER]     = {.name = "(other)"},
+        [LOCK_PROF_SCHEDULER] = {.name = "(scheduler)"},
+};
+
+static u32_t scheduler_locked_at;
+static u16_t scheduler_nesting;
+#endif
 
 /*==============================================================================
   Exported object definitions
@@ -86,6 +147,18 @@ static bool is_mutex_valid(mutex_t *mtx)
         return _mm_is_object_in_heap(mtx) && mtx->header.type == RES_TYPE_MUTEX && mtx->object;
 }
 
+//==============================================================================
+/**
+ * @brief Function check that reader-writer lock is a valid object
+ * @param rwlock        lock object to examine
+ * @return If object is valid then true is returned, false otherwise.
+ */
+//==============================================================================
+static bool is_rwlock_valid(rwlock_t *rwlock)
+{
+        return _mm_is_object_in_heap(rwlock) && rwlock->header.type == RES_TYPE_RWLOCK && rwlock->object;
+}
+
 //==============================================================================
 /**
  * @brief Function check that queue is a valid object
@@ -165,6 +238,12 @@ int _kernel_get_number_of_tasks(void)
 void _kernel_scheduler_lock(void)
 {
         vTaskSuspendAll();
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        if (scheduler_nesting++ == 0) {
+                scheduler_locked_at = _cpuctl_get_cycle_counter();
+        }
+#endif
 }
 
 //==============================================================================
@@ -174,6 +253,14 @@ void _kernel_scheduler_lock(void)
 //==============================================================================
 void _kernel_scheduler_unlock(void)
 {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        if (scheduler_nesting && (--scheduler_nesting == 0)) {
+                lock_prof_acquire(LOCK_PROF_SCHEDULER, true, false, 0);
+                lock_prof_release(LOCK_PROF_SCHEDULER,
+                                  _cpuctl_get_cycle_counter() - scheduler_locked_at);
+        }
+#endif
+
         if (xTaskResumeAll() == pdTRUE) {
                 taskYIELD();
         }
@@ -243,8 +330,14 @@ int _task_create(task_func_t func, const char *name, const size_t stack_depth, v
                                              parent_priority - 1 : parent_priority;
 
                 task_t *tsk = NULL;
-                if (xTaskCreate(func, name, stack_depth, argv,
-                                child_priority, &tsk) == pdPASS) {
+
+#if _TASK_POOL_SIZE > 0
+                tsk = task_pool_create(func, name, stack_depth, argv, child_priority);
+#endif
+
+                if (  tsk
+                   || xTaskCreate(func, name, stack_depth, argv,
+                                  child_priority, &tsk) == pdPASS) {
 
                         vTaskSetApplicationTaskTag(tsk, (void *)tag);
 
@@ -284,6 +377,88 @@ void _task_destroy(task_t *taskHdl)
         vTaskDelete(taskHdl);
 }
 
+#if _TASK_POOL_SIZE > 0
+//==============================================================================
+/**
+ * @brief Function create task by using preallocated stack and control block.
+ *        The smallest free stack that is not smaller than requested one is
+ *        used.
+ *
+ * @param[in ] func             task code
+ * @param[in ] name             task name
+ * @param[in ] stack_depth      task stack
+ * @param[in ] argv             task arguments
+ * @param[in ] priority         task priority
+ *
+ * @return On success task handle is returned, otherwise NULL (no free stack).
+ */
+//==============================================================================
+static task_t *task_pool_create(task_func_t func, const char *name, size_t stack_depth,
+                                void *argv, UBaseType_t priority)
+{
+        int    slot   = -1;
+        size_t depth  = 0;
+        size_t offset = 0;
+
+        _critical_section_begin();
+        {
+                size_t base  = 0;
+                size_t stack = 0;
+
+                for (size_t c = 0; c < ARRAY_SIZE(task_pool_class); c++) {
+                        const task_pool_class_t *class = &task_pool_class[c];
+
+                        if (  (class->stack_depth >= stack_depth)
+                           && (slot < 0 || class->stack_depth < depth) ) {
+
+                                for (size_t i = 0; i < class->count; i++) {
+                                        if (!task_pool.used[base + i]) {
+                                                slot   = base + i;
+                                                depth  = class->stack_depth;
+                                                offset = stack + (i * class->stack_depth);
+                                                break;
+                                        }
+                                }
+                        }
+
+                        base  += class->count;
+                        stack += class->count * class->stack_depth;
+                }
+
+                if (slot >= 0) {
+                        task_pool.used[slot] = true;
+                }
+        }
+        _critical_section_end();
+
+        if (slot >= 0) {
+                return xTaskCreateStatic(func, name, depth, argv, priority,
+                                         &task_pool.stack[offset],
+                                         &task_pool.tcb[slot]);
+        } else {
+                return NULL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function release preallocated stack and control block of deleted
+ *        task. Function is called by kernel when task memory is not used
+ *        anymore (see portCLEAN_UP_TCB in FreeRTOSConfig.h).
+ *
+ * @param[in] tcb               task control block
+ */
+//==============================================================================
+void _task_pool_release(void *tcb)
+{
+        StaticTask_t *task = tcb;
+
+        if (task >= &task_pool.tcb[0] && task < &task_pool.tcb[_TASK_POOL_SIZE]) {
+                task_pool.used[task - task_pool.tcb] = false;
+        }
+}
+#endif
+
 //==============================================================================
 /**
  * @brief Function wait for task exit
@@ -404,6 +579,42 @@ int _task_get_free_stack(task_t *taskhdl)
         return uxTaskGetStackHighWaterMark(taskhdl);
 }
 
+//==============================================================================
+/**
+ * @brief Function return peak stack usage of selected task. If task uses
+ *        preallocated stack then depth of pool stack is used instead of
+ *        requested one.
+ *
+ * @param[in] *taskhdl          task handle (NULL for current task)
+ * @param[in]  stack_depth      requested stack depth
+ *
+ * @return peak stack usage
+ */
+//==============================================================================
+size_t _task_get_stack_usage(task_t *taskhdl, size_t stack_depth)
+{
+#if _TASK_POOL_SIZE > 0
+        StaticTask_t *task = cast(StaticTask_t*, taskhdl ? taskhdl : xTaskGetCurrentTaskHandle());
+
+        if (task >= &task_pool.tcb[0] && task < &task_pool.tcb[_TASK_POOL_SIZE]) {
+                size_t slot = task - task_pool.tcb;
+
+                for (size_t c = 0; c < ARRAY_SIZE(task_pool_class); c++) {
+                        if (slot < task_pool_class[c].count) {
+                                stack_depth = task_pool_class[c].stack_depth;
+                                break;
+                        } else {
+                                slot -= task_pool_class[c].count;
+                        }
+                }
+        }
+#endif
+
+        size_t free_stack = uxTaskGetStackHighWaterMark(taskhdl);
+
+        return (stack_depth > free_stack) ? (stack_depth - free_stack) : 0;
+}
+
 //==============================================================================
 /**
  * @brief Function yield task
@@ -558,7 +769,21 @@ int _semaphore_destroy(sem_t *sem)
 int _semaphore_wait(sem_t *sem, const u32_t blocktime_ms)
 {
         if (is_semaphore_valid(sem)) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                u32_t wait = 0;
+                bool  r    = xSemaphoreTake(sem->object, 0);
+                bool  busy = !r;
+
+                if (busy && blocktime_ms) {
+                        u32_t t = _cpuctl_get_cycle_counter();
+                        r    = xSemaphoreTake(sem->object, MS2TICK((TickType_t)blocktime_ms));
+                        wait = _cpuctl_get_cycle_counter() - t;
+                }
+
+                lock_prof_acquire(sem->prof, r, busy, wait);
+#else
                 bool r = xSemaphoreTake(sem->object, MS2TICK((TickType_t)blocktime_ms));
+#endif
                 return r ? ESUCC : ETIME;
         } else {
                 printk("Invalid semaphore object @ %p", sem);
@@ -659,6 +884,30 @@ int _semaphore_signal_from_ISR(sem_t *sem, bool *task_woken)
         }
 }
 
+//==============================================================================
+/**
+ * @brief Function set semaphore name used by lock profiler. Statistics of all
+ *        objects with the same name are accumulated in common entry. Unnamed
+ *        objects are accumulated in "(other)" entry.
+ *
+ * @param[in] *sem              semaphore object
+ * @param[in] *name             name (must be valid during entire system runtime)
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _semaphore_set_name(sem_t *sem, const char *name)
+{
+        if (is_semaphore_valid(sem) && name) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                sem->prof = lock_prof_entry(name);
+#endif
+                return ESUCC;
+        } else {
+                return EINVAL;
+        }
+}
+
 //==============================================================================
 /**
  * @brief Function create new mutex
@@ -676,13 +925,9 @@ int _mutex_create(enum mutex_type type, mutex_t **mtx)
         if (type <= MUTEX_TYPE_NORMAL && mtx) {
                 err = _kzalloc(_MM_KRN, sizeof(mutex_t), cast(void**, mtx));
                 if (err == ESUCC) {
-                        if (type == MUTEX_TYPE_RECURSIVE) {
-                                (*mtx)->object    = xSemaphoreCreateRecursiveMutexStatic(&(*mtx)->buffer);
-                                (*mtx)->recursive = true;
-                        } else {
-                                (*mtx)->object    = xSemaphoreCreateMutexStatic(&(*mtx)->buffer);
-                                (*mtx)->recursive = false;
-                        }
+                        // lock is taken by owner field, semaphore only wakes up waiters
+                        (*mtx)->object    = xSemaphoreCreateBinaryStatic(&(*mtx)->buffer);
+                        (*mtx)->recursive = (type == MUTEX_TYPE_RECURSIVE);
 
                         if ((*mtx)->object) {
                                 (*mtx)->header.type = RES_TYPE_MUTEX;
@@ -720,7 +965,10 @@ int _mutex_destroy(mutex_t *mutex)
 
 //==============================================================================
 /**
- * @brief Function lock mutex
+ * @brief Function lock mutex. Free mutex is taken by atomic operation on
+ *        owner field. If mutex is locked then task marks mutex as contended,
+ *        rises priority of owner to own priority (priority inheritance) and
+ *        waits for unlock.
  *
  * @param[in] mutex             mutex object
  * @param[in] blocktime_ms      polling time
@@ -731,13 +979,30 @@ int _mutex_destroy(mutex_t *mutex)
 int _mutex_lock(mutex_t *mutex, const u32_t blocktime_ms)
 {
         if (is_mutex_valid(mutex)) {
-                bool status;
-                if (mutex->recursive) {
-                        status = xSemaphoreTakeRecursive(mutex->object, MS2TICK((TickType_t)blocktime_ms));
-                } else {
-                        status = xSemaphoreTake(mutex->object, MS2TICK((TickType_t)blocktime_ms));
+                task_t *task   = xTaskGetCurrentTaskHandle();
+                bool    status = mutex_take(mutex, task);
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                u32_t wait = 0;
+                bool  busy = !status;
+
+                if (busy && blocktime_ms) {
+                        u32_t t = _cpuctl_get_cycle_counter();
+                        status  = mutex_wait(mutex, task, blocktime_ms);
+                        wait    = _cpuctl_get_cycle_counter() - t;
                 }
 
+                lock_prof_acquire(mutex->prof, status, busy, wait);
+
+                if (status && (mutex->nesting == 0)) {
+                        mutex->locked_at = _cpuctl_get_cycle_counter();
+                }
+#else
+                if (!status && blocktime_ms) {
+                        status = mutex_wait(mutex, task, blocktime_ms);
+                }
+#endif
+
                 return status ? ESUCC : ETIME;
         } else {
                 printk("Invalid mutex object @ %p", mutex);
@@ -747,7 +1012,8 @@ int _mutex_lock(mutex_t *mutex, const u32_t blocktime_ms)
 
 //==============================================================================
 /**
- * @brief Function unlock mutex
+ * @brief Function unlock mutex. If tasks wait for mutex then inherited
+ *        priority is restored and one waiting task is woken up.
  *
  * @param[in] *mutex            mutex object
  *
@@ -757,20 +1023,375 @@ int _mutex_lock(mutex_t *mutex, const u32_t blocktime_ms)
 int _mutex_unlock(mutex_t *mutex)
 {
         if (is_mutex_valid(mutex)) {
-                bool status;
-                if (mutex->recursive) {
-                        status = xSemaphoreGiveRecursive(mutex->object);
-                } else {
-                        status = xSemaphoreGive(mutex->object);
+                uintptr_t task = (uintptr_t)xTaskGetCurrentTaskHandle();
+
+                // only owner can unlock mutex, thus nesting is not shared
+                if ((__atomic_load_n(&mutex->owner, __ATOMIC_RELAXED) & ~_MUTEX_WAITERS) != task) {
+                        return EBUSY;
                 }
 
-                return status ? ESUCC : EBUSY;
+                if (mutex->nesting) {
+                        mutex->nesting--;
+                        return ESUCC;
+                }
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                lock_prof_release(mutex->prof, _cpuctl_get_cycle_counter() - mutex->locked_at);
+#endif
+
+                uintptr_t owner = task;
+                if (!__atomic_compare_exchange_n(&mutex->owner, &owner, 0, false,
+                                                 __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                        bool yield;
+
+                        taskENTER_CRITICAL();
+                        {
+                                // waiters flag stays set for tasks that still wait
+                                __atomic_store_n(&mutex->owner,
+                                                 mutex->waiters ? _MUTEX_WAITERS : 0,
+                                                 __ATOMIC_RELEASE);
+
+                                // owner priority could be inherited by waiters
+                                pvTaskIncrementMutexHeldCount();
+                                yield = xTaskPriorityDisinherit(cast(TaskHandle_t, task));
+                        }
+                        taskEXIT_CRITICAL();
+
+                        xSemaphoreGive(mutex->object);
+
+                        if (yield) {
+                                taskYIELD();
+                        }
+                }
+
+                return ESUCC;
         } else {
                 printk("Invalid mutex object @ %p", mutex);
                 return EINVAL;
         }
 }
 
+//==============================================================================
+/**
+ * @brief Function set mutex name used by lock profiler. Statistics of all
+ *        objects with the same name are accumulated in common entry. Unnamed
+ *        objects are accumulated in "(other)" entry.
+ *
+ * @param[in] *mutex            mutex object
+ * @param[in] *name             name (must be valid during entire system runtime)
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mutex_set_name(mutex_t *mutex, const char *name)
+{
+        if (is_mutex_valid(mutex) && name) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                mutex->prof = lock_prof_entry(name);
+#endif
+                return ESUCC;
+        } else {
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function create new reader-writer lock. Many readers can hold lock
+ *        at the same time, writer has exclusive access. Writer is protected
+ *        by priority inheritance mutex, thus tasks waiting for lock (readers
+ *        and writers) rise priority of writer. Readers are not boosted, so
+ *        read sections should be short. Lock is writer preferred: new readers
+ *        wait when writer waits for active readers.
+ *
+ * @param[out] **rwlock         created lock
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_create(rwlock_t **rwlock)
+{
+        int err = EINVAL;
+
+        if (rwlock) {
+                err = _kzalloc(_MM_KRN, sizeof(rwlock_t), cast(void**, rwlock));
+                if (err == ESUCC) {
+                        (*rwlock)->object = xSemaphoreCreateRecursiveMutexStatic(&(*rwlock)->buffer);
+                        (*rwlock)->drain  = xSemaphoreCreateBinaryStatic(&(*rwlock)->drain_buffer);
+
+                        if ((*rwlock)->object && (*rwlock)->drain) {
+                                (*rwlock)->header.type = RES_TYPE_RWLOCK;
+                        } else {
+                                if ((*rwlock)->object) {
+                                        vSemaphoreDelete((*rwlock)->object);
+                                }
+
+                                if ((*rwlock)->drain) {
+                                        vSemaphoreDelete((*rwlock)->drain);
+                                }
+
+                                _kfree(_MM_KRN, cast(void**, rwlock));
+                                err = ENOMEM;
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function destroy reader-writer lock.
+ *
+ * @param[in] *rwlock           lock object
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_destroy(rwlock_t *rwlock)
+{
+        if (is_rwlock_valid(rwlock)) {
+                rwlock->header.type = RES_TYPE_UNKNOWN;
+                vSemaphoreDelete(rwlock->object);
+                vSemaphoreDelete(rwlock->drain);
+                rwlock->object = NULL;
+                rwlock->drain  = NULL;
+                return _kfree(_MM_KRN, cast(void**, &rwlock));
+        } else {
+                printk("Invalid rwlock object @ %p", rwlock);
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function lock reader-writer lock for reading. Writer can lock the
+ *        same lock for reading (nested lock). Reader cannot upgrade lock to
+ *        write lock (deadlock).
+ *
+ * @param[in] *rwlock           lock object
+ * @param[in]  blocktime_ms     lock polling time
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_read_lock(rwlock_t *rwlock, const u32_t blocktime_ms)
+{
+        if (is_rwlock_valid(rwlock)) {
+                // writer mutex is held only for a moment, thus reader that
+                // waits for writer rise its priority
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                u32_t wait   = 0;
+                bool  status = xSemaphoreTakeRecursive(rwlock->object, 0);
+                bool  busy   = !status;
+
+                if (busy && blocktime_ms) {
+                        u32_t t = _cpuctl_get_cycle_counter();
+                        status  = xSemaphoreTakeRecursive(rwlock->object, MS2TICK((TickType_t)blocktime_ms));
+                        wait    = _cpuctl_get_cycle_counter() - t;
+                }
+
+                lock_prof_acquire(rwlock->prof, status, busy, wait);
+#else
+                bool status = xSemaphoreTakeRecursive(rwlock->object, MS2TICK((TickType_t)blocktime_ms));
+#endif
+                if (status) {
+                        if (rwlock->writer == xTaskGetCurrentTaskHandle()) {
+                                // read lock nested in write lock, mutex stays taken
+                                rwlock->nesting++;
+                        } else {
+                                _critical_section_begin();
+                                rwlock->readers++;
+                                _critical_section_end();
+
+                                xSemaphoreGiveRecursive(rwlock->object);
+                        }
+                }
+
+                return status ? ESUCC : ETIME;
+        } else {
+                printk("Invalid rwlock object @ %p", rwlock);
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function unlock reader-writer lock locked for reading.
+ *
+ * @param[in] *rwlock           lock object
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_read_unlock(rwlock_t *rwlock)
+{
+        if (is_rwlock_valid(rwlock)) {
+                if (rwlock->writer == xTaskGetCurrentTaskHandle()) {
+                        return _rwlock_write_unlock(rwlock);
+                }
+
+                int  err  = EPERM;
+                bool wake = false;
+
+                _critical_section_begin();
+                {
+                        if (rwlock->readers) {
+                                rwlock->readers--;
+                                wake = (rwlock->readers == 0) && rwlock->drain_wait;
+                                err  = ESUCC;
+                        }
+                }
+                _critical_section_end();
+
+                if (wake) {
+                        xSemaphoreGive(rwlock->drain);
+                }
+
+                return err;
+        } else {
+                printk("Invalid rwlock object @ %p", rwlock);
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function lock reader-writer lock for writing. Function waits until
+ *        all readers leave the lock. Write lock is recursive.
+ *
+ * @param[in] *rwlock           lock object
+ * @param[in]  blocktime_ms     lock polling time
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_write_lock(rwlock_t *rwlock, const u32_t blocktime_ms)
+{
+        if (is_rwlock_valid(rwlock)) {
+                TickType_t timeout = MS2TICK((TickType_t)blocktime_ms);
+                TickType_t start   = xTaskGetTickCount();
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                u32_t t    = _cpuctl_get_cycle_counter();
+                bool  busy = (rwlock->readers > 0)
+                          || (xSemaphoreGetMutexHolder(rwlock->object) != NULL);
+#endif
+
+                if (!xSemaphoreTakeRecursive(rwlock->object, timeout)) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                        lock_prof_acquire(rwlock->prof, false, true, _cpuctl_get_cycle_counter() - t);
+#endif
+                        return ETIME;
+                }
+
+                if (rwlock->writer == xTaskGetCurrentTaskHandle()) {
+                        rwlock->nesting++;
+                        return ESUCC;
+                }
+
+                // new readers are blocked by writer mutex, wait for active ones
+                int err = ESUCC;
+
+                for (;;) {
+                        bool drained;
+
+                        _critical_section_begin();
+                        {
+                                drained            = (rwlock->readers == 0);
+                                rwlock->drain_wait = !drained;
+                        }
+                        _critical_section_end();
+
+                        if (drained) {
+                                break;
+                        }
+
+                        TickType_t elapsed = xTaskGetTickCount() - start;
+
+                        if (  (elapsed >= timeout)
+                           || !xSemaphoreTake(rwlock->drain, timeout - elapsed) ) {
+                                err = ETIME;
+                                break;
+                        }
+                }
+
+                if (!err) {
+                        rwlock->writer  = xTaskGetCurrentTaskHandle();
+                        rwlock->nesting = 1;
+                } else {
+                        _critical_section_begin();
+                        rwlock->drain_wait = false;
+                        _critical_section_end();
+
+                        // remove signal given by reader after timeout
+                        xSemaphoreTake(rwlock->drain, 0);
+                        xSemaphoreGiveRecursive(rwlock->object);
+                }
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                rwlock->locked_at = _cpuctl_get_cycle_counter();
+                lock_prof_acquire(rwlock->prof, !err, busy, busy ? rwlock->locked_at - t : 0);
+#endif
+
+                return err;
+        } else {
+                printk("Invalid rwlock object @ %p", rwlock);
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function unlock reader-writer lock locked for writing.
+ *
+ * @param[in] *rwlock           lock object
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_write_unlock(rwlock_t *rwlock)
+{
+        if (is_rwlock_valid(rwlock)) {
+                if (rwlock->writer != xTaskGetCurrentTaskHandle()) {
+                        return EPERM;
+                }
+
+                if (--rwlock->nesting == 0) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                        lock_prof_release(rwlock->prof, _cpuctl_get_cycle_counter() - rwlock->locked_at);
+#endif
+                        rwlock->writer = NULL;
+                }
+
+                return xSemaphoreGiveRecursive(rwlock->object) ? ESUCC : EPERM;
+        } else {
+                printk("Invalid rwlock object @ %p", rwlock);
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function set reader-writer lock name used by lock profiler.
+ *
+ * @param[in] *rwlock           lock object
+ * @param[in] *name             name (must be valid during entire system runtime)
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _rwlock_set_name(rwlock_t *rwlock, const char *name)
+{
+        if (is_rwlock_valid(rwlock) && name) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                rwlock->prof = lock_prof_entry(name);
+#endif
+                return ESUCC;
+        } else {
+                return EINVAL;
+        }
+}
 
 //==============================================================================
 /**
@@ -1020,7 +1641,21 @@ int _queue_reset(queue_t *queue)
 int _queue_send(queue_t *queue, const void *item, const u32_t waittime_ms)
 {
         if (is_queue_valid(queue) && item) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                u32_t      wait = 0;
+                BaseType_t r    = xQueueSend(queue->object, item, 0);
+                bool       busy = (r != pdTRUE);
+
+                if (busy && waittime_ms) {
+                        u32_t t = _cpuctl_get_cycle_counter();
+                        r    = xQueueSend(queue->object, item, MS2TICK((TickType_t)waittime_ms));
+                        wait = _cpuctl_get_cycle_counter() - t;
+                }
+
+                lock_prof_acquire(queue->prof, r == pdTRUE, busy, wait);
+#else
                 BaseType_t r = xQueueSend(queue->object, item, MS2TICK((TickType_t)waittime_ms));
+#endif
                 return r == pdTRUE ? ESUCC : ENOSPC;
         } else {
                 printk("Invalid queue object @ %p", queue);
@@ -1191,6 +1826,101 @@ int _queue_get_space_available(queue_t *queue, size_t *items)
         }
 }
 
+//==============================================================================
+/**
+ * @brief Function set queue name used by lock profiler. Statistics of all
+ *        objects with the same name are accumulated in common entry. Unnamed
+ *        objects are accumulated in "(other)" entry.
+ *
+ * @param[in] *queue            queue object
+ * @param[in] *name             name (must be valid during entire system runtime)
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _queue_set_name(queue_t *queue, const char *name)
+{
+        if (is_queue_valid(queue) && name) {
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+                queue->prof = lock_prof_entry(name);
+#endif
+                return ESUCC;
+        } else {
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function return statistics of selected lock (lock profiler). Entry 0
+ *        accumulates unnamed objects, entry 1 is the scheduler lock.
+ *
+ * @param[in]  entry            entry number
+ * @param[out] stat             lock statistics
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _lock_prof_get(uint entry, _lock_prof_t *stat)
+{
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        int err = EINVAL;
+
+        if (stat && (entry < ARRAY_SIZE(lock_prof)) && lock_prof[entry].name) {
+                u32_t cycles_per_us = max(1, _cpuctl_get_cycle_counter_frequency() / 1000000);
+
+                _critical_section_begin();
+                {
+                        stat->name       = lock_prof[entry].name;
+                        stat->acquires   = lock_prof[entry].acquires;
+                        stat->contended  = lock_prof[entry].contended;
+                        stat->timeouts   = lock_prof[entry].timeouts;
+                        stat->wait_total = lock_prof[entry].wait_total / cycles_per_us;
+                        stat->wait_max   = lock_prof[entry].wait_max / cycles_per_us;
+                        stat->hold_max   = lock_prof[entry].hold_max / cycles_per_us;
+                }
+                _critical_section_end();
+
+                err = ESUCC;
+        }
+
+        return err;
+#else
+        UNUSED_ARG2(entry, stat);
+        return ENOTSUP;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief Function reset statistics of all locks (lock profiler). Lock names
+ *        are not changed.
+ *
+ * @return One of errno value (ENOTSUP if profiler is disabled).
+ */
+//==============================================================================
+int _lock_prof_reset(void)
+{
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+        for (size_t i = 0; i < ARRAY_SIZE(lock_prof); i++) {
+                _critical_section_begin();
+                {
+                        lock_prof[i].acquires   = 0;
+                        lock_prof[i].contended  = 0;
+                        lock_prof[i].timeouts   = 0;
+                        lock_prof[i].wait_total = 0;
+                        lock_prof[i].wait_max   = 0;
+                        lock_prof[i].hold_max   = 0;
+                }
+                _critical_section_end();
+        }
+
+        return ESUCC;
+#else
+        return ENOTSUP;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief Function enter to critical section
@@ -1305,6 +2035,172 @@ void _sleep_until(const u32_t seconds, u32_t *ref_time_ticks)
         vTaskDelayUntil((TickType_t *)ref_time_ticks, MS2TICK(seconds * 1000UL));
 }
 
+//==============================================================================
+/**
+ * @brief Function take free mutex or increase nesting of recursive mutex
+ *        owned by task. Waiters flag of free mutex is kept, so next unlock
+ *        wakes up waiting task.
+ *
+ * @param[in] mutex             mutex object
+ * @param[in] task              current task
+ *
+ * @return If mutex is taken then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool mutex_take(mutex_t *mutex, task_t *task)
+{
+        uintptr_t owner = __atomic_load_n(&mutex->owner, __ATOMIC_RELAXED);
+
+        while ((owner & ~_MUTEX_WAITERS) == 0) {
+                if (__atomic_compare_exchange_n(&mutex->owner, &owner,
+                                                (uintptr_t)task | (owner & _MUTEX_WAITERS),
+                                                true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                        return true;
+                }
+        }
+
+        if (mutex->recursive && ((owner & ~_MUTEX_WAITERS) == (uintptr_t)task)) {
+                mutex->nesting++;
+                return true;
+        }
+
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief Function wait for mutex (contended path). Waiters flag forces owner
+ *        to unlock mutex in kernel, where inherited priority is restored and
+ *        waiting task is woken up. Flag is cleared only by unlock, thus owner
+ *        boosted by task that left by timeout is restored too.
+ *
+ * @param[in] mutex             mutex object
+ * @param[in] task              current task
+ * @param[in] blocktime_ms      max waiting time
+ *
+ * @return If mutex is taken then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool mutex_wait(mutex_t *mutex, task_t *task, u32_t blocktime_ms)
+{
+        TickType_t timeout = MS2TICK((TickType_t)blocktime_ms);
+        TimeOut_t  time;
+        bool       status;
+
+        vTaskSetTimeOutState(&time);
+
+        __atomic_add_fetch(&mutex->waiters, 1, __ATOMIC_RELAXED);
+
+        while (!(status = mutex_take(mutex, task))) {
+                uintptr_t owner;
+
+                taskENTER_CRITICAL();
+                {
+                        owner = __atomic_fetch_or(&mutex->owner, _MUTEX_WAITERS, __ATOMIC_RELAXED)
+                              & ~_MUTEX_WAITERS;
+
+                        if (owner) {
+                                vTaskPriorityInherit(cast(TaskHandle_t, owner));
+                        }
+                }
+                taskEXIT_CRITICAL();
+
+                // mutex released in the meantime, try again
+                if (owner) {
+                        if (xTaskCheckForTimeOut(&time, &timeout) == pdTRUE) {
+                                break;
+                        }
+
+                        xSemaphoreTake(mutex->object, timeout);
+                }
+        }
+
+        __atomic_sub_fetch(&mutex->waiters, 1, __ATOMIC_RELAXED);
+
+        return status;
+}
+
+#if __OS_ENABLE_LOCK_PROFILER__ == _YES_
+//==============================================================================
+/**
+ * @brief Function find lock profiler entry of selected name. If entry does not
+ *        exist then new one is created.
+ *
+ * @param[in] *name             lock name
+ *
+ * @return Entry number. If table is full then entry of unnamed locks.
+ */
+//==============================================================================
+static u8_t lock_prof_entry(const char *name)
+{
+        u8_t entry = LOCK_PROF_OTHER;
+
+        _kernel_scheduler_lock();
+        {
+                for (size_t i = LOCK_PROF_NAMED; i < ARRAY_SIZE(lock_prof); i++) {
+                        if (lock_prof[i].name == NULL) {
+                                lock_prof[i].name = name;
+                                entry = i;
+                                break;
+
+                        } else if (strcmp(lock_prof[i].name, name) == 0) {
+                                entry = i;
+                                break;
+                        }
+                }
+        }
+        _kernel_scheduler_unlock();
+
+        return entry;
+}
+
+//==============================================================================
+/**
+ * @brief Function update lock statistics at acquire.
+ *
+ * @param[in] entry             lock profiler entry
+ * @param[in] acquired          lock acquired
+ * @param[in] contended         lock was busy at first attempt
+ * @param[in] wait              wait time [cycles]
+ */
+//==============================================================================
+static void lock_prof_acquire(u8_t entry, bool acquired, bool contended, u32_t wait)
+{
+        _critical_section_begin();
+        {
+                if (acquired) {
+                        lock_prof[entry].acquires++;
+                } else {
+                        lock_prof[entry].timeouts++;
+                }
+
+                if (contended) {
+                        lock_prof[entry].contended++;
+                        lock_prof[entry].wait_total += wait;
+                        lock_prof[entry].wait_max    = max(lock_prof[entry].wait_max, wait);
+                }
+        }
+        _critical_section_end();
+}
+
+//==============================================================================
+/**
+ * @brief Function update lock statistics at release.
+ *
+ * @param[in] entry             lock profiler entry
+ * @param[in] hold              hold time [cycles]
+ */
+//==============================================================================
+static void lock_prof_release(u8_t entry, u32_t hold)
+{
+        _critical_section_begin();
+        {
+                lock_prof[entry].hold_max = max(lock_prof[entry].hold_max, hold);
+        }
+        _critical_section_end();
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
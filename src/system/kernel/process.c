@@ -41,6 +41,7 @@
 #include "kernel/printk.h"
 #include "kernel/sysfunc.h"
 #include "kernel/khooks.h"
+#include "kernel/ktrace.h"
 #include "lib/llist.h"
 #include "lib/cast.h"
 #include "dnx/misc.h"
@@ -60,6 +61,12 @@
 #define ATOMIC(_mtx) for (int __ = 0; __ == 0;)\
         for (int _e = _mutex_lock(_mtx, MAX_DELAY_MS); _e == 0 && __ == 0; _mutex_unlock(_mtx), __++)
 
+#define READ_LOCKED(_rwl) for (int __ = 0; __ == 0;)\
+        for (int _e = _rwlock_read_lock(_rwl, MAX_DELAY_MS); _e == 0 && __ == 0; _rwlock_read_unlock(_rwl), __++)
+
+#define WRITE_LOCKED(_rwl) for (int __ = 0; __ == 0;)\
+        for (int _e = _rwlock_write_lock(_rwl, MAX_DELAY_MS); _e == 0 && __ == 0; _rwlock_write_unlock(_rwl), __++)
+
 #define PROC_MAX_THREADS(proc)          (((proc)->flag & FLAG_KWORKER) ? __OS_TASK_MAX_SYSTEM_THREADS__ : __OS_TASK_MAX_USER_THREADS__)
 
 #define is_proc_valid(proc)             (_mm_is_object_in_heap(proc) && (proc->header.type == RES_TYPE_PROCESS))
@@ -81,6 +88,7 @@ struct _process {
         FILE            *f_stdout;      //!< stdout file
         FILE            *f_stderr;      //!< stderr file
         void            *globals;       //!< address to global variables
+        struct _uheap   *heap;          //!< user space heap (malloc arena)
         res_header_t    *res_list;      //!< list of used resources
         char            *cwd;           //!< current working path
         const pdata_t   *pdata;         //!< program data
@@ -94,6 +102,9 @@ struct _process {
         u8_t             flag;          //!< control flags
         u16_t            syscalls;      //!< syscalls per second
         u16_t            syscalls_ctr;  //!< syscall counter
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        struct thread_info *thread_info;//!< thread functions and stack depths
+#endif
 };
 
 typedef struct {
@@ -101,6 +112,13 @@ typedef struct {
         void           *arg;
 } thread_args_t;
 
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+struct thread_info {
+        thread_func_t   func;
+        size_t          stack_depth;
+};
+#endif
+
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
@@ -117,6 +135,10 @@ static void process_get_stat(_process_t *proc, process_stat_t *stat);
 static void process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to);
 static int  get_pid(pid_t *pid);
 
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+static void stack_prof_record(_process_t *proc, tid_t tid, bool finished);
+#endif
+
 #if __OS_SYSTEM_SHEBANG_ENABLE__ > 0
 static bool is_cmd_path(const char *cmd);
 static int  analyze_shebang(_process_t *proc, const char *cmd, char **cmdarg);
@@ -130,12 +152,16 @@ static _process_t    *active_process_list;
 static _process_t    *destroy_process_list;
 static _process_t    *zombie_process_list;
 static _process_t    *active_process;
-static task_t        *active_task;
 static u32_t          CPU_total_time_last;
 static avg_CPU_load_t avg_CPU_load_calc;
 static avg_CPU_load_t avg_CPU_load_result;
 static mutex_t       *process_mtx;
 static mutex_t       *kworker_mtx;
+static rwlock_t      *process_list_lock;
+
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+static _process_stack_prof_t stack_prof[__OS_STACK_PROFILER_ENTRIES__];
+#endif
 
 /*==============================================================================
   Exported object definitions
@@ -158,6 +184,12 @@ int _errno = ESUCC;
 /* global variables */
 struct _GVAR_STRUCT_NAME *global = NULL;
 
+/* user space heap */
+struct _uheap *_uheap = NULL;
+
+/* current task (NULL until first context switch) */
+task_t *_active_task = NULL;
+
 /*==============================================================================
   External object definitions
 ==============================================================================*/
@@ -184,10 +216,17 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
 {
         if (!process_mtx) {
                 _assert(_mutex_create(MUTEX_TYPE_RECURSIVE, &process_mtx) == ESUCC);
+                _mutex_set_name(process_mtx, "process");
         }
 
         if (!kworker_mtx) {
                 _assert(_mutex_create(MUTEX_TYPE_RECURSIVE, &kworker_mtx) == ESUCC);
+                _mutex_set_name(kworker_mtx, "kworker");
+        }
+
+        if (!process_list_lock) {
+                _assert(_rwlock_create(&process_list_lock) == ESUCC);
+                _rwlock_set_name(process_list_lock, "process-list");
         }
 
         if (!cmd) {
@@ -247,6 +286,12 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                                cast(void*, &proc->task));
                 if (err) goto finish;
 
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                err = _kzalloc(_MM_KRN, sizeof(struct thread_info) * PROC_MAX_THREADS(proc),
+                               cast(void*, &proc->thread_info));
+                if (err) goto finish;
+#endif
+
                 ATOMIC(process_mtx) {
                         err = _task_create(process_code,
                                            proc->pdata->name,
@@ -264,14 +309,16 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                                         *pid = proc->pid;
                                 }
 
-                                if (active_process_list == NULL) {
-                                        active_process_list = proc;
+                                WRITE_LOCKED(process_list_lock) {
+                                        if (active_process_list == NULL) {
+                                                active_process_list = proc;
 
-                                } else {
-                                        proc->header.next = cast(res_header_t*,
-                                                                 active_process_list);
+                                        } else {
+                                                proc->header.next = cast(res_header_t*,
+                                                                         active_process_list);
 
-                                        active_process_list = proc;
+                                                active_process_list = proc;
+                                        }
                                 }
                         }
                 }
@@ -312,7 +359,10 @@ KERNELSPACE void _process_clean_up_killed_processes(void)
                                                           &destroy_process_list,
                                                           &zombie_process_list);
                                 } else {
-                                        destroy_process_list = cast(_process_t *, proc->header.next);
+                                        WRITE_LOCKED(process_list_lock) {
+                                                destroy_process_list = cast(_process_t *, proc->header.next);
+                                        }
+
                                         _flag_destroy(proc->event);
                                         proc->event = NULL;
                                         _kfree(_MM_KRN, cast(void*, &proc));
@@ -347,6 +397,10 @@ KERNELSPACE int _process_kill(pid_t pid)
 
                                 for (int i = 0; i < threads; i++) {
                                         if (proc->task && proc->task[i]) {
+                                                #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                                                stack_prof_record(proc, i, true);
+                                                #endif
+
                                                 _task_destroy(proc->task[i]);
                                                 proc->task[i] = NULL;
                                         }
@@ -378,28 +432,35 @@ KERNELSPACE void _process_remove_zombie(_process_t *proc, int *status)
         _assert(is_proc_valid(proc));
 
         ATOMIC(process_mtx) {
-                _process_t *prev = NULL;
-                foreach_process(p, zombie_process_list) {
-                        if (p == proc) {
+                bool found = false;
 
-                                if (prev) {
-                                        prev->header.next = proc->header.next;
-                                } else {
-                                        zombie_process_list = cast(_process_t *,
-                                                                   proc->header.next);
-                                }
+                WRITE_LOCKED(process_list_lock) {
+                        _process_t *prev = NULL;
+                        foreach_process(p, zombie_process_list) {
+                                if (p == proc) {
 
-                                if (status) {
-                                        *status = proc->status;
-                                }
+                                        if (prev) {
+                                                prev->header.next = proc->header.next;
+                                        } else {
+                                                zombie_process_list = cast(_process_t *,
+                                                                           proc->header.next);
+                                        }
 
-                                _flag_destroy(proc->event);
-                                _kfree(_MM_KRN, cast(void*, &proc));
+                                        found = true;
+                                        break;
+                                } else {
+                                        prev = p;
+                                }
+                        }
+                }
 
-                                break;
-                        } else {
-                                prev = p;
+                if (found) {
+                        if (status) {
+                                *status = proc->status;
                         }
+
+                        _flag_destroy(proc->event);
+                        _kfree(_MM_KRN, cast(void*, &proc));
                 }
         }
 }
@@ -443,6 +504,10 @@ KERNELSPACE void _process_exit(_process_t *proc, int status)
 
                         for (int i = 1; i < threads; i++) {
                                 if (proc->task[i]) {
+                                        #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                                        stack_prof_record(proc, i, true);
+                                        #endif
+
                                         _task_destroy(proc->task[i]);
                                         proc->task[i] = NULL;
                                 }
@@ -450,6 +515,10 @@ KERNELSPACE void _process_exit(_process_t *proc, int status)
 
                         process_move_list(proc, &active_process_list, &destroy_process_list);
 
+                        #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                        stack_prof_record(proc, 0, true);
+                        #endif
+
                         proc->task[0] = NULL;
                 }
 
@@ -640,6 +709,52 @@ KERNELSPACE int _process_get_stat_pid(pid_t pid, process_stat_t *stat)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function return peak stack usage of selected program thread (stack
+ *         profiler). Statistics are kept for all runs of the program thread
+ *         since system start. Threads that are still running are sampled when
+ *         the first entry is read.
+ *
+ * @param  seek         entry number
+ * @param  prof         stack profile
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+KERNELSPACE int _process_get_stack_prof(size_t seek, _process_stack_prof_t *prof)
+{
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        int err = EINVAL;
+
+        if (prof) {
+                ATOMIC(process_mtx) {
+                        if (seek == 0) {
+                                foreach_process(proc, active_process_list) {
+                                        u8_t threads = PROC_MAX_THREADS(proc);
+
+                                        for (tid_t tid = 0; proc->task && tid < threads; tid++) {
+                                                if (proc->task[tid]) {
+                                                        stack_prof_record(proc, tid, false);
+                                                }
+                                        }
+                                }
+                        }
+
+                        if ((seek < ARRAY_SIZE(stack_prof)) && stack_prof[seek].name) {
+                                *prof = stack_prof[seek];
+                                err   = ESUCC;
+                        }
+                }
+        }
+
+        return err;
+#else
+        UNUSED_ARG2(seek, prof);
+        return ENOTSUP;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  Function return stderr file of selected process.
@@ -687,7 +802,7 @@ KERNELSPACE size_t _process_get_count(void)
 {
         size_t count = 0;
 
-        ATOMIC(process_mtx) {
+        READ_LOCKED(process_list_lock) {
                 foreach_process(proc, active_process_list) {
                         count++;
                 }
@@ -777,8 +892,7 @@ KERNELSPACE int _process_get_priority(pid_t pid, int *prio)
         int err = EINVAL;
 
         if (pid && prio) {
-                _kernel_scheduler_lock();
-                {
+                READ_LOCKED(process_list_lock) {
                         if (active_process->pid == pid) {
                                 *prio = _task_get_priority(active_process->task[0]);
                                 err   = ESUCC;
@@ -793,7 +907,6 @@ KERNELSPACE int _process_get_priority(pid_t pid, int *prio)
                                 }
                         }
                 }
-                _kernel_scheduler_unlock();
         }
 
         return err;
@@ -814,8 +927,7 @@ KERNELSPACE int _process_get_container(pid_t pid, _process_t **process)
         int err = EINVAL;
 
         if (pid && process) {
-                _kernel_scheduler_lock();
-                {
+                READ_LOCKED(process_list_lock) {
                         if (active_process->pid == pid) {
                                 *process = active_process;
                                 err = ESUCC;
@@ -851,7 +963,6 @@ KERNELSPACE int _process_get_container(pid_t pid, _process_t **process)
                                 }
                         }
                 }
-                _kernel_scheduler_unlock();
         }
 
         return err;
@@ -871,7 +982,7 @@ KERNELSPACE tid_t _process_get_active_thread(void)
         tid_t tid = UINT8_MAX;
 
         for (int i = 0; i < PROC_MAX_THREADS(active_process); i++) {
-                if (active_process->task && (active_process->task[i] == active_task)) {
+                if (active_process->task && (active_process->task[i] == _active_task)) {
                         tid = i;
                         break;
                 }
@@ -1077,6 +1188,11 @@ KERNELSPACE int _process_thread_create(_process_t          *proc,
                                                                    attr->priority);
                                         }
 
+                                        #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                                        proc->thread_info[id].func        = func;
+                                        proc->thread_info[id].stack_depth = (attr ? attr->stack_depth : STACK_DEPTH_LOW);
+                                        #endif
+
                                         if (tid) {
                                                 *tid = id;
                                         }
@@ -1108,6 +1224,10 @@ KERNELSPACE int _process_thread_kill(_process_t *proc, tid_t tid)
         if (is_proc_valid(proc) && proc->task && is_tid_in_range(proc, tid)) {
                 ATOMIC(process_mtx) {
                         if (proc->task[tid]) {
+                                #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                                stack_prof_record(proc, tid, true);
+                                #endif
+
                                 _task_destroy(proc->task[tid]);
                                 proc->task[tid] = NULL;
                         }
@@ -1317,6 +1437,10 @@ USERSPACE static void thread_code(void *arg)
                         _flag_set(proc->event, _PROCESS_EXIT_FLAG(tid));
                 }
 
+                #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                stack_prof_record(proc, tid, true);
+                #endif
+
                 proc->task[tid] = NULL;
         }
 
@@ -1335,23 +1459,25 @@ USERSPACE static void thread_code(void *arg)
 static void process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to)
 {
         ATOMIC(process_mtx) {
-                _process_t *prev = NULL;
-                foreach_process(p, *list_from) {
-                        if (p == proc) {
+                WRITE_LOCKED(process_list_lock) {
+                        _process_t *prev = NULL;
+                        foreach_process(p, *list_from) {
+                                if (p == proc) {
 
-                                if (prev) {
-                                        prev->header.next = proc->header.next;
-                                } else {
-                                        *list_from = cast(_process_t*, proc->header.next);
-                                }
+                                        if (prev) {
+                                                prev->header.next = proc->header.next;
+                                        } else {
+                                                *list_from = cast(_process_t*, proc->header.next);
+                                        }
 
-                                proc->header.next = cast(struct res_header*, *list_to);
+                                        proc->header.next = cast(struct res_header*, *list_to);
 
-                                *list_to = proc;
+                                        *list_to = proc;
 
-                                break;
-                        } else {
-                                prev = p;
+                                        break;
+                                } else {
+                                        prev = p;
+                                }
                         }
                 }
         }
@@ -1372,6 +1498,10 @@ static void process_destroy_all_resources(_process_t *proc)
         if (proc->task) {
                 for (tid_t tid = 0; tid < threads; tid++) {
                         if (proc->task[tid]) {
+                                #if __OS_ENABLE_STACK_PROFILER__ == _YES_
+                                stack_prof_record(proc, tid, true);
+                                #endif
+
                                 _task_destroy(proc->task[tid]);
                                 proc->task[tid] = NULL;
                         }
@@ -1380,6 +1510,12 @@ static void process_destroy_all_resources(_process_t *proc)
                 _kfree(_MM_KRN, cast(void*, &proc->task));
         }
 
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+        if (proc->thread_info) {
+                _kfree(_MM_KRN, cast(void*, &proc->thread_info));
+        }
+#endif
+
         if (proc->argv) {
                 argtab_destroy(proc->argv);
                 proc->argv = NULL;
@@ -1441,6 +1577,7 @@ static void process_destroy_all_resources(_process_t *proc)
         proc->f_stdout = NULL;
         proc->f_stderr = NULL;
         proc->globals  = NULL;
+        proc->heap     = NULL;
 }
 
 //==============================================================================
@@ -2056,7 +2193,7 @@ static int allocate_process_globals(_process_t *proc, const struct _prog_data *u
 //==============================================================================
 /**
  * @brief  Function copy task context to standard variables (stdin, stdout, stderr,
- *         global, errno). Function is called when this task is already switched.
+ *         global, heap, errno). Function is called when this task is already switched.
  *         See FreeRTOSConfig.h file.
  *
  * @param  task         current task
@@ -2067,27 +2204,37 @@ KERNELSPACE void _task_switched_in(task_t *task, void *task_tag)
 {
         CPU_total_time_last = _CPU_total_time;
         active_process = task_tag;
-        active_task = task;
+        _active_task = task;
 
         if (active_process && (active_process->header.type == RES_TYPE_PROCESS)) {
+                #if __OS_ENABLE_TRACE__ > 0
+                _trace_event(_TRACE_EVENT_TASK_SWITCHED_IN, active_process->pid, (u32_t)(size_t)task);
+                #endif
+
                 stdin  = active_process->f_stdin;
                 stdout = active_process->f_stdout;
                 stderr = active_process->f_stderr;
                 global = active_process->globals;
+                _uheap = active_process->heap;
                 _errno = active_process->errnov;
         } else {
+                #if __OS_ENABLE_TRACE__ > 0
+                _trace_event(_TRACE_EVENT_TASK_SWITCHED_IN, 0, (u32_t)(size_t)task);
+                #endif
+
                 stdin  = NULL;
                 stdout = NULL;
                 stderr = NULL;
                 global = NULL;
+                _uheap = NULL;
                 _errno = 0;
         }
 }
 
 //==============================================================================
 /**
- * @brief  Function copy standard variables (stdin, stdout, stderr, global, errno)
- *         to task context. Function is called before this task context to be
+ * @brief  Function copy standard variables (stdin, stdout, stderr, global, heap,
+ *         errno) to task context. Function is called before this task context to be
  *         switched.
  *         See FreeRTOSConfig.h file.
  *
@@ -2100,10 +2247,15 @@ KERNELSPACE void _task_switched_out(task_t *task, void *task_tag)
         UNUSED_ARG2(task, task_tag);
 
         if (active_process && (active_process->header.type == RES_TYPE_PROCESS)) {
+                #if __OS_ENABLE_TRACE__ > 0
+                _trace_event(_TRACE_EVENT_TASK_SWITCHED_OUT, active_process->pid, (u32_t)(size_t)task);
+                #endif
+
                 active_process->f_stdin  = stdin;
                 active_process->f_stdout = stdout;
                 active_process->f_stderr = stderr;
                 active_process->globals  = global;
+                active_process->heap     = _uheap;
                 active_process->errnov   = _errno;
 
                 #if (__OS_MONITOR_CPU_LOAD__ > 0)
@@ -2111,12 +2263,62 @@ KERNELSPACE void _task_switched_out(task_t *task, void *task_tag)
                 active_process->timecnt += (_CPU_total_time - CPU_total_time_last);
                 #endif
         } else {
+                #if __OS_ENABLE_TRACE__ > 0
+                _trace_event(_TRACE_EVENT_TASK_SWITCHED_OUT, 0, (u32_t)(size_t)task);
+                #endif
+
                 #if (__OS_MONITOR_CPU_LOAD__ > 0)
                 _CPU_total_time += _cpuctl_get_CPU_load_counter_delta();
                 #endif
         }
 }
 
+#if __OS_ENABLE_STACK_PROFILER__ == _YES_
+//==============================================================================
+/**
+ * @brief  Function update peak stack usage of selected thread in stack profile
+ *         table. Threads are identified by program name, thread function, and
+ *         requested stack depth. New threads are not recorded if table is full.
+ *
+ * @param  proc         process
+ * @param  tid          thread ID
+ * @param  finished     thread is finished (run is counted)
+ */
+//==============================================================================
+static void stack_prof_record(_process_t *proc, tid_t tid, bool finished)
+{
+        thread_func_t func  = tid ? proc->thread_info[tid].func : NULL;
+        size_t        depth = tid ? proc->thread_info[tid].stack_depth
+                                  : *proc->pdata->stack_depth;
+
+        for (size_t i = 0; i < ARRAY_SIZE(stack_prof); i++) {
+                _process_stack_prof_t *prof = &stack_prof[i];
+
+                if (prof->name == NULL) {
+                        prof->name        = proc->pdata->name;
+                        prof->entry       = func;
+                        prof->stack_depth = depth;
+
+                } else if (  (prof->name != proc->pdata->name)
+                          || (prof->entry != func)
+                          || (prof->stack_depth != depth) ) {
+                        continue;
+                }
+
+                size_t usage = _task_get_stack_usage(proc->task[tid], depth);
+                if (usage > prof->max_usage) {
+                        prof->max_usage = usage;
+                }
+
+                if (finished) {
+                        prof->runs++;
+                }
+
+                break;
+        }
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
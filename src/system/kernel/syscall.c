@@ -41,6 +41,7 @@
 #include "kernel/errno.h"
 #include "kernel/time.h"
 #include "kernel/khooks.h"
+#include "kernel/ktrace.h"
 #include "kernel/sysfunc.h"
 #include "lib/cast.h"
 #include "lib/unarg.h"
@@ -48,6 +49,8 @@
 #include "lib/strlcpy.h"
 #include "net/netm.h"
 #include "mm/shm.h"
+#include "mm/cache.h"
+#include "mm/shrinker.h"
 #include "dnx/misc.h"
 
 /*==============================================================================
@@ -55,6 +58,13 @@
 ==============================================================================*/
 #define SYSCALL_QUEUE_LENGTH            4
 
+#if __OS_TASK_KWORKER_MODE__ == 1
+#define IO_THREADS_MAX                  min(max(__OS_TASK_KWORKER_IO_THREADS_MAX__, __OS_TASK_KWORKER_IO_THREADS__),\
+                                            __OS_TASK_MAX_SYSTEM_THREADS__ - 1)
+#define IO_THREADS_MIN                  min(__OS_TASK_KWORKER_IO_THREADS__, IO_THREADS_MAX)
+#define IO_IDLE_TIMEOUT_MS              (1000 * __OS_TASK_KWORKER_IO_IDLE_TIMEOUT__)
+#endif
+
 #define FS_CACHE_SYNC_PERIOD_MS         (1000 * __OS_SYSTEM_CACHE_SYNC_PERIOD__)
 
 #define GETARG(type, var)               type var = va_arg(rq->args, type)
@@ -74,13 +84,18 @@
 /*==============================================================================
   Local object types
 ==============================================================================*/
-typedef struct {
+typedef struct syscallrq {
         void       *retptr;
         _process_t *client_proc;
         tid_t       client_thread;
         syscall_t   syscall_no;
         va_list     args;
         int         err;
+#if __OS_TASK_KWORKER_MODE__ == 1
+        struct syscallrq *next;         // next request in class queue
+        int               priority;     // client thread priority
+        u32_t             timestamp;    // time of request enqueue
+#endif
 } syscallrq_t;
 
 typedef void (*syscallfunc_t)(syscallrq_t*);
@@ -90,7 +105,11 @@ typedef void (*syscallfunc_t)(syscallrq_t*);
 ==============================================================================*/
 static void syscall_do(void *rq);
 #if __OS_TASK_KWORKER_MODE__ == 1
-static void syscall_RTR(void *rq_queue);
+static void syscall_RTR(void *arg);
+static int  io_thread_start(void);
+static int  io_request_send(syscallrq_t *rq);
+static syscallrq_t *io_request_take(enum _syscall_class *class);
+static enum _syscall_class get_syscall_class(syscall_t syscall);
 #endif
 
 
@@ -191,6 +210,9 @@ static void syscall_netshutdown(syscallrq_t *rq);
 static void syscall_netsendto(syscallrq_t *rq);
 static void syscall_netrecvfrom(syscallrq_t *rq);
 static void syscall_netgetaddress(syscallrq_t *rq);
+static void syscall_netrecvview(syscallrq_t *rq);
+static void syscall_netrecvrelease(syscallrq_t *rq);
+static void syscall_netsendmsg(syscallrq_t *rq);
 #endif
 #if __OS_ENABLE_SHARED_MEMORY__ == _YES_
 static void syscall_shmcreate(syscallrq_t *rq);
@@ -207,12 +229,29 @@ static void syscall_shmdestroy(syscallrq_t *rq);
 static queue_t *call_request;
 #elif __OS_TASK_KWORKER_MODE__ == 1
 static queue_t *call_nonblocking;
-static queue_t *call_blocking;
+
+/* I/O thread pool */
+static struct {
+        syscallrq_t            *queue[_SYSCALL_CLASS_COUNT];    // requests ordered by client priority
+        sem_t                  *request;                        // request counter
+        u32_t                   pending;                        // number of queued requests
+        u32_t                   deferred;                       // requests postponed by class limit
+        u32_t                   spawning;                       // number of threads during start
+        _syscall_kworker_stat_t stat;
+} iopool;
 #elif __OS_TASK_KWORKER_MODE__ == 2
 #else
 #error __OS_TASK_KWORKER_MODE__: unknown mode
 #endif
 
+#if (__OS_TASK_KWORKER_MODE__ == 0) || (__OS_TASK_KWORKER_MODE__ == 1)
+static const thread_attr_t io_thread_attr = {
+        .stack_depth = STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__),
+        .priority    = PRIORITY_NORMAL,
+        .detached    = true
+};
+#endif
+
 /* syscall table */
 static const syscallfunc_t syscalltab[] = {
         [SYSCALL_MOUNT ] = syscall_mount,
@@ -320,6 +359,9 @@ static const syscallfunc_t syscalltab[] = {
         [SYSCALL_NETSENDTO        ] = syscall_netsendto,
         [SYSCALL_NETRECVFROM      ] = syscall_netrecvfrom,
         [SYSCALL_NETGETADDRESS    ] = syscall_netgetaddress,
+        [SYSCALL_NETRECVVIEW      ] = syscall_netrecvview,
+        [SYSCALL_NETRECVRELEASE   ] = syscall_netrecvrelease,
+        [SYSCALL_NETSENDMSG       ] = syscall_netsendmsg,
         #endif
 };
 
@@ -364,12 +406,19 @@ int _syscall_init()
         catcherr(err = _queue_create(SYSCALL_QUEUE_LENGTH, sizeof(syscallrq_t*),
                                      &call_request), exit);
 
+        _queue_set_name(call_request, "syscall");
+
 #elif __OS_TASK_KWORKER_MODE__ == 1
         catcherr(err = _queue_create(SYSCALL_QUEUE_LENGTH, sizeof(syscallrq_t*),
                                      &call_nonblocking), exit);
 
-        catcherr(err = _queue_create(SYSCALL_QUEUE_LENGTH, sizeof(syscallrq_t*),
-                                     &call_blocking), exit);
+        catcherr(err = _semaphore_create(UINT16_MAX, 0, &iopool.request), exit);
+
+        _queue_set_name(call_nonblocking, "syscall");
+        _semaphore_set_name(iopool.request, "iopool");
+
+        iopool.stat.threads_min = IO_THREADS_MIN;
+        iopool.stat.threads_max = IO_THREADS_MAX;
 #endif
 
         catcherr(err = _process_create("kworker", &attr, NULL), exit);
@@ -451,7 +500,7 @@ void syscall(syscall_t syscall, void *retptr, ...)
                                         call_rq = call_nonblocking;
 
                                 } else if (syscall <= _SYSCALL_GROUP_1_BLOCKING) {
-                                        call_rq = call_blocking;
+                                        call_rq = NULL;
 
                                 } else {
                                         _errno = ENOSYS;
@@ -461,9 +510,13 @@ void syscall(syscall_t syscall, void *retptr, ...)
 #endif
 
                                 while (true) {
-                                        if (_queue_send(call_rq,
-                                                        &syscallrq_ptr,
-                                                        2000) == ESUCC) {
+#if __OS_TASK_KWORKER_MODE__ == 1
+                                        int err = call_rq ? _queue_send(call_rq, &syscallrq_ptr, 2000)
+                                                          : io_request_send(syscallrq_ptr);
+#else
+                                        int err = _queue_send(call_rq, &syscallrq_ptr, 2000);
+#endif
+                                        if (err == ESUCC) {
 
                                                 if (_flag_wait(event_flags,
                                                                _PROCESS_SYSCALL_FLAG(tid),
@@ -503,31 +556,19 @@ int _syscall_kworker_process(int argc, char *argv[])
 {
         UNUSED_ARG2(argc, argv);
 
-#if (__OS_TASK_KWORKER_MODE__ ==  0) || (__OS_TASK_KWORKER_MODE__ ==  1)
-        static const thread_attr_t blocking_thread_attr = {
-                .stack_depth = STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__),
-                .priority    = PRIORITY_NORMAL,
-                .detached    = true
-        };
-#endif
-
         _task_get_process_container(_THIS_TASK, &_kworker_proc, NULL);
         _assert(_kworker_proc);
 
 #if __OS_TASK_KWORKER_MODE__ == 1
         int iothrs_created = 0;
 
-        for (int i = 0;
-                (i < __OS_TASK_KWORKER_IO_THREADS__)
-             && (i < __OS_TASK_MAX_SYSTEM_THREADS__ - 1); i++) {
+        for (int i = 0; i < IO_THREADS_MIN; i++) {
 
-                int err = _process_thread_create(_kworker_proc,
-                                                 syscall_RTR,
-                                                 &blocking_thread_attr,
-                                                 call_blocking,
-                                                 NULL);
+                _critical_section_begin();
+                iopool.spawning++;
+                _critical_section_end();
 
-                if (err) {
+                if (io_thread_start() != ESUCC) {
                         _assert_msg(false, "Fail in creating Ready-To-Run thread");
                         break;
                 }
@@ -535,8 +576,8 @@ int _syscall_kworker_process(int argc, char *argv[])
                 iothrs_created++;
         }
 
-        _printk("Created %d/%d Ready-To-Run IO threads",
-                iothrs_created, __OS_TASK_KWORKER_IO_THREADS__);
+        _printk("Created %d/%d Ready-To-Run IO threads (max %d)",
+                iothrs_created, IO_THREADS_MIN, IO_THREADS_MAX);
 #endif
 
         u32_t sync_period_ref = _kernel_get_time_ms();
@@ -544,7 +585,7 @@ int _syscall_kworker_process(int argc, char *argv[])
         for (;;) {
 #if __OS_TASK_KWORKER_MODE__ == 0
                 syscallrq_t *sysrq = NULL;
-                if (_queue_receive(call_request, &sysrq, SYNC_PERIOD_MS) == ESUCC) {
+                if (_queue_receive(call_request, &sysrq, FS_CACHE_SYNC_PERIOD_MS) == ESUCC) {
 
                         _process_clean_up_killed_processes();
 
@@ -556,7 +597,7 @@ int _syscall_kworker_process(int argc, char *argv[])
                                 /* create new syscall task */
                                 switch (_process_thread_create(_kworker_proc,
                                                                syscall_do,
-                                                               &blocking_thread_attr,
+                                                               &io_thread_attr,
                                                                sysrq, NULL) ) {
                                 case ESUCC:
                                         _task_yield();
@@ -569,6 +610,8 @@ int _syscall_kworker_process(int argc, char *argv[])
                                         _kernel_release_resources();
                                         _vfs_sync();
                                         _cache_sync();
+                                        _mm_shrink(STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__)
+                                                  * sizeof(StackType_t));
                                         // go through
 
                                 default:
@@ -579,6 +622,7 @@ int _syscall_kworker_process(int argc, char *argv[])
                         }
                 }
 #elif __OS_TASK_KWORKER_MODE__ == 1
+                syscallrq_t *sysrq = NULL;
                 if (_queue_receive(call_nonblocking, &sysrq, FS_CACHE_SYNC_PERIOD_MS) == ESUCC) {
                         _process_clean_up_killed_processes();
                         _kernel_release_resources();
@@ -638,8 +682,20 @@ static void syscall_do(void *rq)
 #endif
         _process_syscall_stat_inc(sysrq->client_proc, _kworker_proc);
 
+#if __OS_ENABLE_TRACE__ > 0
+        if (_trace_is_enabled()) {
+                pid_t pid = 0;
+                _process_get_pid(sysrq->client_proc, &pid);
+                _trace_event(_TRACE_EVENT_SYSCALL_ENTER, sysrq->syscall_no, pid);
+        }
+#endif
+
         syscalltab[sysrq->syscall_no](sysrq);
 
+#if __OS_ENABLE_TRACE__ > 0
+        _trace_event(_TRACE_EVENT_SYSCALL_EXIT, sysrq->syscall_no, sysrq->err);
+#endif
+
 #if (__OS_TASK_KWORKER_MODE__ == 0) || (__OS_TASK_KWORKER_MODE__ == 1)
         _syscall_client_PID[tid] = 0;
 
@@ -652,22 +708,260 @@ static void syscall_do(void *rq)
 #if __OS_TASK_KWORKER_MODE__ == 1
 //==============================================================================
 /**
- * @brief  Function handle thread ready-to-run feature.
+ * @brief  Function handle thread ready-to-run feature. Thread handles
+ *         requests of I/O syscall queues. Thread started above minimum number
+ *         of threads is stopped after idle timeout.
  *
- * @param  rq           request information
+ * @param  arg          not used
  */
 //==============================================================================
-static void syscall_RTR(void *rq_queue)
+static void syscall_RTR(void *arg)
 {
+        UNUSED_ARG1(arg);
+
+        _critical_section_begin();
+        {
+                iopool.spawning--;
+                iopool.stat.threads++;
+                iopool.stat.threads_idle++;
+                iopool.stat.threads_peak = max(iopool.stat.threads_peak,
+                                               iopool.stat.threads);
+        }
+        _critical_section_end();
+
         for (;;) {
-                syscallrq_t *sysrq;
+                bool received = _semaphore_wait(iopool.request, IO_IDLE_TIMEOUT_MS) == ESUCC;
+                bool stop     = false;
+
+                syscallrq_t        *sysrq = NULL;
+                enum _syscall_class class = _SYSCALL_CLASS_FS;
+
+                _critical_section_begin();
+                {
+                        if (received) {
+                                sysrq = io_request_take(&class);
+
+                                if (sysrq) {
+                                        iopool.stat.threads_idle--;
+                                } else {
+                                        iopool.deferred++;
+                                }
+
+                        } else if (iopool.stat.threads > IO_THREADS_MIN) {
+                                iopool.stat.threads--;
+                                iopool.stat.threads_idle--;
+                                iopool.stat.reaped++;
+                                stop = true;
+                        }
+                }
+                _critical_section_end();
+
+                if (stop) {
+                        break;
+                }
 
-                if (_queue_receive(rq_queue, &sysrq, MAX_DELAY_MS) == ESUCC) {
+                if (sysrq) {
                         _process_clean_up_killed_processes();
+
+                        /* request object is not valid after this call */
                         syscall_do(sysrq);
+
+                        bool resume = false;
+
+                        _critical_section_begin();
+                        {
+                                iopool.stat.class[class].busy--;
+                                iopool.stat.threads_idle++;
+
+                                if (iopool.deferred) {
+                                        iopool.deferred--;
+                                        resume = true;
+                                }
+                        }
+                        _critical_section_end();
+
+                        if (resume) {
+                                _semaphore_signal(iopool.request);
+                        }
                 }
         }
 }
+
+//==============================================================================
+/**
+ * @brief  Function start new I/O thread. Number of starting threads
+ *         (iopool.spawning) should be incremented before call.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int io_thread_start(void)
+{
+        int err = _process_thread_create(_kworker_proc, syscall_RTR,
+                                         &io_thread_attr, NULL, NULL);
+        if (err) {
+                _critical_section_begin();
+                iopool.spawning--;
+                iopool.stat.spawn_failed++;
+                _critical_section_end();
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add request to queue of syscall class. Requests are
+ *         ordered by client thread priority (FIFO for equal priority). If all
+ *         I/O threads are busy then new thread is started (up to maximum).
+ *
+ * @param  rq           request
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int io_request_send(syscallrq_t *rq)
+{
+        enum _syscall_class class = get_syscall_class(rq->syscall_no);
+
+        rq->next      = NULL;
+        rq->priority  = _task_get_priority(_THIS_TASK);
+        rq->timestamp = _kernel_get_time_ms();
+
+        bool spawn = false;
+
+        _critical_section_begin();
+        {
+                syscallrq_t **rqp = &iopool.queue[class];
+                while (*rqp && (*rqp)->priority >= rq->priority) {
+                        rqp = &(*rqp)->next;
+                }
+
+                rq->next = *rqp;
+                *rqp     = rq;
+
+                _syscall_class_stat_t *stat = &iopool.stat.class[class];
+                stat->depth++;
+                stat->depth_max = max(stat->depth_max, stat->depth);
+
+                iopool.pending++;
+
+                if (  (iopool.pending > iopool.stat.threads_idle + iopool.spawning)
+                   && (iopool.stat.threads + iopool.spawning < IO_THREADS_MAX) ) {
+
+                        iopool.spawning++;
+                        iopool.stat.spawned++;
+                        spawn = true;
+                }
+        }
+        _critical_section_end();
+
+        if (spawn) {
+                io_thread_start();
+        }
+
+        return _semaphore_signal(iopool.request);
+}
+
+//==============================================================================
+/**
+ * @brief  Function take the most important request from syscall class queues.
+ *         Request of the highest client priority is selected; for equal
+ *         priority file system class is the first one. Classes of slow
+ *         operations can not occupy all I/O threads, so file system requests
+ *         are not starved by long block or network operations.
+ *
+ * @note   Function must be called in critical section.
+ *
+ * @param  class        selected request class
+ *
+ * @return Request or NULL if there is no request that can be handled now.
+ */
+//==============================================================================
+static syscallrq_t *io_request_take(enum _syscall_class *class)
+{
+        syscallrq_t *rq = NULL;
+
+        for (int c = 0; c < _SYSCALL_CLASS_COUNT; c++) {
+
+                u32_t limit = (c == _SYSCALL_CLASS_FS) ? IO_THREADS_MAX
+                                                       : max(1, IO_THREADS_MAX - 1);
+
+                syscallrq_t *head = iopool.queue[c];
+
+                if (  head
+                   && (iopool.stat.class[c].busy < limit)
+                   && (!rq || head->priority > rq->priority) ) {
+
+                        rq     = head;
+                        *class = c;
+                }
+        }
+
+        if (rq) {
+                iopool.queue[*class] = rq->next;
+                iopool.pending--;
+
+                u32_t wait = _kernel_get_time_ms() - rq->timestamp;
+
+                _syscall_class_stat_t *stat = &iopool.stat.class[*class];
+                stat->depth--;
+                stat->busy++;
+                stat->requests++;
+                stat->wait_total_ms += wait;
+                stat->wait_max_ms    = max(stat->wait_max_ms, wait);
+        }
+
+        return rq;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return class of selected syscall.
+ *
+ * @param  syscall      syscall number
+ *
+ * @return Syscall class.
+ */
+//==============================================================================
+static enum _syscall_class get_syscall_class(syscall_t syscall)
+{
+#if __ENABLE_NETWORK__ == _YES_
+        if (syscall >= SYSCALL_NETIFUP) {
+                return _SYSCALL_CLASS_NET;
+        }
+#endif
+
+        switch (syscall) {
+        case SYSCALL_MOUNT:
+        case SYSCALL_UMOUNT:
+        case SYSCALL_FWRITE:
+        case SYSCALL_FREAD:
+        case SYSCALL_IOCTL:
+        case SYSCALL_FFLUSH:
+        case SYSCALL_SYNC:
+        case SYSCALL_DRIVERINIT:
+        case SYSCALL_DRIVERRELEASE:
+                return _SYSCALL_CLASS_BLOCK;
+
+        default:
+                return _SYSCALL_CLASS_FS;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function return statistics of I/O thread pool.
+ *
+ * @param  stat         statistics destination
+ */
+//==============================================================================
+void _syscall_get_kworker_stat(_syscall_kworker_stat_t *stat)
+{
+        _critical_section_begin();
+        *stat = iopool.stat;
+        _critical_section_end();
+}
 #endif
 
 //==============================================================================
@@ -2028,6 +2322,56 @@ static void syscall_netgetaddress(syscallrq_t *rq)
         SETERRNO(_net_socket_getaddress(socket, sockaddr));
         SETRETURN(int, GETERRNO() == ESUCC ? 0 : -1);
 }
+
+//==============================================================================
+/**
+ * @brief  This syscall returns view of received data (zero copy receive).
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_netrecvview(syscallrq_t *rq)
+{
+        GETARG(SOCKET *, socket);
+        GETARG(NET_recv_view_t *, view);
+
+        SETERRNO(_net_socket_recv_view(socket, view));
+        SETRETURN(int, GETERRNO() == ESUCC ? cast(int, view->len) : -1);
+}
+
+//==============================================================================
+/**
+ * @brief  This syscall releases view of received data.
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_netrecvrelease(syscallrq_t *rq)
+{
+        GETARG(SOCKET *, socket);
+
+        SETERRNO(_net_socket_recv_release(socket));
+        SETRETURN(int, GETERRNO() == ESUCC ? 0 : -1);
+}
+
+//==============================================================================
+/**
+ * @brief  This syscall send vectored messages by socket.
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_netsendmsg(syscallrq_t *rq)
+{
+        GETARG(SOCKET *, socket);
+        GETARG(NET_msg_t *, msg);
+        GETARG(size_t *, count);
+        GETARG(NET_flags_t *, flags);
+
+        size_t msgsent = 0;
+        SETERRNO(_net_socket_sendmsg(socket, msg, *count, *flags, &msgsent));
+        SETRETURN(int, GETERRNO() == ESUCC ? cast(int, msgsent) : -1);
+}
 #endif
 
 #if __OS_ENABLE_SHARED_MEMORY__ == _YES_
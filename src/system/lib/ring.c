@@ -0,0 +1,723 @@
+/*==============================================================================
+File     ring.c
+
+Author   Daniel Zorychta
+
+Brief    Lock-free ring buffer library.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <string.h>
+#include "lib/ring.h"
+#include "lib/cast.h"
+#include "kernel/kwrapper.h"
+#include "libc/errno.h"
+#include "dnx/misc.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+/*
+ * Positions are free running 32-bit counters, ring index is position & mask.
+ * Producer publishes items by release store of head (SPSC) or of item
+ * sequence (MPSC), consumer releases space by release store of tail.
+ */
+#define load_acquire(_var)              __atomic_load_n(&(_var), __ATOMIC_ACQUIRE)
+#define store_release(_var, _val)       __atomic_store_n(&(_var), (_val), __ATOMIC_RELEASE)
+#define full_barrier()                  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#define capacity(_ring)                 ((_ring)->mask + 1)
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static size_t push(ring_t *ring, const void *src, size_t count);
+static size_t pop(ring_t *ring, void *dst, size_t count);
+static void   notify(sem_t *sem, u32_t *wait, bool from_ISR, bool *task_woken);
+static bool   wait_for(ring_t *ring, sem_t *sem, u32_t *wait, bool data, u32_t timeout_ms);
+static void   free_usr(void *mem, void *freectx);
+static void   free_krn(void *mem, void *freectx);
+static void   free_mod(void *mem, void *freectx);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function initialize ring in selected memory. Object can be placed
+ *         in static or shared memory.
+ *
+ * @param[in]  ring             ring object
+ * @param[in]  mode             ring mode
+ * @param[in]  item_size        item size
+ * @param[in]  capacity         number of items (power of 2)
+ * @param[in]  storage          storage of _RING_STORAGE_SIZE() bytes (word aligned)
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _ring_init(ring_t        *ring,
+               enum ring_mode mode,
+               size_t         item_size,
+               size_t         capacity,
+               void          *storage)
+{
+        if (  !ring || !storage || (item_size == 0)
+           || (mode > RING_MODE_MPSC)
+           || (capacity < 2) || (capacity > (UINT32_MAX / 2))
+           || (capacity & (capacity - 1)) ) {
+
+                return EINVAL;
+        }
+
+        memset(ring, 0, sizeof(ring_t));
+
+        ring->mask      = capacity - 1;
+        ring->item_size = item_size;
+        ring->mode      = mode;
+
+        if (mode == RING_MODE_MPSC) {
+                ring->seq  = storage;
+                ring->data = cast(u8_t*, storage) + (sizeof(u32_t) * capacity);
+
+                // no item is ready for the first round
+                memset(ring->seq, 0, sizeof(u32_t) * capacity);
+        } else {
+                ring->data = storage;
+        }
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Ring constructor for userland. Ring and storage are allocated in
+ *         single block.
+ *
+ * @param[in]  malloc           allocate memory function
+ * @param[in]  free             free memory function
+ * @param[in]  mode             ring mode
+ * @param[in]  item_size        item size
+ * @param[in]  capacity         number of items (power of 2)
+ * @param[out] ring             pointer to pointer of ring handle
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _ring_create_usr(ring_malloc_t  malloc,
+                     ring_free_t    free,
+                     enum ring_mode mode,
+                     size_t         item_size,
+                     size_t         capacity,
+                     ring_t       **ring)
+{
+        int err = EINVAL;
+
+        if (malloc && free && ring) {
+                *ring = malloc(sizeof(ring_t) + _RING_STORAGE_SIZE(mode, item_size, capacity));
+                if (*ring) {
+                        err = _ring_init(*ring, mode, item_size, capacity, &(*ring)[1]);
+                        if (!err) {
+                                (*ring)->free    = free_usr;
+                                (*ring)->freectx = free;
+                        } else {
+                                free(*ring);
+                                *ring = NULL;
+                        }
+                } else {
+                        err = ENOMEM;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Ring constructor for kernel space. Ring and storage are allocated in
+ *         single block.
+ *
+ * @param[in]  mem              memory group
+ * @param[in]  mode             ring mode
+ * @param[in]  item_size        item size
+ * @param[in]  capacity         number of items (power of 2)
+ * @param[out] ring             pointer to pointer of ring handle
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _ring_create_krn(enum _mm_mem   mem,
+                     enum ring_mode mode,
+                     size_t         item_size,
+                     size_t         capacity,
+                     ring_t       **ring)
+{
+        int err = EINVAL;
+
+        if (ring && mem != _MM_MOD && mem < _MM_COUNT) {
+                err = _kmalloc(mem, sizeof(ring_t) + _RING_STORAGE_SIZE(mode, item_size, capacity),
+                               cast(void**, ring));
+                if (!err) {
+                        err = _ring_init(*ring, mode, item_size, capacity, &(*ring)[1]);
+                        if (!err) {
+                                (*ring)->free    = free_krn;
+                                (*ring)->freectx = cast(void*, mem);
+                        } else {
+                                _kfree(mem, cast(void**, ring));
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Ring constructor for modules space. Ring and storage are allocated
+ *         in single block.
+ *
+ * @param[in]  modid            module ID
+ * @param[in]  mode             ring mode
+ * @param[in]  item_size        item size
+ * @param[in]  capacity         number of items (power of 2)
+ * @param[out] ring             pointer to pointer of ring handle
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _ring_create_mod(size_t         modid,
+                     enum ring_mode mode,
+                     size_t         item_size,
+                     size_t         capacity,
+                     ring_t       **ring)
+{
+        int err = EINVAL;
+
+        if (ring) {
+                err = _kmalloc(_MM_MOD, sizeof(ring_t) + _RING_STORAGE_SIZE(mode, item_size, capacity),
+                               cast(void**, ring), modid);
+                if (!err) {
+                        err = _ring_init(*ring, mode, item_size, capacity, &(*ring)[1]);
+                        if (!err) {
+                                (*ring)->free    = free_mod;
+                                (*ring)->freectx = cast(void*, modid);
+                        } else {
+                                _kfree(_MM_MOD, cast(void**, ring), modid);
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Ring destructor. Memory is released only if ring was created by
+ *         _ring_create_*() function. Waiter semaphores are not destroyed.
+ *
+ * @param  ring         ring object
+ */
+//==============================================================================
+void _ring_destroy(ring_t *ring)
+{
+        if (ring && ring->free) {
+                ring->free(ring, ring->freectx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function set semaphores used to wake up waiting consumer and
+ *         producer. Semaphores should be binary (max count 1) and are owned
+ *         by caller. Semaphores are required by _ring_push_wait() and
+ *         _ring_pop_wait() functions.
+ *
+ * @param  ring         ring object
+ * @param  data_sem     semaphore signaled when data is pushed (can be NULL)
+ * @param  space_sem    semaphore signaled when data is popped (can be NULL)
+ */
+//==============================================================================
+void _ring_set_waiters(ring_t *ring, sem_t *data_sem, sem_t *space_sem)
+{
+        if (ring) {
+                ring->data_sem  = data_sem;
+                ring->space_sem = space_sem;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function push items to ring. Items that do not fit are not pushed.
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ *
+ * @return Number of pushed items.
+ */
+//==============================================================================
+size_t _ring_push(ring_t *ring, const void *src, size_t count)
+{
+        size_t n = push(ring, src, count);
+
+        if (n) {
+                notify(ring->data_sem, &ring->data_wait, false, NULL);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function push items to ring from interrupt.
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ * @param  task_woken   set to true if context switch is required (can be NULL)
+ *
+ * @return Number of pushed items.
+ */
+//==============================================================================
+size_t _ring_push_from_ISR(ring_t *ring, const void *src, size_t count, bool *task_woken)
+{
+        size_t n = push(ring, src, count);
+
+        if (n) {
+                notify(ring->data_sem, &ring->data_wait, true, task_woken);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function push all items to ring. If ring is full then function waits
+ *         for free space.
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ * @param  pushed       number of pushed items (can be NULL)
+ * @param  timeout_ms   max waiting time for free space
+ *
+ * @return One of errno value (ETIME if not all items are pushed).
+ */
+//==============================================================================
+int _ring_push_wait(ring_t *ring, const void *src, size_t count, size_t *pushed, u32_t timeout_ms)
+{
+        if (!ring || !src || !ring->space_sem) {
+                return EINVAL;
+        }
+
+        size_t done = 0;
+        int    err  = ESUCC;
+
+        while (done < count) {
+                done += _ring_push(ring, cast(const u8_t*, src) + (done * ring->item_size),
+                                   count - done);
+
+                if ((done < count) && !wait_for(ring, ring->space_sem, &ring->space_wait,
+                                                false, timeout_ms)) {
+                        err = ETIME;
+                        break;
+                }
+        }
+
+        if (pushed) {
+                *pushed = done;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring.
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer (can be NULL to drop items)
+ * @param  count        max number of items
+ *
+ * @return Number of popped items.
+ */
+//==============================================================================
+size_t _ring_pop(ring_t *ring, void *dst, size_t count)
+{
+        size_t n = pop(ring, dst, count);
+
+        if (n) {
+                notify(ring->space_sem, &ring->space_wait, false, NULL);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring in interrupt.
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer (can be NULL to drop items)
+ * @param  count        max number of items
+ * @param  task_woken   set to true if context switch is required (can be NULL)
+ *
+ * @return Number of popped items.
+ */
+//==============================================================================
+size_t _ring_pop_from_ISR(ring_t *ring, void *dst, size_t count, bool *task_woken)
+{
+        size_t n = pop(ring, dst, count);
+
+        if (n) {
+                notify(ring->space_sem, &ring->space_wait, true, task_woken);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring. If ring is empty then function waits
+ *         for at least one item.
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer
+ * @param  count        max number of items
+ * @param  popped       number of popped items (can be NULL)
+ * @param  timeout_ms   max waiting time for data
+ *
+ * @return One of errno value (ETIME if no item is popped).
+ */
+//==============================================================================
+int _ring_pop_wait(ring_t *ring, void *dst, size_t count, size_t *popped, u32_t timeout_ms)
+{
+        if (!ring || !ring->data_sem) {
+                return EINVAL;
+        }
+
+        int    err = ESUCC;
+        size_t n;
+
+        while ((n = _ring_pop(ring, dst, count)) == 0 && count) {
+                if (!wait_for(ring, ring->data_sem, &ring->data_wait, true, timeout_ms)) {
+                        err = ETIME;
+                        break;
+                }
+        }
+
+        if (popped) {
+                *popped = n;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of items in ring. In MPSC mode the number
+ *         includes items that are being pushed.
+ *
+ * @param  ring         ring object
+ *
+ * @return Number of items.
+ */
+//==============================================================================
+size_t _ring_get_count(ring_t *ring)
+{
+        if (ring) {
+                return load_acquire(ring->head) - load_acquire(ring->tail);
+        } else {
+                return 0;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function return free space in ring.
+ *
+ * @param  ring         ring object
+ *
+ * @return Number of items that can be pushed.
+ */
+//==============================================================================
+size_t _ring_get_space(ring_t *ring)
+{
+        if (ring) {
+                return capacity(ring) - _ring_get_count(ring);
+        } else {
+                return 0;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function drop all items. Function can be used only by consumer.
+ *
+ * @param  ring         ring object
+ */
+//==============================================================================
+void _ring_flush(ring_t *ring)
+{
+        if (ring) {
+                while (_ring_pop(ring, NULL, capacity(ring)));
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function push items to ring (producer side).
+ *
+ * @param  ring         ring object
+ * @param  src          items to push
+ * @param  count        number of items
+ *
+ * @return Number of pushed items.
+ */
+//==============================================================================
+static size_t push(ring_t *ring, const void *src, size_t count)
+{
+        if (!ring || !src || !count) {
+                return 0;
+        }
+
+        u32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        u32_t n;
+
+        if (ring->mode == RING_MODE_SPSC) {
+                u32_t tail = load_acquire(ring->tail);
+                n = min(count, capacity(ring) - (head - tail));
+
+        } else {
+                // reserve space, items are published one by one by sequence
+                do {
+                        u32_t tail = load_acquire(ring->tail);
+                        n = min(count, capacity(ring) - (head - tail));
+                        if (n == 0) {
+                                return 0;
+                        }
+                } while (!__atomic_compare_exchange_n(&ring->head, &head, head + n, true,
+                                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        }
+
+        if (n) {
+                u32_t idx   = head & ring->mask;
+                u32_t first = min(n, capacity(ring) - idx);
+
+                memcpy(ring->data + (idx * ring->item_size), src, first * ring->item_size);
+                memcpy(ring->data, cast(const u8_t*, src) + (first * ring->item_size),
+                       (n - first) * ring->item_size);
+
+                if (ring->mode == RING_MODE_SPSC) {
+                        store_release(ring->head, head + n);
+                } else {
+                        for (u32_t i = 0; i < n; i++) {
+                                store_release(ring->seq[(head + i) & ring->mask], head + i + 1);
+                        }
+                }
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function pop items from ring (consumer side).
+ *
+ * @param  ring         ring object
+ * @param  dst          item buffer (can be NULL)
+ * @param  count        max number of items
+ *
+ * @return Number of popped items.
+ */
+//==============================================================================
+static size_t pop(ring_t *ring, void *dst, size_t count)
+{
+        if (!ring || !count) {
+                return 0;
+        }
+
+        u32_t tail = ring->tail;
+        u32_t n;
+
+        if (ring->mode == RING_MODE_SPSC) {
+                u32_t head = load_acquire(ring->head);
+                n = min(count, head - tail);
+
+        } else {
+                // items are taken in order up to the first not published one
+                n = 0;
+                while (  (n < count) && (n <= ring->mask)
+                      && (load_acquire(ring->seq[(tail + n) & ring->mask]) == (tail + n + 1)) ) {
+                        n++;
+                }
+        }
+
+        if (n) {
+                if (dst) {
+                        u32_t idx   = tail & ring->mask;
+                        u32_t first = min(n, capacity(ring) - idx);
+
+                        memcpy(dst, ring->data + (idx * ring->item_size), first * ring->item_size);
+                        memcpy(cast(u8_t*, dst) + (first * ring->item_size), ring->data,
+                               (n - first) * ring->item_size);
+                }
+
+                store_release(ring->tail, tail + n);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function wake up waiter if any waits. Many producers can wait for
+ *         space in MPSC mode, so semaphore is signaled after each operation
+ *         until all waiters are woken up.
+ *
+ * @param  sem          waiter semaphore (can be NULL)
+ * @param  wait         number of waiters
+ * @param  from_ISR     function called from interrupt
+ * @param  task_woken   set to true if context switch is required (can be NULL)
+ */
+//==============================================================================
+static void notify(sem_t *sem, u32_t *wait, bool from_ISR, bool *task_woken)
+{
+        if (sem) {
+                // pairs with barrier of waiter: waiter sees items or we see waiter
+                full_barrier();
+
+                if (__atomic_load_n(wait, __ATOMIC_RELAXED)) {
+                        if (from_ISR) {
+                                bool woken = false;
+                                _semaphore_signal_from_ISR(sem, &woken);
+
+                                if (task_woken && woken) {
+                                        *task_woken = true;
+                                }
+                        } else {
+                                _semaphore_signal(sem);
+                        }
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait for data or free space.
+ *
+ * @param  ring         ring object
+ * @param  sem          waiter semaphore
+ * @param  wait         number of waiters
+ * @param  data         wait for data (true) or for free space (false)
+ * @param  timeout_ms   timeout
+ *
+ * @return If condition is met then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool wait_for(ring_t *ring, sem_t *sem, u32_t *wait, bool data, u32_t timeout_ms)
+{
+        __atomic_add_fetch(wait, 1, __ATOMIC_RELAXED);
+        full_barrier();
+
+        bool ready;
+        if (data) {
+                // reserved but not published MPSC item is not ready
+                u32_t tail = ring->tail;
+                ready = (ring->mode == RING_MODE_MPSC)
+                      ? (load_acquire(ring->seq[tail & ring->mask]) == (tail + 1))
+                      : (load_acquire(ring->head) != tail);
+        } else {
+                ready = (_ring_get_space(ring) > 0);
+        }
+        if (!ready) {
+                ready = (_semaphore_wait(sem, timeout_ms) == ESUCC);
+        }
+
+        __atomic_sub_fetch(wait, 1, __ATOMIC_RELAXED);
+
+        return ready;
+}
+
+//==============================================================================
+/**
+ * @brief  Free allocated memory in user space.
+ *
+ * @param  mem          block to free
+ * @param  freectx      deallocation context (user's free function)
+ */
+//==============================================================================
+static void free_usr(void *mem, void *freectx)
+{
+        ring_free_t free = freectx;
+        free(mem);
+}
+
+//==============================================================================
+/**
+ * @brief  Free allocated memory in kernel space.
+ *
+ * @param  mem          block to free
+ * @param  freectx      deallocation context (kernel memory index)
+ */
+//==============================================================================
+static void free_krn(void *mem, void *freectx)
+{
+        _kfree(cast(enum _mm_mem, freectx), &mem);
+}
+
+//==============================================================================
+/**
+ * @brief  Free allocated memory in module space.
+ *
+ * @param  mem          block to free
+ * @param  freectx      deallocation context (module ID)
+ */
+//==============================================================================
+static void free_mod(void *mem, void *freectx)
+{
+        _kfree(_MM_MOD, &mem, cast(size_t, freectx));
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
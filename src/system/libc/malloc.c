@@ -0,0 +1,629 @@
+/*==============================================================================
+File    malloc.c
+
+Author  Daniel Zorychta
+
+Brief   User space heap. Small blocks are allocated from chunks taken from
+        the kernel by each process, so most allocations do not use syscalls.
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <config.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dnx/thread.h>
+
+#if __OS_ENABLE_USER_HEAP__ == _YES_
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define ALIGN                   8
+#define ALIGN_UP(n)             (((n) + (ALIGN - 1)) & ~((size_t)(ALIGN - 1)))
+#define ALIGN_DOWN(n)           ((n) & ~((size_t)(ALIGN - 1)))
+
+#define BLOCK_USED              (1 << 0)
+#define BLOCK_LARGE             (1 << 1)
+#define BLOCK_FLAGS             (BLOCK_USED | BLOCK_LARGE)
+
+#define HDR_SIZE                ALIGN_UP(sizeof(block_t))
+#define CHUNK_HDR_SIZE          ALIGN_UP(sizeof(chunk_t))
+#define MIN_BLOCK               ALIGN_UP(HDR_SIZE + sizeof(free_link_t))
+#define LARGE_THRESHOLD         (__OS_USER_HEAP_CHUNK_SIZE__ / 2)
+
+#define SIZE(block)             ((block)->size & ~((size_t)BLOCK_FLAGS))
+#define PAYLOAD(block)          ((void *)((u8_t *)(block) + HDR_SIZE))
+#define BLOCK(payload)          ((block_t *)((u8_t *)(payload) - HDR_SIZE))
+#define LINK(block)             ((free_link_t *)PAYLOAD(block))
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+/*
+ * Block header. Blocks of chunk are placed one by one and the last one is
+ * the sentinel (size 0, used). Free block contains free list links.
+ * Large block is allocated directly by the kernel; in this case prev_size
+ * contains block capacity.
+ */
+typedef struct block {
+        size_t size;                    // block size with header and flags
+        size_t prev_size;               // size of previous block (0 for the first one)
+} block_t;
+
+typedef struct {
+        block_t *next;                  // next free block
+        block_t *prev;                  // previous free block
+} free_link_t;
+
+typedef struct chunk {
+        struct chunk *next;             // next chunk of heap
+} chunk_t;
+
+struct _uheap {
+        mutex_t *mtx;                   // heap access
+        chunk_t *chunks;                // chunks taken from the kernel
+        block_t *free;                  // list of free blocks
+};
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void          *kernel_alloc(size_t size, bool clear);
+static void           kernel_free(void *mem);
+static struct _uheap *heap_get(void);
+static void          *heap_alloc(struct _uheap *heap, size_t size);
+static bool           heap_resize(struct _uheap *heap, block_t *block, size_t size);
+static block_t       *chunk_create(struct _uheap *heap, size_t need);
+static void           block_split(struct _uheap *heap, block_t *block, size_t need);
+static void           block_free(struct _uheap *heap, block_t *block);
+static void          *large_alloc(size_t size, bool clear);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function return size of block needed to store selected number of
+ *         bytes.
+ *
+ * @param  size         payload size
+ *
+ * @return Block size.
+ */
+//==============================================================================
+static inline size_t block_size(size_t size)
+{
+        size_t need = ALIGN_UP(size + HDR_SIZE);
+        return need < MIN_BLOCK ? MIN_BLOCK : need;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return next block of chunk.
+ */
+//==============================================================================
+static inline block_t *block_next(block_t *block)
+{
+        return (block_t *)((u8_t *)block + SIZE(block));
+}
+
+//==============================================================================
+/**
+ * @brief  Function return previous block of chunk.
+ */
+//==============================================================================
+static inline block_t *block_prev(block_t *block)
+{
+        return (block_t *)((u8_t *)block - block->prev_size);
+}
+
+//==============================================================================
+/**
+ * @brief  Function add block to free list.
+ */
+//==============================================================================
+static inline void free_list_insert(struct _uheap *heap, block_t *block)
+{
+        LINK(block)->prev = NULL;
+        LINK(block)->next = heap->free;
+
+        if (heap->free) {
+                LINK(heap->free)->prev = block;
+        }
+
+        heap->free = block;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove block from free list.
+ */
+//==============================================================================
+static inline void free_list_remove(struct _uheap *heap, block_t *block)
+{
+        free_link_t *link = LINK(block);
+
+        if (link->prev) {
+                LINK(link->prev)->next = link->next;
+        } else {
+                heap->free = link->next;
+        }
+
+        if (link->next) {
+                LINK(link->next)->prev = link->prev;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates memory block.
+ *
+ * @param  size         block size
+ *
+ * @return Pointer to block or NULL on error (errno is set).
+ *
+ * @see malloc()
+ */
+//==============================================================================
+void *_uheap_malloc(size_t size)
+{
+        if (size == 0) {
+                return NULL;
+        }
+
+        if (size > LARGE_THRESHOLD) {
+                return large_alloc(size, false);
+        }
+
+        void *mem = NULL;
+
+        struct _uheap *heap = heap_get();
+        if (heap && _mutex_lock(heap->mtx, MAX_DELAY_MS) == ESUCC) {
+                mem = heap_alloc(heap, size);
+                _mutex_unlock(heap->mtx);
+        }
+
+        return mem;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates array and clear its memory.
+ *
+ * @param  n            number of elements
+ * @param  size         element size
+ *
+ * @return Pointer to block or NULL on error (errno is set).
+ *
+ * @see calloc()
+ */
+//==============================================================================
+void *_uheap_calloc(size_t n, size_t size)
+{
+        if (size && (n > SIZE_MAX / size)) {
+                _errno = ENOMEM;
+                return NULL;
+        }
+
+        size *= n;
+
+        if (size > LARGE_THRESHOLD) {
+                return large_alloc(size, true);
+        }
+
+        void *mem = _uheap_malloc(size);
+        if (mem) {
+                memset(mem, 0, size);
+        }
+
+        return mem;
+}
+
+//==============================================================================
+/**
+ * @brief  Function frees memory block.
+ *
+ * @param  mem          block to free
+ *
+ * @see free()
+ */
+//==============================================================================
+void _uheap_free(void *mem)
+{
+        if (mem == NULL) {
+                return;
+        }
+
+        block_t *block = BLOCK(mem);
+
+        if (!(block->size & BLOCK_USED)) {
+                _errno = EINVAL;
+
+        } else if (block->size & BLOCK_LARGE) {
+                kernel_free(block);
+
+        } else if (_uheap && _mutex_lock(_uheap->mtx, MAX_DELAY_MS) == ESUCC) {
+                block_free(_uheap, block);
+                _mutex_unlock(_uheap->mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function changes size of memory block. If possible block is resized
+ *         in place: shrunk block returns its tail to the heap, and grown block
+ *         takes following free block. Otherwise block is moved.
+ *
+ * @param  mem          block to resize
+ * @param  size         new size
+ *
+ * @return Pointer to block or NULL on error (errno is set).
+ *
+ * @see realloc()
+ */
+//==============================================================================
+void *_uheap_realloc(void *mem, size_t size)
+{
+        if (mem == NULL) {
+                return _uheap_malloc(size);
+        }
+
+        if (size == 0) {
+                _uheap_free(mem);
+                return NULL;
+        }
+
+        block_t *block = BLOCK(mem);
+        size_t   capacity;
+
+        if (block->size & BLOCK_LARGE) {
+                capacity = block->prev_size;
+
+                if ((size <= capacity) && (size >= capacity / 2) && (size > LARGE_THRESHOLD)) {
+                        return mem;
+                }
+
+        } else {
+                capacity = SIZE(block) - HDR_SIZE;
+
+                if (size <= LARGE_THRESHOLD) {
+                        bool resized = false;
+
+                        if (_mutex_lock(_uheap->mtx, MAX_DELAY_MS) == ESUCC) {
+                                resized = heap_resize(_uheap, block, size);
+                                _mutex_unlock(_uheap->mtx);
+                        }
+
+                        if (resized) {
+                                return mem;
+                        }
+                }
+        }
+
+        void *new = _uheap_malloc(size);
+        if (new) {
+                memcpy(new, mem, size < capacity ? size : capacity);
+                _uheap_free(mem);
+        }
+
+        return new;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates memory in the kernel (syscall).
+ *
+ * @param  size         size to allocate
+ * @param  clear        clear memory
+ *
+ * @return Pointer to memory or NULL on error (errno is set).
+ */
+//==============================================================================
+static void *kernel_alloc(size_t size, bool clear)
+{
+        void *mem = NULL;
+        syscall(clear ? SYSCALL_ZALLOC : SYSCALL_MALLOC, &mem, &size);
+        return mem;
+}
+
+//==============================================================================
+/**
+ * @brief  Function frees memory allocated in the kernel (syscall).
+ *
+ * @param  mem          memory to free
+ */
+//==============================================================================
+static void kernel_free(void *mem)
+{
+        syscall(SYSCALL_FREE, NULL, mem);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return heap of current process. Heap is created at first
+ *         use. Heap objects are process resources, thus are released by the
+ *         kernel when process exits.
+ *
+ * @return Heap object or NULL on error (errno is set).
+ */
+//==============================================================================
+static struct _uheap *heap_get(void)
+{
+        if (_uheap == NULL) {
+                struct _uheap *heap = kernel_alloc(sizeof(struct _uheap), true);
+                if (heap) {
+                        heap->mtx = mutex_new(MUTEX_TYPE_NORMAL);
+                        if (heap->mtx == NULL) {
+                                kernel_free(heap);
+                                return NULL;
+                        }
+
+                        /* other thread of process can create heap in the meantime */
+                        _kernel_scheduler_lock();
+                        {
+                                if (_uheap == NULL) {
+                                        _uheap = heap;
+                                        heap   = NULL;
+                                }
+                        }
+                        _kernel_scheduler_unlock();
+
+                        if (heap) {
+                                mutex_delete(heap->mtx);
+                                kernel_free(heap);
+                        }
+                }
+        }
+
+        return _uheap;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates block from heap (first fit). If there is no
+ *         free block then new chunk is taken from the kernel.
+ *
+ * @param  heap         heap
+ * @param  size         payload size
+ *
+ * @return Pointer to block or NULL on error (errno is set).
+ */
+//==============================================================================
+static void *heap_alloc(struct _uheap *heap, size_t size)
+{
+        size_t   need  = block_size(size);
+        block_t *block = heap->free;
+
+        while (block && (SIZE(block) < need)) {
+                block = LINK(block)->next;
+        }
+
+        if (block == NULL) {
+                block = chunk_create(heap, need);
+                if (block == NULL) {
+                        return NULL;
+                }
+        }
+
+        free_list_remove(heap, block);
+        block->size |= BLOCK_USED;
+        block_split(heap, block, need);
+
+        return PAYLOAD(block);
+}
+
+//==============================================================================
+/**
+ * @brief  Function resize block in place.
+ *
+ * @param  heap         heap
+ * @param  block        used block
+ * @param  size         new payload size
+ *
+ * @return true if block was resized, false if block must be moved.
+ */
+//==============================================================================
+static bool heap_resize(struct _uheap *heap, block_t *block, size_t size)
+{
+        size_t need = block_size(size);
+
+        if (need > SIZE(block)) {
+                block_t *next = block_next(block);
+
+                if ((next->size & BLOCK_USED) || (SIZE(block) + SIZE(next) < need)) {
+                        return false;
+                }
+
+                free_list_remove(heap, next);
+                block->size += SIZE(next);
+                block_next(block)->prev_size = SIZE(block);
+        }
+
+        block_split(heap, block, need);
+
+        return true;
+}
+
+//==============================================================================
+/**
+ * @brief  Function takes new chunk from the kernel.
+ *
+ * @param  heap         heap
+ * @param  need         size of block that should fit in the chunk
+ *
+ * @return Free block that covers entire chunk or NULL on error.
+ */
+//==============================================================================
+static block_t *chunk_create(struct _uheap *heap, size_t need)
+{
+        size_t size = CHUNK_HDR_SIZE + need + HDR_SIZE;
+        if (size < __OS_USER_HEAP_CHUNK_SIZE__) {
+                size = __OS_USER_HEAP_CHUNK_SIZE__;
+        }
+
+        chunk_t *chunk = kernel_alloc(size, false);
+        if (chunk == NULL) {
+                return NULL;
+        }
+
+        chunk->next  = heap->chunks;
+        heap->chunks = chunk;
+
+        block_t *block   = (block_t *)((u8_t *)chunk + CHUNK_HDR_SIZE);
+        block->size      = ALIGN_DOWN(size - CHUNK_HDR_SIZE - HDR_SIZE);
+        block->prev_size = 0;
+
+        block_t *end     = block_next(block);
+        end->size        = BLOCK_USED;
+        end->prev_size   = block->size;
+
+        free_list_insert(heap, block);
+
+        return block;
+}
+
+//==============================================================================
+/**
+ * @brief  Function split used block to selected size. Tail of block is
+ *         released if is big enough to be a block.
+ *
+ * @param  heap         heap
+ * @param  block        used block
+ * @param  need         new block size
+ */
+//==============================================================================
+static void block_split(struct _uheap *heap, block_t *block, size_t need)
+{
+        size_t size = SIZE(block);
+
+        if (size - need >= MIN_BLOCK) {
+                block_t *tail   = (block_t *)((u8_t *)block + need);
+                tail->size      = (size - need) | BLOCK_USED;
+                tail->prev_size = need;
+
+                block->size = need | (block->size & BLOCK_FLAGS);
+                block_next(tail)->prev_size = SIZE(tail);
+
+                block_free(heap, tail);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function release block. Block is merged with adjacent free blocks.
+ *         Chunk that become free is returned to the kernel (the last chunk of
+ *         heap is kept).
+ *
+ * @param  heap         heap
+ * @param  block        used block
+ */
+//==============================================================================
+static void block_free(struct _uheap *heap, block_t *block)
+{
+        block->size = SIZE(block);
+
+        block_t *next = block_next(block);
+        if (!(next->size & BLOCK_USED)) {
+                free_list_remove(heap, next);
+                block->size += next->size;
+        }
+
+        if (block->prev_size) {
+                block_t *prev = block_prev(block);
+                if (!(prev->size & BLOCK_USED)) {
+                        free_list_remove(heap, prev);
+                        prev->size += block->size;
+                        block = prev;
+                }
+        }
+
+        next = block_next(block);
+        next->prev_size = block->size;
+
+        if ((block->prev_size == 0) && (SIZE(next) == 0)) {
+                chunk_t *chunk = (chunk_t *)((u8_t *)block - CHUNK_HDR_SIZE);
+
+                if (heap->chunks != chunk || chunk->next) {
+                        chunk_t **cp = &heap->chunks;
+                        while (*cp != chunk) {
+                                cp = &(*cp)->next;
+                        }
+
+                        *cp = chunk->next;
+                        kernel_free(chunk);
+                        return;
+                }
+        }
+
+        free_list_insert(heap, block);
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates large block directly in the kernel.
+ *
+ * @param  size         payload size
+ * @param  clear        clear memory
+ *
+ * @return Pointer to block or NULL on error (errno is set).
+ */
+//==============================================================================
+static void *large_alloc(size_t size, bool clear)
+{
+        if (size > SIZE_MAX - HDR_SIZE) {
+                _errno = ENOMEM;
+                return NULL;
+        }
+
+        block_t *block = kernel_alloc(HDR_SIZE + size, clear);
+        if (block == NULL) {
+                return NULL;
+        }
+
+        block->size      = BLOCK_USED | BLOCK_LARGE;
+        block->prev_size = size;
+
+        return PAYLOAD(block);
+}
+
+#endif /* __OS_ENABLE_USER_HEAP__ == _YES_ */
+
+/*==============================================================================
+  End of file
+==============================================================================*/
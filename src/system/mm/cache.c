@@ -0,0 +1,1519 @@
+/*=========================================================================*//**
+File     cache.c
+
+Author   Daniel Zorychta
+
+Brief    Block device cache.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * Locking rules:
+ * - CACHE.mtx protects device list, hash chains, LRU list and contents of
+ *   clean blocks. The mutex is never held during device access.
+ * - dev->mtx serializes all operations on the selected device (also device
+ *   access). Lock order is always: dev->mtx then CACHE.mtx.
+ * - Dirty block can be modified or evicted only by the owner of dev->mtx,
+ *   so its buffer can be written to the device without CACHE.mtx.
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <string.h>
+#include <stdbool.h>
+#include "mm/cache.h"
+#include "mm/mm.h"
+#include "mm/shrinker.h"
+#include "kernel/ktypes.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+#include "kernel/printk.h"
+#include "lib/cast.h"
+#include "dnx/misc.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define CACHE_MAX_SIZE                  __OS_SYSTEM_CACHE_SIZE__
+#define READAHEAD_MAX_BLOCKS            __OS_SYSTEM_CACHE_READAHEAD__
+#define READAHEAD_LIMIT                 64
+#define COALESCE_MAX_BLOCKS             16
+#define DIRTY_LIMIT                     (CACHE_MAX_SIZE / 2)
+
+#define HASH_SIZE                       16
+#define HASH(_blkpos)                   ((_blkpos) & (HASH_SIZE - 1))
+
+#define BLK_SIZE(_blksz)                (sizeof(cache_blk_t) + (_blksz))
+
+#define foreach_dev(_v, _l)\
+        for (cache_dev_t *_v = _l; _v; _v = _v->next)
+
+#define foreach_dev_blk(_v, _dev)\
+        for (size_t _h = 0; _h < HASH_SIZE; _h++)\
+                for (cache_blk_t *_v = (_dev)->hash[_h]; _v; _v = _v->hnext)
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct cache_blk {
+        struct cache_blk *hnext;        //!< next block in hash chain
+        struct cache_blk *prev;         //!< LRU list: more recently used block
+        struct cache_blk *next;         //!< LRU list: less recently used block
+        struct cache_dev *dev;          //!< block owner
+        u32_t             blkpos;       //!< block position on device
+        bool              dirty;        //!< block not synchronized with device
+        u8_t              buf[];        //!< block data
+} cache_blk_t;
+
+typedef struct cache_dev {
+        struct cache_dev *next;         //!< next device
+        FILE             *file;         //!< device file
+        mutex_t          *mtx;          //!< device access mutex
+        u64_t             size;         //!< device size in bytes (0 if unknown)
+        size_t            blksz;        //!< block size
+        size_t            dirty;        //!< number of dirty bytes
+        u32_t             next_blkpos;  //!< expected block of sequential read
+        u32_t             ra_window;    //!< current readahead window [blocks]
+        u32_t             ra_max;       //!< maximum readahead window [blocks]
+        u32_t             wr_max;       //!< maximum coalesced write [blocks]
+        u32_t             users;        //!< number of device users
+        cache_write_cb_t  on_write;     //!< device write notification (can be NULL)
+        void             *on_write_arg; //!< notification argument
+        sem_t            *released;     //!< signaled when last user leaves dropped device
+        cache_blk_t      *hash[HASH_SIZE];
+} cache_dev_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int          dev_acquire(FILE *file, size_t blksz, bool create, cache_dev_t **dev);
+static void         dev_release(cache_dev_t *dev);
+static void         dev_link(cache_dev_t *dev);
+static void         dev_unlink(cache_dev_t *dev);
+static int          dev_read(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, void *buf);
+static int          dev_write(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, const void *buf);
+static int          dev_write_blocks(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, const void *buf);
+static int          dev_flush(cache_dev_t *dev);
+static size_t       dev_collect_dirty_run(cache_dev_t *dev, cache_blk_t **run, size_t max);
+static void         dev_invalidate(cache_dev_t *dev);
+static void         dev_discard(cache_dev_t *dev, u32_t blkpos, size_t blksz, size_t blkcnt);
+static int          dev_set_block_size(cache_dev_t *dev, size_t blksz);
+static cache_blk_t *blk_find(cache_dev_t *dev, u32_t blkpos);
+static bool         blk_is_cached(cache_dev_t *dev, u32_t blkpos);
+static bool         blk_load(cache_dev_t *dev, u32_t blkpos, void *dst);
+static bool         blk_store(cache_dev_t *dev, u32_t blkpos, const void *src, bool overwrite, bool dirty);
+static void        *mem_alloc(cache_dev_t *owner, size_t size);
+static void         mem_free(void *mem, size_t size);
+static cache_blk_t *blk_alloc(cache_dev_t *dev);
+static void         blk_link(cache_blk_t *blk);
+static void         blk_unlink(cache_blk_t *blk);
+static void         blk_free(cache_blk_t *blk);
+static void         blk_set_dirty(cache_blk_t *blk, bool dirty);
+static void         lru_touch(cache_blk_t *blk);
+static bool         evict(cache_dev_t *owner);
+static void         readahead_update(cache_dev_t *dev, u32_t blkpos, size_t blkcnt);
+static size_t       readahead_trim(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, size_t ra);
+static int          run_read(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, size_t ra, u8_t *dst);
+static size_t       shrink(size_t size, void *arg);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static struct {
+        mutex_t     *mtx;
+        cache_dev_t *devs;
+        cache_blk_t *lru_head;
+        cache_blk_t *lru_tail;
+        size_t       size;
+} CACHE;
+
+static _mm_shrinker_t shrinker;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief  Function initialize cache subsystem.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_init(void)
+{
+        int err = _mutex_create(MUTEX_TYPE_NORMAL, &CACHE.mtx);
+        if (!err) {
+                _mutex_set_name(CACHE.mtx, "cache");
+                err = _mm_shrinker_register(&shrinker, "cache", 0, shrink, NULL);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function read blocks from device by using cache. Missing blocks are
+ *         read in the largest possible runs. If sequential access is detected
+ *         then next blocks are read ahead.
+ *
+ * @param  file         device file
+ * @param  blkpos       first block position
+ * @param  blksz        block size
+ * @param  blkcnt       number of blocks to read
+ * @param  buf          destination buffer
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_read(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, void *buf)
+{
+        if (!file || !blksz || !blkcnt || !buf) {
+                return EINVAL;
+        }
+
+        cache_dev_t *dev = NULL;
+        if (dev_acquire(file, blksz, true, &dev) != ESUCC) {
+                return dev_read(file, blkpos, blksz, blkcnt, buf);
+        }
+
+        int err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+        if (!err) {
+                err = dev_set_block_size(dev, blksz);
+
+                readahead_update(dev, blkpos, blkcnt);
+
+                u8_t  *dst = buf;
+                size_t i   = 0;
+
+                while (!err && (i < blkcnt)) {
+
+                        if (blk_load(dev, blkpos + i, dst + (i * blksz))) {
+                                i++;
+                                continue;
+                        }
+
+                        size_t run = 1;
+                        while (((i + run) < blkcnt) && !blk_is_cached(dev, blkpos + i + run)) {
+                                run++;
+                        }
+
+                        size_t ra = ((i + run) == blkcnt) ? dev->ra_window : 0;
+
+                        err = run_read(dev, blkpos + i, run, ra, dst + (i * blksz));
+
+                        i += run;
+                }
+
+                _mutex_unlock(dev->mtx);
+        }
+
+        dev_release(dev);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write blocks to device by using cache.
+ *
+ * @param  file         device file
+ * @param  blkpos       first block position
+ * @param  blksz        block size
+ * @param  blkcnt       number of blocks to write
+ * @param  buf          source buffer
+ * @param  mode         write mode
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_write(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt,
+                 const void *buf, enum cache_mode mode)
+{
+        if (!file || !blksz || !blkcnt || !buf) {
+                return EINVAL;
+        }
+
+        cache_dev_t *dev = NULL;
+        if (dev_acquire(file, blksz, true, &dev) != ESUCC) {
+                return dev_write(file, blkpos, blksz, blkcnt, buf);
+        }
+
+        int err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+        if (!err) {
+                err = dev_set_block_size(dev, blksz);
+
+                const u8_t *src = buf;
+
+                if (!err && (mode == CACHE_WRITE_THROUGH)) {
+                        err = dev_write_blocks(dev, blkpos, blkcnt, buf);
+
+                        for (size_t i = 0; !err && (i < blkcnt); i++) {
+                                blk_store(dev, blkpos + i, src + (i * blksz), true, false);
+                        }
+
+                } else {
+                        for (size_t i = 0; !err && (i < blkcnt); i++) {
+                                if (!blk_store(dev, blkpos + i, src + (i * blksz), true, true)) {
+                                        err = dev_write_blocks(dev, blkpos + i, 1, src + (i * blksz));
+                                }
+                        }
+
+                        if (!err && (dev->dirty > DIRTY_LIMIT)) {
+                                err = dev_flush(dev);
+                        }
+                }
+
+                _mutex_unlock(dev->mtx);
+        }
+
+        dev_release(dev);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function configure caching of selected device. Function is used by
+ *         file systems to tune cache according to mount options.
+ *
+ * @param  file         device file
+ * @param  blksz        block size
+ * @param  readahead    maximum readahead window [blocks] (0: disabled)
+ * @param  coalesce     maximum number of blocks merged in single write
+ *                      (0 or 1: disabled)
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_configure(FILE *file, size_t blksz, u32_t readahead, u32_t coalesce)
+{
+        if (!file || !blksz) {
+                return EINVAL;
+        }
+
+        cache_dev_t *dev = NULL;
+        int err = dev_acquire(file, blksz, true, &dev);
+        if (!err) {
+                err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+                if (!err) {
+                        err = dev_set_block_size(dev, blksz);
+
+                        dev->ra_max    = min(readahead, READAHEAD_LIMIT);
+                        dev->ra_window = 0;
+                        dev->wr_max    = max(1, min(coalesce, COALESCE_MAX_BLOCKS));
+
+                        _mutex_unlock(dev->mtx);
+                }
+
+                dev_release(dev);
+
+        } else if (err == ENOENT) {
+                err = ESUCC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function set notification called after each successful write of
+ *         blocks to selected device (write-through, flush and eviction).
+ *         Notification is called with cache locks held, so it must not block
+ *         nor use the cache. File systems use it to count physical writes.
+ *
+ * @param  file         device file
+ * @param  blksz        block size
+ * @param  cb           notification function (NULL: disabled)
+ * @param  arg          notification argument
+ *
+ * @return One of errno value. ENOENT is returned if cache is disabled, in
+ *         this case each write goes directly to the device.
+ */
+//==============================================================================
+int _cache_set_write_callback(FILE *file, size_t blksz, cache_write_cb_t cb, void *arg)
+{
+        if (!file || !blksz) {
+                return EINVAL;
+        }
+
+        cache_dev_t *dev = NULL;
+        int err = dev_acquire(file, blksz, cb != NULL, &dev);
+        if (!err) {
+                err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+                if (!err) {
+                        dev->on_write     = cb;
+                        dev->on_write_arg = arg;
+
+                        _mutex_unlock(dev->mtx);
+                }
+
+                dev_release(dev);
+
+        } else if ((err == ENOENT) && !cb) {
+                err = ESUCC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write all dirty blocks of selected device.
+ *
+ * @param  file         device file
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_flush(FILE *file)
+{
+        cache_dev_t *dev = NULL;
+        int err = dev_acquire(file, 0, false, &dev);
+        if (!err) {
+                err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+                if (!err) {
+                        err = dev_flush(dev);
+                        _mutex_unlock(dev->mtx);
+                }
+
+                dev_release(dev);
+
+        } else if (err == ENOENT) {
+                err = ESUCC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function release cached blocks of discarded (trimmed) device region.
+ *         Dirty blocks are released without write, because region content
+ *         is not used anymore. Function shall be called before the device
+ *         discards the region, otherwise dirty block can be written later.
+ *
+ * @param  file         device file
+ * @param  blkpos       first block position
+ * @param  blksz        block size
+ * @param  blkcnt       number of blocks
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_discard(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt)
+{
+        cache_dev_t *dev = NULL;
+        int err = dev_acquire(file, 0, false, &dev);
+        if (!err) {
+                err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+                if (!err) {
+                        dev_discard(dev, blkpos, blksz, blkcnt);
+                        _mutex_unlock(dev->mtx);
+                }
+
+                dev_release(dev);
+
+        } else if (err == ENOENT) {
+                err = ESUCC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write all dirty blocks of selected device and release all
+ *         cached blocks. Function is called when device file is closed.
+ *         Function waits until current users leave the device. If dirty blocks
+ *         cannot be written then device stays cached (nothing is lost) and
+ *         error is returned, unless release is forced.
+ *
+ * @param  file         device file
+ * @param  force        release blocks even if dirty blocks cannot be written
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _cache_drop(FILE *file, bool force)
+{
+        if (CACHE.devs == NULL) {
+                return ESUCC;
+        }
+
+        int err = _mutex_lock(CACHE.mtx, MAX_DELAY_MS);
+        if (err) {
+                return err;
+        }
+
+        cache_dev_t *dev = NULL;
+
+        foreach_dev(d, CACHE.devs) {
+                if (d->file == file) {
+                        dev = d;
+                        break;
+                }
+        }
+
+        if (dev && (dev->users > 0)) {
+                err = _semaphore_create(1, 0, &dev->released);
+        }
+
+        if (dev && !err) {
+                dev_unlink(dev);
+        }
+
+        _mutex_unlock(CACHE.mtx);
+
+        if (!dev || err) {
+                return err;
+        }
+
+        if (dev->released) {
+                _semaphore_wait(dev->released, MAX_DELAY_MS);
+                _semaphore_destroy(dev->released);
+                dev->released = NULL;
+        }
+
+        err = _mutex_lock(dev->mtx, MAX_DELAY_MS);
+        if (!err) {
+                err = dev_flush(dev);
+                if (err) {
+                        _printk("CACHE: unable to flush device (%d)", err);
+                }
+
+                if (!err || force) {
+                        dev_invalidate(dev);
+                }
+
+                _mutex_unlock(dev->mtx);
+        }
+
+        if (!err || force) {
+                _mutex_destroy(dev->mtx);
+                _kfree(_MM_CACHE, cast(void*, &dev));
+        } else {
+                dev_link(dev);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write dirty blocks of all devices.
+ */
+//==============================================================================
+void _cache_sync(void)
+{
+        for (size_t n = 0;; n++) {
+                FILE *file = NULL;
+
+                if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                        size_t i = 0;
+                        foreach_dev(dev, CACHE.devs) {
+                                if (i++ == n) {
+                                        file = dev->file;
+                                        break;
+                                }
+                        }
+
+                        _mutex_unlock(CACHE.mtx);
+                }
+
+                if (file) {
+                        _cache_flush(file);
+                } else {
+                        break;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function release clean (synchronized) blocks, starting from the
+ *         least recently used. Function is called at memory pressure and does
+ *         not block if cache is in use.
+ *
+ * @param  size         number of bytes to release
+ *
+ * @return Number of released bytes.
+ */
+//==============================================================================
+size_t _cache_reduce(size_t size)
+{
+        size_t freed = 0;
+
+        if (CACHE.lru_tail && (_mutex_lock(CACHE.mtx, 0) == ESUCC)) {
+
+                cache_blk_t *blk = CACHE.lru_tail;
+
+                while (blk && (freed < size)) {
+                        cache_blk_t *prev = blk->prev;
+
+                        if (!blk->dirty) {
+                                freed += BLK_SIZE(blk->dev->blksz);
+                                blk_unlink(blk);
+                                blk_free(blk);
+                        }
+
+                        blk = prev;
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+
+        return freed;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find device object and increase number of users. If device
+ *         does not exist then new one is created (if requested).
+ *
+ * @param  file         device file
+ * @param  blksz        block size (used when device is created)
+ * @param  create       create device if not exist
+ * @param  dev          found device
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_acquire(FILE *file, size_t blksz, bool create, cache_dev_t **dev)
+{
+        if ((CACHE_MAX_SIZE == 0) || !file) {
+                return ENOENT;
+        }
+
+        int err = _mutex_lock(CACHE.mtx, MAX_DELAY_MS);
+        if (err) {
+                return err;
+        }
+
+        err = ENOENT;
+
+        foreach_dev(d, CACHE.devs) {
+                if (d->file == file) {
+                        d->users++;
+                        *dev = d;
+                        err  = ESUCC;
+                        break;
+                }
+        }
+
+        _mutex_unlock(CACHE.mtx);
+
+        if ((err == ENOENT) && create) {
+                cache_dev_t *new_dev = NULL;
+                err = _kzalloc(_MM_CACHE, sizeof(cache_dev_t), cast(void*, &new_dev));
+                if (err) {
+                        return err;
+                }
+
+                err = _mutex_create(MUTEX_TYPE_NORMAL, &new_dev->mtx);
+                if (err) {
+                        _kfree(_MM_CACHE, cast(void*, &new_dev));
+                        return err;
+                }
+
+                _mutex_set_name(new_dev->mtx, "cache-dev");
+
+                struct stat st;
+                if (_vfs_fstat(file, &st) == ESUCC) {
+                        new_dev->size = st.st_size;
+                }
+
+                // only files with cache device are dropped at close
+                file->f_flag.cached  = true;
+
+                new_dev->file        = file;
+                new_dev->blksz       = blksz;
+                new_dev->next_blkpos = UINT32_MAX;
+                new_dev->ra_max      = READAHEAD_MAX_BLOCKS;
+                new_dev->wr_max      = COALESCE_MAX_BLOCKS;
+                new_dev->users       = 1;
+
+                err = _mutex_lock(CACHE.mtx, MAX_DELAY_MS);
+                if (!err) {
+                        new_dev->next = CACHE.devs;
+                        CACHE.devs    = new_dev;
+                        *dev          = new_dev;
+                        _mutex_unlock(CACHE.mtx);
+
+                } else {
+                        _mutex_destroy(new_dev->mtx);
+                        _kfree(_MM_CACHE, cast(void*, &new_dev));
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function decrease number of device users. Waiting drop request is
+ *         woken up when the last user leaves the device.
+ *
+ * @param  dev          device
+ */
+//==============================================================================
+static void dev_release(cache_dev_t *dev)
+{
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                dev->users--;
+
+                if ((dev->users == 0) && dev->released) {
+                        _semaphore_signal(dev->released);
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function add device to device list.
+ *
+ * @param  dev          device
+ */
+//==============================================================================
+static void dev_link(cache_dev_t *dev)
+{
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                dev->next  = CACHE.devs;
+                CACHE.devs = dev;
+                _mutex_unlock(CACHE.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove device from device list. Cache mutex must be locked.
+ *
+ * @param  dev          device
+ */
+//==============================================================================
+static void dev_unlink(cache_dev_t *dev)
+{
+        for (cache_dev_t **d = &CACHE.devs; *d; d = &(*d)->next) {
+                if (*d == dev) {
+                        *d = dev->next;
+                        break;
+                }
+        }
+
+        dev->next = NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function read blocks directly from device.
+ *
+ * @param  file         device file
+ * @param  blkpos       first block position
+ * @param  blksz        block size
+ * @param  blkcnt       number of blocks
+ * @param  buf          destination buffer
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_read(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, void *buf)
+{
+        int err = _vfs_fseek(file, cast(i64_t, blkpos) * blksz, VFS_SEEK_SET);
+        if (!err) {
+                size_t rdcnt = 0;
+                err = _vfs_fread(buf, blksz * blkcnt, &rdcnt, file);
+                if (!err && (rdcnt != blksz * blkcnt)) {
+                        err = EIO;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write blocks directly to device.
+ *
+ * @param  file         device file
+ * @param  blkpos       first block position
+ * @param  blksz        block size
+ * @param  blkcnt       number of blocks
+ * @param  buf          source buffer
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_write(FILE *file, u32_t blkpos, size_t blksz, size_t blkcnt, const void *buf)
+{
+        int err = _vfs_fseek(file, cast(i64_t, blkpos) * blksz, VFS_SEEK_SET);
+        if (!err) {
+                size_t wrcnt = 0;
+                err = _vfs_fwrite(buf, blksz * blkcnt, &wrcnt, file);
+                if (!err && (wrcnt != blksz * blkcnt)) {
+                        err = EIO;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write blocks of cached device and notify device owner.
+ *
+ * @param  dev          device
+ * @param  blkpos       first block position
+ * @param  blkcnt       number of blocks
+ * @param  buf          source buffer
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_write_blocks(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, const void *buf)
+{
+        int err = dev_write(dev->file, blkpos, dev->blksz, blkcnt, buf);
+
+        if (!err && dev->on_write) {
+                dev->on_write(dev->on_write_arg, blkpos, blkcnt);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write all dirty blocks of device in ascending order.
+ *         Adjacent dirty blocks are merged into single device write.
+ *         Device mutex must be locked.
+ *
+ * @param  dev          device
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_flush(cache_dev_t *dev)
+{
+        int          err = ESUCC;
+        u8_t        *buf = NULL;
+        size_t       max = 1;
+        cache_blk_t *run[COALESCE_MAX_BLOCKS];
+
+        if ((dev->wr_max > 1) && (dev->dirty > dev->blksz)) {
+                buf = mem_alloc(NULL, dev->wr_max * dev->blksz);
+                if (buf) {
+                        max = dev->wr_max;
+                }
+        }
+
+        while (!err && (dev->dirty > 0)) {
+
+                size_t n = dev_collect_dirty_run(dev, run, max);
+                if (n == 0) {
+                        break;
+
+                } else if (n == 1) {
+                        err = dev_write_blocks(dev, run[0]->blkpos, 1, run[0]->buf);
+
+                } else {
+                        for (size_t i = 0; i < n; i++) {
+                                memcpy(buf + (i * dev->blksz), run[i]->buf, dev->blksz);
+                        }
+
+                        err = dev_write_blocks(dev, run[0]->blkpos, n, buf);
+                }
+
+                if (!err) {
+                        err = _mutex_lock(CACHE.mtx, MAX_DELAY_MS);
+                        if (!err) {
+                                for (size_t i = 0; i < n; i++) {
+                                        blk_set_dirty(run[i], false);
+                                }
+
+                                _mutex_unlock(CACHE.mtx);
+                        }
+                }
+        }
+
+        if (buf) {
+                mem_free(buf, dev->wr_max * dev->blksz);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find the first dirty block of device and following
+ *         adjacent dirty blocks. Device mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  run          found blocks
+ * @param  max          maximum number of blocks
+ *
+ * @return Number of found blocks.
+ */
+//==============================================================================
+static size_t dev_collect_dirty_run(cache_dev_t *dev, cache_blk_t **run, size_t max)
+{
+        size_t n = 0;
+
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                cache_blk_t *first = NULL;
+
+                foreach_dev_blk(b, dev) {
+                        if (b->dirty && (!first || (b->blkpos < first->blkpos))) {
+                                first = b;
+                        }
+                }
+
+                if (first) {
+                        run[n++] = first;
+
+                        while (n < max) {
+                                cache_blk_t *blk = blk_find(dev, first->blkpos + n);
+                                if (blk && blk->dirty) {
+                                        run[n++] = blk;
+                                } else {
+                                        break;
+                                }
+                        }
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function release all blocks of device. Dirty blocks are lost.
+ *         Device mutex must be locked.
+ *
+ * @param  dev          device
+ */
+//==============================================================================
+static void dev_invalidate(cache_dev_t *dev)
+{
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                for (size_t h = 0; h < HASH_SIZE; h++) {
+                        while (dev->hash[h]) {
+                                cache_blk_t *blk = dev->hash[h];
+                                blk_set_dirty(blk, false);
+                                blk_unlink(blk);
+                                blk_free(blk);
+                        }
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function release blocks that are entirely in the selected region.
+ *         Dirty blocks are lost. Device mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  blkpos       first block position (in blksz units)
+ * @param  blksz        block size of region
+ * @param  blkcnt       number of blocks of region
+ */
+//==============================================================================
+static void dev_discard(cache_dev_t *dev, u32_t blkpos, size_t blksz, size_t blkcnt)
+{
+        u64_t begin = cast(u64_t, blkpos) * blksz;
+        u64_t end   = begin + cast(u64_t, blkcnt) * blksz;
+
+        if ((dev->blksz == 0) || (begin == end)) {
+                return;
+        }
+
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                for (size_t h = 0; h < HASH_SIZE; h++) {
+                        cache_blk_t *blk = dev->hash[h];
+
+                        while (blk) {
+                                cache_blk_t *next = blk->hnext;
+                                u64_t        pos  = cast(u64_t, blk->blkpos) * dev->blksz;
+
+                                if ((pos >= begin) && ((pos + dev->blksz) <= end)) {
+                                        blk_set_dirty(blk, false);
+                                        blk_unlink(blk);
+                                        blk_free(blk);
+                                }
+
+                                blk = next;
+                        }
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function change block size of device. All blocks are synchronized
+ *         and released if block size is different. Device mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  blksz        block size
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_set_block_size(cache_dev_t *dev, size_t blksz)
+{
+        int err = ESUCC;
+
+        if (dev->blksz != blksz) {
+                err = dev_flush(dev);
+                if (!err) {
+                        dev_invalidate(dev);
+                        dev->blksz       = blksz;
+                        dev->next_blkpos = UINT32_MAX;
+                        dev->ra_window   = 0;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find block. Cache mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  blkpos       block position
+ *
+ * @return Found block or NULL.
+ */
+//==============================================================================
+static cache_blk_t *blk_find(cache_dev_t *dev, u32_t blkpos)
+{
+        for (cache_blk_t *blk = dev->hash[HASH(blkpos)]; blk; blk = blk->hnext) {
+                if (blk->blkpos == blkpos) {
+                        return blk;
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if block is cached.
+ *
+ * @param  dev          device
+ * @param  blkpos       block position
+ *
+ * @return If block is cached then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool blk_is_cached(cache_dev_t *dev, u32_t blkpos)
+{
+        bool cached = false;
+
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                cached = blk_find(dev, blkpos) != NULL;
+                _mutex_unlock(CACHE.mtx);
+        }
+
+        return cached;
+}
+
+//==============================================================================
+/**
+ * @brief  Function copy cached block to buffer.
+ *
+ * @param  dev          device
+ * @param  blkpos       block position
+ * @param  dst          destination buffer
+ *
+ * @return If block is cached then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool blk_load(cache_dev_t *dev, u32_t blkpos, void *dst)
+{
+        bool cached = false;
+
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                cache_blk_t *blk = blk_find(dev, blkpos);
+                if (blk) {
+                        memcpy(dst, blk->buf, dev->blksz);
+                        lru_touch(blk);
+                        cached = true;
+                }
+
+                _mutex_unlock(CACHE.mtx);
+        }
+
+        return cached;
+}
+
+//==============================================================================
+/**
+ * @brief  Function store block in cache. Device mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  blkpos       block position
+ * @param  src          source buffer
+ * @param  overwrite    overwrite block if already cached
+ * @param  dirty        block is not synchronized with device
+ *
+ * @return If block is cached then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool blk_store(cache_dev_t *dev, u32_t blkpos, const void *src, bool overwrite, bool dirty)
+{
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) != ESUCC) {
+                return false;
+        }
+
+        cache_blk_t *blk = blk_find(dev, blkpos);
+        if (blk) {
+                if (overwrite) {
+                        memcpy(blk->buf, src, dev->blksz);
+                        blk_set_dirty(blk, dirty);
+                }
+
+                lru_touch(blk);
+        }
+
+        _mutex_unlock(CACHE.mtx);
+
+        if (!blk) {
+                blk = blk_alloc(dev);
+                if (blk) {
+                        blk->blkpos = blkpos;
+                        memcpy(blk->buf, src, dev->blksz);
+
+                        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                                blk_link(blk);
+                                blk_set_dirty(blk, dirty);
+                                _mutex_unlock(CACHE.mtx);
+                        } else {
+                                blk_free(blk);
+                                blk = NULL;
+                        }
+                }
+        }
+
+        return blk != NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate cache memory (blocks and temporary buffers).
+ *         Memory is accounted in the cache size. If cache is full or there is
+ *         no free memory then the least recently used blocks are evicted.
+ *         Owner device mutex must be locked.
+ *
+ * @param  owner        device that requests memory (NULL: only clean blocks
+ *                      are evicted)
+ * @param  size         number of bytes
+ *
+ * @return Allocated memory or NULL.
+ */
+//==============================================================================
+static void *mem_alloc(cache_dev_t *owner, size_t size)
+{
+        do {
+                if ((CACHE.size + size) <= CACHE_MAX_SIZE) {
+                        void *mem = NULL;
+                        if (_kmalloc(_MM_CACHE, size, &mem) == ESUCC) {
+                                _kernel_scheduler_lock();
+                                CACHE.size += size;
+                                _kernel_scheduler_unlock();
+
+                                return mem;
+                        }
+                }
+        } while (evict(owner));
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function free cache memory allocated by mem_alloc().
+ *
+ * @param  mem          memory
+ * @param  size         number of bytes (the same as at allocation)
+ */
+//==============================================================================
+static void mem_free(void *mem, size_t size)
+{
+        _kernel_scheduler_lock();
+        CACHE.size -= size;
+        _kernel_scheduler_unlock();
+
+        _kfree(_MM_CACHE, &mem);
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate new block. Device mutex must be locked.
+ *
+ * @param  dev          device
+ *
+ * @return Allocated block or NULL.
+ */
+//==============================================================================
+static cache_blk_t *blk_alloc(cache_dev_t *dev)
+{
+        cache_blk_t *blk = mem_alloc(dev, BLK_SIZE(dev->blksz));
+        if (blk) {
+                memset(blk, 0, sizeof(cache_blk_t));
+                blk->dev = dev;
+        }
+
+        return blk;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add block to hash chain and at front of LRU list.
+ *         Cache mutex must be locked.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void blk_link(cache_blk_t *blk)
+{
+        cache_blk_t **chain = &blk->dev->hash[HASH(blk->blkpos)];
+        blk->hnext = *chain;
+        *chain     = blk;
+
+        blk->prev = NULL;
+        blk->next = CACHE.lru_head;
+
+        if (CACHE.lru_head) {
+                CACHE.lru_head->prev = blk;
+        } else {
+                CACHE.lru_tail = blk;
+        }
+
+        CACHE.lru_head = blk;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove block from hash chain and LRU list.
+ *         Cache mutex must be locked.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void blk_unlink(cache_blk_t *blk)
+{
+        for (cache_blk_t **b = &blk->dev->hash[HASH(blk->blkpos)]; *b; b = &(*b)->hnext) {
+                if (*b == blk) {
+                        *b = blk->hnext;
+                        break;
+                }
+        }
+
+        if (blk->prev) {
+                blk->prev->next = blk->next;
+        } else {
+                CACHE.lru_head = blk->next;
+        }
+
+        if (blk->next) {
+                blk->next->prev = blk->prev;
+        } else {
+                CACHE.lru_tail = blk->prev;
+        }
+
+        blk->hnext = NULL;
+        blk->prev  = NULL;
+        blk->next  = NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function free unlinked block.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void blk_free(cache_blk_t *blk)
+{
+        mem_free(blk, BLK_SIZE(blk->dev->blksz));
+}
+
+//==============================================================================
+/**
+ * @brief  Function set dirty state of block. Cache mutex must be locked.
+ *
+ * @param  blk          block
+ * @param  dirty        dirty state
+ */
+//==============================================================================
+static void blk_set_dirty(cache_blk_t *blk, bool dirty)
+{
+        if (blk->dirty != dirty) {
+                if (dirty) {
+                        blk->dev->dirty += blk->dev->blksz;
+                } else {
+                        blk->dev->dirty -= blk->dev->blksz;
+                }
+
+                blk->dirty = dirty;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function move block to the front of LRU list.
+ *         Cache mutex must be locked.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void lru_touch(cache_blk_t *blk)
+{
+        if (CACHE.lru_head != blk) {
+                blk->prev->next = blk->next;
+
+                if (blk->next) {
+                        blk->next->prev = blk->prev;
+                } else {
+                        CACHE.lru_tail = blk->prev;
+                }
+
+                blk->prev = NULL;
+                blk->next = CACHE.lru_head;
+                CACHE.lru_head->prev = blk;
+                CACHE.lru_head = blk;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function evict the least recently used block. Clean blocks of all
+ *         devices are evicted first, then dirty blocks of owner device are
+ *         written back and evicted. Owner device mutex must be locked.
+ *
+ * @param  owner        device that requests memory
+ *
+ * @return If block was evicted then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool evict(cache_dev_t *owner)
+{
+        cache_blk_t *victim = NULL;
+        bool         dirty  = false;
+
+        if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) != ESUCC) {
+                return false;
+        }
+
+        for (cache_blk_t *blk = CACHE.lru_tail; blk; blk = blk->prev) {
+                if (!blk->dirty) {
+                        victim = blk;
+                        break;
+                }
+        }
+
+        if (!victim) {
+                for (cache_blk_t *blk = CACHE.lru_tail; blk; blk = blk->prev) {
+                        if (blk->dev == owner) {
+                                victim = blk;
+                                break;
+                        }
+                }
+        }
+
+        if (victim) {
+                dirty = victim->dirty;
+
+                if (!dirty) {
+                        blk_unlink(victim);
+                        blk_free(victim);
+                }
+        }
+
+        _mutex_unlock(CACHE.mtx);
+
+        if (dirty) {
+                int err = dev_write_blocks(owner, victim->blkpos, 1, victim->buf);
+
+                if (_mutex_lock(CACHE.mtx, MAX_DELAY_MS) == ESUCC) {
+                        if (!err) {
+                                blk_set_dirty(victim, false);
+                                blk_unlink(victim);
+                                blk_free(victim);
+                        }
+
+                        _mutex_unlock(CACHE.mtx);
+                }
+
+                return err == ESUCC;
+        }
+
+        return victim != NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function update readahead window. Window is doubled for each
+ *         sequential access and reset for random access.
+ *
+ * @param  dev          device
+ * @param  blkpos       first block position
+ * @param  blkcnt       number of blocks
+ */
+//==============================================================================
+static void readahead_update(cache_dev_t *dev, u32_t blkpos, size_t blkcnt)
+{
+        if (blkpos == dev->next_blkpos) {
+                dev->ra_window = min(max(dev->ra_window * 2, 1), dev->ra_max);
+        } else {
+                dev->ra_window = 0;
+        }
+
+        dev->next_blkpos = blkpos + blkcnt;
+}
+
+//==============================================================================
+/**
+ * @brief  Function limit number of readahead blocks to cache capacity, device
+ *         size (if known) and to the first already cached block. Read buffer
+ *         and all read blocks have to fit in the cache, otherwise blocks read
+ *         ahead would evict each other.
+ *
+ * @param  dev          device
+ * @param  blkpos       first block to read ahead
+ * @param  blkcnt       number of requested blocks read together
+ * @param  ra           requested number of blocks
+ *
+ * @return Number of blocks to read ahead.
+ */
+//==============================================================================
+static size_t readahead_trim(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, size_t ra)
+{
+        size_t capacity = CACHE_MAX_SIZE / (dev->blksz + BLK_SIZE(dev->blksz));
+
+        ra = (capacity > blkcnt) ? min(ra, capacity - blkcnt) : 0;
+
+        if (dev->size > 0) {
+                u64_t blklimit = dev->size / dev->blksz;
+
+                if (blkpos >= blklimit) {
+                        return 0;
+                }
+
+                ra = min(ra, blklimit - blkpos);
+        }
+
+        for (size_t i = 0; i < ra; i++) {
+                if (blk_is_cached(dev, blkpos + i)) {
+                        return i;
+                }
+        }
+
+        return ra;
+}
+
+//==============================================================================
+/**
+ * @brief  Function read run of missing blocks (and readahead blocks) by using
+ *         single device access and store them in cache.
+ *         Device mutex must be locked.
+ *
+ * @param  dev          device
+ * @param  blkpos       first block position
+ * @param  blkcnt       number of blocks
+ * @param  ra           number of blocks to read ahead
+ * @param  dst          destination buffer
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int run_read(cache_dev_t *dev, u32_t blkpos, size_t blkcnt, size_t ra, u8_t *dst)
+{
+        int   err = EIO;
+        u8_t *buf = NULL;
+
+        ra = ra ? readahead_trim(dev, blkpos + blkcnt, blkcnt, ra) : 0;
+
+        if (ra > 0) {
+                buf = mem_alloc(dev, (blkcnt + ra) * dev->blksz);
+                if (buf) {
+
+                        err = dev_read(dev->file, blkpos, dev->blksz, blkcnt + ra, buf);
+                        if (!err) {
+                                memcpy(dst, buf, blkcnt * dev->blksz);
+
+                                for (size_t i = 0; i < (blkcnt + ra); i++) {
+                                        blk_store(dev, blkpos + i, buf + (i * dev->blksz), false, false);
+                                }
+                        }
+
+                        mem_free(buf, (blkcnt + ra) * dev->blksz);
+                }
+        }
+
+        if (err) {
+                err = dev_read(dev->file, blkpos, dev->blksz, blkcnt, dst);
+                if (!err) {
+                        for (size_t i = 0; i < blkcnt; i++) {
+                                blk_store(dev, blkpos + i, dst + (i * dev->blksz), false, false);
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Shrinker callback: release clean blocks at memory pressure.
+ *
+ * @param  size         number of bytes to release
+ * @param  arg          not used
+ *
+ * @return Number of released bytes.
+ */
+//==============================================================================
+static size_t shrink(size_t size, void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        return _cache_reduce(size);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -731,6 +731,59 @@ size_t _heap_get_block_size(_heap_t *heap, void *rmem)
         return blksize;
 }
 
+//==============================================================================
+/**
+ * @brief  Function return fragmentation statistics of heap. All free blocks
+ *         are visited (starting from the lowest free block), thus time of
+ *         operation depends on number of blocks.
+ *
+ * @param  heap     heap object
+ * @param  stat     statistics
+ */
+//==============================================================================
+void _heap_get_frag_stat(_heap_t *heap, _heap_frag_stat_t *stat)
+{
+        if (!heap || !stat) {
+                return;
+        }
+
+        memset(stat, 0, sizeof(*stat));
+
+        size_t free_total = 0;
+
+        PROTECT();
+
+        for (size_t ptr = mem_to_ptr(heap, heap->lfree);
+             ptr < heap->size; ptr = ptr_to_mem(heap, ptr)->next) {
+
+                struct mem *mem = ptr_to_mem(heap, ptr);
+
+                if (!mem->used) {
+                        size_t size = mem->next - ptr - SIZEOF_STRUCT_MEM;
+
+                        free_total += size;
+                        stat->free_blocks++;
+
+                        if (size > stat->largest_free) {
+                                stat->largest_free = size;
+                        }
+
+                        size_t class = 0;
+                        while ((class < _HEAP_HISTOGRAM_SIZE - 1) && (size >= (64U << class))) {
+                                class++;
+                        }
+
+                        stat->histogram[class]++;
+                }
+        }
+
+        UNPROTECT();
+
+        if (free_total) {
+                stat->fragmentation = 100 - (((u64_t)stat->largest_free * 100) / free_total);
+        }
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
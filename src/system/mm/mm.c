@@ -35,6 +35,9 @@
 #include "mm/mm.h"
 #include "mm/heap.h"
 #include "mm/shm.h"
+#include "mm/cache.h"
+#include "mm/shrinker.h"
+#include "cpu/cpuctl.h"
 #include "lib/cast.h"
 #include "kernel/errno.h"
 #include "kernel/ktypes.h"
@@ -45,6 +48,16 @@
 /*==============================================================================
   Local macros
 ==============================================================================*/
+#if defined(_CPUCTL_HEAP_START)
+/**
+ * Heap region provided by CPU module (no linker script symbols). There is no
+ * static memory accounted in the region.
+ */
+#define HEAP_SIZE                       _CPUCTL_HEAP_SIZE
+#define HEAP_START                      _CPUCTL_HEAP_START
+#define STACK_START                     _CPUCTL_HEAP_START
+#define RAM_START                       _CPUCTL_HEAP_START
+#else
 /**
  * Heap size declared by linker script
  */
@@ -64,6 +77,7 @@
  * RAM start declared by linker script
  */
 #define RAM_START                       ((void *)&__ram_start)
+#endif
 
 /**
  * Calculate memory size for an aligned buffer - returns the next highest
@@ -77,14 +91,46 @@
  */
 #define IS_IN_HEAP(heap, mem)           ((mem) >= cast(void*, (heap).ram) && (mem) < (cast(void*, (heap).ram_end)))
 
+/**
+ * Macro return region type of selected preference list item. Each nibble of
+ * the list (starting from the least significant) contains region type
+ * increased by 1. The 0 nibble terminates the list.
+ */
+#define POLICY_REGION_TYPE(list)        cast(enum _mm_region_type, ((list) & 0xF) - 1)
+
+/**
+ * Size of allocation profiler header placed before each block.
+ */
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+#define PROF_HDR_SIZE                   MEM_ALIGN_SIZE(sizeof(prof_hdr_t))
+#define PROF_SITE_NONE                  UINT16_MAX
+#else
+#define PROF_HDR_SIZE                   0
+#endif
+
 /*==============================================================================
   Local object types
 ==============================================================================*/
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+/**
+ * Allocation profiler header of block.
+ */
+typedef struct {
+        u16_t site;             //!< call site index
+        u32_t time;             //!< allocation time [ms]
+        u32_t size;             //!< requested size
+} prof_hdr_t;
+#endif
 
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
-static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *arg);
+static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *arg, void *caller);
+static void *region_alloc(enum _mm_mem mpur, size_t size, size_t *allocated);
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+static void prof_alloc(void *blk, size_t size, void *caller);
+static void prof_free(void *blk);
+#endif
 
 /*==============================================================================
   Local objects
@@ -93,10 +139,31 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *
 static const char  *REGISTERED_REGION_STR  = "Registered memory region @ 0x%X of size %d bytes";
 static const char  *REGISTRATION_ERROR_STR = "Memory region registration error (%d) @ 0x%X of size %d bytes";
 #endif
-static _mm_region_t memory_region;
+static _mm_region_t memory_region = {.type = _MM_REGION_INTERNAL};
 static i32_t        memory_usage[_MM_COUNT - 1];
 static i32_t       *module_memory_usage;
 
+/**
+ * Region preference lists of memory purposes. Regions are tried in order of
+ * list items, and in order of registration within the same type. Region types
+ * not present in the list are never used by the purpose.
+ */
+static const u32_t region_policy[_MM_COUNT] = {
+        [_MM_KRN]   = __OS_MM_POLICY_KERNEL__,
+        [_MM_FS]    = __OS_MM_POLICY_FILESYSTEM__,
+        [_MM_NET]   = __OS_MM_POLICY_NETWORK__,
+        [_MM_PROG]  = __OS_MM_POLICY_PROGRAM__,
+        [_MM_SHM]   = __OS_MM_POLICY_SHARED__,
+        [_MM_CACHE] = __OS_MM_POLICY_CACHE__,
+        [_MM_MOD]   = __OS_MM_POLICY_MODULE__,
+};
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+static _mm_alloc_site_t alloc_site[__OS_ALLOC_PROFILER_SITES__];
+static u16_t            alloc_sites;
+static u32_t            alloc_untracked;
+#endif
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -151,15 +218,17 @@ int _mm_init(void)
  * @param  region       region to register
  * @param  start        region start address
  * @param  size         region size
+ * @param  type         region type (used by allocation policy)
  *
  * @return One of errno values.
  */
 //==============================================================================
-int _mm_register_region(_mm_region_t *region, void *start, size_t size)
+int _mm_register_region(_mm_region_t *region, void *start, size_t size,
+                        enum _mm_region_type type)
 {
         int err = EINVAL;
 
-        if (region && start && size) {
+        if (region && start && size && (type < _MM_REGION_TYPE_COUNT)) {
                 // check if memory region is already used
                 for (_mm_region_t *r = &memory_region; r; r = r->next) {
                         if (r->heap.ram == start) {
@@ -172,6 +241,8 @@ int _mm_register_region(_mm_region_t *region, void *start, size_t size)
                 for (_mm_region_t *r = &memory_region; r; r = r->next) {
                         if (r->next == NULL) {
                                 region->next = NULL;
+                                region->type = type;
+                                memset(region->usage, 0, sizeof(region->usage));
                                 err = _heap_init(&region->heap, start, size);
                                 if (!err) {
                                         r->next = region;
@@ -210,7 +281,7 @@ int _kzalloc(enum _mm_mem mpur, const size_t size, void **mem, ...)
         void *arg = va_arg(vaarg, void*);
         va_end(vaarg);
 
-        return kalloc(mpur, size, true, mem, arg);
+        return kalloc(mpur, size, true, mem, arg, __builtin_return_address(0));
 }
 
 //==============================================================================
@@ -232,7 +303,7 @@ int _kmalloc(enum _mm_mem mpur, const size_t size, void **mem, ...)
         void *arg = va_arg(vaarg, void*);
         va_end(vaarg);
 
-        return kalloc(mpur, size, false, mem, arg);
+        return kalloc(mpur, size, false, mem, arg, __builtin_return_address(0));
 }
 
 //==============================================================================
@@ -295,10 +366,19 @@ int _kfree(enum _mm_mem mpur, void **mem, ...)
 
                 if (!err) {
                         size_t blksize = 0;
+                        void  *blk     = cast(u8_t*, *mem) - PROF_HDR_SIZE;
 
                         for (_mm_region_t *r = &memory_region; r; r = r->next) {
-                                if (IS_IN_HEAP(r->heap, *mem)) {
-                                        _heap_free(&r->heap, *mem, &blksize);
+                                if (IS_IN_HEAP(r->heap, blk)) {
+                                        #if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+                                        prof_free(blk);
+                                        #endif
+
+                                        _heap_free(&r->heap, blk, &blksize);
+
+                                        _kernel_scheduler_lock();
+                                        r->usage[mpur] -= blksize;
+                                        _kernel_scheduler_unlock();
                                         break;
                                 }
                         }
@@ -345,6 +425,91 @@ int _mm_get_mem_usage_details(_mm_mem_usage_t *mem_usage)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Return information about selected memory region. Regions are
+ *         numbered in order of registration.
+ *
+ * @param  region       region number
+ * @param  stat         region information
+ *
+ * @return On success ESUCC (0) is returned, otherwise different than 0 is returned.
+ */
+//==============================================================================
+int _mm_get_region_stat(uint region, _mm_region_stat_t *stat)
+{
+        if (stat) {
+                for (_mm_region_t *r = &memory_region; r; r = r->next) {
+                        if (region-- == 0) {
+                                stat->start = r->heap.ram;
+                                stat->size  = _heap_get_size(&r->heap);
+                                stat->free  = _heap_get_free(&r->heap);
+                                stat->used  = _heap_get_used(&r->heap);
+                                stat->type  = r->type;
+
+                                _heap_get_frag_stat(&r->heap, &stat->frag);
+
+                                _kernel_scheduler_lock();
+                                memcpy(stat->usage, r->usage, sizeof(stat->usage));
+                                _kernel_scheduler_unlock();
+
+                                return ESUCC;
+                        }
+                }
+        }
+
+        return EINVAL;
+}
+
+//==============================================================================
+/**
+ * @brief  Return allocation statistics of selected call site (allocation
+ *         profiler). Call sites are numbered in order of first allocation.
+ *
+ * @param  site         call site number
+ * @param  stat         call site statistics
+ *
+ * @return On success ESUCC (0) is returned, otherwise different than 0 is returned.
+ */
+//==============================================================================
+int _mm_get_alloc_site(uint site, _mm_alloc_site_t *stat)
+{
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        int err = EINVAL;
+
+        if (stat) {
+                _kernel_scheduler_lock();
+                if (site < alloc_sites) {
+                        *stat = alloc_site[site];
+                        err   = ESUCC;
+                }
+                _kernel_scheduler_unlock();
+        }
+
+        return err;
+#else
+        UNUSED_ARG2(site, stat);
+        return ENOTSUP;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Return number of allocations not tracked by allocation profiler
+ *         because call site table was full.
+ *
+ * @return Number of untracked allocations.
+ */
+//==============================================================================
+u32_t _mm_get_alloc_untracked(void)
+{
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+        return alloc_untracked;
+#else
+        return 0;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  Return used memory by selected module
@@ -376,6 +541,8 @@ int _mm_get_module_mem_usage(uint module, i32_t *usage)
 //==============================================================================
 size_t _mm_get_block_size(void *mem)
 {
+        mem = cast(u8_t*, mem) - PROF_HDR_SIZE;
+
         for (_mm_region_t *r = &memory_region; r; r = r->next) {
                 if (IS_IN_HEAP(r->heap, mem)) {
                         return _heap_get_block_size(&r->heap, mem);
@@ -469,6 +636,10 @@ bool _mm_is_object_in_heap(void *ptr)
 /**
  * @brief  Allocate memory
  *
+ * Regions are selected according to preference list of memory purpose.
+ * When block cannot be allocated in any preferred region then clean cache
+ * blocks are released and allocation is repeated.
+ *
  * _MM_PROG:
  *      Function allocate extra size (res_header_t) when block is created for
  *      application purposes. Extra size is used to create chain of resources.
@@ -482,11 +653,12 @@ bool _mm_is_object_in_heap(void *ptr)
  * @param[in]      clear            clear allocated block
  * @param[out]     mem              pointer to memory block pointer
  * @param[out,in]  arg              argument depending on selected memory region
+ * @param[in]      caller           call site address (allocation profiler)
  *
  * @return One of errno values.
  */
 //==============================================================================
-static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *arg)
+static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *arg, void *caller)
 {
         int err = EINVAL;
 
@@ -533,37 +705,65 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *
                         _kernel_panic_report(_KERNEL_PANIC_DESC_CAUSE_INTERNAL);
                 }
 
-                size = MEM_ALIGN_SIZE(size);
+                size = MEM_ALIGN_SIZE(size) + PROF_HDR_SIZE;
 
                 size_t allocated = 0;
                 void  *blk       = NULL;
+                bool   reduced   = false;
                        err       = ENOMEM;
 
-                for (_mm_region_t *r = &memory_region; r; r = r->next) {
+                /*
+                 * Keep free memory above low watermark: registered shrinkers
+                 * release memory before allocation drops free memory below.
+                 */
+                if (__OS_MM_LOW_WATERMARK__ > 0) {
+                        size_t freemem = _mm_get_mem_free();
 
-                        if (_heap_get_free(&r->heap) >= size) {
+                        if (freemem < (size + __OS_MM_LOW_WATERMARK__)) {
+                                _mm_shrink(size + __OS_MM_LOW_WATERMARK__ - freemem);
+                        }
+                }
 
-                                blk = _heap_alloc(&r->heap, size, &allocated);
+                retry:
+                blk = region_alloc(mpur, size, &allocated);
 
-                                if (blk) {
-                                        _kernel_scheduler_lock();
-                                        *usage += allocated;
-                                        _kernel_scheduler_unlock();
+                if (blk) {
+                        _kernel_scheduler_lock();
+                        *usage += allocated;
+                        _kernel_scheduler_unlock();
+
+                        if (clear) {
+                                memset(blk, 0, size);
+                        }
 
-                                        if (clear) {
-                                                memset(blk, 0, size);
-                                        }
+                        #if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+                        prof_alloc(blk, size - PROF_HDR_SIZE, caller);
+                        #else
+                        UNUSED_ARG1(caller);
+                        #endif
 
-                                        if (mpur == _MM_PROG) {
-                                                 cast(res_header_t*, blk)->next = NULL;
-                                                 cast(res_header_t*, blk)->type = RES_TYPE_MEMORY;
-                                        }
+                        blk = cast(u8_t*, blk) + PROF_HDR_SIZE;
 
-                                        *mem = blk;
+                        if (mpur == _MM_PROG) {
+                                 cast(res_header_t*, blk)->next = NULL;
+                                 cast(res_header_t*, blk)->type = RES_TYPE_MEMORY;
+                        }
 
-                                        err = ESUCC;
-                                        goto finish;
-                                }
+                        *mem = blk;
+
+                        err = ESUCC;
+                        goto finish;
+                }
+
+                /*
+                 * Call shrinkers and try again. Allocations made by shrinkers
+                 * (or by other threads during reclaim) do not call shrinkers
+                 * again.
+                 */
+                if (!reduced) {
+                        reduced = true;
+                        if (_mm_shrink(size) > 0) {
+                                goto retry;
                         }
                 }
         }
@@ -572,6 +772,111 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, void **mem, void *
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Allocate block in the first region that fits, walking regions in
+ *         order of memory purpose preference list.
+ *
+ * @param[in]  mpur             memory purpose
+ * @param[in]  size             block size (aligned)
+ * @param[out] allocated        allocated size (including block header)
+ *
+ * @return Allocated block or NULL if there is no free memory.
+ */
+//==============================================================================
+static void *region_alloc(enum _mm_mem mpur, size_t size, size_t *allocated)
+{
+        for (u32_t list = region_policy[mpur]; list; list >>= 4) {
+
+                for (_mm_region_t *r = &memory_region; r; r = r->next) {
+
+                        if (  (r->type == POLICY_REGION_TYPE(list))
+                           && (_heap_get_free(&r->heap) >= size) ) {
+
+                                void *blk = _heap_alloc(&r->heap, size, allocated);
+
+                                if (blk) {
+                                        _kernel_scheduler_lock();
+                                        r->usage[mpur] += *allocated;
+                                        _kernel_scheduler_unlock();
+
+                                        return blk;
+                                }
+                        }
+                }
+        }
+
+        return NULL;
+}
+
+#if __OS_ENABLE_ALLOC_PROFILER__ == _YES_
+//==============================================================================
+/**
+ * @brief  Register allocation in call site table and initialize profiler
+ *         header of block.
+ *
+ * @param  blk          allocated block (profiler header)
+ * @param  size         requested size
+ * @param  caller       call site address
+ */
+//==============================================================================
+static void prof_alloc(void *blk, size_t size, void *caller)
+{
+        prof_hdr_t *hdr = blk;
+        hdr->site = PROF_SITE_NONE;
+        hdr->time = _kernel_get_time_ms();
+        hdr->size = size;
+
+        _kernel_scheduler_lock();
+
+        u16_t i = 0;
+        while ((i < alloc_sites) && (alloc_site[i].caller != caller)) {
+                i++;
+        }
+
+        if ((i == alloc_sites) && (alloc_sites < __OS_ALLOC_PROFILER_SITES__)) {
+                alloc_site[alloc_sites++].caller = caller;
+        }
+
+        if (i < alloc_sites) {
+                alloc_site[i].allocs++;
+                alloc_site[i].bytes      += size;
+                alloc_site[i].live_bytes += size;
+                hdr->site = i;
+        } else {
+                alloc_untracked++;
+        }
+
+        _kernel_scheduler_unlock();
+}
+
+//==============================================================================
+/**
+ * @brief  Register free of block in call site table.
+ *
+ * @param  blk          freed block (profiler header)
+ */
+//==============================================================================
+static void prof_free(void *blk)
+{
+        prof_hdr_t *hdr = blk;
+
+        if (hdr->site < alloc_sites) {
+                u32_t lifetime = _kernel_get_time_ms() - hdr->time;
+
+                _kernel_scheduler_lock();
+
+                _mm_alloc_site_t *site = &alloc_site[hdr->site];
+                site->frees++;
+                site->live_bytes     -= hdr->size;
+                site->lifetime_total += lifetime;
+                site->lifetime_max    = max(site->lifetime_max, lifetime);
+
+                _kernel_scheduler_unlock();
+        }
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
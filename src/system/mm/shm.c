@@ -98,7 +98,12 @@ static struct {
 //==============================================================================
 int _shm_init(void)
 {
-        return _mutex_create(MUTEX_TYPE_NORMAL, &SHM.mtx);
+        int err = _mutex_create(MUTEX_TYPE_NORMAL, &SHM.mtx);
+        if (!err) {
+                _mutex_set_name(SHM.mtx, "shm");
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -0,0 +1,267 @@
+/*=========================================================================*//**
+File     shrinker.c
+
+Author   Daniel Zorychta
+
+Brief    Memory pressure shrinkers.
+
+         Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * Shrinkers are called by kalloc when allocation fails or free memory drops
+ * below the low watermark. Only one thread reclaims memory at a time: other
+ * threads (and allocations made by shrinker callbacks) do not wait and get
+ * nothing. List cannot be modified while shrinkers are called, so the
+ * unregistering thread waits until reclaim is finished.
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdbool.h>
+#include "mm/shrinker.h"
+#include "kernel/ktypes.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static bool reclaim_begin(void);
+static void reclaim_end(void);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static _mm_shrinker_t *shrinkers;
+static bool            reclaiming;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief  Function register shrinker. Shrinkers with lower priority value are
+ *         called first.
+ *
+ * @param  shrinker     shrinker object (must be valid until unregistered)
+ * @param  name         subsystem name
+ * @param  priority     call order (the lowest first)
+ * @param  shrink       reclaim callback
+ * @param  arg          callback argument
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _mm_shrinker_register(_mm_shrinker_t *shrinker, const char *name,
+                          u8_t priority, _mm_shrink_func_t shrink, void *arg)
+{
+        if (!shrinker || !name || !shrink) {
+                return EINVAL;
+        }
+
+        shrinker->name     = name;
+        shrinker->priority = priority;
+        shrinker->shrink   = shrink;
+        shrinker->arg      = arg;
+        shrinker->calls    = 0;
+        shrinker->freed    = 0;
+
+        while (!reclaim_begin()) {
+                _sleep_ms(1);
+        }
+
+        int err = ESUCC;
+
+        _mm_shrinker_t **link = &shrinkers;
+        for (; *link; link = &(*link)->next) {
+                if (*link == shrinker) {
+                        err = EADDRINUSE;
+                        break;
+                } else if ((*link)->priority > priority) {
+                        break;
+                }
+        }
+
+        if (!err) {
+                shrinker->next = *link;
+                *link = shrinker;
+        }
+
+        reclaim_end();
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function unregister shrinker. If shrinkers are just called then
+ *         function waits until reclaim is finished.
+ *
+ * @param  shrinker     shrinker object
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _mm_shrinker_unregister(_mm_shrinker_t *shrinker)
+{
+        if (!shrinker) {
+                return EINVAL;
+        }
+
+        while (!reclaim_begin()) {
+                _sleep_ms(1);
+        }
+
+        int err = ENOENT;
+
+        for (_mm_shrinker_t **link = &shrinkers; *link; link = &(*link)->next) {
+                if (*link == shrinker) {
+                        *link = shrinker->next;
+                        shrinker->next = NULL;
+                        err = ESUCC;
+                        break;
+                }
+        }
+
+        reclaim_end();
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function call shrinkers in priority order until requested number of
+ *         bytes is released. If other thread reclaims memory then function
+ *         returns immediately.
+ *
+ * @param  size         number of bytes to release
+ *
+ * @return Number of released bytes.
+ */
+//==============================================================================
+size_t _mm_shrink(size_t size)
+{
+        size_t freed = 0;
+
+        if (reclaim_begin()) {
+
+                for (_mm_shrinker_t *s = shrinkers; s && (freed < size); s = s->next) {
+                        size_t n = s->shrink(size - freed, s->arg);
+
+                        s->calls++;
+                        s->freed += n;
+                        freed    += n;
+                }
+
+                reclaim_end();
+        }
+
+        return freed;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return statistics of selected shrinker. Shrinkers are
+ *         numbered in call order.
+ *
+ * @param  shrinker     shrinker number
+ * @param  stat         shrinker statistics
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _mm_get_shrinker_stat(uint shrinker, _mm_shrinker_stat_t *stat)
+{
+        int err = EINVAL;
+
+        if (stat && reclaim_begin()) {
+                for (_mm_shrinker_t *s = shrinkers; s; s = s->next) {
+                        if (shrinker-- == 0) {
+                                stat->name     = s->name;
+                                stat->priority = s->priority;
+                                stat->calls    = s->calls;
+                                stat->freed    = s->freed;
+                                err = ESUCC;
+                                break;
+                        }
+                }
+
+                reclaim_end();
+
+        } else if (stat) {
+                err = EBUSY;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function take exclusive access to shrinker list.
+ *
+ * @return If access is taken then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool reclaim_begin(void)
+{
+        bool taken = false;
+
+        _kernel_scheduler_lock();
+        if (!reclaiming) {
+                reclaiming = true;
+                taken      = true;
+        }
+        _kernel_scheduler_unlock();
+
+        return taken;
+}
+
+//==============================================================================
+/**
+ * @brief  Function release exclusive access to shrinker list.
+ */
+//==============================================================================
+static void reclaim_end(void)
+{
+        reclaiming = false;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -38,12 +38,17 @@ Brief    Network management.
 #include "lwip/tcpip.h"
 #include "lwip/dhcp.h"
 #include "lwip/prot/dhcp.h"
+#include "lwip/tcp.h"
+#include "lwip/udp.h"
+#include "lwip/memp.h"
+#include "lwip/priv/memp_priv.h"
 #include "netif/etharp.h"
 
 /*==============================================================================
   Local macros
 ==============================================================================*/
 #define MAXIMUM_SAFE_UDP_PAYLOAD        1024
+#define TX_VECTORS                      8
 
 #define zalloc(_size, _pptr)            _kzalloc(_MM_NET, _size, _pptr)
 #define zfree(_pptr)                    _kfree(_MM_NET, _pptr)
@@ -103,10 +108,12 @@ static const u32_t LINK_POLL_TIME = 250;
 //==============================================================================
 static void clear_rx_tx_counters(void)
 {
-        inet->rx_bytes   = 0;
-        inet->tx_bytes   = 0;
-        inet->rx_packets = 0;
-        inet->tx_packets = 0;
+        inet->rx_bytes        = 0;
+        inet->tx_bytes        = 0;
+        inet->rx_packets      = 0;
+        inet->tx_packets      = 0;
+        inet->rx_dropped      = 0;
+        inet->rx_alloc_errors = 0;
 }
 
 //==============================================================================
@@ -263,6 +270,158 @@ static void create_lwIP_addr(ip_addr_t *lwip_addr, const NET_INET_IPv4_t *addr)
                  NET_INET_IPv4_d(*addr));
 }
 
+//==============================================================================
+/**
+ * @brief Function send segments as single UDP datagram. The socket netbuf is
+ *        allocated once and reused by all next datagrams, only packet buffers
+ *        are released after send.
+ * @param inet_sock     socket
+ * @param seg           segments to send
+ * @param count         number of segments
+ * @param flags         flags
+ * @param to            destination address (NULL for connected peer)
+ * @param sent          number of sent bytes
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static int send_datagram(INET_socket_t             *inet_sock,
+                         const NET_segment_t       *seg,
+                         size_t                     count,
+                         NET_flags_t                flags,
+                         const NET_INET_sockaddr_t *to,
+                         size_t                    *sent)
+{
+        size_t len = 0;
+        for (size_t i = 0; i < count; i++) {
+                len += seg[i].len;
+        }
+
+        if (len > MAXIMUM_SAFE_UDP_PAYLOAD) {
+                return EFBIG;
+        }
+
+        if (inet_sock->txbuf == NULL) {
+                inet_sock->txbuf = netbuf_new();
+                if (inet_sock->txbuf == NULL) {
+                        return ENOMEM;
+                }
+        }
+
+        struct netbuf *nb  = inet_sock->txbuf;
+        int            err = ESUCC;
+
+        if ((flags & NET_FLAGS__NOCOPY) && (len > 0)) {
+                for (size_t i = 0; !err && (i < count); i++) {
+                        if (seg[i].len == 0) {
+                                continue;
+                        }
+
+                        if (nb->p == NULL) {
+                                err = err_to_errno(netbuf_ref(nb, seg[i].data,
+                                                              seg[i].len));
+                        } else {
+                                struct pbuf *p = pbuf_alloc(PBUF_RAW, seg[i].len,
+                                                            PBUF_REF);
+                                if (p) {
+                                        p->payload = const_cast(void*, seg[i].data);
+                                        pbuf_cat(nb->p, p);
+                                } else {
+                                        err = ENOMEM;
+                                }
+                        }
+                }
+        } else {
+                u8_t *data = netbuf_alloc(nb, len);
+                if (data) {
+                        for (size_t i = 0; i < count; i++) {
+                                memcpy(data, seg[i].data, seg[i].len);
+                                data += seg[i].len;
+                        }
+                } else {
+                        err = ENOMEM;
+                }
+        }
+
+        if (!err) {
+                if (to) {
+                        ip_addr_t addr;
+                        create_lwIP_addr(&addr, &to->addr);
+                        err = err_to_errno(netconn_sendto(inet_sock->netconn,
+                                                          nb, &addr, to->port));
+                } else {
+                        err = err_to_errno(netconn_send(inet_sock->netconn, nb));
+                }
+        }
+
+        if (!err) {
+                *sent = len;
+        }
+
+        // netconn_send() uses netbuf address if set
+        netbuf_free(nb);
+        ip_addr_set_zero(&nb->addr);
+        nb->port = 0;
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function write segments to TCP stream. Segments are passed to stack
+ *        in groups of TX_VECTORS by single call.
+ * @param inet_sock     socket
+ * @param seg           segments to send
+ * @param count         number of segments
+ * @param flags         flags
+ * @param sent          number of sent bytes
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static int write_stream(INET_socket_t       *inet_sock,
+                        const NET_segment_t *seg,
+                        size_t               count,
+                        NET_flags_t          flags,
+                        size_t              *sent)
+{
+        int err = ESUCC;
+
+        *sent = 0;
+
+        while (!err && count) {
+                struct netvector vec[TX_VECTORS];
+                u16_t  n   = min(count, TX_VECTORS);
+                size_t len = 0;
+
+                for (u16_t i = 0; i < n; i++) {
+                        vec[i].ptr = seg[i].data;
+                        vec[i].len = seg[i].len;
+                        len       += seg[i].len;
+                }
+
+                u8_t lwip_flags = (flags & NET_FLAGS__NOCOPY) ? NETCONN_NOCOPY
+                                                              : NETCONN_COPY;
+
+                if ((flags & NET_FLAGS__MORE) || (count > n)) {
+                        lwip_flags |= NETCONN_MORE;
+                }
+
+                size_t written = 0;
+                err = err_to_errno(netconn_write_vectors_partly(inet_sock->netconn,
+                                                                vec, n, lwip_flags,
+                                                                &written));
+                *sent += written;
+
+                if (written < len) {
+                        break;
+                }
+
+                seg   += n;
+                count -= n;
+        }
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief  Function starts network manager, TCP/IP stack, and set network interface.
@@ -622,6 +781,8 @@ int INET_ifstatus(NET_INET_status_t *status)
                 status->rx_bytes   = inet->rx_bytes;
                 status->tx_packets = inet->tx_packets;
                 status->tx_bytes   = inet->tx_bytes;
+                status->rx_dropped      = inet->rx_dropped;
+                status->rx_alloc_errors = inet->rx_alloc_errors;
 
                 status->state      = NET_INET_STATE__NOT_CONFIGURED;
 
@@ -703,6 +864,10 @@ int INET_socket_destroy(INET_socket_t *inet_sock)
                 netbuf_delete(inet_sock->netbuf);
         }
 
+        if (inet_sock->txbuf) {
+                netbuf_delete(inet_sock->txbuf);
+        }
+
         if (inet_sock->netconn) {
                 netconn_close(inet_sock->netconn);
                 netconn_delete(inet_sock->netconn);
@@ -814,6 +979,10 @@ int INET_socket_recv(INET_socket_t *inet_sock,
                      NET_flags_t    flags,
                      size_t        *recved)
 {
+        if (inet_sock->view_len) {
+                return EBUSY;
+        }
+
         if (flags & NET_FLAGS__REWIND) {
                 inet_sock->seek = 0;
         }
@@ -862,6 +1031,10 @@ int INET_socket_recvfrom(INET_socket_t       *inet_sock,
 {
         UNUSED_ARG1(flags);
 
+        if (inet_sock->view_len) {
+                return EBUSY;
+        }
+
         int err = EPERM;
 
         enum netconn_type type = netconn_type(inet_sock->netconn);
@@ -883,6 +1056,87 @@ int INET_socket_recvfrom(INET_socket_t       *inet_sock,
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns view of received data. Segments point directly to
+ *         pbufs of received netbuf (no copy). Netbuf is kept until view is
+ *         released.
+ * @param  inet_sock    socket
+ * @param  view         view of received data
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int INET_socket_recv_view(INET_socket_t *inet_sock, NET_recv_view_t *view)
+{
+        if (inet_sock->view_len) {
+                return EBUSY;
+        }
+
+        int err = ESUCC;
+        if (inet_sock->netbuf == NULL) {
+                err = err_to_errno(netconn_recv(inet_sock->netconn,
+                                                &inet_sock->netbuf));
+        }
+
+        if (!err) {
+                u16_t skip  = inet_sock->seek;
+                view->count = 0;
+                view->len   = 0;
+
+                for (struct pbuf *p = inet_sock->netbuf->p;
+                     p && view->count < NET_RECV_VIEW_SEGMENTS;
+                     p = p->next) {
+
+                        if (skip >= p->len) {
+                                skip -= p->len;
+                                continue;
+                        }
+
+                        view->seg[view->count].data = cast(u8_t*, p->payload) + skip;
+                        view->seg[view->count].len  = p->len - skip;
+                        view->len += p->len - skip;
+                        view->count++;
+
+                        skip = 0;
+                }
+
+                inet_sock->view_len = view->len;
+
+                if (view->len == 0) {
+                        netbuf_delete(inet_sock->netbuf);
+                        inet_sock->netbuf = NULL;
+                        inet_sock->seek   = 0;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function releases view of received data.
+ * @param  inet_sock    socket
+ * @return One of @ref errno value (EINVAL if there is no view to release).
+ */
+//==============================================================================
+int INET_socket_recv_release(INET_socket_t *inet_sock)
+{
+        if ((inet_sock->netbuf == NULL) || (inet_sock->view_len == 0)) {
+                return EINVAL;
+        }
+
+        inet_sock->seek    += inet_sock->view_len;
+        inet_sock->view_len = 0;
+
+        if (inet_sock->seek >= netbuf_len(inet_sock->netbuf)) {
+                netbuf_delete(inet_sock->netbuf);
+                inet_sock->netbuf = NULL;
+                inet_sock->seek   = 0;
+        }
+
+        return ESUCC;
+}
+
 //==============================================================================
 /**
  * @brief  Function send data to connected socket.
@@ -919,47 +1173,8 @@ int INET_socket_send(INET_socket_t *inet_sock,
                                                         len, lwip_flags, sent));
 
         } else if (type & NETCONN_UDP) {
-
-                if (len <= MAXIMUM_SAFE_UDP_PAYLOAD) {
-
-                        inet_sock->netbuf = netbuf_new();
-                        if (inet_sock->netbuf) {
-                                if (flags & NET_FLAGS__NOCOPY) {
-                                        err = err_to_errno(
-                                                netbuf_ref(inet_sock->netbuf,
-                                                           buf, len)
-                                        );
-                                } else {
-                                        char *data = netbuf_alloc(inet_sock->netbuf, len);
-                                        if (data) {
-                                                memcpy(data, buf, len);
-                                                err = ESUCC;
-                                        } else {
-                                                err = ENOMEM;
-                                        }
-                                }
-
-                                if (!err) {
-                                        err = err_to_errno(
-                                                netconn_send(inet_sock->netconn,
-                                                             inet_sock->netbuf)
-                                        );
-
-                                }
-
-                                if (!err) {
-                                        *sent = len;
-                                }
-
-                                netbuf_delete(inet_sock->netbuf);
-                                inet_sock->netbuf = NULL;
-
-                        } else {
-                                err = ENOMEM;
-                        }
-                } else {
-                        err = EFBIG;
-                }
+                NET_segment_t seg = {.data = buf, .len = len};
+                err = send_datagram(inet_sock, &seg, 1, flags, NULL, sent);
 
         } else {
                 err = EFAULT;
@@ -992,30 +1207,62 @@ int INET_socket_sendto(INET_socket_t             *inet_sock,
         enum netconn_type type = netconn_type(inet_sock->netconn);
 
         if (type & NETCONN_UDP) {
+                NET_segment_t seg = {.data = buf, .len = len};
+                err = send_datagram(inet_sock, &seg, 1, flags, to_sockaddr, sent);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function send vectored messages. UDP message is sent as single
+ *         datagram, TCP messages are written to stream one after another
+ *         (destination address is ignored).
+ * @param  inet_sock    socket
+ * @param  msg          messages to send
+ * @param  count        number of messages
+ * @param  flags        flags
+ * @param  msgsent      number of sent messages
+ * @return One of @ref errno value. If at least one message was sent then
+ *         ESUCC is returned.
+ */
+//==============================================================================
+int INET_socket_sendmsg(INET_socket_t *inet_sock,
+                        NET_msg_t     *msg,
+                        size_t         count,
+                        NET_flags_t    flags,
+                        size_t        *msgsent)
+{
+        int err = EFAULT;
+
+        enum netconn_type type = netconn_type(inet_sock->netconn);
 
-                ip_addr_t           lwip_addr;
-                NET_INET_sockaddr_t sockaddr;
+        *msgsent = 0;
 
-                // get the peer if currently connected
-                err = err_to_errno(netconn_peer(inet_sock->netconn, &lwip_addr,
-                                                &sockaddr.port));
+        for (size_t i = 0; i < count; i++) {
+                msg[i].sent = 0;
 
-                if (!err) {
-                        create_addr(&sockaddr.addr, &lwip_addr);
+                if (msg[i].seg == NULL && msg[i].count > 0) {
+                        err = EINVAL;
 
-                        // connect to new address
-                        err = INET_socket_connect(inet_sock, to_sockaddr);
+                } else if (type & NETCONN_TCP) {
+                        err = write_stream(inet_sock, msg[i].seg, msg[i].count,
+                                           flags, &msg[i].sent);
 
-                        if (!err) {
-                                err = INET_socket_send(inet_sock, buf, len, flags, sent);
-                        }
+                } else if (type & NETCONN_UDP) {
+                        err = send_datagram(inet_sock, msg[i].seg, msg[i].count,
+                                            flags, msg[i].to, &msg[i].sent);
+                }
 
-                        // reset the remote address and port number of the conn.
-                        INET_socket_connect(inet_sock, &sockaddr);
+                if (err) {
+                        break;
                 }
+
+                (*msgsent)++;
         }
 
-        return err;
+        return (*msgsent > 0) ? ESUCC : err;
 }
 
 //==============================================================================
@@ -1117,6 +1364,86 @@ int INET_socket_getaddress(INET_socket_t *inet_sock, NET_INET_sockaddr_t *sockad
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns queue state of socket. Function does not block
+ *         (can be called with locked scheduler), so stack objects are read
+ *         without synchronization.
+ * @param  inet_sock    socket
+ * @param  stat         socket statistics (queue fields are set)
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int INET_socket_stat(INET_socket_t *inet_sock, NET_socket_stat_t *stat)
+{
+        struct netconn *conn = inet_sock->netconn;
+
+        stat->rx_queue    = 0;
+        stat->tx_queue    = 0;
+        stat->retransmits = 0;
+        stat->port        = 0;
+
+        if (inet_sock->netbuf) {
+                stat->rx_queue = netbuf_len(inet_sock->netbuf) - inet_sock->seek;
+        }
+
+#if LWIP_SO_RCVBUF
+        stat->rx_queue += conn->recv_avail;
+#endif
+
+        if (conn->pcb.ip) {
+                if (NETCONNTYPE_GROUP(netconn_type(conn)) == NETCONN_TCP) {
+                        struct tcp_pcb *pcb = conn->pcb.tcp;
+
+                        stat->port = pcb->local_port;
+
+                        if (pcb->state != LISTEN) {
+                                stat->tx_queue    = TCP_SND_BUF - tcp_sndbuf(pcb);
+                                stat->retransmits = pcb->nrtx;
+                        }
+
+                } else if (NETCONNTYPE_GROUP(netconn_type(conn)) == NETCONN_UDP) {
+                        stat->port = conn->pcb.udp->local_port;
+                }
+        }
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Function returns statistics of lwIP memory pool.
+ * @param  seek         pool seek (start from 0)
+ * @param  stat         pool statistics
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int INET_mempool_stat(size_t seek, NET_mempool_stat_t *stat)
+{
+        static const char *const pool_name[MEMP_MAX] = {
+                #define LWIP_MEMPOOL(name, num, size, desc) #name,
+                #include "lwip/priv/memp_std.h"
+        };
+
+        if (seek >= MEMP_MAX) {
+                return ENOENT;
+        }
+
+        stat->name = pool_name[seek];
+        stat->size = memp_pools[seek]->size;
+#if MEMP_STATS
+        stat->used = memp_pools[seek]->stats->used;
+        stat->max  = memp_pools[seek]->stats->max;
+        stat->err  = memp_pools[seek]->stats->err;
+#else
+        stat->used = 0;
+        stat->max  = 0;
+        stat->err  = 0;
+#endif
+
+        return ESUCC;
+}
+
 //==============================================================================
 /**
  * @brief  Function convert value for host/network purpose.
@@ -37,18 +37,36 @@
 /*==============================================================================
   Local macros
 ==============================================================================*/
+#define zalloc(_size, _pptr)    _kzalloc(_MM_NET, _size, _pptr)
+
+#define TX_CHAIN_LINKS          16
+#define RX_BUFFER_SIZE          1518    /* maximum frame without CRC (VLAN tagged) */
+#define RX_POOL_SIZE            __NETWORK_TCPIP_RX_POOL_SIZE__
+#define RX_BATCH                __NETWORK_TCPIP_RX_BATCH__
 
 /*==============================================================================
   Local object types
 ==============================================================================*/
+typedef struct rx_buffer {
+        struct pbuf_custom pbuf;
+        struct rx_buffer  *next;
+        u8_t               payload[RX_BUFFER_SIZE];
+} rx_buffer_t;
 
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+static int          rx_pool_init(void);
+static rx_buffer_t *rx_buffer_get(void);
+static void         rx_buffer_put(rx_buffer_t *buf);
+static void         rx_buffer_free(struct pbuf *p);
+static void         receive_to_heap(inet_t *inet);
 
 /*==============================================================================
   Local objects
 ==============================================================================*/
+static rx_buffer_t *rx_pool;
+static rx_buffer_t *rx_free;
 
 /*==============================================================================
   Exported objects
@@ -77,8 +95,15 @@
 //==============================================================================
 int _inetdrv_hardware_init(inet_t *inet)
 {
+        /* allocate Rx buffers loaned to the stack */
+        int err = rx_pool_init();
+        if (err) {
+                LWIP_DEBUGF(LWIP_DBG_LEVEL_SERIOUS, ("_inetdrv_hardware_init: Rx pool alloc fail\n"));
+                return err;
+        }
+
         /* set MAC address */
-        int err = sys_ioctl(inet->if_file, IOCTL_ETHMAC__GET_MAC_ADDR, inet->netif.hwaddr);
+        err = sys_ioctl(inet->if_file, IOCTL_ETHMAC__GET_MAC_ADDR, inet->netif.hwaddr);
         if (err) {
                 LWIP_DEBUGF(LWIP_DBG_LEVEL_SERIOUS, ("_inetdrv_hardware_init: MAC set fail\n"));
                 return err;
@@ -122,10 +147,11 @@ int _inetdrv_hardware_deinit(inet_t *inet)
  *         Function should try receive packet by specified time passed by
  *         'input_timeout'. If function does not receive any packet due to
  *         specified time then function should exit.
- *         If packet was received then the function should allocate buffer for
- *         transfer by using pbuf_alloc() function and put this buffer to then
- *         TCPIP stack by using inet->netif.input() function. If packets are
- *         received every loop then the function should not exit.
+ *         Packets are received in batches to buffers taken from Rx pool. Each
+ *         buffer is passed to the TCPIP stack as custom pbuf by using
+ *         inet->netif.input() function and returns to the pool when pbuf is
+ *         freed. If packets are received every loop then the function should
+ *         not exit.
  *
  * @param  inet                 inet container
  * @param  input_timeout        packet receive timeout
@@ -139,34 +165,59 @@ void _inetdrv_handle_input(inet_t *inet, u32_t timeout)
         int r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__WAIT_FOR_PACKET, &pw);
 
         while (r == 0 && pw.pkt_size > 0) {
-                // NOTE: subtract packet size by 4 to discard CRC32
-                struct pbuf *p = pbuf_alloc(PBUF_RAW, pw.pkt_size - 4, PBUF_RAM);
-                if (p) {
-                        ETHMAC_packet_t pkt;
-                        pkt.payload = p->payload;
-                        pkt.payload_size = p->len;
+                rx_buffer_t    *buf[RX_BATCH];
+                ETHMAC_packet_t pkt[RX_BATCH];
+                size_t          n = 0;
+
+                while (n < RX_BATCH && (buf[n] = rx_buffer_get())) {
+                        pkt[n].payload      = buf[n]->payload;
+                        pkt[n].payload_size = RX_BUFFER_SIZE;
+                        n++;
+                }
+
+                if (n == 0) {
+                        LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: no free Rx buffers\n"));
+                        inet->rx_alloc_errors++;
+                        receive_to_heap(inet);
+                        r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__WAIT_FOR_PACKET, &pw);
+                        continue;
+                }
+
+                ETHMAC_packet_batch_t batch = {.packet = pkt, .count = n};
+
+                r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__RECEIVE_PACKETS, &batch);
+
+                if (r == 0) {
+                        inet->rx_dropped += batch.dropped;
 
-                        r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__RECEIVE_PACKET, &pkt);
+                        for (size_t i = 0; i < batch.received; i++) {
+                                struct pbuf *p = pbuf_alloced_custom(PBUF_RAW,
+                                                                     pkt[i].payload_size,
+                                                                     PBUF_REF,
+                                                                     &buf[i]->pbuf,
+                                                                     buf[i]->payload,
+                                                                     RX_BUFFER_SIZE);
 
-                        if (r == 0) {
                                 LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: received = %d\n", p->tot_len));
 
                                 inet->rx_packets++;
                                 inet->rx_bytes += p->tot_len;
 
                                 if (inet->netif.input(p, &inet->netif) != ERR_OK) {
+                                        inet->rx_dropped++;
                                         pbuf_free(p);
                                 }
-                        } else {
-                                LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: receive error\n"));
-                                pbuf_free(p);
                         }
-
-                        r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__WAIT_FOR_PACKET, &pw);
                 } else {
-                        LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: not enough free memory\n"));
-                        sys_sleep_ms(10);
+                        LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: receive error\n"));
+                        batch.received = 0;
+                }
+
+                for (size_t i = batch.received; i < n; i++) {
+                        rx_buffer_put(buf[i]);
                 }
+
+                r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__WAIT_FOR_PACKET, &pw);
         }
 
         LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: packet receive timeout\n"));
@@ -194,22 +245,54 @@ void _inetdrv_handle_input(inet_t *inet, u32_t timeout)
 //==============================================================================
 err_t _inetdrv_handle_output(struct netif *netif, struct pbuf *p)
 {
-      inet_t *inet = netif->state;
-
-      LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_output: packet size %d\n", p->tot_len));
-
-      ETHMAC_packet_t pkt;
-      pkt.payload = p->payload;
-      pkt.payload_size = p->len;
-
-      if (sys_ioctl(inet->if_file, IOCTL_ETHMAC__SEND_PACKET, &pkt) == 0) {
-              inet->tx_packets++;
-              inet->tx_bytes += pkt.payload_size;
-              return ERR_OK;
-      } else {
-              LWIP_DEBUGF(LWIP_DBG_LEVEL_SERIOUS, ("_inetdrv_handle_output: packet send error\n"));
-              return ERR_IF;
-      }
+        inet_t *inet = netif->state;
+
+        LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_output: packet size %d\n", p->tot_len));
+
+        /*
+         * Each pbuf of chain is a link of packet chain buffer, so headers and
+         * payload (also NETCONN_NOCOPY data) are gathered by driver directly.
+         * Extremely long chains are coalesced to single pbuf.
+         */
+        struct pbuf *q = p;
+        if (pbuf_clen(p) > TX_CHAIN_LINKS) {
+                q = pbuf_coalesce(p, PBUF_RAW);
+                if (q == p) {
+                        LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_output: not enough free memory\n"));
+                        return ERR_MEM;
+                }
+        }
+
+        ETHMAC_packet_chain_t chain[TX_CHAIN_LINKS];
+        size_t n = 0;
+
+        for (struct pbuf *pb = q; pb && n < TX_CHAIN_LINKS; pb = pb->next, n++) {
+                chain[n].next         = NULL;
+                chain[n].payload      = pb->payload;
+                chain[n].payload_size = pb->len;
+                chain[n].total_size   = q->tot_len;
+
+                if (n > 0) {
+                        chain[n - 1].next = &chain[n];
+                }
+        }
+
+        err_t err;
+
+        if (sys_ioctl(inet->if_file, IOCTL_ETHMAC__SEND_PACKET_FROM_CHAIN, chain) == 0) {
+                inet->tx_packets++;
+                inet->tx_bytes += q->tot_len;
+                err = ERR_OK;
+        } else {
+                LWIP_DEBUGF(LWIP_DBG_LEVEL_SERIOUS, ("_inetdrv_handle_output: packet send error\n"));
+                err = ERR_IF;
+        }
+
+        if (q != p) {
+                pbuf_free(q);
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -237,6 +320,126 @@ bool _inetdrv_is_link_connected(inet_t *inet)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function receives single packet to buffer allocated from the heap.
+ *         Used when all Rx pool buffers are held by the stack. If there is no
+ *         free memory then pending packets are dropped, so the interface does
+ *         not stall until the stack releases buffers.
+ *
+ * @param  inet         inet container
+ */
+//==============================================================================
+static void receive_to_heap(inet_t *inet)
+{
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, RX_BUFFER_SIZE, PBUF_RAM);
+
+        ETHMAC_packet_t pkt;
+        pkt.payload      = p ? p->payload : NULL;
+        pkt.payload_size = p ? RX_BUFFER_SIZE : 0;
+
+        ETHMAC_packet_batch_t batch = {.packet = &pkt, .count = 1};
+
+        int r = sys_ioctl(inet->if_file, IOCTL_ETHMAC__RECEIVE_PACKETS, &batch);
+        if (r == 0) {
+                inet->rx_dropped += batch.dropped;
+        }
+
+        if (r == 0 && batch.received > 0) {
+                pbuf_realloc(p, pkt.payload_size);
+
+                LWIP_DEBUGF(INET_DEBUG, ("_inetdrv_handle_input: received = %d\n", p->tot_len));
+
+                inet->rx_packets++;
+                inet->rx_bytes += p->tot_len;
+
+                if (inet->netif.input(p, &inet->netif) != ERR_OK) {
+                        inet->rx_dropped++;
+                        pbuf_free(p);
+                }
+        } else if (p) {
+                pbuf_free(p);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocates Rx buffer pool. Pool is allocated once and is
+ *         never released because buffers can be still used by the stack
+ *         after interface is stopped. Pool takes RX_POOL_SIZE buffers of
+ *         maximum frame size (about 1.5 KiB each).
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static int rx_pool_init(void)
+{
+        int err = ESUCC;
+
+        if (rx_pool == NULL) {
+                err = zalloc(RX_POOL_SIZE * sizeof(rx_buffer_t), cast(void**, &rx_pool));
+                if (!err) {
+                        for (size_t i = 0; i < RX_POOL_SIZE; i++) {
+                                rx_pool[i].pbuf.custom_free_function = rx_buffer_free;
+                                rx_buffer_put(&rx_pool[i]);
+                        }
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function takes free buffer from Rx pool.
+ *
+ * @return Buffer or NULL if pool is empty.
+ */
+//==============================================================================
+static rx_buffer_t *rx_buffer_get(void)
+{
+        sys_critical_section_begin();
+
+        rx_buffer_t *buf = rx_free;
+        if (buf) {
+                rx_free = buf->next;
+        }
+
+        sys_critical_section_end();
+
+        return buf;
+}
+
+//==============================================================================
+/**
+ * @brief  Function returns buffer to Rx pool.
+ *
+ * @param  buf          buffer
+ */
+//==============================================================================
+static void rx_buffer_put(rx_buffer_t *buf)
+{
+        sys_critical_section_begin();
+
+        buf->next = rx_free;
+        rx_free   = buf;
+
+        sys_critical_section_end();
+}
+
+//==============================================================================
+/**
+ * @brief  Custom pbuf free function. Called by the stack (any thread) when
+ *         last reference of received packet is released.
+ *
+ * @param  p            pbuf (first member of Rx buffer)
+ */
+//==============================================================================
+static void rx_buffer_free(struct pbuf *p)
+{
+        rx_buffer_put(cast(rx_buffer_t*, p));
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -63,6 +63,8 @@ typedef struct {
         uint            tx_packets;
         uint            rx_bytes;
         uint            tx_bytes;
+        uint            rx_dropped;
+        uint            rx_alloc_errors;
         bool            ready:1;
         bool            disconnected:1;
         bool            configured:1;
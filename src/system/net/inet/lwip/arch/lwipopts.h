@@ -1324,6 +1324,12 @@
  * Default width of u8_t can be increased if 255 refs are not enough for you.
  */
 #define LWIP_PBUF_REF_T                 u8_t
+
+/**
+ * LWIP_SUPPORT_CUSTOM_PBUF: custom pbufs are used by the interface driver to
+ * loan preallocated Rx buffers to the stack (returned to the pool on free).
+ */
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
 /**
  * @}
  */
@@ -1693,7 +1699,7 @@
 /**
  * LWIP_SO_RCVBUF==1: Enable SO_RCVBUF processing.
  */
-#define LWIP_SO_RCVBUF                  0
+#define LWIP_SO_RCVBUF                  1
 
 /**
  * LWIP_SO_LINGER==1: Enable SO_LINGER processing.
@@ -1820,9 +1826,10 @@
 #define MEM_STATS                       ((MEM_LIBC_MALLOC == 0) && (MEM_USE_POOLS == 0))
 
 /**
- * MEMP_STATS==1: Enable memp.c pool stats.
+ * MEMP_STATS==1: Enable memp.c pool stats. Pool counters are updated also
+ * when pools are allocated from heap (MEMP_MEM_MALLOC), see /proc/net/memp.
  */
-#define MEMP_STATS                      (MEMP_MEM_MALLOC == 0)
+#define MEMP_STATS                      1
 
 /**
  * SYS_STATS==1: Enable system stats (sem and mbox counts, etc).
@@ -196,6 +196,8 @@ err_t sys_mtx_new(sys_mtx_t *mutex)
 
         if (mutex) {
                 if (sys_mutex_create(MUTEX_TYPE_NORMAL, &(*mutex)) == ESUCC) {
+                        // all stack mutexes (core lock included) in one profiler entry
+                        sys_mutex_set_name(*mutex, "lwip");
                         return ERR_OK;
                 } else {
                         return ERR_MEM;
@@ -59,8 +59,11 @@ Brief    Network management.
 #define PROXY_socket_accept(_family)            PROXY_FUNCTION(_family, socket_accept)
 #define PROXY_socket_recv(_family)              PROXY_FUNCTION(_family, socket_recv)
 #define PROXY_socket_recvfrom(_family)          PROXY_FUNCTION(_family, socket_recvfrom)
+#define PROXY_socket_recv_view(_family)         PROXY_FUNCTION(_family, socket_recv_view)
+#define PROXY_socket_recv_release(_family)      PROXY_FUNCTION(_family, socket_recv_release)
 #define PROXY_socket_send(_family)              PROXY_FUNCTION(_family, socket_send)
 #define PROXY_socket_sendto(_family)            PROXY_FUNCTION(_family, socket_sendto)
+#define PROXY_socket_sendmsg(_family)           PROXY_FUNCTION(_family, socket_sendmsg)
 #define PROXY_socket_set_recv_timeout(_family)  PROXY_FUNCTION(_family, socket_set_recv_timeout)
 #define PROXY_socket_set_send_timeout(_family)  PROXY_FUNCTION(_family, socket_set_send_timeout)
 #define PROXY_socket_get_recv_timeout(_family)  PROXY_FUNCTION(_family, socket_get_recv_timeout)
@@ -69,6 +72,8 @@ Brief    Network management.
 #define PROXY_socket_disconnect(_family)        PROXY_FUNCTION(_family, socket_disconnect)
 #define PROXY_socket_shutdown(_family)          PROXY_FUNCTION(_family, socket_shutdown)
 #define PROXY_socket_getaddress(_family)        PROXY_FUNCTION(_family, socket_getaddress)
+#define PROXY_socket_stat(_family)              PROXY_FUNCTION(_family, socket_stat)
+#define PROXY_mempool_stat(_family)             PROXY_FUNCTION(_family, mempool_stat)
 #define PROXY_hton_u16(_family)                 PROXY_FUNCTION_U16(_family, hton_u16)
 #define PROXY_hton_u32(_family)                 PROXY_FUNCTION_U32(_family, hton_u32)
 #define PROXY_hton_u64(_family)                 PROXY_FUNCTION_U64(_family, hton_u64)
@@ -78,9 +83,13 @@ Brief    Network management.
   Local object types
 ==============================================================================*/
 struct socket {
-        res_header_t header;
-        NET_family_t family;
-        void        *ctx;
+        res_header_t      header;
+        NET_family_t      family;
+        void             *ctx;
+#if __NETWORK_SOCKET_STATISTICS__ == _YES_
+        struct socket    *next;
+        NET_socket_stat_t stat;
+#endif
 };
 
 typedef int (*proxy_func_t)();
@@ -95,6 +104,9 @@ typedef u64_t (*proxy_func_u64_t)();
 /*==============================================================================
   Local objects
 ==============================================================================*/
+#if __NETWORK_SOCKET_STATISTICS__ == _YES_
+static SOCKET *socket_list;
+#endif
 
 /*==============================================================================
   Exported objects
@@ -170,6 +182,124 @@ static bool is_socket_valid(SOCKET *socket)
                                           + _mm_align(sizeof(SOCKET))));
 }
 
+#if __NETWORK_SOCKET_STATISTICS__ == _YES_
+//==============================================================================
+/**
+ * @brief Function add socket to list of statistics.
+ * @param socket        socket to add
+ */
+//==============================================================================
+static void stat_link(SOCKET *socket)
+{
+        _kernel_scheduler_lock();
+        {
+                socket->next = socket_list;
+                socket_list  = socket;
+        }
+        _kernel_scheduler_unlock();
+}
+
+//==============================================================================
+/**
+ * @brief Function remove socket from list of statistics. Socket is removed
+ *        before it is destroyed, so statistics reader never accesses
+ *        released stack objects.
+ * @param socket        socket to remove
+ */
+//==============================================================================
+static void stat_unlink(SOCKET *socket)
+{
+        _kernel_scheduler_lock();
+        {
+                for (SOCKET **s = &socket_list; *s; s = &(*s)->next) {
+                        if (*s == socket) {
+                                *s = socket->next;
+                                break;
+                        }
+                }
+        }
+        _kernel_scheduler_unlock();
+}
+
+//==============================================================================
+/**
+ * @brief Function initialize statistics of new socket.
+ * @param socket        new socket
+ * @param protocol      socket protocol
+ */
+//==============================================================================
+static void stat_register(SOCKET *socket, NET_protocol_t protocol)
+{
+        socket->stat.family   = socket->family;
+        socket->stat.protocol = protocol;
+
+        stat_link(socket);
+}
+
+//==============================================================================
+/**
+ * @brief Function initialize statistics of accepted socket.
+ * @param socket        accepted socket
+ * @param listener      listening socket
+ */
+//==============================================================================
+static void stat_inherit(SOCKET *socket, SOCKET *listener)
+{
+        stat_register(socket, listener->stat.protocol);
+}
+
+//==============================================================================
+/**
+ * @brief Function count result of socket operation.
+ * @param socket        socket
+ * @param err           operation result
+ * @param rx            number of received bytes
+ * @param tx            number of transmitted bytes
+ */
+//==============================================================================
+static void stat_count(SOCKET *socket, int err, size_t rx, size_t tx)
+{
+        if (!err) {
+                if (rx) {
+                        socket->stat.rx_packets++;
+                        socket->stat.rx_bytes += rx;
+                }
+
+                if (tx) {
+                        socket->stat.tx_packets++;
+                        socket->stat.tx_bytes += tx;
+                }
+        } else if (err != ETIME && err != EAGAIN) {
+                socket->stat.errors++;
+        }
+}
+#else
+static inline void stat_link(SOCKET *socket)
+{
+        UNUSED_ARG1(socket);
+}
+
+static inline void stat_unlink(SOCKET *socket)
+{
+        UNUSED_ARG1(socket);
+}
+
+static inline void stat_register(SOCKET *socket, NET_protocol_t protocol)
+{
+        UNUSED_ARG2(socket, protocol);
+}
+
+static inline void stat_inherit(SOCKET *socket, SOCKET *listener)
+{
+        UNUSED_ARG2(socket, listener);
+}
+
+static inline void stat_count(SOCKET *socket, int err, size_t rx, size_t tx)
+{
+        UNUSED_ARG4(socket, err, rx, tx);
+}
+#endif
+
 //==============================================================================
 /**
  * @brief Function setup network interface.
@@ -277,6 +407,8 @@ int _net_socket_create(NET_family_t family, NET_protocol_t protocol, SOCKET **so
 
                         if (err) {
                                 socket_free(socket);
+                        } else {
+                                stat_register(*socket, protocol);
                         }
                 }
         }
@@ -305,9 +437,13 @@ int _net_socket_destroy(SOCKET *socket)
         int err = EINVAL;
 
         if (is_socket_valid(socket)) {
+                stat_unlink(socket);
+
                 err = call_proxy_function(socket->family, socket->ctx);
                 if (!err) {
                         socket_free(&socket);
+                } else {
+                        stat_link(socket);
                 }
         }
 
@@ -397,6 +533,8 @@ int _net_socket_accept(SOCKET *socket, SOCKET **new_socket)
 
                         if (err) {
                                 socket_free(new_socket);
+                        } else {
+                                stat_inherit(*new_socket, socket);
                         }
                 }
         }
@@ -427,8 +565,66 @@ int _net_socket_recv(SOCKET *socket, void *buf, size_t len, NET_flags_t flags, s
         };
 
         if (is_socket_valid(socket) && buf && len && recved) {
-                return call_proxy_function(socket->family, socket->ctx, buf,
-                                           len, flags, recved);
+                int err = call_proxy_function(socket->family, socket->ctx, buf,
+                                              len, flags, recved);
+                stat_count(socket, err, *recved, 0);
+                return err;
+        } else {
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function returns read-only view of next received data of selected
+ *        socket (without copy). View must be released by
+ *        _net_socket_recv_release() before next receive operation.
+ * @param socket        socket to receive
+ * @param view          view of received data
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int _net_socket_recv_view(SOCKET *socket, NET_recv_view_t *view)
+{
+        PROXY_TABLE = {
+                #if __ENABLE_TCPIP_STACK__ > 0
+                PROXY_socket_recv_view(INET),
+                #endif
+                #if __ENABLE_SIPC_STACK__ > 0
+                PROXY_socket_recv_view(SIPC),
+                #endif
+        };
+
+        if (is_socket_valid(socket) && view) {
+                int err = call_proxy_function(socket->family, socket->ctx, view);
+                stat_count(socket, err, view->len, 0);
+                return err;
+        } else {
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function releases view of received data. All bytes of view are
+ *        consumed.
+ * @param socket        socket
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int _net_socket_recv_release(SOCKET *socket)
+{
+        PROXY_TABLE = {
+                #if __ENABLE_TCPIP_STACK__ > 0
+                PROXY_socket_recv_release(INET),
+                #endif
+                #if __ENABLE_SIPC_STACK__ > 0
+                PROXY_socket_recv_release(SIPC),
+                #endif
+        };
+
+        if (is_socket_valid(socket)) {
+                return call_proxy_function(socket->family, socket->ctx);
         } else {
                 return EINVAL;
         }
@@ -463,8 +659,10 @@ int _net_socket_recvfrom(SOCKET                 *socket,
         };
 
         if (is_socket_valid(socket) && buf && len && sockaddr && recved) {
-                return call_proxy_function(socket->family, socket->ctx, buf,
-                                           len, flags, sockaddr, recved);
+                int err = call_proxy_function(socket->family, socket->ctx, buf,
+                                              len, flags, sockaddr, recved);
+                stat_count(socket, err, *recved, 0);
+                return err;
         } else {
                 return EINVAL;
         }
@@ -493,8 +691,10 @@ int _net_socket_send(SOCKET *socket, const void *buf, size_t len, NET_flags_t fl
         };
 
         if (is_socket_valid(socket) && buf && len && sent) {
-                return call_proxy_function(socket->family, socket->ctx, buf,
-                                           len, flags, sent);
+                int err = call_proxy_function(socket->family, socket->ctx, buf,
+                                              len, flags, sent);
+                stat_count(socket, err, 0, *sent);
+                return err;
         } else {
                 return EINVAL;
         }
@@ -529,8 +729,53 @@ int _net_socket_sendto(SOCKET                       *socket,
         };
 
         if (is_socket_valid(socket) && buf && len && to_addr && sent) {
-                return call_proxy_function(socket->family, socket->ctx, buf,
-                                           len, flags, to_addr, sent);
+                int err = call_proxy_function(socket->family, socket->ctx, buf,
+                                              len, flags, to_addr, sent);
+                stat_count(socket, err, 0, *sent);
+                return err;
+        } else {
+                return EINVAL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function send vectored messages by socket. Each message is sent as
+ *        separate datagram (UDP) or appended to stream (TCP).
+ * @param socket        socket that send messages
+ * @param msg           messages to send
+ * @param count         number of messages
+ * @param flags         control flags
+ * @param msgsent       number of sent messages
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int _net_socket_sendmsg(SOCKET      *socket,
+                        NET_msg_t   *msg,
+                        size_t       count,
+                        NET_flags_t  flags,
+                        size_t      *msgsent)
+{
+        PROXY_TABLE = {
+                #if __ENABLE_TCPIP_STACK__ > 0
+                PROXY_socket_sendmsg(INET),
+                #endif
+                #if __ENABLE_SIPC_STACK__ > 0
+                PROXY_socket_sendmsg(SIPC),
+                #endif
+        };
+
+        if (is_socket_valid(socket) && msg && count && msgsent) {
+                int err = call_proxy_function(socket->family, socket->ctx, msg,
+                                              count, flags, msgsent);
+
+                for (size_t i = 0; !err && (i < *msgsent); i++) {
+                        stat_count(socket, err, 0, msg[i].sent);
+                }
+
+                stat_count(socket, err, 0, 0);
+
+                return err;
         } else {
                 return EINVAL;
         }
@@ -743,6 +988,103 @@ int _net_socket_getaddress(SOCKET *socket, NET_generic_sockaddr_t *sockaddr)
         }
 }
 
+//==============================================================================
+/**
+ * @brief Function return statistics of selected socket. Sockets are not
+ *        ordered, so seek is stable only if no socket is created or destroyed
+ *        between calls.
+ * @param seek          socket seek (start from 0)
+ * @param stat          socket statistics
+ * @return One of @ref errno value (ESUCC, EINVAL, ENOENT).
+ */
+//==============================================================================
+int _net_socket_get_stat_seek(size_t seek, NET_socket_stat_t *stat)
+{
+        int err = EINVAL;
+
+        if (stat) {
+                err = ENOENT;
+
+#if __NETWORK_SOCKET_STATISTICS__ == _YES_
+                PROXY_TABLE = {
+                        #if __ENABLE_TCPIP_STACK__ > 0
+                        PROXY_socket_stat(INET),
+                        #endif
+                        #if __ENABLE_SIPC_STACK__ > 0
+                        PROXY_socket_stat(SIPC),
+                        #endif
+                };
+
+                _kernel_scheduler_lock();
+                {
+                        for (SOCKET *socket = socket_list; socket; socket = socket->next) {
+                                if (seek-- == 0) {
+                                        *stat = socket->stat;
+                                        err   = call_proxy_function(socket->family,
+                                                                    socket->ctx, stat);
+                                        break;
+                                }
+                        }
+                }
+                _kernel_scheduler_unlock();
+#else
+                UNUSED_ARG1(seek);
+#endif
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function return number of sockets.
+ * @return Number of sockets.
+ */
+//==============================================================================
+size_t _net_socket_get_count(void)
+{
+        size_t count = 0;
+
+#if __NETWORK_SOCKET_STATISTICS__ == _YES_
+        _kernel_scheduler_lock();
+        {
+                for (SOCKET *socket = socket_list; socket; socket = socket->next) {
+                        count++;
+                }
+        }
+        _kernel_scheduler_unlock();
+#endif
+
+        return count;
+}
+
+//==============================================================================
+/**
+ * @brief Function return statistics of selected memory pool of network stack.
+ * @param family        network family
+ * @param seek          pool seek (start from 0)
+ * @param stat          pool statistics
+ * @return One of @ref errno value (ESUCC, EINVAL, ENOENT).
+ */
+//==============================================================================
+int _net_mempool_get_stat_seek(NET_family_t family, size_t seek, NET_mempool_stat_t *stat)
+{
+        PROXY_TABLE = {
+                #if __ENABLE_TCPIP_STACK__ > 0
+                PROXY_mempool_stat(INET),
+                #endif
+                #if __ENABLE_SIPC_STACK__ > 0
+                PROXY_mempool_stat(SIPC),
+                #endif
+        };
+
+        if (family < _NET_FAMILY__COUNT && stat) {
+                return call_proxy_function(family, seek, stat);
+        } else {
+                return EINVAL;
+        }
+}
+
 //==============================================================================
 /**
  * @brief Function return address of host by name.
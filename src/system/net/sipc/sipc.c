@@ -995,6 +995,10 @@ int SIPC_socket_recv(SIPC_socket_t *socket,
                 return ECONNREFUSED;
         }
 
+        if (socket->view_len) {
+                return EBUSY;
+        }
+
         int   err  = ETIME;
         u32_t tref = sys_time_get_reference();
 
@@ -1026,6 +1030,77 @@ int SIPC_socket_recv(SIPC_socket_t *socket,
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns view of received data (no copy). Data is kept in
+ *         socket buffer until view is released.
+ * @param  socket       socket
+ * @param  view         view of received data
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int SIPC_socket_recv_view(SIPC_socket_t *socket, NET_recv_view_t *view)
+{
+        if (!is_socket_registered(socket)) {
+                return ECONNREFUSED;
+        }
+
+        if (socket->view_len) {
+                return EBUSY;
+        }
+
+        int   err  = ETIME;
+        u32_t tref = sys_time_get_reference();
+
+        while (!sys_time_is_expired(tref, socket->recv_timeout)) {
+
+                err = sipcbuf__peek(socket->rxbuf, view);
+                if (!err && view->len == 0) {
+                        err = ETIME;
+                        sys_sleep_ms(5);
+                        continue;
+                }
+
+                break;
+        }
+
+        if (!err) {
+                socket->view_len = view->len;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function releases view of received data.
+ * @param  socket       socket
+ * @return One of @ref errno value (EINVAL if there is no view to release).
+ */
+//==============================================================================
+int SIPC_socket_recv_release(SIPC_socket_t *socket)
+{
+        if (!is_socket_registered(socket)) {
+                return ECONNREFUSED;
+        }
+
+        if (socket->view_len == 0) {
+                return EINVAL;
+        }
+
+        int err = sipcbuf__consume(socket->rxbuf, socket->view_len);
+        if (!err) {
+                socket->view_len = 0;
+
+                if (socket->busy && !sipcbuf__is_full(socket->rxbuf)) {
+                        socket->busy = false;
+                        send_packet(socket->seq, socket->port, PACKET_TYPE_ACK, NULL, 0);
+                }
+        }
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief  Function receive data from selected address.
@@ -1167,6 +1242,56 @@ int SIPC_socket_sendto(SIPC_socket_t             *socket,
         return ENOTSUP;
 }
 
+//==============================================================================
+/**
+ * @brief  Function send vectored messages. Segments are sent one after
+ *         another to connected socket. Destination address is not supported.
+ * @param  socket       socket
+ * @param  msg          messages to send
+ * @param  count        number of messages
+ * @param  flags        flags
+ * @param  msgsent      number of sent messages
+ * @return One of @ref errno value. If at least one message was sent then
+ *         ESUCC is returned.
+ */
+//==============================================================================
+int SIPC_socket_sendmsg(SIPC_socket_t *socket,
+                        NET_msg_t     *msg,
+                        size_t         count,
+                        NET_flags_t    flags,
+                        size_t        *msgsent)
+{
+        int err = ESUCC;
+
+        *msgsent = 0;
+
+        for (size_t i = 0; !err && (i < count); i++) {
+                msg[i].sent = 0;
+
+                if (msg[i].to) {
+                        err = ENOTSUP;
+                        break;
+                }
+
+                for (size_t n = 0; !err && (n < msg[i].count); n++) {
+                        if (msg[i].seg[n].len == 0) {
+                                continue;
+                        }
+
+                        size_t sent = 0;
+                        err = SIPC_socket_send(socket, msg[i].seg[n].data,
+                                               msg[i].seg[n].len, flags, &sent);
+                        msg[i].sent += sent;
+                }
+
+                if (!err) {
+                        (*msgsent)++;
+                }
+        }
+
+        return (*msgsent > 0) ? ESUCC : err;
+}
+
 //==============================================================================
 /**
  * @brief  Function gets host address by name.
@@ -1252,6 +1377,40 @@ int SIPC_socket_getaddress(SIPC_socket_t *socket, NET_SIPC_sockaddr_t *sockaddr)
         return sockaddr->port = socket->port;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns queue state of socket. Function does not block.
+ * @param  socket       socket
+ * @param  stat         socket statistics (queue fields are set)
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int SIPC_socket_stat(SIPC_socket_t *socket, NET_socket_stat_t *stat)
+{
+        stat->port        = socket->port;
+        stat->rx_queue    = sipcbuf__get_size(socket->rxbuf);
+        stat->tx_queue    = 0;
+        stat->retransmits = 0;
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Function returns statistics of memory pool. SIPC does not use
+ *         memory pools (buffers are allocated from kernel heap).
+ * @param  seek         pool seek (start from 0)
+ * @param  stat         pool statistics
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+int SIPC_mempool_stat(size_t seek, NET_mempool_stat_t *stat)
+{
+        UNUSED_ARG2(seek, stat);
+
+        return ENOENT;
+}
+
 //==============================================================================
 /**
  * @brief  Function convert value for host/network purpose.
@@ -240,6 +240,103 @@ int sipcbuf__read(sipcbuf_t *sipcbuf, u8_t *data, size_t size, size_t *rdctr)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns view of buffered data (no copy). Chains pointed by
+ *         view are valid until consumed or buffer is cleared.
+ *
+ * @param  sipcbuf      buffer instance
+ * @param  view         view of data
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int sipcbuf__peek(sipcbuf_t *sipcbuf, NET_recv_view_t *view)
+{
+        int err = EINVAL;
+
+        if (sipcbuf && view) {
+                err = sys_mutex_lock(sipcbuf->access, MAX_DELAY_MS);
+                if (!err) {
+                        view->count = 0;
+                        view->len   = 0;
+
+                        size_t seek = sipcbuf->seek;
+
+                        for (data_chain_t *chain = sipcbuf->begin;
+                             chain && view->count < NET_RECV_VIEW_SEGMENTS;
+                             chain = chain->next) {
+
+                                view->seg[view->count].data = &chain->buf[seek];
+                                view->seg[view->count].len  = chain->len - seek;
+                                view->len += chain->len - seek;
+                                view->count++;
+
+                                seek = 0;
+                        }
+
+                        sys_mutex_unlock(sipcbuf->access);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function drops selected number of bytes from buffer begin.
+ *
+ * @param  sipcbuf      buffer instance
+ * @param  size         number of bytes to drop
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int sipcbuf__consume(sipcbuf_t *sipcbuf, size_t size)
+{
+        int err = EINVAL;
+
+        if (sipcbuf) {
+                err = sys_mutex_lock(sipcbuf->access, MAX_DELAY_MS);
+                if (!err) {
+                        data_chain_t *chain = sipcbuf->begin;
+
+                        while (chain && size > 0) {
+                                data_chain_t *next = chain->next;
+
+                                size_t n = min(chain->len - sipcbuf->seek, size);
+
+                                size                -= n;
+                                sipcbuf->seek       += n;
+                                sipcbuf->total_size -= n;
+
+                                if (sipcbuf->seek >= chain->len) {
+
+                                        sipcbuf->seek = 0;
+
+                                        if (!chain->reference) {
+                                                _kfree(_MM_NET, (void*)&chain->buf);
+                                        }
+
+                                        _kfree(_MM_NET, (void*)&chain);
+
+                                        sipcbuf->begin = next;
+
+                                        if (sipcbuf->begin == NULL) {
+                                                sipcbuf->end = NULL;
+                                        }
+                                }
+
+                                chain = next;
+                        }
+
+                        sys_mutex_unlock(sipcbuf->access);
+                }
+        }
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief  Function clear data in buffer.
@@ -300,6 +397,21 @@ bool sipcbuf__is_full(sipcbuf_t *sipcbuf)
         return is_full;
 }
 
+//==============================================================================
+/**
+ * @brief  Function returns number of buffered bytes. Buffer is not locked,
+ *         so function can be used with locked scheduler (statistics).
+ *
+ * @param  sipcbuf      buffer instance
+ *
+ * @return Number of buffered bytes.
+ */
+//==============================================================================
+size_t sipcbuf__get_size(sipcbuf_t *sipcbuf)
+{
+        return sipcbuf ? sipcbuf->total_size : 0;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
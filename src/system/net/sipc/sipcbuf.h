@@ -42,6 +42,7 @@ Detailed Doxygen description.
 #include <stdint.h>
 #include <stdbool.h>
 #include "kernel/ktypes.h"
+#include "net/netm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,8 +68,11 @@ extern int  sipcbuf__create(sipcbuf_t **sipcbuf, size_t max_capacity);
 extern void sipcbuf__destroy(sipcbuf_t *sipcbuf);
 extern int  sipcbuf__write(sipcbuf_t *sipcbuf, const u8_t *data, size_t size, bool reference);
 extern int  sipcbuf__read(sipcbuf_t *sipcbuf, u8_t *data, size_t size, size_t *rdctr);
+extern int  sipcbuf__peek(sipcbuf_t *sipcbuf, NET_recv_view_t *view);
+extern int  sipcbuf__consume(sipcbuf_t *sipcbuf, size_t size);
 extern void sipcbuf__clear(sipcbuf_t *sipcbuf);
 extern bool sipcbuf__is_full(sipcbuf_t *sipcbuf);
+extern size_t sipcbuf__get_size(sipcbuf_t *sipcbuf);
 
 /*==============================================================================
   Exported inline functions
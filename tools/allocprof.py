@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+#
+# Report of dnx RTOS kernel allocation profiler (/proc/allocprof).
+#
+# Profiler is enabled by "Allocation profiler" option in the OS configuration.
+# Statistics are read on target by using procfs file:
+#   cat /proc/allocprof > /mnt/allocprof.txt
+#
+# Call site addresses are translated to function names and source lines by
+# addr2line tool when firmware ELF file is given. Script prints the hottest
+# call sites (the most allocations) and call sites that keep the most memory
+# allocated (leak candidates).
+#
+# Usage: python3 allocprof.py <allocprof.txt> [<firmware.elf>] [<count>]
+#
+
+import subprocess
+import sys
+
+ADDR2LINE = "arm-none-eabi-addr2line"
+
+
+def parse(lines):
+    """Parse call site records."""
+
+    sites = []
+
+    for line in lines:
+        fields = line.split()
+        if len(fields) != 7 or not fields[0].startswith("0x"):
+            continue
+
+        sites.append({"caller":     int(fields[0], 16),
+                      "allocs":     int(fields[1]),
+                      "frees":      int(fields[2]),
+                      "live":       int(fields[3]),
+                      "live_bytes": int(fields[4]),
+                      "life_avg":   int(fields[5]),
+                      "life_max":   int(fields[6])})
+
+    return sites
+
+
+def resolve(sites, elf):
+    """Translate call site addresses to function names and source lines."""
+
+    names = {}
+
+    if elf:
+        # return address points to instruction after call
+        addrs = ["0x%x" % (site["caller"] - 1) for site in sites]
+        try:
+            out = subprocess.check_output([ADDR2LINE, "-f", "-s", "-e", elf] + addrs,
+                                          universal_newlines=True).splitlines()
+        except (OSError, subprocess.CalledProcessError) as err:
+            print("addr2line: %s" % err, file=sys.stderr)
+            out = []
+
+        for i, site in enumerate(sites):
+            if 2 * i + 1 < len(out):
+                names[site["caller"]] = "%s (%s)" % (out[2 * i], out[2 * i + 1])
+
+    return names
+
+
+def report(title, sites, names, key, count):
+    print(title)
+    print("    caller   allocs    frees     live live_bytes life_avg life_max  function")
+
+    for site in sorted(sites, key=lambda s: s[key], reverse=True)[:count]:
+        print("0x%08x %8d %8d %8d %10d %8d %8d  %s" %
+              (site["caller"], site["allocs"], site["frees"], site["live"],
+               site["live_bytes"], site["life_avg"], site["life_max"],
+               names.get(site["caller"], "")))
+
+    print()
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python3 allocprof.py <allocprof.txt> [<firmware.elf>] [<count>]")
+        exit(1)
+
+    with open(sys.argv[1], "r") as fin:
+        sites = parse(fin.readlines())
+
+    elf   = sys.argv[2] if len(sys.argv) > 2 else None
+    count = int(sys.argv[3]) if len(sys.argv) > 3 else 10
+    names = resolve(sites, elf)
+
+    report("Hot call sites (allocations):", sites, names, "allocs", count)
+    report("Leak candidates (live bytes):", [s for s in sites if s["live"] > 0],
+           names, "live_bytes", count)
+
+
+if __name__ == "__main__":
+    main()
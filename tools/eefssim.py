@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+#
+# EEPROM simulator for eefs block allocator.
+#
+# Script models eefs medium (128 B blocks) and counts writes of each block
+# for a synthetic workload: files are created, appended, and removed in loop.
+# Block allocation follows the eefs allocator: first-fit (wear leveling
+# disabled) or rotating cursor with least written block selection (wear
+# leveling enabled). Writes are counted at sync points, so several updates of
+# the same block between syncs (e.g. bitmap) are counted once, as with the
+# write-back block cache. Allocator counters are updated at the same points
+# and start from zero, as in eefs at mount.
+#
+# Usage: python3 eefssim.py [options]
+#
+
+import argparse
+import random
+
+BLOCK_SIZE    = 128
+MAIN_BITS     = 119 * 8
+BITMAP_BITS   = 122 * 8
+FILE_PAYLOAD  = 120
+
+
+class Medium:
+    def __init__(self, blocks, wear_leveling, seed):
+        self.blocks        = blocks
+        self.wear_leveling = wear_leveling
+        self.writes        = [0] * blocks
+        self.ram_wear      = [0] * blocks
+        self.free          = [True] * blocks
+        self.dirty         = set()
+        self.cursor        = random.Random(seed).randrange(blocks) if wear_leveling else 0
+        self.wear_floor    = 0
+
+        bitmap_blocks = 0
+        if blocks > MAIN_BITS:
+            bitmap_blocks = (blocks - MAIN_BITS + BITMAP_BITS - 1) // BITMAP_BITS
+
+        # main block, bitmap blocks and root directory are always used
+        for blk in range(0, bitmap_blocks + 2):
+            self.free[blk] = False
+
+        self.root = bitmap_blocks + 1
+
+    def bitmap_block(self, blk):
+        if blk < MAIN_BITS:
+            return 0
+        return (blk - MAIN_BITS) // BITMAP_BITS + 1
+
+    def write(self, blk):
+        self.dirty.add(blk)
+
+    def sync(self):
+        # eefs counts writes reported by the cache, i.e. at flush time
+        for blk in self.dirty:
+            self.writes[blk]   += 1
+            self.ram_wear[blk] += 1
+        self.dirty.clear()
+
+    def find_empty(self):
+        found, least, scanned = None, None, True
+
+        for n in range(self.blocks):
+            blk = (self.cursor + n) % self.blocks
+            if not self.free[blk]:
+                continue
+
+            wear = self.ram_wear[blk] if self.wear_leveling else 0
+            if least is None or wear < least:
+                found, least = blk, wear
+
+            if wear <= self.wear_floor:
+                scanned = False
+                break
+
+        if found is None:
+            raise MemoryError("no space left on medium")
+
+        if scanned:
+            self.wear_floor = least
+
+        return found
+
+    def alloc(self):
+        blk = self.find_empty()
+        self.free[blk] = False
+        self.write(self.bitmap_block(blk))
+
+        if self.wear_leveling:
+            self.cursor = (blk + 1) % self.blocks
+
+        return blk
+
+    def release(self, blk):
+        self.free[blk] = True
+        self.write(self.bitmap_block(blk))
+
+
+def run(args, wear_leveling):
+    rnd    = random.Random(args.seed)
+    medium = Medium(args.blocks, wear_leveling, args.seed)
+    files  = []
+
+    for op in range(args.ops):
+        if files and (len(files) >= args.files or rnd.random() < 0.3):
+            chain = files.pop(rnd.randrange(len(files)))
+            for blk in chain:
+                medium.release(blk)
+            medium.write(medium.root)
+
+        else:
+            size  = rnd.randint(1, args.max_size)
+            chain = []
+            try:
+                for _ in range((size + FILE_PAYLOAD - 1) // FILE_PAYLOAD + 1):
+                    blk = medium.alloc()
+                    medium.write(blk)
+                    chain.append(blk)
+            except MemoryError:
+                for blk in chain:
+                    medium.release(blk)
+                chain = None
+
+            if chain:
+                files.append(chain)
+                medium.write(medium.root)
+
+        if (op + 1) % args.sync == 0:
+            medium.sync()
+
+    medium.sync()
+
+    return medium.writes, medium.root + 1
+
+
+def report(name, result, endurance):
+    writes, meta = result
+    data  = writes[meta:]
+    used  = [w for w in data if w]
+    peak  = max(data)
+    mean  = sum(data) / len(data)
+    print("%-16s metadata max: %7d  data max: %7d  data mean: %8.1f  "
+          "used data blocks: %5d/%d  data lifetime: x%.2f"
+          % (name, max(writes[:meta]), peak, mean, len(used), len(data),
+             endurance / peak if peak else float("inf")))
+    return peak
+
+
+def main():
+    parser = argparse.ArgumentParser(description="eefs wear simulator")
+    parser.add_argument("--blocks",   type=int, default=256,   help="number of 128 B blocks")
+    parser.add_argument("--ops",      type=int, default=20000, help="number of file operations")
+    parser.add_argument("--files",    type=int, default=8,     help="maximum number of files")
+    parser.add_argument("--max-size", type=int, default=1024,  help="maximum file size in bytes")
+    parser.add_argument("--sync",     type=int, default=4,     help="operations between syncs")
+    parser.add_argument("--seed",     type=int, default=1,     help="random seed")
+    parser.add_argument("--endurance",type=int, default=100000,help="block write endurance")
+    args = parser.parse_args()
+
+    print("medium: %d blocks (%d B), %d operations, sync every %d operations\n"
+          % (args.blocks, args.blocks * BLOCK_SIZE, args.ops, args.sync))
+
+    # main, bitmap, and root directory blocks have fixed positions, so their
+    # writes are reduced only by the write-back cache (see --sync); lifetime
+    # is number of simulated workloads before peak data block reaches endurance
+    base = report("first-fit", run(args, False), args.endurance)
+    wl   = report("wear-leveling", run(args, True), args.endurance)
+
+    print("\npeak data block writes reduced by factor %.2f" % (base / wl if wl else float("inf")))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+#
+# Report of dnx RTOS lock profiler (/proc/lockprof).
+#
+# Profiler is enabled by "Lock profiler" option in the OS configuration.
+# Statistics are read and cleared on target by using procfs file:
+#   echo reset > /proc/lockprof
+#   ... (run workload)
+#   cat /proc/lockprof > /mnt/lockprof.txt
+#
+# Script ranks lock classes by total wait time, so the locks that should be
+# split or shortened first are at the top of the report. When two files are
+# given, counters of the first one (e.g. taken before workload) are subtracted
+# from the second one; max values are taken from the second file.
+#
+# Usage: python3 lockprof.py [<before.txt>] <after.txt>
+#
+
+import sys
+
+COUNTERS = ("acquires", "contended", "timeouts", "wait")
+MAXIMUMS = ("wait_max", "hold_max")
+
+
+def parse(lines):
+    """Parse lock profile records. Returns dictionary of lock classes."""
+
+    locks = {}
+
+    for line in lines:
+        fields = line.split()
+        if len(fields) != 8 or not fields[1].isdigit():
+            continue
+
+        locks[fields[0]] = {"acquires":  int(fields[1]),
+                            "contended": int(fields[2]),
+                            "timeouts":  int(fields[3]),
+                            "wait":      int(fields[4]),
+                            "wait_max":  int(fields[6]),
+                            "hold_max":  int(fields[7])}
+
+    return locks
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print("Usage: python3 lockprof.py [<before.txt>] <after.txt>")
+        exit(1)
+
+    files = []
+    for path in sys.argv[1:]:
+        with open(path, "r") as fin:
+            files.append(parse(fin.readlines()))
+
+    locks = files[-1]
+
+    if len(files) == 2:
+        for name, stat in locks.items():
+            before = files[0].get(name)
+            if before:
+                for key in COUNTERS:
+                    stat[key] = max(stat[key] - before[key], 0)
+
+    total = sum(stat["wait"] for stat in locks.values())
+
+    print("        lock   acquires contention  wait[ms]  share  avg[us]  max[us] hold[us]")
+
+    for name in sorted(locks, key=lambda n: locks[n]["wait"], reverse=True):
+        stat  = locks[name]
+        ratio = 100.0 * stat["contended"] / stat["acquires"] if stat["acquires"] else 0.0
+        share = 100.0 * stat["wait"] / total if total else 0.0
+        avg   = stat["wait"] // stat["contended"] if stat["contended"] else 0
+
+        print("%12s %10d %9.1f%% %9.1f %5.1f%% %8d %8d %8d%s" %
+              (name, stat["acquires"], ratio, stat["wait"] / 1000.0, share, avg,
+               stat["wait_max"], stat["hold_max"],
+               "  (timeouts: %d)" % stat["timeouts"] if stat["timeouts"] else ""))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+#
+# Report of dnx RTOS stack profiler (/proc/stackprof).
+#
+# Profiler is enabled by "Stack profiler" option in the OS configuration.
+# Statistics are read on target by using procfs file:
+#   cat /proc/stackprof > /mnt/stackprof.txt
+#
+# Several files (e.g. from different boards or test runs) can be given: peak
+# usage of each program thread is the maximum of all files. Thread function
+# addresses are translated to function names by addr2line tool when firmware
+# ELF file is given. Script prints recommended stack depths (peak usage with
+# safety margin) and amount of memory that can be reclaimed.
+#
+# Usage: python3 stackprof.py [--margin=<%>] [--elf=<firmware.elf>] <stackprof.txt>...
+#
+
+import subprocess
+import sys
+
+ADDR2LINE  = "arm-none-eabi-addr2line"
+WORD_SIZE  = 4
+
+
+def parse(lines, threads):
+    """Parse stack profile records and merge them with already parsed ones."""
+
+    margin = None
+
+    for line in lines:
+        if line.startswith("Safety margin:"):
+            margin = int(line.split(":")[1].strip().rstrip("%"))
+            continue
+
+        fields = line.split()
+        if len(fields) != 7 or not fields[1].startswith("0x"):
+            continue
+
+        key  = (fields[0], int(fields[1], 16), int(fields[2]))
+        prev = threads.get(key, {"peak": 0, "runs": 0})
+
+        threads[key] = {"peak": max(prev["peak"], int(fields[3])),
+                        "runs": prev["runs"] + int(fields[4])}
+
+    return margin
+
+
+def resolve(threads, elf):
+    """Translate thread function addresses to function names."""
+
+    names = {}
+    addrs = sorted(set(key[1] for key in threads if key[1]))
+
+    if elf and addrs:
+        try:
+            out = subprocess.check_output([ADDR2LINE, "-f", "-s", "-e", elf] +
+                                          ["0x%x" % (addr & ~1) for addr in addrs],
+                                          universal_newlines=True).splitlines()
+        except (OSError, subprocess.CalledProcessError) as err:
+            print("addr2line: %s" % err, file=sys.stderr)
+            out = []
+
+        for i, addr in enumerate(addrs):
+            if 2 * i < len(out):
+                names[addr] = out[2 * i]
+
+    return names
+
+
+def main():
+    margin = None
+    elf    = None
+    files  = []
+
+    for arg in sys.argv[1:]:
+        if arg.startswith("--margin="):
+            margin = int(arg.split("=")[1])
+        elif arg.startswith("--elf="):
+            elf = arg.split("=")[1]
+        else:
+            files.append(arg)
+
+    if not files:
+        print("Usage: python3 stackprof.py [--margin=<%>] [--elf=<firmware.elf>] <stackprof.txt>...")
+        exit(1)
+
+    threads = {}
+    for path in files:
+        with open(path, "r") as fin:
+            file_margin = parse(fin.readlines(), threads)
+            if margin is None:
+                margin = file_margin
+
+    if margin is None:
+        margin = 25
+
+    names       = resolve(threads, elf)
+    reclaimable = 0
+
+    print("Safety margin: %d%%" % margin)
+    print("     program  thread                    depth   peak    rec   runs  reclaim[B]")
+
+    for key in sorted(threads, key=lambda k: k[2] - threads[k]["peak"], reverse=True):
+        name, entry, depth = key
+        peak = threads[key]["peak"]
+        rec  = (peak + (peak * margin) // 100 + 7) & ~7
+        gain = max(depth - rec, 0) * WORD_SIZE
+
+        reclaimable += gain
+
+        if entry == 0:
+            thread = "main"
+        else:
+            thread = names.get(entry, "0x%08x" % entry)
+
+        print("%12s  %-24s %6d %6d %6d %6d  %10d%s" %
+              (name, thread[:24], depth, peak, rec, threads[key]["runs"], gain,
+               "  (too small!)" if rec > depth else ""))
+
+    print()
+    print("Reclaimable stack memory: %d bytes" % reclaimable)
+
+
+if __name__ == "__main__":
+    main()
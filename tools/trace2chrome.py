@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+#
+# Converter of dnx RTOS kernel trace (/proc/trace) to Chrome trace JSON.
+#
+# Trace is recorded and read on target by using procfs file:
+#   echo start > /proc/trace
+#   ... (run workload)
+#   echo stop > /proc/trace
+#   cat /proc/trace > /mnt/trace.txt
+#
+# Output file can be opened in chrome://tracing or https://ui.perfetto.dev.
+# Each task is presented as thread of owning process (task handle is used as
+# thread ID). Task run time and interrupt handlers are presented as slices,
+# system calls as asynchronous slices (call can be switched out), and queue
+# blocking and unblocking as instant events.
+#
+# Usage: python3 trace2chrome.py <trace.txt> [<trace.json>]
+#
+
+import json
+import sys
+
+EVENT_HEADER             = 0x00
+EVENT_TASK_SWITCHED_IN   = 0x01
+EVENT_TASK_SWITCHED_OUT  = 0x02
+EVENT_BLOCK_ON_RECEIVE   = 0x03
+EVENT_BLOCK_ON_SEND      = 0x04
+EVENT_TASK_READY         = 0x05
+EVENT_SEND_FROM_ISR      = 0x06
+EVENT_RECEIVE_FROM_ISR   = 0x07
+EVENT_ISR_ENTER          = 0x08
+EVENT_ISR_EXIT           = 0x09
+EVENT_SYSCALL_ENTER      = 0x0A
+EVENT_SYSCALL_EXIT       = 0x0B
+EVENT_PROCESS_NAME       = 0x0C
+
+FORMAT_VERSION           = 1
+IRQ_PID                  = 0x10000
+
+
+def parse(lines):
+    """Parse trace records. Returns frequency, events, and process names."""
+
+    freq   = None
+    events = []
+    names  = {}
+
+    for num, line in enumerate(lines, 1):
+        fields = line.split(None, 3)
+        if not fields:
+            continue
+
+        try:
+            timestamp = int(fields[0], 16)
+            evtype    = int(fields[1], 16)
+            arg16     = int(fields[2], 16)
+        except (IndexError, ValueError):
+            raise ValueError("line %d: invalid record" % num)
+
+        if evtype == EVENT_HEADER:
+            if arg16 != FORMAT_VERSION:
+                raise ValueError("unsupported trace format version %d" % arg16)
+            freq = int(fields[3], 16)
+
+        elif evtype == EVENT_PROCESS_NAME:
+            names[arg16] = fields[3].strip() if len(fields) > 3 else ""
+
+        else:
+            events.append((timestamp, evtype, arg16, int(fields[3], 16)))
+
+    if not freq:
+        raise ValueError("no trace header")
+
+    return freq, events, names
+
+
+def convert(freq, events, names):
+    """Convert events to Chrome trace format."""
+
+    out      = []
+    task_pid = {}
+    running  = None
+    irq      = {}
+    time     = 0
+    last     = None
+
+    # time stamp counter is 32-bit, so overflows are unwrapped assuming
+    # that distance between events is shorter than counter period
+    def us(timestamp):
+        nonlocal time, last
+        if last is not None:
+            time += (timestamp - last) & 0xFFFFFFFF
+        last = timestamp
+        return time * 1e6 / freq
+
+    for timestamp, evtype, arg16, arg32 in events:
+        ts = us(timestamp)
+
+        if evtype == EVENT_TASK_SWITCHED_IN:
+            task_pid[arg32] = arg16
+            running = (arg16, arg32, ts)
+
+        elif evtype == EVENT_TASK_SWITCHED_OUT:
+            if running and running[1] == arg32:
+                out.append({"name": "running", "cat": "sched", "ph": "X",
+                            "pid": arg16, "tid": arg32,
+                            "ts": running[2], "dur": ts - running[2]})
+            running = None
+
+        elif evtype in (EVENT_BLOCK_ON_RECEIVE, EVENT_BLOCK_ON_SEND):
+            if running:
+                out.append({"name": "block on " + ("receive" if evtype == EVENT_BLOCK_ON_RECEIVE else "send"),
+                            "cat": "queue", "ph": "i", "s": "t",
+                            "pid": running[0], "tid": running[1], "ts": ts,
+                            "args": {"queue": "0x%08x" % arg32}})
+
+        elif evtype == EVENT_TASK_READY:
+            out.append({"name": "ready", "cat": "sched", "ph": "i", "s": "t",
+                        "pid": task_pid.get(arg32, 0), "tid": arg32, "ts": ts})
+
+        elif evtype in (EVENT_SEND_FROM_ISR, EVENT_RECEIVE_FROM_ISR):
+            out.append({"name": "send from ISR" if evtype == EVENT_SEND_FROM_ISR else "receive from ISR",
+                        "cat": "queue", "ph": "i", "s": "p", "pid": IRQ_PID, "tid": 0,
+                        "ts": ts, "args": {"queue": "0x%08x" % arg32}})
+
+        elif evtype == EVENT_ISR_ENTER:
+            irq[arg16] = ts
+
+        elif evtype == EVENT_ISR_EXIT:
+            if arg16 in irq:
+                begin = irq.pop(arg16)
+                out.append({"name": "IRQ %d" % arg16, "cat": "irq", "ph": "X",
+                            "pid": IRQ_PID, "tid": IRQ_PID + arg16,
+                            "ts": begin, "dur": ts - begin})
+
+        elif evtype == EVENT_SYSCALL_ENTER:
+            if running:
+                out.append({"name": "syscall %d" % arg16, "cat": "syscall", "ph": "b",
+                            "id": "0x%08x" % running[1], "pid": running[0],
+                            "tid": running[1], "ts": ts,
+                            "args": {"client_pid": arg32}})
+
+        elif evtype == EVENT_SYSCALL_EXIT:
+            if running:
+                out.append({"name": "syscall %d" % arg16, "cat": "syscall", "ph": "e",
+                            "id": "0x%08x" % running[1], "pid": running[0],
+                            "tid": running[1], "ts": ts,
+                            "args": {"err": arg32}})
+
+    # close slice of task running at the end of trace
+    if running:
+        out.append({"name": "running", "cat": "sched", "ph": "X",
+                    "pid": running[0], "tid": running[1],
+                    "ts": running[2], "dur": us(last) - running[2]})
+
+    # metadata
+    for pid in set(task_pid.values()):
+        out.append({"name": "process_name", "ph": "M", "pid": pid,
+                    "args": {"name": names.get(pid, "kernel") + " (%d)" % pid}})
+
+    for task, pid in task_pid.items():
+        out.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": task,
+                    "args": {"name": "task 0x%08x" % task}})
+
+    for num in set(ev[2] for ev in events if ev[1] == EVENT_ISR_ENTER):
+        out.append({"name": "thread_name", "ph": "M", "pid": IRQ_PID, "tid": IRQ_PID + num,
+                    "args": {"name": "IRQ %d" % num}})
+
+    out.append({"name": "process_name", "ph": "M", "pid": IRQ_PID,
+                "args": {"name": "interrupts"}})
+
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python3 trace2chrome.py <trace.txt> [<trace.json>]")
+        exit(1)
+
+    with open(sys.argv[1], "r") as fin:
+        freq, events, names = parse(fin.readlines())
+
+    trace = {"traceEvents": convert(freq, events, names), "displayTimeUnit": "ns"}
+
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as fout:
+            json.dump(trace, fout)
+    else:
+        json.dump(trace, sys.stdout)
+
+    print("trace: %d events, %d Hz time stamp" % (len(events), freq), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()